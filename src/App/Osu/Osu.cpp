@@ -8,6 +8,7 @@
 #include "OsuDatabase.h"
 #include "Osu.h"
 
+#include "AllocTracker.h"
 #include "Engine.h"
 #include "Environment.h"
 #include "Keyboard.h"
@@ -41,6 +42,7 @@
 #include "OsuNotificationOverlay.h"
 #include "OsuTooltipOverlay.h"
 #include "OsuGameRules.h"
+#include "OsuConVarSnapshot.h"
 #include "OsuPauseMenu.h"
 #include "OsuScore.h"
 #include "OsuSkin.h"
@@ -51,6 +53,7 @@
 #include "OsuRichPresence.h"
 #include "OsuSteamWorkshop.h"
 #include "OsuModFPoSu.h"
+#include "OsuRenderBenchmark.h"
 
 #include "OsuBeatmap.h"
 #include "OsuDatabaseBeatmap.h"
@@ -407,6 +410,7 @@ Osu::Osu()
 	if constexpr (Env::cfg(FEAT::STEAM))
 		m_steamWorkshop = new OsuSteamWorkshop();
 	m_fposu = new OsuModFPoSu();
+	m_renderBenchmark = new OsuRenderBenchmark();
 
 	// the order in this vector will define in which order events are handled/consumed
 	m_screens.push_back(m_notificationOverlay);
@@ -479,6 +483,7 @@ Osu::~Osu()
 	if constexpr (Env::cfg(FEAT::STEAM))
 		SAFE_DELETE(m_steamWorkshop);
 	SAFE_DELETE(m_fposu);
+	SAFE_DELETE(m_renderBenchmark);
 
 	SAFE_DELETE(m_updateHandler);
 	SAFE_DELETE(m_score);
@@ -666,6 +671,8 @@ void Osu::draw()
 
 void Osu::update()
 {
+	OsuConVarSnapshot::update();
+
 	const int wheelDelta = mouse->getWheelDeltaVertical(); // HACKHACK: songbrowser focus
 
 	if (m_skin != NULL)
@@ -676,9 +683,12 @@ void Osu::update()
 
 	m_windowManager->update();
 
-	for (int i=0; i<m_screens.size(); i++)
 	{
-		m_screens[i]->update();
+		ALLOC_TAG(UI);
+		for (int i=0; i<m_screens.size(); i++)
+		{
+			m_screens[i]->update();
+		}
 	}
 
 	// main beatmap update
@@ -994,6 +1004,9 @@ void Osu::update()
 		m_bFireResolutionChangedScheduled = false;
 		fireResolutionChanged();
 	}
+
+	// render benchmark (must be last, measures with everything up to date)
+	m_renderBenchmark->update();
 }
 
 void Osu::updateMods()
@@ -1139,7 +1152,7 @@ void Osu::onKeyDown(KeyboardEvent &key)
 					else
 						m_bKeyboardKey1Down = true;
 
-					onKey1Change(true, false);
+					onKey1Change(true, false, key.getTimestampNS());
 
 					if (!getSelectedBeatmap()->hasFailed())
 						key.consume();
@@ -1162,7 +1175,7 @@ void Osu::onKeyDown(KeyboardEvent &key)
 					else
 						m_bKeyboardKey2Down = true;
 
-					onKey2Change(true, false);
+					onKey2Change(true, false, key.getTimestampNS());
 
 					if (!getSelectedBeatmap()->hasFailed())
 						key.consume();
@@ -1409,7 +1422,7 @@ void Osu::onKeyUp(KeyboardEvent &key)
 					m_bKeyboardKey1Down = false;
 
 				if (isInPlayMode())
-					onKey1Change(false, false);
+					onKey1Change(false, false, key.getTimestampNS());
 			}
 		}
 
@@ -1425,7 +1438,7 @@ void Osu::onKeyUp(KeyboardEvent &key)
 					m_bKeyboardKey2Down = false;
 
 				if (isInPlayMode())
-					onKey2Change(false, false);
+					onKey2Change(false, false, key.getTimestampNS());
 			}
 		}
 	}
@@ -1483,12 +1496,12 @@ void Osu::onButtonChange(MouseButton::Index button, bool down)
 		if (!m_bMouseKey1Down && down)
 		{
 			m_bMouseKey1Down = true;
-			onKey1Change(true, true);
+			onKey1Change(true, true, mouse->getButtonChangeTimestampNS());
 		}
 		else if (m_bMouseKey1Down)
 		{
 			m_bMouseKey1Down = false;
-			onKey1Change(false, true);
+			onKey1Change(false, true, mouse->getButtonChangeTimestampNS());
 		}
 		break;
 	}
@@ -1497,12 +1510,12 @@ void Osu::onButtonChange(MouseButton::Index button, bool down)
 		if (!m_bMouseKey2Down && down)
 		{
 			m_bMouseKey2Down = true;
-			onKey2Change(true, true);
+			onKey2Change(true, true, mouse->getButtonChangeTimestampNS());
 		}
 		else if (m_bMouseKey2Down)
 		{
 			m_bMouseKey2Down = false;
-			onKey2Change(false, true);
+			onKey2Change(false, true, mouse->getButtonChangeTimestampNS());
 		}
 		break;
 	}
@@ -2371,7 +2384,7 @@ void Osu::onConfineCursorNeverChange(const UString & /*oldValue*/, const UString
 	updateConfineCursor();
 }
 
-void Osu::onKey1Change(bool pressed, bool mouseButton)
+void Osu::onKey1Change(bool pressed, bool mouseButton, uint64_t timestampNS)
 {
 	int numKeys1Down = 0;
 	if (m_bKeyboardKey1Down)
@@ -2393,7 +2406,7 @@ void Osu::onKey1Change(bool pressed, bool mouseButton)
 				m_bMouseKey1Down = false;
 
 			if (pressed && isKeyPressed1Allowed && !getSelectedBeatmap()->isPaused()) // see above note
-				getSelectedBeatmap()->keyPressed1(mouseButton);
+				getSelectedBeatmap()->keyPressed1(mouseButton, timestampNS);
 			else if (!m_bKeyboardKey1Down && !m_bKeyboardKey12Down && !m_bMouseKey1Down)
 				getSelectedBeatmap()->keyReleased1(mouseButton);
 		}
@@ -2413,7 +2426,7 @@ void Osu::onKey1Change(bool pressed, bool mouseButton)
 	}
 }
 
-void Osu::onKey2Change(bool pressed, bool mouseButton)
+void Osu::onKey2Change(bool pressed, bool mouseButton, uint64_t timestampNS)
 {
 	int numKeys2Down = 0;
 	if (m_bKeyboardKey2Down)
@@ -2435,7 +2448,7 @@ void Osu::onKey2Change(bool pressed, bool mouseButton)
 				m_bMouseKey2Down = false;
 
 			if (pressed && isKeyPressed2Allowed && !getSelectedBeatmap()->isPaused()) // see above note
-				getSelectedBeatmap()->keyPressed2(mouseButton);
+				getSelectedBeatmap()->keyPressed2(mouseButton, timestampNS);
 			else if (!m_bKeyboardKey2Down && !m_bKeyboardKey22Down && !m_bMouseKey2Down)
 				getSelectedBeatmap()->keyReleased2(mouseButton);
 		}
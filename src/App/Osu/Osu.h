@@ -46,6 +46,7 @@ class OsuHUD;
 class OsuChangelog;
 class OsuEditor;
 class OsuModFPoSu;
+class OsuRenderBenchmark;
 
 class Graphics;
 
@@ -240,8 +241,8 @@ private:
 	void onConfineCursorFullscreenChange(const UString &oldValue, const UString &newValue);
 	void onConfineCursorNeverChange(const UString &oldValue, const UString &newValue);
 
-	void onKey1Change(bool pressed, bool mouseButton);
-	void onKey2Change(bool pressed, bool mouseButton);
+	void onKey1Change(bool pressed, bool mouseButton, uint64_t timestampNS);
+	void onKey2Change(bool pressed, bool mouseButton, uint64_t timestampNS);
 
 	void onModMafhamChange(const UString &oldValue, const UString &newValue);
 	void onModFPoSuChange(const UString &oldValue, const UString &newValue);
@@ -273,6 +274,7 @@ private:
 	OsuUpdateHandler *m_updateHandler;
 	[[maybe_unused]] OsuSteamWorkshop *m_steamWorkshop;
 	OsuModFPoSu *m_fposu;
+	OsuRenderBenchmark *m_renderBenchmark;
 	OsuKeyBindings *m_bindings;
 
 	std::vector<OsuScreen*> m_screens;
@@ -7,6 +7,7 @@
 
 #include "OsuBeatmap.h"
 
+#include "AllocTracker.h"
 #include "Engine.h"
 #include "ResourceManager.h"
 #include "Environment.h"
@@ -15,9 +16,12 @@
 #include "Keyboard.h"
 #include "Mouse.h"
 #include "Timing.h"
+#include "FrameTimeStats.h"
+#include "File.h"
 #include "ConVar.h"
 
 #include "Osu.h"
+#include "OsuConVarSnapshot.h"
 #include "OsuMultiplayer.h"
 #include "OsuHUD.h"
 #include "OsuSkin.h"
@@ -72,6 +76,8 @@ ConVar universal_offset_hardcoded_fallback_dsound("osu_universal_offset_hardcode
 ConVar old_beatmap_offset("osu_old_beatmap_offset", 24.0f, FCVAR_NONE, "offset in ms which is added to beatmap versions < 5 (default value is hardcoded 24 ms in stable)");
 ConVar timingpoints_offset("osu_timingpoints_offset", 5.0f, FCVAR_NONE, "Offset in ms which is added before determining the active timingpoint for the sample type and sample volume (hitsounds) of the current frame");
 ConVar interpolate_music_pos("osu_interpolate_music_pos", true, FCVAR_NONE, "Interpolate song position with engine time if the audio library reports the same position more than once");
+ConVar frametime_stats_per_play("osu_frametime_stats_per_play", false, FCVAR_NONE, "reset frametime_stats whenever a map starts playing, and save them to frametimes/ whenever a map is finished (named after the unix timestamp, same as the score)");
+ConVar click_timestamps("osu_click_timestamps", true, FCVAR_NONE, "judge clicks at the music position of when the key/button was actually pressed, instead of when the frame got around to handling it");
 ConVar compensate_music_speed("osu_compensate_music_speed", true, FCVAR_NONE, "compensates speeds slower than 1x a little bit, by adding an offset depending on the slowness");
 ConVar combobreak_sound_combo("osu_combobreak_sound_combo", 20, FCVAR_NONE, "Only play the combobreak sound if the combo is higher than this");
 ConVar beatmap_preview_mods_live("osu_beatmap_preview_mods_live", false, FCVAR_NONE, "whether to immediately apply all currently selected mods while browsing beatmaps (e.g. speed/pitch)");
@@ -187,6 +193,7 @@ OsuBeatmap::OsuBeatmap()
 	m_fMusicFrequencyBackup = cv::snd_freq.getFloat();
 	m_iCurMusicPos = 0;
 	m_iCurMusicPosWithOffsets = 0;
+	m_iCurMusicPosTimestampNS = 0;
 	m_bWasSeekFrame = false;
 	m_fInterpolatedMusicPos = 0.0;
 	m_fLastAudioTimeAccurateSet = 0.0;
@@ -243,6 +250,7 @@ OsuBeatmap::~OsuBeatmap()
 
 void OsuBeatmap::draw()
 {
+	ALLOC_TAG(GAMEPLAY);
 	drawInt();
 }
 
@@ -392,6 +400,10 @@ void OsuBeatmap::update()
 {
 	if (!canUpdate()) return;
 
+	ALLOC_TAG(GAMEPLAY);
+
+	const OsuConVarSnapshot &cvars = OsuConVarSnapshot::get();
+
 	if (m_bContinueScheduled)
 	{
 		bool isEarlyNoteContinue = (!m_bIsPaused && m_bIsWaiting); // if we paused while m_bIsWaiting (green progressbar), then we have to let the 'if (m_bIsWaiting)' block handle the sound play() call
@@ -423,6 +435,8 @@ void OsuBeatmap::update()
 	}
 
 	// update current music position (this variable does not include any offsets!)
+	const uint64_t prevMusicPosTimestampNS = m_iCurMusicPosTimestampNS;
+	m_iCurMusicPosTimestampNS = Timing::getTicksNS();
 	m_iCurMusicPos = getMusicPositionMSInterpolated();
 	m_iContinueMusicPos = m_music->getPositionMS();
 	const bool wasSeekFrame = m_bWasSeekFrame;
@@ -474,6 +488,10 @@ void OsuBeatmap::update()
 
 					m_bIsRestartScheduledQuick = false;
 
+					// (only now, loading and preloading stalls shouldn't count)
+					if (cv::osu::frametime_stats_per_play.getBool())
+						engine->getFrameTimeStats()->reset();
+
 					onPlayStart();
 				}
 			}
@@ -483,12 +501,12 @@ void OsuBeatmap::update()
 
 		// ugh. force update all hitobjects while waiting (necessary because of pvs optimization)
 		long curPos = m_iCurMusicPos
-			+ (long)(cv::osu::universal_offset.getFloat() * osu->getSpeedMultiplier())
-			+ (long)cv::osu::universal_offset_hardcoded.getInt()
-			+ (cv::win_snd_fallback_dsound.getBool() ? (long)cv::osu::universal_offset_hardcoded_fallback_dsound.getInt() : 0)
+			+ (long)(cvars.universalOffset * osu->getSpeedMultiplier())
+			+ (long)cvars.universalOffsetHardcoded
+			+ (cvars.sndFallbackDSound ? (long)cvars.universalOffsetHardcodedFallbackDSound : 0)
 			- m_selectedDifficulty2->getLocalOffset()
 			- m_selectedDifficulty2->getOnlineOffset()
-			- (m_selectedDifficulty2->getVersion() < 5 ? cv::osu::old_beatmap_offset.getInt() : 0);
+			- (m_selectedDifficulty2->getVersion() < 5 ? cvars.oldBeatmapOffset : 0);
 		if (curPos > -1) // otherwise auto would already click elements that start at exactly 0 (while the map has not even started)
 			curPos = -1;
 
@@ -555,14 +573,30 @@ void OsuBeatmap::update()
 
 	// update timing (points)
 	m_iCurMusicPosWithOffsets = m_iCurMusicPos
-		+ (long)(cv::osu::universal_offset.getFloat() * osu->getSpeedMultiplier())
-		+ (long)cv::osu::universal_offset_hardcoded.getInt()
-		+ (cv::win_snd_fallback_dsound.getBool() ? (long)cv::osu::universal_offset_hardcoded_fallback_dsound.getInt() : 0)
+		+ (long)(cvars.universalOffset * osu->getSpeedMultiplier())
+		+ (long)cvars.universalOffsetHardcoded
+		+ (cvars.sndFallbackDSound ? (long)cvars.universalOffsetHardcodedFallbackDSound : 0)
 		- m_selectedDifficulty2->getLocalOffset()
 		- m_selectedDifficulty2->getOnlineOffset()
-		- (m_selectedDifficulty2->getVersion() < 5 ? cv::osu::old_beatmap_offset.getInt() : 0);
+		- (m_selectedDifficulty2->getVersion() < 5 ? cvars.oldBeatmapOffset : 0);
 	updateTimingPoints(m_iCurMusicPosWithOffsets);
 
+	// input is handled before the update, so all new clicks got the music position of the previous frame.
+	// move them forward to when they actually happened, going back from the position we just sampled at the rate the music clock advances at
+	// (only for events inbetween the two samples, anything else was synthesized or is stale)
+	if (cv::osu::click_timestamps.getBool() && !wasSeekFrame && prevMusicPosTimestampNS > 0)
+	{
+		for (std::vector<CLICK> *clicks : {&m_clicks, &m_keyUps})
+		{
+			for (CLICK &click : *clicks)
+			{
+				click.musicPos = getClickMusicPosAtTimestamp(click.musicPos, click.timestampNS, m_iCurMusicPosWithOffsets, m_iCurMusicPosTimestampNS, prevMusicPosTimestampNS, osu->getSpeedMultiplier());
+
+				click.timestampNS = 0; // (only once, these may stick around for more than one frame)
+			}
+		}
+	}
+
 	// for performance reasons, a lot of operations are crammed into 1 loop over all hitobjects:
 	// update all hitobjects,
 	// handle click events,
@@ -583,10 +617,10 @@ void OsuBeatmap::update()
 	{
 		bool blockNextNotes = false;
 
-		const long pvs = !cv::osu::stdrules::mod_mafham.getBool() ? getPVS() : (m_hitobjects.size() > 0 ? (m_hitobjects[std::clamp<int>(m_iCurrentHitObjectIndex + cv::osu::stdrules::mod_mafham_render_livesize.getInt() + 1, 0, m_hitobjects.size()-1)]->getTime() - m_iCurMusicPosWithOffsets + 1500) : getPVS());
-		const bool usePVS = cv::osu::pvs.getBool();
+		const long pvs = !cvars.modMafham ? getPVS() : (m_hitobjects.size() > 0 ? (m_hitobjects[std::clamp<int>(m_iCurrentHitObjectIndex + cvars.modMafhamRenderLivesize + 1, 0, m_hitobjects.size()-1)]->getTime() - m_iCurMusicPosWithOffsets + 1500) : getPVS());
+		const bool usePVS = cvars.pvs;
 
-		const int notelockType = cv::osu::notelock_type.getInt();
+		const int notelockType = cvars.notelockType;
 		const long tolerance2B = (long)cv::osu::notelock_stable_tolerance2b.getInt();
 
 		m_iCurrentHitObjectIndex = 0; // reset below here, since it's needed for mafham pvs
@@ -621,7 +655,7 @@ void OsuBeatmap::update()
 					const long actualPrevHitObjectTime = m_hitobjects[i]->getTime() + m_hitobjects[i]->getDuration();
 					m_iPreviousHitObjectTime = actualPrevHitObjectTime;
 
-					if (m_iCurMusicPosWithOffsets > actualPrevHitObjectTime + (long)cv::osu::followpoints_prevfadetime.getFloat())
+					if (m_iCurMusicPosWithOffsets > actualPrevHitObjectTime + (long)cvars.followpointsPrevFadeTime)
 						m_iPreviousFollowPointObjectIndex = i;
 				}
 			}
@@ -1166,7 +1200,18 @@ void OsuBeatmap::skipEmptySection()
 	soundEngine->play(osu->getSkin()->getMenuHit());
 }
 
-void OsuBeatmap::keyPressed1(bool mouseButton)
+long OsuBeatmap::getClickMusicPosAtTimestamp(long clickMusicPos, uint64_t clickTimestampNS, long musicPos, uint64_t musicPosTimestampNS, uint64_t prevMusicPosTimestampNS, float speedMultiplier)
+{
+	// anything outside of the two samples was synthesized or is stale
+	if (clickTimestampNS <= prevMusicPosTimestampNS || clickTimestampNS > musicPosTimestampNS)
+		return clickMusicPos;
+
+	// never before the previous position (which is what the click already has), in case the music didn't actually advance inbetween (pause etc.)
+	const double deltaMS = (double)(musicPosTimestampNS - clickTimestampNS) / (double)Timing::NS_PER_MS;
+	return std::max(clickMusicPos, musicPos - (long)std::round(deltaMS * speedMultiplier));
+}
+
+void OsuBeatmap::keyPressed1(bool mouseButton, uint64_t timestampNS)
 {
 	if (m_bContinueScheduled)
 	{
@@ -1199,12 +1244,13 @@ void OsuBeatmap::keyPressed1(bool mouseButton)
 	CLICK click;
 	click.musicPos = m_iCurMusicPosWithOffsets;
 	click.maniaColumn = -1;
+	click.timestampNS = timestampNS;
 
 	if ((!osu->getModAuto() && !osu->getModRelax()) || !cv::osu::auto_and_relax_block_user_input.getBool())
 		m_clicks.push_back(click);
 }
 
-void OsuBeatmap::keyPressed2(bool mouseButton)
+void OsuBeatmap::keyPressed2(bool mouseButton, uint64_t timestampNS)
 {
 	if (m_bContinueScheduled)
 	{
@@ -1237,6 +1283,7 @@ void OsuBeatmap::keyPressed2(bool mouseButton)
 	CLICK click;
 	click.musicPos = m_iCurMusicPosWithOffsets;
 	click.maniaColumn = -1;
+	click.timestampNS = timestampNS;
 
 	if ((!osu->getModAuto() && !osu->getModRelax()) || !cv::osu::auto_and_relax_block_user_input.getBool())
 		m_clicks.push_back(click);
@@ -1583,6 +1630,10 @@ void OsuBeatmap::stop(bool quit)
 
 	onBeforeStop(quit);
 
+	// (for every mode, independent of whether a score got saved)
+	if (!quit)
+		saveFrameTimeStats();
+
 	unloadObjects();
 
 	onStop(quit);
@@ -2279,6 +2330,42 @@ void OsuBeatmap::playMissSound()
 	}
 }
 
+long OsuBeatmap::getMusicPosWithOffsetsAt(uint64_t timestampNS) const
+{
+	// extrapolated from the last sample, at the rate the music clock advances
+	const double deltaMS = ((double)timestampNS - (double)m_iCurMusicPosTimestampNS) / (double)Timing::NS_PER_MS;
+	return m_iCurMusicPosWithOffsets + (long)std::round(deltaMS * osu->getSpeedMultiplier());
+}
+
+void OsuBeatmap::saveFrameTimeStats() const
+{
+	if (!cv::osu::frametime_stats_per_play.getBool() || m_selectedDifficulty2 == NULL)
+		return;
+
+	if (!env->directoryExists("frametimes") && !env->createDirectory("frametimes"))
+	{
+		debugLog("Osu Error: Couldn't create frametimes folder!\n");
+		return;
+	}
+
+	// same clock as OsuDatabase::Score::unixTimestamp, so that saved scores can be matched up with their file
+	const uint64_t unixTimestamp = std::chrono::duration_cast<std::chrono::seconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+
+	const UString filePath = UString::format("frametimes/%llu_%s.txt", (unsigned long long)unixTimestamp, m_selectedDifficulty2->getMD5Hash().c_str());
+	McFile file(filePath, McFile::TYPE::WRITE);
+	if (!file.canWrite())
+	{
+		debugLog("Osu Error: Couldn't write {:s}\n", filePath);
+		return;
+	}
+
+	file.writeLine(UString::format("%s - %s [%s]", m_selectedDifficulty2->getArtist().toUtf8(), m_selectedDifficulty2->getTitle().toUtf8(),
+	                               m_selectedDifficulty2->getDifficultyName().toUtf8()));
+	file.writeLine(UString::format("md5: %s, timestamp: %llu, build: %s %s", m_selectedDifficulty2->getMD5Hash().c_str(), (unsigned long long)unixTimestamp, __DATE__, __TIME__));
+	file.writeLine("");
+	file.writeLine(UString(engine->getFrameTimeStats()->toString().c_str()), false);
+}
+
 unsigned long OsuBeatmap::getMusicPositionMSInterpolated()
 {
 	if (!cv::osu::interpolate_music_pos.getBool() || isLoading())
@@ -37,6 +37,7 @@ public:
 	{
 		long musicPos;
 		int maniaColumn;
+		uint64_t timestampNS; // when the input event happened (Timing::getTicksNS() time base), musicPos is corrected to it in update()
 	};
 	enum Type : uint8_t { STANDARD, MANIA, EXAMPLE };
 
@@ -62,11 +63,14 @@ public:
 
 	// callbacks called by the Osu class (osu!standard)
 	void skipEmptySection();
-	void keyPressed1(bool mouseButton);
-	void keyPressed2(bool mouseButton);
+	void keyPressed1(bool mouseButton, uint64_t timestampNS);
+	void keyPressed2(bool mouseButton, uint64_t timestampNS);
 	void keyReleased1(bool mouseButton);
 	void keyReleased2(bool mouseButton);
 
+	// music position of a click which happened inbetween the previous and the current music position sample, going back from the current one (see update())
+	[[nodiscard]] static long getClickMusicPosAtTimestamp(long clickMusicPos, uint64_t clickTimestampNS, long musicPos, uint64_t musicPosTimestampNS, uint64_t prevMusicPosTimestampNS, float speedMultiplier);
+
 	// songbrowser & player logic
 	void select(); // loads the music of the currently selected diff and starts playing from the previewTime (e.g. clicking on a beatmap)
 	void selectDifficulty2(OsuDatabaseBeatmap *difficulty2);
@@ -129,6 +133,7 @@ public:
 
 	[[nodiscard]] inline long getCurMusicPos() const {return m_iCurMusicPos;}
 	[[nodiscard]] inline long getCurMusicPosWithOffsets() const {return m_iCurMusicPosWithOffsets;}
+	[[nodiscard]] long getMusicPosWithOffsetsAt(uint64_t timestampNS) const; // for input timestamps (Timing::getTicksNS() time base) close to the current frame
 
 	[[nodiscard]] float getRawAR() const;
 	[[nodiscard]] float getAR() const;
@@ -238,6 +243,8 @@ protected:
 
 	void playMissSound();
 
+	void saveFrameTimeStats() const; // osu_frametime_stats_per_play
+
 	unsigned long getMusicPositionMSInterpolated();
 
 	// custom
@@ -267,6 +274,7 @@ protected:
 	float m_fMusicFrequencyBackup;
 	long m_iCurMusicPos;
 	long m_iCurMusicPosWithOffsets;
+	uint64_t m_iCurMusicPosTimestampNS; // when m_iCurMusicPos was sampled
 	bool m_bWasSeekFrame;
 	double m_fInterpolatedMusicPos;
 	double m_fLastAudioTimeAccurateSet;
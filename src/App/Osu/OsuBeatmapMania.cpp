@@ -181,6 +181,7 @@ void OsuBeatmapMania::onKeyDown(KeyboardEvent &key)
 		CLICK click;
 		click.musicPos = m_iCurMusicPosWithOffsets;
 		click.maniaColumn = column;
+		click.timestampNS = key.getTimestampNS();
 
 		m_clicks.push_back(click);
 	}
@@ -198,6 +199,7 @@ void OsuBeatmapMania::onKeyUp(KeyboardEvent &key)
 		CLICK click;
 		click.musicPos = m_iCurMusicPosWithOffsets;
 		click.maniaColumn = column;
+		click.timestampNS = key.getTimestampNS();
 
 		m_keyUps.push_back(click);
 	}
@@ -16,6 +16,7 @@
 #include "ConVar.h"
 
 #include "Osu.h"
+#include "OsuConVarSnapshot.h"
 #include "OsuMultiplayer.h"
 #include "OsuHUD.h"
 #include "OsuSkin.h"
@@ -217,7 +218,7 @@ void OsuBeatmapStandard::draw()
 	}
 
 	// draw followpoints
-	if (cv::osu::draw_followpoints.getBool() && !cv::osu::stdrules::mod_mafham.getBool())
+	if (OsuConVarSnapshot::get().drawFollowpoints && !OsuConVarSnapshot::get().modMafham)
 		drawFollowPoints();
 
 	// draw all hitobjects in reverse
@@ -315,7 +316,7 @@ void OsuBeatmapStandard::draw3D()
 	{
 		const long curPos = m_iCurMusicPosWithOffsets;
 		const long pvs = getPVS();
-		const bool usePVS = cv::osu::pvs.getBool();
+		const bool usePVS = OsuConVarSnapshot::get().pvs;
 
 		if (!cv::osu::draw_reverse_order.getBool())
 		{
@@ -363,7 +364,7 @@ void OsuBeatmapStandard::draw3D2()
 	// TODO: draw followpoints
 	{
 		/*
-		if (cv::osu::draw_followpoints.getBool() && !cv::osu::stdrules::mod_mafham.getBool())
+		if (OsuConVarSnapshot::get().drawFollowpoints && !OsuConVarSnapshot::get().modMafham)
 			drawFollowPoints();
 		*/
 	}
@@ -373,7 +374,7 @@ void OsuBeatmapStandard::draw3D2()
 	{
 		const long curPos = m_iCurMusicPosWithOffsets;
 		const long pvs = getPVS();
-		const bool usePVS = cv::osu::pvs.getBool();
+		const bool usePVS = OsuConVarSnapshot::get().pvs;
 
 		for (int i=0; std::cmp_less(i,m_hitobjectsSortedByEndTime.size()); i++)
 		{
@@ -405,7 +406,7 @@ void OsuBeatmapStandard::drawFollowPoints()
 	const bool followPointsConnectCombos = cv::osu::followpoints_connect_combos.getBool();
 	const bool followPointsConnectSpinners = cv::osu::followpoints_connect_spinners.getBool();
 	const float followPointSeparationMultiplier = std::max(cv::osu::followpoints_separation_multiplier.getFloat(), 0.1f);
-	const float followPointPrevFadeTime = cv::osu::followpoints_prevfadetime.getFloat();
+	const float followPointPrevFadeTime = OsuConVarSnapshot::get().followpointsPrevFadeTime;
 	const float followPointScaleMultiplier = cv::osu::followpoints_scale_multiplier.getFloat();
 
 	// include previous object in followpoints
@@ -522,9 +523,9 @@ void OsuBeatmapStandard::drawHitObjects()
 {
 	const long curPos = m_iCurMusicPosWithOffsets;
 	const long pvs = getPVS();
-	const bool usePVS = cv::osu::pvs.getBool();
+	const bool usePVS = OsuConVarSnapshot::get().pvs;
 
-	if (!cv::osu::stdrules::mod_mafham.getBool())
+	if (!OsuConVarSnapshot::get().modMafham)
 	{
 		if (!cv::osu::draw_reverse_order.getBool())
 		{
@@ -575,7 +576,7 @@ void OsuBeatmapStandard::drawHitObjects()
 	}
 	else
 	{
-		const int mafhamRenderLiveSize = cv::osu::stdrules::mod_mafham_render_livesize.getInt();
+		const int mafhamRenderLiveSize = OsuConVarSnapshot::get().modMafhamRenderLivesize;
 
 		if (m_mafhamActiveRenderTarget == NULL)
 			m_mafhamActiveRenderTarget = osu->getFrameBuffer();
@@ -658,7 +659,7 @@ void OsuBeatmapStandard::drawHitObjects()
 		}
 
 		// draw followpoints
-		if (cv::osu::draw_followpoints.getBool())
+		if (OsuConVarSnapshot::get().drawFollowpoints)
 			drawFollowPoints();
 
 		// draw live hitobjects (also, code duplication yay)
@@ -910,8 +911,10 @@ bool OsuBeatmapStandard::isLoading() const
 
 Vector2 OsuBeatmapStandard::pixels2OsuCoords(Vector2 pixelCoords) const
 {
+	const OsuConVarSnapshot &cvars = OsuConVarSnapshot::get();
+
 	// un-first-person
-	if (cv::osu::stdrules::mod_fps.getBool())
+	if (cvars.modFPS)
 	{
 		// HACKHACK: this is the worst hack possible (engine->isDrawing()), but it works
 		// the problem is that this same function is called while draw()ing and update()ing
@@ -928,39 +931,41 @@ Vector2 OsuBeatmapStandard::pixels2OsuCoords(Vector2 pixelCoords) const
 
 Vector2 OsuBeatmapStandard::osuCoords2Pixels(Vector2 coords) const
 {
+	const OsuConVarSnapshot &cvars = OsuConVarSnapshot::get();
+
 	if (osu->getModHR())
 		coords.y = OsuGameRules::OSU_COORD_HEIGHT - coords.y;
-	if (cv::osu::playfield_mirror_horizontal.getBool())
+	if (cvars.playfieldMirrorHorizontal)
 		coords.y = OsuGameRules::OSU_COORD_HEIGHT - coords.y;
-	if (cv::osu::playfield_mirror_vertical.getBool())
+	if (cvars.playfieldMirrorVertical)
 		coords.x = OsuGameRules::OSU_COORD_WIDTH - coords.x;
 
 	// wobble
-	if (cv::osu::mod_wobble.getBool())
+	if (cvars.modWobble)
 	{
 		const float speedMultiplierCompensation = 1.0f / getSpeedMultiplier();
-		coords.x += std::sin((m_iCurMusicPos/1000.0f)*5*speedMultiplierCompensation*cv::osu::mod_wobble_frequency.getFloat())*cv::osu::mod_wobble_strength.getFloat();
-		coords.y += std::sin((m_iCurMusicPos/1000.0f)*4*speedMultiplierCompensation*cv::osu::mod_wobble_frequency.getFloat())*cv::osu::mod_wobble_strength.getFloat();
+		coords.x += std::sin((m_iCurMusicPos/1000.0f)*5*speedMultiplierCompensation*cvars.modWobbleFrequency)*cvars.modWobbleStrength;
+		coords.y += std::sin((m_iCurMusicPos/1000.0f)*4*speedMultiplierCompensation*cvars.modWobbleFrequency)*cvars.modWobbleStrength;
 	}
 
 	// wobble2
-	if (cv::osu::mod_wobble2.getBool())
+	if (cvars.modWobble2)
 	{
 		const float speedMultiplierCompensation = 1.0f / getSpeedMultiplier();
 		Vector2 centerDelta = coords - Vector2(OsuGameRules::OSU_COORD_WIDTH, OsuGameRules::OSU_COORD_HEIGHT)/2.0f;
-		coords.x += centerDelta.x*0.25f*std::sin((m_iCurMusicPos/1000.0f)*5*speedMultiplierCompensation*cv::osu::mod_wobble_frequency.getFloat())*cv::osu::mod_wobble_strength.getFloat();
-		coords.y += centerDelta.y*0.25f*std::sin((m_iCurMusicPos/1000.0f)*3*speedMultiplierCompensation*cv::osu::mod_wobble_frequency.getFloat())*cv::osu::mod_wobble_strength.getFloat();
+		coords.x += centerDelta.x*0.25f*std::sin((m_iCurMusicPos/1000.0f)*5*speedMultiplierCompensation*cvars.modWobbleFrequency)*cvars.modWobbleStrength;
+		coords.y += centerDelta.y*0.25f*std::sin((m_iCurMusicPos/1000.0f)*3*speedMultiplierCompensation*cvars.modWobbleFrequency)*cvars.modWobbleStrength;
 	}
 
 	// rotation
-	if (m_fPlayfieldRotation + cv::osu::playfield_rotation.getFloat() != 0.0f)
+	if (m_fPlayfieldRotation + cvars.playfieldRotation != 0.0f)
 	{
 		coords.x -= OsuGameRules::OSU_COORD_WIDTH/2;
 		coords.y -= OsuGameRules::OSU_COORD_HEIGHT/2;
 
 		Vector3 coords3 = Vector3(coords.x, coords.y, 0);
 		Matrix4 rot;
-		rot.rotateZ(m_fPlayfieldRotation + cv::osu::playfield_rotation.getFloat()); // (m_iCurMusicPos/1000.0f)*30
+		rot.rotateZ(m_fPlayfieldRotation + cvars.playfieldRotation); // (m_iCurMusicPos/1000.0f)*30
 
 		coords3 = coords3 * rot;
 		coords3.x += OsuGameRules::OSU_COORD_WIDTH/2;
@@ -988,7 +993,7 @@ Vector2 OsuBeatmapStandard::osuCoords2Pixels(Vector2 coords) const
 	}
 
 	// if wobble, clamp coordinates
-	if (cv::osu::mod_wobble.getBool() || cv::osu::mod_wobble2.getBool())
+	if (cvars.modWobble || cvars.modWobble2)
 	{
 		coords.x = std::clamp<float>(coords.x, 0.0f, OsuGameRules::OSU_COORD_WIDTH);
 		coords.y = std::clamp<float>(coords.y, 0.0f, OsuGameRules::OSU_COORD_HEIGHT);
@@ -1018,7 +1023,7 @@ Vector2 OsuBeatmapStandard::osuCoords2Pixels(Vector2 coords) const
 	coords.x -= OsuGameRules::OSU_COORD_WIDTH/2; // center
 	coords.y -= OsuGameRules::OSU_COORD_HEIGHT/2;
 	{
-		if (cv::osu::playfield_circular.getBool())
+		if (cvars.playfieldCircular)
 		{
 			// normalize to -1 +1
 			coords.x /= (float)OsuGameRules::OSU_COORD_WIDTH / 2.0f;
@@ -1035,8 +1040,8 @@ Vector2 OsuBeatmapStandard::osuCoords2Pixels(Vector2 coords) const
 		}
 
 		// stretch
-		coords.x *= 1.0f + cv::osu::playfield_stretch_x.getFloat();
-		coords.y *= 1.0f + cv::osu::playfield_stretch_y.getFloat();
+		coords.x *= 1.0f + cvars.playfieldStretchX;
+		coords.y *= 1.0f + cvars.playfieldStretchY;
 	}
 	coords.x += OsuGameRules::OSU_COORD_WIDTH/2; // undo center
 	coords.y += OsuGameRules::OSU_COORD_HEIGHT/2;
@@ -1046,7 +1051,7 @@ Vector2 OsuBeatmapStandard::osuCoords2Pixels(Vector2 coords) const
 	coords += m_vPlayfieldOffset; // the offset is already scaled, just add it
 
 	// first person mod, centered cursor
-	if (cv::osu::stdrules::mod_fps.getBool())
+	if (cvars.modFPS)
 	{
 		// this is the worst hack possible (engine->isDrawing()), but it works
 		// the problem is that this same function is called while draw()ing and update()ing
@@ -1068,39 +1073,41 @@ Vector2 OsuBeatmapStandard::osuCoords2RawPixels(Vector2 coords) const
 
 Vector3 OsuBeatmapStandard::osuCoordsTo3D(Vector2 coords, const OsuHitObject * /*hitObject*/) const
 {
+	const OsuConVarSnapshot &cvars = OsuConVarSnapshot::get();
+
 	if (osu->getModHR())
 		coords.y = OsuGameRules::OSU_COORD_HEIGHT - coords.y;
-	if (cv::osu::playfield_mirror_horizontal.getBool())
+	if (cvars.playfieldMirrorHorizontal)
 		coords.y = OsuGameRules::OSU_COORD_HEIGHT - coords.y;
-	if (cv::osu::playfield_mirror_vertical.getBool())
+	if (cvars.playfieldMirrorVertical)
 		coords.x = OsuGameRules::OSU_COORD_WIDTH - coords.x;
 
 	// wobble
-	if (cv::osu::mod_wobble.getBool())
+	if (cvars.modWobble)
 	{
 		const float speedMultiplierCompensation = 1.0f / getSpeedMultiplier();
-		coords.x += std::sin((m_iCurMusicPos/1000.0f)*5*speedMultiplierCompensation*cv::osu::mod_wobble_frequency.getFloat())*cv::osu::mod_wobble_strength.getFloat();
-		coords.y += std::sin((m_iCurMusicPos/1000.0f)*4*speedMultiplierCompensation*cv::osu::mod_wobble_frequency.getFloat())*cv::osu::mod_wobble_strength.getFloat();
+		coords.x += std::sin((m_iCurMusicPos/1000.0f)*5*speedMultiplierCompensation*cvars.modWobbleFrequency)*cvars.modWobbleStrength;
+		coords.y += std::sin((m_iCurMusicPos/1000.0f)*4*speedMultiplierCompensation*cvars.modWobbleFrequency)*cvars.modWobbleStrength;
 	}
 
 	// wobble2
-	if (cv::osu::mod_wobble2.getBool())
+	if (cvars.modWobble2)
 	{
 		const float speedMultiplierCompensation = 1.0f / getSpeedMultiplier();
 		Vector2 centerDelta = coords - Vector2(OsuGameRules::OSU_COORD_WIDTH, OsuGameRules::OSU_COORD_HEIGHT)/2.0f;
-		coords.x += centerDelta.x*0.25f*std::sin((m_iCurMusicPos/1000.0f)*5*speedMultiplierCompensation*cv::osu::mod_wobble_frequency.getFloat())*cv::osu::mod_wobble_strength.getFloat();
-		coords.y += centerDelta.y*0.25f*std::sin((m_iCurMusicPos/1000.0f)*3*speedMultiplierCompensation*cv::osu::mod_wobble_frequency.getFloat())*cv::osu::mod_wobble_strength.getFloat();
+		coords.x += centerDelta.x*0.25f*std::sin((m_iCurMusicPos/1000.0f)*5*speedMultiplierCompensation*cvars.modWobbleFrequency)*cvars.modWobbleStrength;
+		coords.y += centerDelta.y*0.25f*std::sin((m_iCurMusicPos/1000.0f)*3*speedMultiplierCompensation*cvars.modWobbleFrequency)*cvars.modWobbleStrength;
 	}
 
 	// rotation
-	if (m_fPlayfieldRotation + cv::osu::playfield_rotation.getFloat() != 0.0f)
+	if (m_fPlayfieldRotation + cvars.playfieldRotation != 0.0f)
 	{
 		coords.x -= OsuGameRules::OSU_COORD_WIDTH/2;
 		coords.y -= OsuGameRules::OSU_COORD_HEIGHT/2;
 
 		Vector3 coords3 = Vector3(coords.x, coords.y, 0);
 		Matrix4 rot;
-		rot.rotateZ(m_fPlayfieldRotation + cv::osu::playfield_rotation.getFloat());
+		rot.rotateZ(m_fPlayfieldRotation + cvars.playfieldRotation);
 
 		coords3 = coords3 * rot;
 		coords3.x += OsuGameRules::OSU_COORD_WIDTH/2;
@@ -1111,7 +1118,7 @@ Vector3 OsuBeatmapStandard::osuCoordsTo3D(Vector2 coords, const OsuHitObject * /
 	}
 
 	// if wobble, clamp coordinates
-	if (cv::osu::mod_wobble.getBool() || cv::osu::mod_wobble2.getBool())
+	if (cvars.modWobble || cvars.modWobble2)
 	{
 		coords.x = std::clamp<float>(coords.x, 0.0f, OsuGameRules::OSU_COORD_WIDTH);
 		coords.y = std::clamp<float>(coords.y, 0.0f, OsuGameRules::OSU_COORD_HEIGHT);
@@ -1141,7 +1148,7 @@ Vector3 OsuBeatmapStandard::osuCoordsTo3D(Vector2 coords, const OsuHitObject * /
 	coords.x -= OsuGameRules::OSU_COORD_WIDTH / 2;
 	coords.y -= OsuGameRules::OSU_COORD_HEIGHT / 2;
 
-	if (cv::osu::playfield_circular.getBool())
+	if (cvars.playfieldCircular)
 	{
 		// normalize to -1 +1
 		coords.x /= (float)OsuGameRules::OSU_COORD_WIDTH / 2.0f;
@@ -1158,8 +1165,8 @@ Vector3 OsuBeatmapStandard::osuCoordsTo3D(Vector2 coords, const OsuHitObject * /
 	}
 
 	// 3d scale
-	coords.x *= 1.0f + cv::osu::playfield_stretch_x.getFloat();
-	coords.y *= 1.0f + cv::osu::playfield_stretch_y.getFloat();
+	coords.x *= 1.0f + cvars.playfieldStretchX;
+	coords.y *= 1.0f + cvars.playfieldStretchY;
 
 	const float xCurvePercent = (1.0f + ((coords.x / ((float)OsuGameRules::OSU_COORD_WIDTH / 2.0f)) * cv::osu::fposu::threeD_curve_multiplier.getFloat())) / 2.0f;
 
@@ -1254,22 +1261,24 @@ Vector3 OsuBeatmapStandard::osuCoordsToRaw3D(Vector2 coords) const
 
 Vector2 OsuBeatmapStandard::osuCoords2LegacyPixels(Vector2 coords) const
 {
+	const OsuConVarSnapshot &cvars = OsuConVarSnapshot::get();
+
 	if (osu->getModHR())
 		coords.y = OsuGameRules::OSU_COORD_HEIGHT - coords.y;
-	if (cv::osu::playfield_mirror_horizontal.getBool())
+	if (cvars.playfieldMirrorHorizontal)
 		coords.y = OsuGameRules::OSU_COORD_HEIGHT - coords.y;
-	if (cv::osu::playfield_mirror_vertical.getBool())
+	if (cvars.playfieldMirrorVertical)
 		coords.x = OsuGameRules::OSU_COORD_WIDTH - coords.x;
 
 	// rotation
-	if (m_fPlayfieldRotation + cv::osu::playfield_rotation.getFloat() != 0.0f)
+	if (m_fPlayfieldRotation + cvars.playfieldRotation != 0.0f)
 	{
 		coords.x -= OsuGameRules::OSU_COORD_WIDTH/2;
 		coords.y -= OsuGameRules::OSU_COORD_HEIGHT/2;
 
 		Vector3 coords3 = Vector3(coords.x, coords.y, 0);
 		Matrix4 rot;
-		rot.rotateZ(m_fPlayfieldRotation + cv::osu::playfield_rotation.getFloat());
+		rot.rotateZ(m_fPlayfieldRotation + cvars.playfieldRotation);
 
 		coords3 = coords3 * rot;
 		coords3.x += OsuGameRules::OSU_COORD_WIDTH/2;
@@ -1283,7 +1292,7 @@ Vector2 OsuBeatmapStandard::osuCoords2LegacyPixels(Vector2 coords) const
 	coords.x -= OsuGameRules::OSU_COORD_WIDTH/2;
 	coords.y -= OsuGameRules::OSU_COORD_HEIGHT/2;
 
-	if (cv::osu::playfield_circular.getBool())
+	if (cvars.playfieldCircular)
 	{
 		// normalize to -1 +1
 		coords.x /= (float)OsuGameRules::OSU_COORD_WIDTH / 2.0f;
@@ -1300,8 +1309,8 @@ Vector2 OsuBeatmapStandard::osuCoords2LegacyPixels(Vector2 coords) const
 	}
 
 	// VR scale
-	coords.x *= 1.0f + cv::osu::playfield_stretch_x.getFloat();
-	coords.y *= 1.0f + cv::osu::playfield_stretch_y.getFloat();
+	coords.x *= 1.0f + cvars.playfieldStretchX;
+	coords.y *= 1.0f + cvars.playfieldStretchY;
 
 	return coords;
 }
@@ -1327,6 +1336,31 @@ Vector2 OsuBeatmapStandard::getCursorPos() const
 	}
 }
 
+Vector2 OsuBeatmapStandard::getCursorPosAt(long musicPos) const
+{
+	// only the plain mouse cursor has samples, everything else (and music positions outside of this frame) just uses the current position
+	const std::vector<Mouse::MOTION_SAMPLE> &samples = mouse->getMotionSamples();
+	if (samples.empty() || m_bIsPaused || cv::osu::stdrules::mod_fps.getBool() || osu->getModAuto() || osu->getModAutopilot() || (cv::osu::mod_shirone.getBool() && osu->getScore()->getCombo() > 0))
+		return getCursorPos();
+
+	long prevSampleMusicPos = getMusicPosWithOffsetsAt(samples[0].timestampNS);
+	if (musicPos <= prevSampleMusicPos)
+		return samples[0].pos;
+
+	for (size_t i=1; i<samples.size(); i++)
+	{
+		const long sampleMusicPos = getMusicPosWithOffsetsAt(samples[i].timestampNS);
+		if (musicPos <= sampleMusicPos)
+		{
+			const float t = (sampleMusicPos > prevSampleMusicPos ? (float)(musicPos - prevSampleMusicPos) / (float)(sampleMusicPos - prevSampleMusicPos) : 1.0f);
+			return samples[i-1].pos + (samples[i].pos - samples[i-1].pos) * t;
+		}
+		prevSampleMusicPos = sampleMusicPos;
+	}
+
+	return getCursorPos();
+}
+
 Vector2 OsuBeatmapStandard::getFirstPersonCursorDelta() const
 {
 	return m_vPlayfieldCenter - (osu->getModAuto() || osu->getModAutopilot() ? m_vAutoCursorPos : mouse->getPos());
@@ -43,6 +43,7 @@ public:
 
 	// cursor
 	[[nodiscard]] Vector2 getCursorPos() const;
+	[[nodiscard]] Vector2 getCursorPosAt(long musicPos) const; // interpolated between the mouse motion samples of this frame
 	[[nodiscard]] Vector2 getFirstPersonCursorDelta() const;
 	[[nodiscard]] inline Vector2 getContinueCursorPoint() const {return m_vContinueCursorPoint;}
 
@@ -31,6 +31,7 @@ OsuChangelog::OsuChangelog() : OsuScreenBackable()
 	m_scrollView->setDrawBackground(false);
 	m_scrollView->setDrawFrame(false);
 	m_scrollView->setScrollResistance(0);
+	m_scrollView->setCulling(true);
 	m_container->addBaseUIElement(m_scrollView);
 
 	std::vector<CHANGELOG> changelogs;
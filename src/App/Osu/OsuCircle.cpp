@@ -13,8 +13,10 @@
 #include "SoundEngine.h"
 #include "Camera.h"
 #include "ConVar.h"
+#include "FrameArena.h"
 
 #include "Osu.h"
+#include "OsuConVarSnapshot.h"
 #include "OsuSkin.h"
 #include "OsuSkinImage.h"
 #include "OsuGameRules.h"
@@ -302,7 +304,7 @@ void OsuCircle::draw3DSliderEndCircle(const OsuModFPoSu *fposu, const Matrix4 &b
 
 void OsuCircle::drawApproachCircle(OsuSkin *skin, Vector2 pos, Color comboColor, float hitcircleDiameter, float approachScale, float alpha, bool modHD, bool overrideHDApproachCircle)
 {
-	if ((!modHD || overrideHDApproachCircle) && cv::osu::draw_approach_circles.getBool() && !cv::osu::stdrules::mod_mafham.getBool())
+	if ((!modHD || overrideHDApproachCircle) && cv::osu::draw_approach_circles.getBool() && !OsuConVarSnapshot::get().modMafham)
 	{
 		if (approachScale > 1.0f)
 		{
@@ -337,7 +339,7 @@ void OsuCircle::drawApproachCircle(OsuSkin *skin, Vector2 pos, Color comboColor,
 
 void OsuCircle::draw3DApproachCircle(const OsuModFPoSu *fposu, const Matrix4 &baseScale, OsuSkin *skin, Vector3 pos, Color comboColor, float  /*rawHitcircleDiameter*/, float approachScale, float alpha, bool modHD, bool overrideHDApproachCircle)
 {
-	if ((!modHD || overrideHDApproachCircle) && cv::osu::draw_approach_circles.getBool() && !cv::osu::stdrules::mod_mafham.getBool())
+	if ((!modHD || overrideHDApproachCircle) && cv::osu::draw_approach_circles.getBool() && !OsuConVarSnapshot::get().modMafham)
 	{
 		if (approachScale > 1.0f)
 		{
@@ -492,8 +494,11 @@ void OsuCircle::draw3DHitCircle(const OsuModFPoSu *fposu, OsuSkin *skin, const M
 			modelMatrixInverseTransposed.transpose();
 
 #if defined(MCENGINE_FEATURE_OPENGL) || defined(MCENGINE_FEATURE_GLES32) || defined(MCENGINE_FEATURE_GL3)
-			if constexpr (Env::cfg(REND::GL | REND::GLES32 | REND::GL3))
+			if (Env::cfg(REND::GL | REND::GLES32 | REND::GL3) && !g->isNullRenderer())
+			{
+				g->flushBatch();
 				glBlendEquation(GL_MAX); // HACKHACK: OpenGL hardcoded
+			}
 #endif
 
 			fposu->getHitcircleShader()->enable();
@@ -506,7 +511,7 @@ void OsuCircle::draw3DHitCircle(const OsuModFPoSu *fposu, OsuSkin *skin, const M
 			fposu->getHitcircleShader()->disable();
 
 #if defined(MCENGINE_FEATURE_OPENGL) || defined(MCENGINE_FEATURE_GLES32) || defined(MCENGINE_FEATURE_GL3)
-			if constexpr (Env::cfg(REND::GL | REND::GLES32 | REND::GL3))
+			if (Env::cfg(REND::GL | REND::GLES32 | REND::GL3) && !g->isNullRenderer())
 				glBlendEquation(GL_FUNC_ADD); // HACKHACK: OpenGL hardcoded
 #endif
 		}
@@ -575,7 +580,7 @@ void OsuCircle::drawHitCircleNumber(OsuSkin *skin, float numberScale, float over
 	};
 
 	// generate digits
-	std::vector<int> digits;
+	FrameVector<int> digits;
 	while (number >= 10)
 	{
 		digits.push_back(number % 10);
@@ -700,7 +705,8 @@ void OsuCircle::draw()
 
 		g->pushTransform();
 		{
-			g->scale((1.0f+scale*cv::osu::stdrules::circle_fade_out_scale.getFloat()), (1.0f+scale*cv::osu::stdrules::circle_fade_out_scale.getFloat()));
+			const float fadeOutScale = 1.0f + scale*OsuConVarSnapshot::get().circleFadeOutScale;
+			g->scale(fadeOutScale, fadeOutScale);
 			m_beatmap->getSkin()->getHitCircleOverlay2()->setAnimationTimeOffset(!m_beatmap->isInMafhamRenderChunk() ? m_iTime - m_iApproachTime : m_beatmap->getCurMusicPosWithOffsets());
 			drawCircle(m_beatmap, m_vRawPos, m_iComboNumber, m_iColorCounter, m_iColorOffset, 1.0f, 1.0f, alpha, alpha, drawNumber);
 		}
@@ -787,7 +793,7 @@ void OsuCircle::draw3D()
 			Matrix4 baseScale;
 			baseScale.scale(m_beatmap->getRawHitcircleDiameter() * OsuModFPoSu::SIZEDIV3D);
 			baseScale.scale(osu->getFPoSu()->get3DPlayfieldScale());
-			baseScale.scale((1.0f+scale*cv::osu::stdrules::circle_fade_out_scale.getFloat()));
+			baseScale.scale((1.0f+scale*OsuConVarSnapshot::get().circleFadeOutScale));
 
 			m_beatmap->getSkin()->getHitCircleOverlay2()->setAnimationTimeOffset(!m_beatmap->isInMafhamRenderChunk() ? m_iTime - m_iApproachTime : m_beatmap->getCurMusicPosWithOffsets());
 			draw3DCircle(m_beatmap, this, baseScale, m_vRawPos, m_iComboNumber, m_iColorCounter, m_iColorOffset, 1.0f, 1.0f, alpha, alpha, drawNumber);
@@ -0,0 +1,138 @@
+//================ Copyright (c) 2025, WH, All rights reserved. =================//
+//
+// Purpose:		compressed id set for collection membership
+//
+// $NoKeywords: $osucolbmp
+//===============================================================================//
+
+#include "OsuCollectionBitmap.h"
+
+#include <algorithm>
+
+std::vector<OsuCollectionBitmap::CONTAINER>::const_iterator OsuCollectionBitmap::findContainer(uint16_t key) const
+{
+	return std::ranges::lower_bound(m_containers, key, {}, &CONTAINER::key);
+}
+
+bool OsuCollectionBitmap::add(uint32_t id)
+{
+	const auto key = static_cast<uint16_t>(id >> 16);
+	const auto low = static_cast<uint16_t>(id & 0xffff);
+
+	auto it = m_containers.begin() + (findContainer(key) - m_containers.cbegin());
+	if (it == m_containers.end() || it->key != key)
+		it = m_containers.insert(it, CONTAINER{.key = key, .cardinality = 0, .array = {}, .bits = {}});
+
+	CONTAINER &container = *it;
+	if (!container.bits.empty())
+	{
+		uint64_t &word = container.bits[low / 64];
+		const uint64_t mask = (uint64_t)1 << (low % 64);
+		if ((word & mask) != 0)
+			return false;
+
+		word |= mask;
+	}
+	else
+	{
+		const auto pos = std::ranges::lower_bound(container.array, low);
+		if (pos != container.array.end() && *pos == low)
+			return false;
+
+		container.array.insert(pos, low);
+	}
+
+	container.cardinality++;
+	m_iSize++;
+
+	if (container.bits.empty() && container.array.size() > MAX_ARRAY_SIZE)
+		toBitmap(container);
+
+	return true;
+}
+
+bool OsuCollectionBitmap::remove(uint32_t id)
+{
+	const auto key = static_cast<uint16_t>(id >> 16);
+	const auto low = static_cast<uint16_t>(id & 0xffff);
+
+	const auto it = m_containers.begin() + (findContainer(key) - m_containers.cbegin());
+	if (it == m_containers.end() || it->key != key)
+		return false;
+
+	CONTAINER &container = *it;
+	if (!container.bits.empty())
+	{
+		uint64_t &word = container.bits[low / 64];
+		const uint64_t mask = (uint64_t)1 << (low % 64);
+		if ((word & mask) == 0)
+			return false;
+
+		word &= ~mask;
+	}
+	else
+	{
+		const auto pos = std::ranges::lower_bound(container.array, low);
+		if (pos == container.array.end() || *pos != low)
+			return false;
+
+		container.array.erase(pos);
+	}
+
+	container.cardinality--;
+	m_iSize--;
+
+	if (container.cardinality == 0)
+		m_containers.erase(it);
+	else if (!container.bits.empty() && container.cardinality <= MAX_ARRAY_SIZE / 2) // (not right at the limit, that would flip back and forth)
+		toArray(container);
+
+	return true;
+}
+
+void OsuCollectionBitmap::clear()
+{
+	m_containers.clear();
+	m_iSize = 0;
+}
+
+bool OsuCollectionBitmap::contains(uint32_t id) const
+{
+	const auto key = static_cast<uint16_t>(id >> 16);
+	const auto low = static_cast<uint16_t>(id & 0xffff);
+
+	const auto it = findContainer(key);
+	if (it == m_containers.end() || it->key != key)
+		return false;
+
+	if (!it->bits.empty())
+		return (it->bits[low / 64] & ((uint64_t)1 << (low % 64))) != 0;
+
+	return std::ranges::binary_search(it->array, low);
+}
+
+void OsuCollectionBitmap::toBitmap(CONTAINER &container)
+{
+	container.bits.assign(NUM_BITMAP_WORDS, 0);
+	for (const uint16_t low : container.array)
+	{
+		container.bits[low / 64] |= (uint64_t)1 << (low % 64);
+	}
+	container.array = std::vector<uint16_t>();
+}
+
+void OsuCollectionBitmap::toArray(CONTAINER &container)
+{
+	container.array.clear();
+	container.array.reserve(container.cardinality);
+	for (size_t w=0; w<container.bits.size(); w++)
+	{
+		uint64_t word = container.bits[w];
+		while (word != 0)
+		{
+			container.array.push_back(static_cast<uint16_t>(w * 64 + std::countr_zero(word)));
+			word &= word - 1;
+		}
+	}
+	container.bits = std::vector<uint64_t>();
+}
@@ -0,0 +1,83 @@
+//================ Copyright (c) 2025, WH, All rights reserved. =================//
+//
+// Purpose:		compressed id set for collection membership
+//
+// $NoKeywords: $osucolbmp
+//===============================================================================//
+
+#pragma once
+#ifndef OSUCOLLECTIONBITMAP_H
+#define OSUCOLLECTIONBITMAP_H
+
+#include "cbase.h"
+
+#include <bit>
+
+// Set of 32 bit ids, split by their upper 16 bits into containers (like roaring bitmaps).
+// Sparse containers are sorted arrays of the lower 16 bits, dense ones (more than MAX_ARRAY_SIZE ids) plain 64 kbit bitmaps,
+// so membership tests and add/remove stay cheap for both a handful of maps and collections with thousands of them.
+class OsuCollectionBitmap
+{
+public:
+	OsuCollectionBitmap() {m_iSize = 0;}
+
+	bool add(uint32_t id);		// returns false if it was already contained
+	bool remove(uint32_t id);	// returns false if it wasn't contained
+	void clear();
+
+	[[nodiscard]] bool contains(uint32_t id) const;
+
+	[[nodiscard]] inline size_t size() const {return m_iSize;}
+	[[nodiscard]] inline bool empty() const {return m_iSize == 0;}
+
+	// calls func(id) for every contained id, in ascending order
+	template <typename FUNC>
+	void forEach(FUNC &&func) const
+	{
+		for (const CONTAINER &container : m_containers)
+		{
+			const uint32_t high = static_cast<uint32_t>(container.key) << 16;
+
+			if (container.bits.empty())
+			{
+				for (const uint16_t low : container.array)
+				{
+					func(high | low);
+				}
+			}
+			else
+			{
+				for (size_t w=0; w<container.bits.size(); w++)
+				{
+					uint64_t word = container.bits[w];
+					while (word != 0)
+					{
+						func(high | static_cast<uint32_t>(w * 64 + std::countr_zero(word)));
+						word &= word - 1;
+					}
+				}
+			}
+		}
+	}
+
+private:
+	static constexpr size_t MAX_ARRAY_SIZE = 4096; // a full bitmap container is 8 KB, same as this many array entries
+	static constexpr size_t NUM_BITMAP_WORDS = 65536 / 64;
+
+	struct CONTAINER
+	{
+		uint16_t key;					// upper 16 bits of all ids in here
+		uint32_t cardinality;
+		std::vector<uint16_t> array;	// sorted lower 16 bits, while sparse
+		std::vector<uint64_t> bits;		// NUM_BITMAP_WORDS words once dense (array is empty then)
+	};
+
+	[[nodiscard]] std::vector<CONTAINER>::const_iterator findContainer(uint16_t key) const;
+	static void toBitmap(CONTAINER &container);
+	static void toArray(CONTAINER &container);
+
+	std::vector<CONTAINER> m_containers; // sorted by key
+	size_t m_iSize;
+};
+
+#endif
@@ -121,6 +121,8 @@ extern ConVar followpoints_prevfadetime;
 extern ConVar hiterrorbar_misaims;
 extern ConVar hp_override;
 extern ConVar interpolate_music_pos;
+extern ConVar click_timestamps;
+extern ConVar frametime_stats_per_play;
 extern ConVar mod_artimewarp;
 extern ConVar mod_artimewarp_multiplier;
 extern ConVar mod_arwobble;
@@ -718,6 +720,12 @@ extern ConVar draw_rankingscreen_background_image;
 extern ConVar rankingscreen_pp;
 extern ConVar rankingscreen_topbar_height_percent;
 
+// from OsuRenderBenchmark.cpp
+extern ConVar bench_render;
+extern ConVar bench_render_frames;
+extern ConVar bench_render_settle_updates;
+extern ConVar bench_render_beatmap;
+
 // from OsuRichPresence.cpp
 extern ConVar rich_presence;
 extern ConVar rich_presence_discord_show_totalpp;
@@ -774,6 +782,7 @@ extern ConVar slider_break_epilepsy;
 extern ConVar slider_draw_body;
 extern ConVar slider_end_inside_check_offset;
 extern ConVar slider_end_miss_breaks_combo;
+extern ConVar slider_follow_cursor_samples;
 extern ConVar slider_reverse_arrow_alpha_multiplier;
 extern ConVar slider_reverse_arrow_animated;
 extern ConVar slider_reverse_arrow_black_threshold;
@@ -814,10 +823,12 @@ extern ConVar songbrowser_background_star_calculation;
 extern ConVar songbrowser_bottombar_percent;
 extern ConVar songbrowser_debug;
 extern ConVar songbrowser_dynamic_star_recalc;
+extern ConVar songbrowser_prefetch_audio_neighbours;
 extern ConVar songbrowser_scorebrowser_enabled;
 extern ConVar songbrowser_scores_sortingtype;
 extern ConVar songbrowser_search_delay;
 extern ConVar songbrowser_search_hardcoded_filter;
+extern ConVar songbrowser_search_threads;
 extern ConVar songbrowser_sortingtype;
 extern ConVar songbrowser_topbar_left_percent;
 extern ConVar songbrowser_topbar_left_width_percent;
@@ -0,0 +1,81 @@
+//================ Copyright (c) 2025, WH, All rights reserved. =================//
+//
+// Purpose:		plain copies of the ConVars read by hot gameplay/render/star calc loops
+//
+// $NoKeywords: $osucvsnap
+//===============================================================================//
+
+#include "OsuConVarSnapshot.h"
+
+#include "OsuConVarDefs.h"
+
+OsuConVarSnapshot OsuConVarSnapshot::s_current{.version = UINT64_MAX};
+
+std::mutex OsuConVarSnapshot::s_sharedMutex;
+std::shared_ptr<const OsuConVarSnapshot> OsuConVarSnapshot::s_shared;
+
+OsuConVarSnapshot OsuConVarSnapshot::build()
+{
+	// (the version is read first, so that anything changing while we copy just causes another rebuild)
+	return OsuConVarSnapshot{
+	    .version = ConVar::getValueVersion(),
+
+	    .universalOffset = cv::osu::universal_offset.getFloat(),
+	    .universalOffsetHardcoded = cv::osu::universal_offset_hardcoded.getInt(),
+	    .universalOffsetHardcodedFallbackDSound = cv::osu::universal_offset_hardcoded_fallback_dsound.getInt(),
+	    .sndFallbackDSound = cv::win_snd_fallback_dsound.getBool(),
+	    .oldBeatmapOffset = cv::osu::old_beatmap_offset.getInt(),
+	    .notelockType = cv::osu::notelock_type.getInt(),
+
+	    .pvs = cv::osu::pvs.getBool(),
+	    .drawFollowpoints = cv::osu::draw_followpoints.getBool(),
+	    .followpointsPrevFadeTime = cv::osu::followpoints_prevfadetime.getFloat(),
+
+	    .playfieldRotation = cv::osu::playfield_rotation.getFloat(),
+	    .playfieldMirrorHorizontal = cv::osu::playfield_mirror_horizontal.getBool(),
+	    .playfieldMirrorVertical = cv::osu::playfield_mirror_vertical.getBool(),
+	    .playfieldStretchX = cv::osu::playfield_stretch_x.getFloat(),
+	    .playfieldStretchY = cv::osu::playfield_stretch_y.getFloat(),
+	    .playfieldCircular = cv::osu::playfield_circular.getBool(),
+	    .modWobble = cv::osu::mod_wobble.getBool(),
+	    .modWobble2 = cv::osu::mod_wobble2.getBool(),
+	    .modWobbleFrequency = cv::osu::mod_wobble_frequency.getFloat(),
+	    .modWobbleStrength = cv::osu::mod_wobble_strength.getFloat(),
+	    .modFPS = cv::osu::stdrules::mod_fps.getBool(),
+	    .modMafham = cv::osu::stdrules::mod_mafham.getBool(),
+	    .modMafhamRenderLivesize = cv::osu::stdrules::mod_mafham_render_livesize.getInt(),
+
+	    .circleFadeOutScale = cv::osu::stdrules::circle_fade_out_scale.getFloat(),
+
+	    .starsXexxarAnglesSliders = cv::osu::stars_xexxar_angles_sliders.getBool(),
+	    .starsSliderCurvePointsSeparation = cv::osu::stars_slider_curve_points_separation.getFloat(),
+	    .starsIgnoreClampedSliders = cv::osu::stars_ignore_clamped_sliders.getBool(),
+	    .starsAlwaysRecalcLiveStrains = cv::osu::stars_always_recalc_live_strains.getBool(),
+	    .starsAndPPLazerRelaxAutopilotNerfDisabled = cv::osu::stars_and_pp_lazer_relax_autopilot_nerf_disabled.getBool(),
+	    .sliderCurveMaxLength = cv::osu::slider_curve_max_length.getFloat(),
+	    .sliderEndInsideCheckOffset = cv::osu::slider_end_inside_check_offset.getInt(),
+	};
+}
+
+void OsuConVarSnapshot::publish()
+{
+	s_current = build();
+
+	auto shared = std::make_shared<const OsuConVarSnapshot>(s_current);
+	{
+		std::lock_guard<std::mutex> lock(s_sharedMutex);
+		s_shared.swap(shared);
+	}
+	// (the previous snapshot is released here, or by whichever thread still holds it)
+}
+
+std::shared_ptr<const OsuConVarSnapshot> OsuConVarSnapshot::acquire()
+{
+	std::lock_guard<std::mutex> lock(s_sharedMutex);
+
+	// nothing has been published yet (e.g. star calc started before the first frame), so just build one here
+	if (!s_shared)
+		s_shared = std::make_shared<const OsuConVarSnapshot>(build());
+
+	return s_shared;
+}
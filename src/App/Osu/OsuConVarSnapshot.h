@@ -0,0 +1,94 @@
+//================ Copyright (c) 2025, WH, All rights reserved. =================//
+//
+// Purpose:		plain copies of the ConVars read by hot gameplay/render/star calc loops
+//
+// $NoKeywords: $osucvsnap
+//===============================================================================//
+
+#pragma once
+#ifndef OSUCONVARSNAPSHOT_H
+#define OSUCONVARSNAPSHOT_H
+
+#include "cbase.h"
+#include "ConVar.h"
+
+#include <memory>
+#include <mutex>
+
+// Rebuilt from the ConVars only if any ConVar changed since the last build (see ConVar::getValueVersion()).
+// Main thread code grabs a reference via get() once per function and then reads plain fields, instead of going through
+// ConVar::getVal() (cheat check + atomic load) per hitobject.
+// Other threads (star calc, loaders) must use acquire(), which returns the state as of the last get()/update() on the main thread,
+// and stays unchanged for as long as they hold on to it (so a whole calculation sees one consistent set of values).
+class OsuConVarSnapshot final
+{
+public:
+	uint64_t version;
+
+	// timing
+	float universalOffset;
+	int universalOffsetHardcoded;
+	int universalOffsetHardcodedFallbackDSound;
+	bool sndFallbackDSound;
+	int oldBeatmapOffset;
+	int notelockType;
+
+	// visibility
+	bool pvs;
+	bool drawFollowpoints;
+	float followpointsPrevFadeTime;
+
+	// playfield transforms
+	float playfieldRotation;
+	bool playfieldMirrorHorizontal;
+	bool playfieldMirrorVertical;
+	float playfieldStretchX;
+	float playfieldStretchY;
+	bool playfieldCircular;
+	bool modWobble;
+	bool modWobble2;
+	float modWobbleFrequency;
+	float modWobbleStrength;
+	bool modFPS;
+	bool modMafham;
+	int modMafhamRenderLivesize;
+
+	// hitobjects
+	float circleFadeOutScale;
+
+	// star/pp calc
+	bool starsXexxarAnglesSliders;
+	float starsSliderCurvePointsSeparation;
+	bool starsIgnoreClampedSliders;
+	bool starsAlwaysRecalcLiveStrains;
+	bool starsAndPPLazerRelaxAutopilotNerfDisabled;
+	float sliderCurveMaxLength;
+	int sliderEndInsideCheckOffset;
+
+public:
+	// main thread only
+	[[nodiscard]] static inline const OsuConVarSnapshot &get()
+	{
+		update();
+		return s_current;
+	}
+	static inline void update() // (called once per frame by Osu::update(), so that acquire() is never more than a frame behind)
+	{
+		if (s_current.version != ConVar::getValueVersion()) [[unlikely]]
+			publish();
+	}
+
+	// any thread
+	[[nodiscard]] static std::shared_ptr<const OsuConVarSnapshot> acquire();
+
+private:
+	static OsuConVarSnapshot build();
+	static void publish();
+
+	static OsuConVarSnapshot s_current;
+
+	static std::mutex s_sharedMutex;
+	static std::shared_ptr<const OsuConVarSnapshot> s_shared;
+};
+
+#endif
@@ -7,10 +7,12 @@
 
 #include "OsuDatabase.h"
 
+#include "AllocTracker.h"
 #include "Engine.h"
 #include "ConVar.h"
 #include "Timing.h"
 #include "File.h"
+#include "JobSystem.h"
 #include "ResourceManager.h"
 
 #include "Osu.h"
@@ -239,6 +241,8 @@ public:
 protected:
 	void init() override
 	{
+		ALLOC_TAG(DATABASE);
+
 		// legacy loading, if db is not found or by convar
 		if (m_bNeedRawLoad)
 			m_db->scheduleLoadRaw();
@@ -263,6 +267,7 @@ protected:
 
 	void initAsync() override
 	{
+		ALLOC_TAG(DATABASE);
 		debugLog("\n");
 
 		// load scores
@@ -331,12 +336,8 @@ OsuDatabase::OsuDatabase()
 	m_iCurRawBeatmapLoadIndex = 0;
 	m_bRawBeatmapLoadScheduled = false;
 
-	m_prevPlayerStats.pp = 0.0f;
-	m_prevPlayerStats.accuracy = 0.0f;
-	m_prevPlayerStats.numScoresWithPP = 0;
-	m_prevPlayerStats.level = 0;
-	m_prevPlayerStats.percentToNextLevel = 0.0f;
-	m_prevPlayerStats.totalScore = 0;
+	m_bPlayerScoresIncludeRelaxAndAutopilot = false;
+	m_fPlayerScoresPPSanityLimit = 0.0f;
 
 	m_scoreSortingMethods.push_back({"Sort By Accuracy", sortScoreByAccuracy});
 	m_scoreSortingMethods.push_back({"Sort By Combo", sortScoreByCombo});
@@ -362,6 +363,7 @@ void OsuDatabase::update()
 	// loadRaw() logic
 	if (m_bRawBeatmapLoadScheduled)
 	{
+		ALLOC_TAG(DATABASE);
 		Timer t;
 
 		while (t.getElapsedTime() < 0.033f)
@@ -370,14 +372,39 @@ void OsuDatabase::update()
 
 			if (m_rawLoadBeatmapFolders.size() > 0 && m_iCurRawBeatmapLoadIndex < m_rawLoadBeatmapFolders.size())
 			{
-				UString curBeatmap = m_rawLoadBeatmapFolders[m_iCurRawBeatmapLoadIndex++];
-				m_rawBeatmapFolders.push_back(curBeatmap); // for future incremental loads, so that we know what's been loaded already
+				// parse a batch of folders in parallel, then add them in order
+				const size_t batchStart = (size_t)m_iCurRawBeatmapLoadIndex;
+				const size_t batchSize = std::min((jobSystem->getNumWorkers() + 1) * 4, m_rawLoadBeatmapFolders.size() - batchStart);
+
+				std::vector<std::vector<OsuDatabaseBeatmap*>> batchDiffs(batchSize);
+				std::vector<std::vector<UString>> batchWarnings(batchSize);
+				jobSystem->parallelFor("OsuDatabase::loadRawBeatmapDiffs", batchSize, 1, [&](size_t begin, size_t end) -> void {
+					for (size_t i=begin; i<end; i++)
+					{
+						UString fullBeatmapPath = m_sRawBeatmapLoadOsuSongFolder;
+						fullBeatmapPath.append(m_rawLoadBeatmapFolders[batchStart + i]);
+						fullBeatmapPath.append("/");
+
+						batchDiffs[i] = loadRawBeatmapDiffs(fullBeatmapPath, &batchWarnings[i]);
+					}
+				});
+
+				for (size_t i=0; i<batchSize; i++)
+				{
+					// (the workers only collect these, the engine isn't thread safe)
+					for (const UString &warning : batchWarnings[i])
+					{
+						engine->showMessageWarning("OsuBeatmapDatabase::loadRawBeatmap()", warning);
+					}
 
-				UString fullBeatmapPath = m_sRawBeatmapLoadOsuSongFolder;
-				fullBeatmapPath.append(curBeatmap);
-				fullBeatmapPath.append("/");
+					m_rawBeatmapFolders.push_back(m_rawLoadBeatmapFolders[batchStart + i]); // for future incremental loads, so that we know what's been loaded already
+
+					OsuDatabaseBeatmap *beatmap = createRawBeatmap(std::move(batchDiffs[i]));
+					if (beatmap != NULL)
+						m_databaseBeatmaps.push_back(beatmap);
+				}
 
-				addBeatmap(fullBeatmapPath);
+				m_iCurRawBeatmapLoadIndex += (int)batchSize;
 			}
 
 			// update progress
@@ -460,7 +487,11 @@ int OsuDatabase::addScore(const std::string &beatmapMD5Hash, const OsuDatabase::
 	sortScores(beatmapMD5Hash);
 
 	m_bDidScoresChangeForSave = true;
-	m_bDidScoresChangeForStats = true;
+	if (arePlayerScoresUpToDate())
+	{
+		updatePlayerBestScores(beatmapMD5Hash);
+		updatePlayerScore(beatmapMD5Hash, score, true);
+	}
 
 	if (cv::osu::scores_save_immediately.getBool())
 		saveScores();
@@ -524,10 +555,15 @@ void OsuDatabase::deleteScore(const std::string &beatmapMD5Hash, uint64_t scoreU
 	{
 		if (m_scores[beatmapMD5Hash][i].unixTimestamp == scoreUnixTimestamp)
 		{
+			const Score deletedScore = std::move(m_scores[beatmapMD5Hash][i]);
 			m_scores[beatmapMD5Hash].erase(m_scores[beatmapMD5Hash].begin() + i);
 
 			m_bDidScoresChangeForSave = true;
-			m_bDidScoresChangeForStats = true;
+			if (arePlayerScoresUpToDate())
+			{
+				updatePlayerBestScores(beatmapMD5Hash);
+				updatePlayerScore(beatmapMD5Hash, deletedScore, false);
+			}
 
 			//debugLog("Deleted score for {:s} at {}\n", beatmapMD5Hash.c_str(), scoreUnixTimestamp);
 
@@ -545,6 +581,7 @@ void OsuDatabase::sortScores(const std::string &beatmapMD5Hash)
 		if (cv::osu::songbrowser_scores_sortingtype.getString() == sortMethod.name)
 		{
 			std::ranges::sort(m_scores[beatmapMD5Hash], sortMethod.comparator);
+			updatePlayerBestScores(beatmapMD5Hash);
 			return;
 		}
 	}
@@ -645,172 +682,128 @@ void OsuDatabase::addBeatmapToCollection(const UString &collectionName, const st
 {
 	if (beatmapMD5Hash.length() != 32) return;
 
-	for (auto & collection : m_collections)
-	{
-		if (collection.name == collectionName)
-		{
-			bool containedAlready = false;
-			for (auto & hash : collection.hashes)
-			{
-				if (hash.hash == beatmapMD5Hash)
-				{
-					containedAlready = true;
-					break;
-				}
-			}
+	Collection *collection = findCollection(collectionName);
+	if (collection == NULL) return;
 
-			if (!containedAlready)
-			{
-				CollectionEntry entry;
-				{
-					entry.isLegacyEntry = false;
+	const uint32_t id = getCollectionEntryId(beatmapMD5Hash);
+	if (!collection->entries.add(id)) return; // contained already
 
-					entry.hash = beatmapMD5Hash;
-				}
-				collection.hashes.push_back(entry);
-
-				m_bDidCollectionsChangeForSave = true;
-
-				if (doSaveImmediatelyIfEnabled && cv::osu::collections_save_immediately.getBool())
-					saveCollections();
+	// also resolve the beatmap for entries which weren't in the database while loading (songbrowser will use that to rebuild the UI)
+	COLLECTION_ENTRY &entry = m_collectionEntries[id];
+	if (entry.diff2 == NULL)
+	{
+		entry.diff2 = getBeatmapDifficulty(beatmapMD5Hash);
+		entry.beatmap = (entry.diff2 != NULL ? getBeatmap(beatmapMD5Hash) : NULL);
+	}
 
-				// also update .beatmaps for convenience (songbrowser will use that to rebuild the UI)
-				{
-					OsuDatabaseBeatmap *beatmap = getBeatmap(beatmapMD5Hash);
-					OsuDatabaseBeatmap *diff2 = getBeatmapDifficulty(beatmapMD5Hash);
+	m_bDidCollectionsChangeForSave = true;
 
-					if (beatmap != NULL && diff2 != NULL)
-					{
-						bool beatmapContainedAlready = false;
-						for (auto & b : collection.beatmaps)
-						{
-							if (b.first == beatmap)
-							{
-								beatmapContainedAlready = true;
+	if (doSaveImmediatelyIfEnabled && cv::osu::collections_save_immediately.getBool())
+		saveCollections();
+}
 
-								bool diffContainedAlready = false;
-								for (auto & d : b.second)
-								{
-									if (d == diff2)
-									{
-										diffContainedAlready = true;
-										break;
-									}
-								}
+void OsuDatabase::removeBeatmapFromCollection(const UString &collectionName, const std::string &beatmapMD5Hash, bool doSaveImmediatelyIfEnabled)
+{
+	if (beatmapMD5Hash.length() != 32) return;
 
-								if (!diffContainedAlready)
-									b.second.push_back(diff2);
+	Collection *collection = findCollection(collectionName);
+	uint32_t id = 0;
+	if (collection == NULL || !findCollectionEntryId(beatmapMD5Hash, id)) return;
 
-								break;
-							}
-						}
+	// can't delete loaded osu! collection entries
+	if (collection->legacyEntries.contains(id) || !collection->entries.remove(id)) return;
 
-						if (!beatmapContainedAlready)
-						{
-							std::vector<OsuDatabaseBeatmap*> diffs2;
-							{
-								diffs2.push_back(diff2);
-							}
-							collection.beatmaps.emplace_back(beatmap, diffs2);
-						}
-					}
-				}
-			}
+	m_bDidCollectionsChangeForSave = true;
 
-			break;
-		}
-	}
+	if (doSaveImmediatelyIfEnabled && cv::osu::collections_save_immediately.getBool())
+		saveCollections();
 }
 
-void OsuDatabase::removeBeatmapFromCollection(const UString &collectionName, const std::string &beatmapMD5Hash, bool doSaveImmediatelyIfEnabled)
+const OsuDatabase::Collection *OsuDatabase::getCollection(const UString &collectionName) const
 {
-	if (beatmapMD5Hash.length() != 32) return;
-
-	for (auto & collection : m_collections)
+	for (const auto & collection : m_collections)
 	{
 		if (collection.name == collectionName)
-		{
-			bool didRemove = false;
-			for (size_t h=0; h<collection.hashes.size(); h++)
-			{
-				if (collection.hashes[h].hash == beatmapMD5Hash)
-				{
-					// can't delete loaded osu! collection entries
-					if (!collection.hashes[h].isLegacyEntry)
-					{
-						collection.hashes.erase(collection.hashes.begin() + h);
-
-						didRemove = true;
+			return &collection;
+	}
 
-						m_bDidCollectionsChangeForSave = true;
+	return NULL;
+}
 
-						if (doSaveImmediatelyIfEnabled && cv::osu::collections_save_immediately.getBool())
-							saveCollections();
-					}
+OsuDatabase::Collection *OsuDatabase::findCollection(const UString &collectionName)
+{
+	return const_cast<Collection*>(getCollection(collectionName));
+}
 
-					break;
-				}
-			}
+bool OsuDatabase::isInCollection(const Collection &collection, const std::string &beatmapMD5Hash) const
+{
+	uint32_t id = 0;
+	return findCollectionEntryId(beatmapMD5Hash, id) && collection.entries.contains(id);
+}
 
-			// also update .beatmaps for convenience (songbrowser will use that to rebuild the UI)
-			if (didRemove)
-			{
-				for (auto & beatmap : collection.beatmaps)
-				{
-					bool found = false;
-					for (size_t d=0; d<beatmap.second.size(); d++)
-					{
-						if (beatmap.second[d]->getMD5Hash() == beatmapMD5Hash)
-						{
-							found = true;
+bool OsuDatabase::isLegacyCollectionEntry(const Collection &collection, const std::string &beatmapMD5Hash) const
+{
+	uint32_t id = 0;
+	return findCollectionEntryId(beatmapMD5Hash, id) && collection.legacyEntries.contains(id);
+}
 
-							beatmap.second.erase(beatmap.second.begin() + d);
+OsuDatabaseBeatmap *OsuDatabase::getCollectionEntryBeatmap(uint32_t id) const
+{
+	return (id < m_collectionEntries.size() ? m_collectionEntries[id].beatmap : NULL);
+}
 
-							break;
-						}
-					}
+uint32_t OsuDatabase::getCollectionEntryId(const std::string &beatmapMD5Hash)
+{
+	const auto [it, inserted] = m_collectionEntryIds.try_emplace(beatmapMD5Hash, static_cast<uint32_t>(m_collectionEntries.size()));
+	if (inserted)
+		m_collectionEntries.push_back(COLLECTION_ENTRY{.hash = beatmapMD5Hash, .beatmap = NULL, .diff2 = NULL});
 
-					if (found)
-						break;
-				}
-			}
-		}
-	}
+	return it->second;
 }
 
-std::vector<UString> OsuDatabase::getPlayerNamesWithPPScores()
+bool OsuDatabase::findCollectionEntryId(const std::string &beatmapMD5Hash, uint32_t &id) const
 {
-	std::vector<std::string> keys;
-	keys.reserve(m_scores.size());
+	const auto it = m_collectionEntryIds.find(beatmapMD5Hash);
+	if (it == m_collectionEntryIds.end())
+		return false;
 
-	for (const auto& kv : m_scores)
+	id = it->second;
+	return true;
+}
+
+void OsuDatabase::updateCollectionEntries(const std::unordered_map<std::string, OsuDatabaseBeatmap*> &hashToDiff2, const std::unordered_map<std::string, OsuDatabaseBeatmap*> &hashToBeatmap)
+{
+	// every diff in the database gets an id, so on the first load they are dense over all diffs
+	m_collectionEntries.reserve(m_collectionEntries.size() + hashToDiff2.size());
+	for (const auto & [hash, diff2] : hashToDiff2)
 	{
-		keys.push_back(kv.first);
-	}
+		if (hash.length() != 32) continue;
 
-	// bit of a useless double string conversion going on here, but whatever
+		COLLECTION_ENTRY &entry = m_collectionEntries[getCollectionEntryId(hash)];
+		entry.diff2 = diff2;
 
-	std::unordered_set<std::string> tempNames;
-	for (auto &key : keys)
-	{
-		for (Score &score : m_scores[key])
-		{
-			if (!score.isLegacyScore)
-				tempNames.insert(std::string(score.playerName.toUtf8()));
-		}
+		const auto beatmap = hashToBeatmap.find(hash);
+		entry.beatmap = (beatmap != hashToBeatmap.end() ? beatmap->second : NULL);
 	}
+}
 
-	// always add local user, even if there were no scores
-	tempNames.insert(std::string(cv::name.getString().toUtf8()));
+std::vector<UString> OsuDatabase::getPlayerNamesWithPPScores()
+{
+	updatePlayerScores();
 
 	std::vector<UString> names;
-	names.reserve(tempNames.size());
-	for (const auto& k : tempNames)
+	names.reserve(m_playerScores.size() + 1);
+	for (const auto &[playerName, player] : m_playerScores)
 	{
-		if (k.length() > 0)
-			names.emplace_back(k.c_str());
+		if (player.numScores > 0 && playerName.length() > 0)
+			names.push_back(playerName);
 	}
 
+	// always add local user, even if there were no scores
+	const UString &localName = cv::name.getString();
+	if (localName.length() > 0 && std::ranges::find(names, localName) == names.end())
+		names.push_back(localName);
+
 	return names;
 }
 
@@ -818,113 +811,52 @@ std::vector<UString> OsuDatabase::getPlayerNamesWithScoresForUserSwitcher()
 {
 	const bool includeLegacyNames = cv::osu::user_switcher_include_legacy_scores_for_names.getBool();
 
-	// bit of a useless double string conversion going on here, but whatever
+	updatePlayerScores();
 
-	std::unordered_set<std::string> tempNames;
-	for (const auto& kv : m_scores)
+	std::vector<UString> names;
+	names.reserve(m_playerScores.size() + 1);
+	for (const auto &[playerName, player] : m_playerScores)
 	{
-		const std::string &key = kv.first;
-		for (Score &score : m_scores[key])
-		{
-			if (!score.isLegacyScore || includeLegacyNames)
-				tempNames.insert(std::string(score.playerName.toUtf8()));
-		}
+		if ((player.numScores > 0 || (includeLegacyNames && player.numLegacyScores > 0)) && playerName.length() > 0)
+			names.push_back(playerName);
 	}
 
 	// always add local user, even if there were no scores
-	tempNames.insert(std::string(cv::name.getString().toUtf8()));
-
-	std::vector<UString> names;
-	names.reserve(tempNames.size());
-	for (const auto& k : tempNames)
-	{
-		if (k.length() > 0)
-			names.emplace_back(k.c_str());
-	}
+	const UString &localName = cv::name.getString();
+	if (localName.length() > 0 && std::ranges::find(names, localName) == names.end())
+		names.push_back(localName);
 
 	return names;
 }
 
 OsuDatabase::PlayerPPScores OsuDatabase::getPlayerPPScores(const UString &playerName)
 {
-	std::vector<Score*> scores;
+	updatePlayerScores();
 
-	// collect all scores with pp data
-	std::vector<std::string> keys;
-	keys.reserve(m_scores.size());
+	PlayerPPScores ppScores;
+	ppScores.totalScore = 0;
 
-	for (const auto& kv : m_scores)
-	{
-		keys.push_back(kv.first);
-	}
+	const auto player = m_playerScores.find(playerName);
+	if (player == m_playerScores.end())
+		return ppScores;
 
-	constexpr auto scoreSortComparator = [](Score const *a, Score const *b) -> bool
-	{
-		// sort by pp
-		// strict weak ordering!
-		if (a->pp == b->pp)
-			return a->sortHack < b->sortHack;
-		else
-			return a->pp < b->pp;
-	};
+	ppScores.totalScore = player->second.totalScore;
 
-	unsigned long long totalScore = 0;
-	const float userBeatmapPpSanityLimitForStats = cv::osu::user_beatmap_pp_sanity_limit_for_stats.getFloat();
-	for (auto &key : keys)
+	ppScores.ppScores.reserve(player->second.ppScores.size());
+	for (const PLAYER_PP_SCORE &ppScore : player->second.ppScores)
 	{
-		if (m_scores[key].size() > 0)
-		{
-			Score *tempScore = &m_scores[key][0];
-
-			// only add highest pp score per diff
-			bool foundValidScore = false;
-			float prevPP = -1.0f;
-			for (Score &score : m_scores[key])
-			{
-				if (!score.isLegacyScore && (cv::osu::user_include_relax_and_autopilot_for_stats.getBool() ? true : !((score.modsLegacy & OsuReplay::Mods::Relax) || (score.modsLegacy & OsuReplay::Mods::Relax2))) && score.playerName == playerName)
-				{
-					const bool isSaneScore = (userBeatmapPpSanityLimitForStats <= 0.0f || score.pp <= userBeatmapPpSanityLimitForStats);
-					if (isSaneScore)
-					{
-						foundValidScore = true;
-
-						totalScore += score.score;
-
-						score.sortHack = m_iSortHackCounter++;
-
-						if ((score.pp > prevPP || prevPP < 0.0f))
-						{
-							prevPP = score.pp;
-							tempScore = &score;
-						}
-					}
-				}
-			}
-
-			if (foundValidScore)
-				scores.push_back(tempScore);
-		}
+		ppScores.ppScores.push_back(ppScore.score);
 	}
 
-	// sort by pp
-	std::ranges::sort(scores, scoreSortComparator);
-
-	PlayerPPScores ppScores;
-	ppScores.ppScores = std::move(scores);
-	ppScores.totalScore = totalScore;
-
 	return ppScores;
 }
 
 OsuDatabase::PlayerStats OsuDatabase::calculatePlayerStats(const UString &playerName)
 {
-	if (!m_bDidScoresChangeForStats && playerName == m_prevPlayerStats.name) return m_prevPlayerStats;
+	updatePlayerScores();
 
-	const PlayerPPScores ps = getPlayerPPScores(playerName);
-
-	// delay caching until we actually have scores loaded
-	if (ps.ppScores.size() > 0)
-		m_bDidScoresChangeForStats = false;
+	PLAYER_SCORES &player = m_playerScores[playerName];
+	if (player.statsValid) return player.stats;
 
 	// "If n is the amount of scores giving more pp than a given score, then the score's weight is 0.95^n"
 	// "Total pp = PP[1] * 0.95^0 + PP[2] * 0.95^1 + PP[3] * 0.95^2 + ... + PP[n] * 0.95^(n-1)"
@@ -932,45 +864,173 @@ OsuDatabase::PlayerStats OsuDatabase::calculatePlayerStats(const UString &player
 
 	// https://expectancyviolation.github.io/osu-acc/
 
+	const size_t numScores = player.ppScores.size();
+
 	float pp = 0.0f;
 	float acc = 0.0f;
-	for (size_t i=0; i<ps.ppScores.size(); i++)
+	size_t i = 0;
+	for (const PLAYER_PP_SCORE &ppScore : player.ppScores)
 	{
-		const float weight = getWeightForIndex(ps.ppScores.size() - 1 - i);
+		const float weight = getWeightForIndex(numScores - 1 - i);
 
-		pp += ps.ppScores[i]->pp * weight;
-		acc += OsuScore::calculateAccuracy(ps.ppScores[i]->num300s, ps.ppScores[i]->num100s, ps.ppScores[i]->num50s, ps.ppScores[i]->numMisses) * weight;
+		pp += ppScore.pp * weight;
+		acc += ppScore.accuracy * weight;
+
+		i++;
 	}
 
 	// bonus pp
 	// https://osu.ppy.sh/wiki/en/Performance_points
 	if (cv::osu::scores_bonus_pp.getBool())
-		pp += getBonusPPForNumScores(ps.ppScores.size());
+		pp += getBonusPPForNumScores(numScores);
 
 	// normalize accuracy
-	if (ps.ppScores.size() > 0)
-		acc /= (20.0f * (1.0f - getWeightForIndex(ps.ppScores.size())));
+	if (numScores > 0)
+		acc /= (20.0f * (1.0f - getWeightForIndex(numScores)));
 
 	// fill stats
-	m_prevPlayerStats.name = playerName;
-	m_prevPlayerStats.pp = pp;
-	m_prevPlayerStats.accuracy = acc;
-	m_prevPlayerStats.numScoresWithPP = ps.ppScores.size();
+	PlayerStats &stats = player.stats;
+	stats.name = playerName;
+	stats.pp = pp;
+	stats.accuracy = acc;
+	stats.numScoresWithPP = numScores;
+	stats.level = getLevelForScore(player.totalScore);
+	stats.percentToNextLevel = 0.0f;
+	stats.totalScore = player.totalScore;
+
+	const unsigned long long requiredScoreForCurrentLevel = getRequiredScoreForLevel(stats.level);
+	const unsigned long long requiredScoreForNextLevel = getRequiredScoreForLevel(stats.level + 1);
+
+	if (requiredScoreForNextLevel > requiredScoreForCurrentLevel)
+		stats.percentToNextLevel = (double)(player.totalScore - requiredScoreForCurrentLevel) / (double)(requiredScoreForNextLevel - requiredScoreForCurrentLevel);
 
-	if (ps.totalScore != m_prevPlayerStats.totalScore)
+	player.statsValid = true;
+
+	return stats;
+}
+
+bool OsuDatabase::isScoreValidForStats(const Score &score) const
+{
+	if (score.isLegacyScore) return false;
+
+	if (!m_bPlayerScoresIncludeRelaxAndAutopilot && ((score.modsLegacy & OsuReplay::Mods::Relax) || (score.modsLegacy & OsuReplay::Mods::Relax2)))
+		return false;
+
+	return (m_fPlayerScoresPPSanityLimit <= 0.0f || score.pp <= m_fPlayerScoresPPSanityLimit);
+}
+
+bool OsuDatabase::arePlayerScoresUpToDate() const
+{
+	return (!m_bDidScoresChangeForStats
+			&& m_bPlayerScoresIncludeRelaxAndAutopilot == cv::osu::user_include_relax_and_autopilot_for_stats.getBool()
+			&& m_fPlayerScoresPPSanityLimit == cv::osu::user_beatmap_pp_sanity_limit_for_stats.getFloat());
+}
+
+void OsuDatabase::updatePlayerScores()
+{
+	if (arePlayerScoresUpToDate()) return;
+
+	m_bDidScoresChangeForStats = false;
+	m_bPlayerScoresIncludeRelaxAndAutopilot = cv::osu::user_include_relax_and_autopilot_for_stats.getBool();
+	m_fPlayerScoresPPSanityLimit = cv::osu::user_beatmap_pp_sanity_limit_for_stats.getFloat();
+
+	m_playerScores.clear();
+
+	std::unordered_map<UString, Score*> bestScores; // of the current diff, by player
+	for (auto &[beatmapMD5Hash, scores] : m_scores)
 	{
-		m_prevPlayerStats.level = getLevelForScore(ps.totalScore);
+		bestScores.clear();
 
-		const unsigned long long requiredScoreForCurrentLevel = getRequiredScoreForLevel(m_prevPlayerStats.level);
-		const unsigned long long requiredScoreForNextLevel = getRequiredScoreForLevel(m_prevPlayerStats.level + 1);
+		for (Score &score : scores)
+		{
+			PLAYER_SCORES &player = m_playerScores[score.playerName];
+			if (score.isLegacyScore)
+				player.numLegacyScores++;
+			else
+				player.numScores++;
+
+			if (!isScoreValidForStats(score)) continue;
 
-		if (requiredScoreForNextLevel > requiredScoreForCurrentLevel)
-			m_prevPlayerStats.percentToNextLevel = (double)(ps.totalScore - requiredScoreForCurrentLevel) / (double)(requiredScoreForNextLevel - requiredScoreForCurrentLevel);
+			player.totalScore += score.score;
+
+			// only the highest pp score per diff counts
+			Score *&best = bestScores[score.playerName];
+			if (best == NULL || score.pp > best->pp)
+				best = &score;
+		}
+
+		for (const auto &[playerName, best] : bestScores)
+		{
+			PLAYER_SCORES &player = m_playerScores[playerName];
+			player.bestScores[beatmapMD5Hash] = player.ppScores.insert(PLAYER_PP_SCORE{
+				.pp = best->pp,
+				.sortHack = best->sortHack,
+				.accuracy = OsuScore::calculateAccuracy(best->num300s, best->num100s, best->num50s, best->numMisses),
+				.score = best,
+				.beatmapMD5Hash = beatmapMD5Hash});
+		}
 	}
+}
+
+void OsuDatabase::updatePlayerScore(const std::string &beatmapMD5Hash, const Score &score, bool added)
+{
+	PLAYER_SCORES &player = m_playerScores[score.playerName];
+	int &numScores = (score.isLegacyScore ? player.numLegacyScores : player.numScores);
+	numScores += (added ? 1 : -1);
+
+	if (!isScoreValidForStats(score)) return;
 
-	m_prevPlayerStats.totalScore = ps.totalScore;
+	if (added)
+		player.totalScore += score.score;
+	else
+		player.totalScore -= score.score;
 
-	return m_prevPlayerStats;
+	updatePlayerBestScore(beatmapMD5Hash, score.playerName);
+}
+
+void OsuDatabase::updatePlayerBestScore(const std::string &beatmapMD5Hash, const UString &playerName)
+{
+	PLAYER_SCORES &player = m_playerScores[playerName];
+	player.statsValid = false;
+
+	Score *best = NULL;
+	const auto scores = m_scores.find(beatmapMD5Hash);
+	if (scores != m_scores.end())
+	{
+		for (Score &score : scores->second)
+		{
+			if (score.playerName == playerName && isScoreValidForStats(score) && (best == NULL || score.pp > best->pp))
+				best = &score;
+		}
+	}
+
+	const auto prevBest = player.bestScores.find(beatmapMD5Hash);
+	if (prevBest != player.bestScores.end())
+	{
+		player.ppScores.erase(prevBest->second);
+		player.bestScores.erase(prevBest);
+	}
+
+	if (best != NULL)
+	{
+		player.bestScores[beatmapMD5Hash] = player.ppScores.insert(PLAYER_PP_SCORE{
+			.pp = best->pp,
+			.sortHack = best->sortHack,
+			.accuracy = OsuScore::calculateAccuracy(best->num300s, best->num100s, best->num50s, best->numMisses),
+			.score = best,
+			.beatmapMD5Hash = beatmapMD5Hash});
+	}
+}
+
+void OsuDatabase::updatePlayerBestScores(const std::string &beatmapMD5Hash)
+{
+	if (!arePlayerScoresUpToDate()) return; // the next full rebuild takes care of it
+
+	for (auto &[playerName, player] : m_playerScores)
+	{
+		if (player.bestScores.contains(beatmapMD5Hash))
+			updatePlayerBestScore(beatmapMD5Hash, playerName);
+	}
 }
 
 float OsuDatabase::getWeightForIndex(int i)
@@ -1219,6 +1279,8 @@ void OsuDatabase::loadDB(OsuFile *db, bool &fallbackToRawLoad)
 {
 	// reset
 	m_collections.clear();
+	m_collectionEntries.clear();
+	m_collectionEntryIds.clear();
 
 	if (m_databaseBeatmaps.size() > 0)
 		debugLog("WARNING: called without cleared m_beatmaps!!!\n");
@@ -2306,6 +2368,8 @@ void OsuDatabase::loadScores()
 
 	if (m_scores.size() > 0)
 		m_bScoresLoaded = true;
+
+	m_bDidScoresChangeForStats = true;
 }
 
 void OsuDatabase::saveScores()
@@ -2428,54 +2492,7 @@ void OsuDatabase::loadCollections(const UString& collectionFilePath, bool isLega
 {
 	bool wasInterrupted = false;
 
-	struct CollectionLoadingHelper
-	{
-		static void addBeatmapsEntryForBeatmapAndDiff2(Collection &c, OsuDatabaseBeatmap *beatmap, OsuDatabaseBeatmap *diff2, std::atomic<bool> &interruptLoad, bool &wasInterrupted)
-		{
-			if (beatmap == NULL || diff2 == NULL) return;
-
-			// we now have one matching OsuBeatmap and OsuBeatmapDifficulty, add either of them if they don't exist yet
-			bool beatmapIsAlreadyInCollection = false;
-			{
-				for (auto & m : c.beatmaps)
-				{
-					if (interruptLoad.load()) {wasInterrupted = true; break;} // cancellation point
-
-					if (m.first == beatmap)
-					{
-						beatmapIsAlreadyInCollection = true;
-
-						// the beatmap already exists, check if we have to add the current diff
-						bool diffIsAlreadyInCollection = false;
-						{
-							for (auto & d : m.second)
-							{
-								if (interruptLoad.load()) {wasInterrupted = true; break;} // cancellation point
-
-								if (d == diff2)
-								{
-									diffIsAlreadyInCollection = true;
-									break;
-								}
-							}
-						}
-						if (!diffIsAlreadyInCollection)
-							m.second.push_back(diff2);
-
-						break;
-					}
-				}
-			}
-			if (!beatmapIsAlreadyInCollection)
-			{
-				std::vector<OsuDatabaseBeatmap*> diffs2;
-				{
-					diffs2.push_back(diff2);
-				}
-				c.beatmaps.emplace_back(beatmap, diffs2);
-			}
-		}
-	};
+	updateCollectionEntries(hashToDiff2, hashToBeatmap);
 
 	OsuFile collectionFile(collectionFilePath);
 	if (collectionFile.isReady())
@@ -2510,138 +2527,27 @@ void OsuDatabase::loadCollections(const UString& collectionFilePath, bool isLega
 				{
 					if (m_bInterruptLoad.load()) {wasInterrupted = true; break;} // cancellation point
 
-					std::string md5hash = collectionFile.readStdString();
+					const uint32_t id = getCollectionEntryId(collectionFile.readStdString());
 
-					CollectionEntry entry;
-					{
-						entry.isLegacyEntry = isLegacy;
-
-						entry.hash = md5hash;
-					}
-					c.hashes.push_back(entry);
-				}
-
-				if (c.hashes.size() > 0)
-				{
-					// collect OsuBeatmaps corresponding to this collection
-
-					// go through every hash of the collection
-					std::vector<OsuDatabaseBeatmap*> matchingDiffs2;
-					for (auto & hash : c.hashes)
-					{
-						if (m_bInterruptLoad.load()) {wasInterrupted = true; break;} // cancellation point
-
-						// new: use hashmap
-						if (hash.hash.length() == 32)
-						{
-							const auto result = hashToDiff2.find(hash.hash);
-							if (result != hashToDiff2.end())
-								matchingDiffs2.push_back(result->second);
-						}
-					}
-
-					// we now have an array of all OsuBeatmapDifficulty objects within this collection
-
-					// go through every found OsuBeatmapDifficulty
-					for (auto diff2 : matchingDiffs2)
-					{
-						if (m_bInterruptLoad.load()) {wasInterrupted = true; break;} // cancellation point
-
-						if (diff2 == NULL) continue;
-
-						// find the OsuBeatmap object corresponding to this diff
-						OsuDatabaseBeatmap *beatmap = NULL;
-						if (diff2->getMD5Hash().length() == 32)
-						{
-							// new: use hashmap
-							const auto result = hashToBeatmap.find(diff2->getMD5Hash());
-							if (result != hashToBeatmap.end())
-								beatmap = result->second;
-						}
-
-						CollectionLoadingHelper::addBeatmapsEntryForBeatmapAndDiff2(c, beatmap, diff2, m_bInterruptLoad, wasInterrupted);
-					}
+					c.entries.add(id);
+					if (isLegacy)
+						c.legacyEntries.add(id);
 				}
 
 				// add the collection
 				// check if we already have a collection with that name, if so then just add our new entries to it (necessary since this function will load both osu!'s collection.db as well as our own custom collections.db)
 				// this handles all the merging between both legacy and custom collections
+				Collection *existingCollection = findCollection(c.name);
+				if (existingCollection != NULL)
 				{
-					bool collectionAlreadyExists = false;
-					for (auto & existingCollection : m_collections)
-					{
-						if (m_bInterruptLoad.load()) {wasInterrupted = true; break;} // cancellation point
-
-							if (existingCollection.name == c.name)
-						{
-							collectionAlreadyExists = true;
-
-							// merge with existing collection
-							{
-								for (auto & chash : c.hashes)
-								{
-									const std::string &toBeAddedEntryHash = chash.hash;
-
-									bool entryAlreadyExists = false;
-									{
-										for (auto & ehash : existingCollection.hashes)
-										{
-											const std::string &existingEntryHash = ehash.hash;
-											if (existingEntryHash == toBeAddedEntryHash)
-											{
-												entryAlreadyExists = true;
-												break;
-											}
-										}
-									}
-
-									// if the entry does not yet exist in the existing collection, then add that entry
-									if (!entryAlreadyExists)
-									{
-										// add to .hashes
-										{
-											CollectionEntry toBeAddedEntry;
-											{
-												toBeAddedEntry.isLegacyEntry = isLegacy;
-
-												toBeAddedEntry.hash = toBeAddedEntryHash;
-											}
-											existingCollection.hashes.push_back(toBeAddedEntry);
-										}
-
-										// add to .beatmaps
-										{
-											const auto result = hashToDiff2.find(toBeAddedEntryHash);
-											if (result != hashToDiff2.end())
-											{
-												OsuDatabaseBeatmap *diff2 = result->second;
-
-												if (diff2 != NULL)
-												{
-													// find the OsuBeatmap object corresponding to this diff
-													OsuDatabaseBeatmap *beatmap = NULL;
-													if (diff2->getMD5Hash().length() == 32)
-													{
-														// new: use hashmap
-														const auto result = hashToBeatmap.find(diff2->getMD5Hash());
-														if (result != hashToBeatmap.end())
-															beatmap = result->second;
-													}
-
-													CollectionLoadingHelper::addBeatmapsEntryForBeatmapAndDiff2(existingCollection, beatmap, diff2, m_bInterruptLoad, wasInterrupted);
-												}
-											}
-										}
-									}
-								}
-							}
-
-							break;
-						}
-					}
-					if (!collectionAlreadyExists)
-						m_collections.push_back(c);
+					// entries which already exist keep where they were loaded from
+					c.entries.forEach([&](uint32_t id) {
+						if (existingCollection->entries.add(id) && isLegacy)
+							existingCollection->legacyEntries.add(id);
+					});
 				}
+				else
+					m_collections.push_back(std::move(c));
 			}
 		}
 		else
@@ -2651,7 +2557,7 @@ void OsuDatabase::loadCollections(const UString& collectionFilePath, bool isLega
 		{
 			for (int i=0; i<m_collections.size(); i++)
 			{
-				debugLog("Collection #{}: name = {:s}, numBeatmaps = {}\n", i, m_collections[i].name.toUtf8(), m_collections[i].beatmaps.size());
+				debugLog("Collection #{}: name = {:s}, numBeatmaps = {}\n", i, m_collections[i].name.toUtf8(), m_collections[i].entries.size());
 			}
 		}
 	}
@@ -2710,20 +2616,9 @@ void OsuDatabase::saveCollections()
 			int32_t numNonLegacyCollectionsOrCollectionsWithNonLegacyEntries = 0;
 			for (auto & collection : m_collections)
 			{
-				if (!collection.isLegacyCollection)
+				// (legacyEntries is always a subset of entries)
+				if (!collection.isLegacyCollection || collection.entries.size() > collection.legacyEntries.size())
 					numNonLegacyCollectionsOrCollectionsWithNonLegacyEntries++;
-				else
-				{
-					// does this legacy collection have any non-legacy entries?
-					for (auto & hash : collection.hashes)
-					{
-						if (!hash.isLegacyEntry)
-						{
-							numNonLegacyCollectionsOrCollectionsWithNonLegacyEntries++;
-							break;
-						}
-					}
-				}
 			}
 
 			db.writeInt(dbVersion);
@@ -2733,35 +2628,17 @@ void OsuDatabase::saveCollections()
 			{
 				for (auto & collection : m_collections)
 				{
-					bool hasNonLegacyEntries = false;
-					{
-						for (auto & hash : collection.hashes)
-						{
-							if (!hash.isLegacyEntry)
-							{
-								hasNonLegacyEntries = true;
-								break;
-							}
-						}
-					}
+					const auto numNonLegacyEntries = static_cast<int32_t>(collection.entries.size() - collection.legacyEntries.size());
 
-					if (!collection.isLegacyCollection || hasNonLegacyEntries)
+					if (!collection.isLegacyCollection || numNonLegacyEntries > 0)
 					{
-						int32_t numNonLegacyEntries = 0;
-						for (auto & hash : collection.hashes)
-						{
-							if (!hash.isLegacyEntry)
-								numNonLegacyEntries++;
-						}
-
 						db.writeString(collection.name);
 						db.writeInt(numNonLegacyEntries);
 
-						for (auto & hash : collection.hashes)
-						{
-							if (!hash.isLegacyEntry)
-								db.writeStdString(hash.hash);
-						}
+						collection.entries.forEach([&](uint32_t id) {
+							if (!collection.legacyEntries.contains(id))
+								db.writeStdString(m_collectionEntries[id].hash);
+						});
 					}
 				}
 			}
@@ -2776,6 +2653,19 @@ void OsuDatabase::saveCollections()
 }
 
 OsuDatabaseBeatmap *OsuDatabase::loadRawBeatmap(const UString& beatmapPath)
+{
+	std::vector<UString> warnings;
+	std::vector<OsuDatabaseBeatmap*> diffs = loadRawBeatmapDiffs(beatmapPath, &warnings);
+
+	for (const UString &warning : warnings)
+	{
+		engine->showMessageWarning("OsuBeatmapDatabase::loadRawBeatmap()", warning);
+	}
+
+	return createRawBeatmap(std::move(diffs));
+}
+
+std::vector<OsuDatabaseBeatmap*> OsuDatabase::loadRawBeatmapDiffs(const UString& beatmapPath, std::vector<UString> *warnings) const
 {
 	if (cv::osu::debug.getBool())
 		debugLog("{:s}\n", beatmapPath.toUtf8());
@@ -2802,8 +2692,8 @@ OsuDatabaseBeatmap *OsuDatabase::loadRawBeatmap(const UString& beatmapPath)
 					if (cv::osu::debug.getBool())
 					{
 						debugLog("Couldn't loadMetadata(), deleting object.\n");
-						if (diff2->getGameMode() == 0)
-							engine->showMessageWarning("OsuBeatmapDatabase::loadRawBeatmap()", "Couldn't loadMetadata()\n");
+						if (diff2->getGameMode() == 0 && warnings != NULL)
+							warnings->push_back("Couldn't loadMetadata()\n");
 					}
 					SAFE_DELETE(diff2);
 					continue;
@@ -2823,22 +2713,23 @@ OsuDatabaseBeatmap *OsuDatabase::loadRawBeatmap(const UString& beatmapPath)
 		}
 	}
 
-	// build beatmap from diffs
-	OsuDatabaseBeatmap *beatmap = NULL;
+	return diffs2;
+}
+
+OsuDatabaseBeatmap *OsuDatabase::createRawBeatmap(std::vector<OsuDatabaseBeatmap*> diffs2)
+{
+	if (diffs2.size() < 1)
+		return NULL;
+
+	auto *beatmap = new OsuDatabaseBeatmap(diffs2);
+
+	// and add entries in our hashmaps
+	for (auto diff2 : diffs2)
 	{
-		if (diffs2.size() > 0)
+		if (diff2->getMD5Hash().length() == 32)
 		{
-			beatmap = new OsuDatabaseBeatmap(diffs2);
-
-			// and add entries in our hashmaps
-			for (auto diff2 : diffs2)
-			{
-				if (diff2->getMD5Hash().length() == 32)
-				{
-					m_rawHashToDiff2[diff2->getMD5Hash()] = diff2;
-					m_rawHashToBeatmap[diff2->getMD5Hash()] = beatmap;
-				}
-			}
+			m_rawHashToDiff2[diff2->getMD5Hash()] = diff2;
+			m_rawHashToBeatmap[diff2->getMD5Hash()] = beatmap;
 		}
 	}
 
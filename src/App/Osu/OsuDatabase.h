@@ -10,8 +10,11 @@
 #define OSUDATABASE_H
 
 #include "cbase.h"
+#include "OsuCollectionBitmap.h"
 #include "Timing.h"
 
+#include <set>
+
 class ConVar;
 
 class Osu;
@@ -23,21 +26,15 @@ class OsuDatabaseLoader;
 class OsuDatabase
 {
 public:
-	struct CollectionEntry
-	{
-		bool isLegacyEntry;			// used for identifying loaded osu! collection entries
-
-		std::string hash;
-	};
-
 	struct Collection
 	{
 		bool isLegacyCollection;	// used for identifying loaded osu! collections
 
 		UString name;
-		std::vector<CollectionEntry> hashes;
 
-		std::vector<std::pair<OsuDatabaseBeatmap*, std::vector<OsuDatabaseBeatmap*>>> beatmaps;
+		// collection entry ids (one per md5 hash, see getCollectionEntryBeatmap())
+		OsuCollectionBitmap entries;
+		OsuCollectionBitmap legacyEntries; // the subset loaded from osu!'s collection.db, used for identifying loaded osu! collection entries
 	};
 
 	struct Score
@@ -216,6 +213,10 @@ public:
 	OsuDatabaseBeatmap *getBeatmapDifficulty(const std::string &md5hash);
 
 	inline const std::vector<Collection> &getCollections() const {return m_collections;}
+	const Collection *getCollection(const UString &collectionName) const;
+	bool isInCollection(const Collection &collection, const std::string &beatmapMD5Hash) const;
+	bool isLegacyCollectionEntry(const Collection &collection, const std::string &beatmapMD5Hash) const;
+	OsuDatabaseBeatmap *getCollectionEntryBeatmap(uint32_t id) const; // the set containing the diff of this entry, NULL if it isn't in the database
 
 	inline std::unordered_map<std::string, std::vector<Score>> *getScores() {return &m_scores;}
 	inline const std::vector<SCORE_SORTING_METHOD> &getScoreSortingMethods() const {return m_scoreSortingMethods;}
@@ -230,6 +231,13 @@ private:
 
 	void addScoreRaw(const std::string &beatmapMD5Hash, const OsuDatabase::Score &score);
 
+	bool isScoreValidForStats(const Score &score) const;
+	bool arePlayerScoresUpToDate() const;
+	void updatePlayerScores(); // full rebuild if scores were changed from the outside (or the stats convars changed)
+	void updatePlayerScore(const std::string &beatmapMD5Hash, const Score &score, bool added); // incremental, after score was added to/erased from m_scores
+	void updatePlayerBestScore(const std::string &beatmapMD5Hash, const UString &playerName);
+	void updatePlayerBestScores(const std::string &beatmapMD5Hash); // after scores of this diff were added/erased/reordered
+
 	UString parseLegacyCfgBeatmapDirectoryParameter();
 	void scheduleLoadRaw();
 	void loadDB(OsuFile *db, bool &fallbackToRawLoad);
@@ -243,7 +251,14 @@ private:
 	void loadCollections(const UString& collectionFilePath, bool isLegacy, const std::unordered_map<std::string, OsuDatabaseBeatmap*> &hashToDiff2, const std::unordered_map<std::string, OsuDatabaseBeatmap*> &hashToBeatmap);
 	void saveCollections();
 
+	Collection *findCollection(const UString &collectionName);
+	uint32_t getCollectionEntryId(const std::string &beatmapMD5Hash); // adds a new id for unknown hashes
+	bool findCollectionEntryId(const std::string &beatmapMD5Hash, uint32_t &id) const;
+	void updateCollectionEntries(const std::unordered_map<std::string, OsuDatabaseBeatmap*> &hashToDiff2, const std::unordered_map<std::string, OsuDatabaseBeatmap*> &hashToBeatmap);
+
 	OsuDatabaseBeatmap *loadRawBeatmap(const UString& beatmapPath); // only used for raw loading without db
+	std::vector<OsuDatabaseBeatmap*> loadRawBeatmapDiffs(const UString& beatmapPath, std::vector<UString> *warnings) const; // thread safe, only reads m_starsCache, warnings must be shown by the caller
+	OsuDatabaseBeatmap *createRawBeatmap(std::vector<OsuDatabaseBeatmap*> diffs2);
 
 	void onScoresRename(const UString& args);
 	void onScoresExport();
@@ -263,18 +278,51 @@ private:
 	int m_iFolderCount;
 
 	// collection.db (legacy and custom)
+	struct COLLECTION_ENTRY
+	{
+		std::string hash;
+		OsuDatabaseBeatmap *beatmap;	// NULL if not in the database
+		OsuDatabaseBeatmap *diff2;		// NULL if not in the database
+	};
 	std::vector<Collection> m_collections;
+	std::vector<COLLECTION_ENTRY> m_collectionEntries; // by id, ids are dense and never reused (until the database is reloaded)
+	std::unordered_map<std::string, uint32_t> m_collectionEntryIds;
 	bool m_bDidCollectionsChangeForSave;
 
 	// scores.db (legacy and custom)
 	bool m_bScoresLoaded;
 	std::unordered_map<std::string, std::vector<Score>> m_scores;
 	bool m_bDidScoresChangeForSave;
-	bool m_bDidScoresChangeForStats;
+	bool m_bDidScoresChangeForStats; // forces a full rebuild of m_playerScores
 	unsigned long long m_iSortHackCounter;
-	PlayerStats m_prevPlayerStats;
 	std::vector<SCORE_SORTING_METHOD> m_scoreSortingMethods;
 
+	// per player index over m_scores, so that the user stats don't have to go through every score on every change
+	struct PLAYER_PP_SCORE
+	{
+		float pp;
+		unsigned long long sortHack;
+		float accuracy;
+		Score *score; // into m_scores, kept valid by updatePlayerBestScores() whenever the vector of that diff changes
+		std::string beatmapMD5Hash;
+
+		bool operator<(const PLAYER_PP_SCORE &other) const {return (pp == other.pp ? sortHack < other.sortHack : pp < other.pp);}
+	};
+	struct PLAYER_SCORES
+	{
+		int numScores = 0;					// non-legacy
+		int numLegacyScores = 0;
+		unsigned long long totalScore = 0;	// of all scores valid for stats
+		std::multiset<PLAYER_PP_SCORE> ppScores; // highest pp valid score per diff, ascending
+		std::unordered_map<std::string, std::multiset<PLAYER_PP_SCORE>::iterator> bestScores; // into ppScores, by beatmap md5hash
+
+		bool statsValid = false;
+		PlayerStats stats{};
+	};
+	std::unordered_map<UString, PLAYER_SCORES> m_playerScores;
+	bool m_bPlayerScoresIncludeRelaxAndAutopilot;	// convar values m_playerScores was built with
+	float m_fPlayerScoresPPSanityLimit;
+
 	// raw load
 	bool m_bRawBeatmapLoadScheduled;
 	int m_iCurRawBeatmapLoadIndex;
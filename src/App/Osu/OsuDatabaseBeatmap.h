@@ -396,6 +396,7 @@ public:
 
 	[[nodiscard]] inline const UString &getLoadedBackgroundImageFileName() const {return m_sLoadedBackgroundImageFileName;}
 	[[nodiscard]] Type getResType() const override { return APPDEFINED; } // TODO: handle this better?
+	[[nodiscard]] bool isBackgroundWork() const override { return false; } // quick, and song browser thumbnails are waiting for it
 private:
 	void init() override;
 	void initAsync() override;
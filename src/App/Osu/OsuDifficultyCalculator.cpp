@@ -12,6 +12,7 @@
 
 #include "Osu.h"
 #include "OsuBeatmap.h"
+#include "OsuConVarSnapshot.h"
 #include "OsuGameRules.h"
 #include "OsuReplay.h"
 
@@ -268,6 +269,7 @@ double OsuDifficultyCalculator::calculateStarDiffForHitObjectsInt(std::vector<Di
 
 
 	// global independent variables/constants
+	const std::shared_ptr<const OsuConVarSnapshot> cvars = OsuConVarSnapshot::acquire(); // (one consistent set for the whole calculation, see OsuConVarSnapshot)
 	float circleRadiusInOsuPixels = 64.0f * OsuGameRules::getRawHitCircleScale(std::clamp<float>(CS, 0.0f, 12.142f)); // NOTE: clamped CS because McOsu allows CS > ~12.1429 (at which point the diameter becomes negative)
 	const float hitWindow300 = 2.0f * OsuGameRules::getRawHitWindow300(OD) / speedMultiplier;
 
@@ -297,7 +299,7 @@ double OsuDifficultyCalculator::calculateStarDiffForHitObjectsInt(std::vector<Di
 	class DistanceCalc
 	{
 	public:
-		static void computeSliderCursorPosition(DiffObject &slider, float circleRadius)
+		static void computeSliderCursorPosition(DiffObject &slider, float circleRadius, const OsuConVarSnapshot &cvars)
 		{
 			if (slider.lazyCalcFinished || slider.ho->curve == NULL) return;
 
@@ -305,16 +307,16 @@ double OsuDifficultyCalculator::calculateStarDiffForHitObjectsInt(std::vector<Di
 			// this isn't entirely accurate to how lazer does it (as that skips loading the object entirely),
 			// but this is a good middle ground for maps that aren't completely aspire and still have relatively normal star counts on lazer
 			// see: DJ Noriken - Stargazer feat. YUC'e (PSYQUI Remix) (Hishiro Chizuru) [Starg-Azer isn't so great? Are you kidding me?]
-			if (cv::osu::stars_ignore_clamped_sliders.getBool())
+			if (cvars.starsIgnoreClampedSliders)
 			{
 
 
-				if (slider.ho->curve->getPixelLength() >= cv::osu::slider_curve_max_length.getFloat()) return;
+				if (slider.ho->curve->getPixelLength() >= cvars.sliderCurveMaxLength) return;
 			}
 
 			// NOTE: although this looks like a duplicate of the end tick time, this really does have a noticeable impact on some maps due to precision issues
 			// see: Ocelot - KAEDE (Hollow Wings) [EX EX]
-			const double tailLeniency = (double)cv::osu::slider_end_inside_check_offset.getInt();
+			const double tailLeniency = (double)cvars.sliderEndInsideCheckOffset;
 			const double totalDuration = (double)slider.ho->spanDuration * slider.ho->repeats;
 			double trackingEndTime = (double)slider.ho->time + std::max(totalDuration - tailLeniency, totalDuration / 2.0);
 
@@ -385,11 +387,11 @@ double OsuDifficultyCalculator::calculateStarDiffForHitObjectsInt(std::vector<Di
 			slider.lazyCalcFinished = true;
 		}
 
-		static Vector2 getEndCursorPosition(DiffObject &hitObject, float circleRadius)
+		static Vector2 getEndCursorPosition(DiffObject &hitObject, float circleRadius, const OsuConVarSnapshot &cvars)
 		{
 			if (hitObject.ho->type == OsuDifficultyHitObject::TYPE::SLIDER)
 			{
-				computeSliderCursorPosition(hitObject, circleRadius);
+				computeSliderCursorPosition(hitObject, circleRadius, cvars);
 				return hitObject.lazyEndPos; // (slider.lazyEndPos is already initialized to ho->pos in DiffObject constructor)
 			}
 
@@ -420,9 +422,9 @@ double OsuDifficultyCalculator::calculateStarDiffForHitObjectsInt(std::vector<Di
 	// calculate angles and travel/jump distances (before calculating strains)
 	if (!isUsingCachedDiffObjects)
 	{
-		if (cv::osu::stars_xexxar_angles_sliders.getBool())
+		if (cvars->starsXexxarAnglesSliders)
 		{
-			const float starsSliderCurvePointsSeparation = cv::osu::stars_slider_curve_points_separation.getFloat();
+			const float starsSliderCurvePointsSeparation = cvars->starsSliderCurvePointsSeparation;
 			for (size_t i=0; i<numDiffObjects; i++)
 			{
 				if (dead.load())
@@ -448,7 +450,7 @@ double OsuDifficultyCalculator::calculateStarDiffForHitObjectsInt(std::vector<Di
 
 					if (cur.ho->type == OsuDifficultyHitObject::TYPE::SLIDER)
 					{
-						DistanceCalc::computeSliderCursorPosition(cur, circleRadiusInOsuPixels);
+						DistanceCalc::computeSliderCursorPosition(cur, circleRadiusInOsuPixels, *cvars);
 						cur.travelDistance = cur.lazyTravelDist * std::pow(1.0 + (cur.ho->repeats - 1) / 2.5, 1.0 / 2.5);
 						cur.travelTime = std::max(cur.lazyTravelTime, 25.0);
 					}
@@ -457,7 +459,7 @@ double OsuDifficultyCalculator::calculateStarDiffForHitObjectsInt(std::vector<Di
 					if (cur.ho->type == OsuDifficultyHitObject::TYPE::SPINNER || prev1.ho->type == OsuDifficultyHitObject::TYPE::SPINNER)
 						continue;
 
-					const Vector2 lastCursorPosition = DistanceCalc::getEndCursorPosition(prev1, circleRadiusInOsuPixels);
+					const Vector2 lastCursorPosition = DistanceCalc::getEndCursorPosition(prev1, circleRadiusInOsuPixels, *cvars);
 
 					double cur_strain_time = (double)std::max(cur.ho->time - prev1.ho->time, 25l); // strain_time isn't initialized here
 					cur.jumpDistance = (cur.norm_start - lastCursorPosition*radius_scaling_factor).length();
@@ -482,7 +484,7 @@ double OsuDifficultyCalculator::calculateStarDiffForHitObjectsInt(std::vector<Di
 						if (prev2.ho->type == OsuDifficultyHitObject::TYPE::SPINNER)
 							continue;
 
-						const Vector2 lastLastCursorPosition = DistanceCalc::getEndCursorPosition(prev2, circleRadiusInOsuPixels);
+						const Vector2 lastLastCursorPosition = DistanceCalc::getEndCursorPosition(prev2, circleRadiusInOsuPixels, *cvars);
 
 						// MCKAY:
 						{
@@ -510,17 +512,17 @@ double OsuDifficultyCalculator::calculateStarDiffForHitObjectsInt(std::vector<Di
 	}
 
 	// calculate strains/skills
-	if (!isUsingCachedDiffObjects || cv::osu::stars_always_recalc_live_strains.getBool()) // NOTE: yes, this loses some extremely minor accuracy (~0.001 stars territory) for live star/pp for some rare individual upToObjectIndex due to not being recomputed for the cut set of cached diffObjects every time, but the performance gain is so insane I don't care
+	if (!isUsingCachedDiffObjects || cvars->starsAlwaysRecalcLiveStrains) // NOTE: yes, this loses some extremely minor accuracy (~0.001 stars territory) for live star/pp for some rare individual upToObjectIndex due to not being recomputed for the cut set of cached diffObjects every time, but the performance gain is so insane I don't care
 	{
-		bool autopilotNerf = !cv::osu::stars_and_pp_lazer_relax_autopilot_nerf_disabled.getBool() && autopilot;
+		bool autopilotNerf = !cvars->starsAndPPLazerRelaxAutopilotNerfDisabled && autopilot;
 		for (size_t i=1; i<numDiffObjects; i++) // NOTE: start at 1
 		{
-			diffObjects[i].calculate_strains(diffObjects[i - 1], (i == numDiffObjects - 1) ? nullptr : &diffObjects[i + 1], hitWindow300, autopilotNerf);
+			diffObjects[i].calculate_strains(diffObjects[i - 1], (i == numDiffObjects - 1) ? nullptr : &diffObjects[i + 1], hitWindow300, autopilotNerf, cvars->starsXexxarAnglesSliders);
 		}
 	}
 
 	// calculate final difficulty (weigh strains)
-	double aimNoSliders = cv::osu::stars_xexxar_angles_sliders.getBool() ? DiffObject::calculate_difficulty(Skills::Skill::AIM_NO_SLIDERS, diffObjects, numDiffObjects, incremental ? &incremental[(size_t)Skills::Skill::AIM_NO_SLIDERS] : NULL) : 0.0;
+	double aimNoSliders = cvars->starsXexxarAnglesSliders ? DiffObject::calculate_difficulty(Skills::Skill::AIM_NO_SLIDERS, diffObjects, numDiffObjects, incremental ? &incremental[(size_t)Skills::Skill::AIM_NO_SLIDERS] : NULL) : 0.0;
 	*aim = DiffObject::calculate_difficulty(Skills::Skill::AIM_SLIDERS, diffObjects, numDiffObjects, incremental ? &incremental[(size_t)Skills::Skill::AIM_SLIDERS] : NULL, outAimStrains, difficultAimStrains, aimDifficultSliders);
 	*speed = DiffObject::calculate_difficulty(Skills::Skill::SPEED, diffObjects, numDiffObjects, incremental ? &incremental[(size_t)Skills::Skill::SPEED] : NULL, outSpeedStrains, difficultSpeedStrains, speedNotes);
 
@@ -530,12 +532,12 @@ double OsuDifficultyCalculator::calculateStarDiffForHitObjectsInt(std::vector<Di
 	*aim = std::sqrt(*aim) * star_scaling_factor;
 	*speed = std::sqrt(*speed) * star_scaling_factor;
 
-	*aimSliderFactor = (*aim > 0 && cv::osu::stars_xexxar_angles_sliders.getBool()) ? aimNoSliders / *aim : 1.0;
+	*aimSliderFactor = (*aim > 0 && cvars->starsXexxarAnglesSliders) ? aimNoSliders / *aim : 1.0;
 
 	if (touchDevice)
 		*aim = std::pow(*aim, 0.8);
 
-	if (!cv::osu::stars_and_pp_lazer_relax_autopilot_nerf_disabled.getBool())
+	if (!cvars->starsAndPPLazerRelaxAutopilotNerfDisabled)
 	{
 		if (relax)
 		{
@@ -1143,15 +1145,15 @@ OsuDifficultyCalculator::DiffObject::DiffObject(OsuDifficultyHitObject *base_obj
 	prevObjectIndex = prevObjectIdx;
 }
 
-void OsuDifficultyCalculator::DiffObject::calculate_strains(const DiffObject &prev, const DiffObject *next, double hitWindow300, bool autopilotNerf)
+void OsuDifficultyCalculator::DiffObject::calculate_strains(const DiffObject &prev, const DiffObject *next, double hitWindow300, bool autopilotNerf, bool xexxarAnglesSliders)
 {
-	calculate_strain(prev, next, hitWindow300, autopilotNerf, Skills::Skill::SPEED);
-	calculate_strain(prev, next, hitWindow300, autopilotNerf, Skills::Skill::AIM_SLIDERS);
-	if (cv::osu::stars_xexxar_angles_sliders.getBool())
-		calculate_strain(prev, next, hitWindow300, autopilotNerf, Skills::Skill::AIM_NO_SLIDERS);
+	calculate_strain(prev, next, hitWindow300, autopilotNerf, xexxarAnglesSliders, Skills::Skill::SPEED);
+	calculate_strain(prev, next, hitWindow300, autopilotNerf, xexxarAnglesSliders, Skills::Skill::AIM_SLIDERS);
+	if (xexxarAnglesSliders)
+		calculate_strain(prev, next, hitWindow300, autopilotNerf, xexxarAnglesSliders, Skills::Skill::AIM_NO_SLIDERS);
 }
 
-void OsuDifficultyCalculator::DiffObject::calculate_strain(const DiffObject &prev, const DiffObject *next, double hitWindow300, bool autopilotNerf, const Skills::Skill dtype)
+void OsuDifficultyCalculator::DiffObject::calculate_strain(const DiffObject &prev, const DiffObject *next, double hitWindow300, bool autopilotNerf, bool xexxarAnglesSliders, const Skills::Skill dtype)
 {
 	double currentStrainOfDiffObject = 0;
 
@@ -1166,7 +1168,7 @@ void OsuDifficultyCalculator::DiffObject::calculate_strain(const DiffObject &pre
 		case OsuDifficultyHitObject::TYPE::SLIDER:
 		case OsuDifficultyHitObject::TYPE::CIRCLE:
 
-			if (!cv::osu::stars_xexxar_angles_sliders.getBool())
+			if (!xexxarAnglesSliders)
 				currentStrainOfDiffObject = spacing_weight1((norm_start - prev.norm_start).length(), dtype);
 			else
 				currentStrainOfDiffObject = spacing_weight2(dtype, prev, next, hitWindow300, autopilotNerf);
@@ -1181,7 +1183,7 @@ void OsuDifficultyCalculator::DiffObject::calculate_strain(const DiffObject &pre
 			return;
 	}
 
-	if (!cv::osu::stars_xexxar_angles_sliders.getBool())
+	if (!xexxarAnglesSliders)
 		currentStrainOfDiffObject /= (double)std::max(time_elapsed, (long)50); // this has been removed, see https://github.com/Francesco149/oppai-ng/commit/5a1787ec0bd91b2bf686964b154228c68a99bf73
 
 	// see Process() @ https://github.com/ppy/osu/blob/master/osu.Game/Rulesets/Difficulty/Skills/Skill.cs
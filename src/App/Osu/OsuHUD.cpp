@@ -723,6 +723,16 @@ void OsuHUD::drawCursorTrailInt(Shader *trailShader, std::vector<CURSORTRAIL> &t
 		if (smoothCursorTrail)
 			m_cursorTrailVAO->empty();
 
+		// for the player's own cursor, also add everything the mouse moved through since the previous frame (the last sample is pos itself)
+		if (&trail == &m_cursorTrail && !emptyTrailFrame && pos == mouse->getPos())
+		{
+			const std::vector<Mouse::MOTION_SAMPLE> &samples = mouse->getMotionSamples();
+			for (size_t i=0; i+1<samples.size(); i++)
+			{
+				addCursorTrailPosition(trail, samples[i].pos);
+			}
+		}
+
 		// add the sample for the current frame
 		addCursorTrailPosition(trail, pos, emptyTrailFrame);
 
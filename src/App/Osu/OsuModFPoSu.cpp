@@ -367,9 +367,10 @@ void OsuModFPoSu::draw()
 							g->setBlending(true);
 							{
 #if defined(MCENGINE_FEATURE_OPENGL) || defined(MCENGINE_FEATURE_GLES32) || defined(MCENGINE_FEATURE_GL3)
-								if constexpr (Env::cfg(REND::GL | REND::GLES32 | REND::GL3))
+								if (Env::cfg(REND::GL | REND::GLES32 | REND::GL3) && !g->isNullRenderer())
 								{
 									// HACKHACK: OpenGL hardcoded
+									g->flushBatch();
 									glBlendFunc(GL_ONE_MINUS_DST_ALPHA, GL_DST_ALPHA);
 									glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_FALSE);
 								}
@@ -435,9 +436,10 @@ void OsuModFPoSu::draw()
 								}
 
 #if defined(MCENGINE_FEATURE_OPENGL) || defined(MCENGINE_FEATURE_GLES32) || defined(MCENGINE_FEATURE_GL3)
-								if constexpr (Env::cfg(REND::GL | REND::GLES32 | REND::GL3))
+								if (Env::cfg(REND::GL | REND::GLES32 | REND::GL3) && !g->isNullRenderer())
 								{
 									// HACKHACK: OpenGL hardcoded
+									g->flushBatch();
 									glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 									glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
 								}
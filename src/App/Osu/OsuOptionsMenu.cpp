@@ -499,6 +499,7 @@ OsuOptionsMenu::OsuOptionsMenu()
 	m_options->setDrawBackground(true);
 	m_options->setBackgroundColor(0xdd000000);
 	m_options->setHorizontalScrolling(false);
+	m_options->setCulling(true); // hundreds of elements
 	m_container->addBaseUIElement(m_options);
 
 	m_categories = new CBaseUIScrollView(0, -1, 0, 0, "");
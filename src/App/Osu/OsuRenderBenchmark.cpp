@@ -0,0 +1,344 @@
+//================ Copyright (c) 2025, WH, All rights reserved. =================//
+//
+// Purpose:		renders representative screens back to back and reports cpu frame times
+//
+// $NoKeywords: $osubench
+//===============================================================================//
+
+#include "OsuRenderBenchmark.h"
+
+#include "Engine.h"
+#include "Environment.h"
+#include "ConVar.h"
+#include "Timing.h"
+#include "NullGraphicsInterface.h"
+
+#include "Osu.h"
+#include "OsuBeatmap.h"
+#include "OsuDatabase.h"
+#include "OsuDatabaseBeatmap.h"
+#include "OsuMainMenu.h"
+#include "OsuModSelector.h"
+#include "OsuNotificationOverlay.h"
+#include "OsuSongBrowser2.h"
+
+#include <algorithm>
+#include <array>
+
+namespace cv::osu {
+ConVar bench_render("osu_bench_render");
+ConVar bench_render_frames("osu_bench_render_frames", 300, FCVAR_NONE, "number of frames measured per screen by osu_bench_render (main menu, song browser, gameplay)");
+ConVar bench_render_settle_updates("osu_bench_render_settle_updates", 120, FCVAR_NONE, "number of normal update ticks to let animations settle before measuring a screen");
+ConVar bench_render_beatmap("osu_bench_render_beatmap", "", FCVAR_NONE, "md5 hash of the beatmap difficulty played by osu_bench_render, empty = the first one by file path (so that results stay comparable)");
+}
+
+// where to seek to for the gameplay measurements, in percent of the playable length
+static constexpr std::array<double, 3> GAMEPLAY_POSITIONS{0.25, 0.5, 0.75};
+
+// how long to wait for the database or a beatmap to load before giving up, in update ticks
+static constexpr int LOADING_TIMEOUT_UPDATES = 60 * 60;
+
+OsuRenderBenchmark::OsuRenderBenchmark()
+{
+	m_state = STATE::IDLE;
+	m_iWaitUpdates = 0;
+	m_iTimeoutUpdates = 0;
+	m_iGameplayPosition = 0;
+	m_bQuitWhenDone = false;
+	m_bMeasuring = false;
+
+	cv::osu::bench_render.setCallback(SA::MakeDelegate<&OsuRenderBenchmark::start>(this));
+
+	// (the main menu is already the active screen at startup, and the screens don't exist yet at this point)
+	if (env->getLaunchArgs().contains("-benchrender"))
+	{
+		m_bQuitWhenDone = true;
+		setState(STATE::MAINMENU, cv::osu::bench_render_settle_updates.getInt());
+	}
+}
+
+void OsuRenderBenchmark::start()
+{
+	if (isRunning())
+		return;
+
+	if (osu->isInPlayMode())
+	{
+		osu->getNotificationOverlay()->addNotification("Can't benchmark while playing.");
+		return;
+	}
+
+	debugLog("OsuRenderBenchmark: Starting ({:d} frames per screen) ...\n", cv::osu::bench_render_frames.getInt());
+
+	m_results.clear();
+	m_sBeatmapName.clear();
+
+	// always start from the main menu
+	if (osu->getSongBrowser()->isVisible())
+		osu->toggleSongBrowser();
+
+	setState(STATE::MAINMENU, cv::osu::bench_render_settle_updates.getInt());
+}
+
+void OsuRenderBenchmark::update()
+{
+	if (!isRunning())
+		return;
+
+	if (m_iWaitUpdates > 0)
+	{
+		m_iWaitUpdates--;
+		return;
+	}
+
+	switch (m_state)
+	{
+	case STATE::IDLE:
+		break;
+
+	case STATE::MAINMENU:
+		if (!measure("main menu"))
+			break;
+
+		osu->toggleSongBrowser();
+		setState(STATE::SONGBROWSER, 0);
+		break;
+
+	case STATE::SONGBROWSER:
+		// wait for the database, the song browser is only representative with all beatmaps loaded
+		if (!osu->getSongBrowser()->getDatabase()->isFinished())
+		{
+			if (--m_iTimeoutUpdates < 0)
+			{
+				debugLog("OsuRenderBenchmark: Timed out waiting for the database, skipping song browser and gameplay.\n");
+				setState(STATE::DONE, 0);
+			}
+			break;
+		}
+
+		// (let the carousel settle first)
+		if (m_iTimeoutUpdates >= 0)
+		{
+			m_iTimeoutUpdates = -1;
+			m_iWaitUpdates = cv::osu::bench_render_settle_updates.getInt();
+			break;
+		}
+
+		if (!measure("song browser"))
+			break;
+
+		if (osu->getSongBrowser()->getDatabase()->getDatabaseBeatmaps().size() < 1)
+		{
+			debugLog("OsuRenderBenchmark: No beatmaps available, skipping gameplay.\n");
+			setState(STATE::DONE, 0);
+			break;
+		}
+
+		{
+			OsuDatabaseBeatmap *diff2 = getBenchmarkBeatmap();
+			if (diff2 == NULL)
+			{
+				debugLog("OsuRenderBenchmark: Beatmap {:s} not found, skipping gameplay.\n", cv::osu::bench_render_beatmap.getString().toUtf8());
+				setState(STATE::DONE, 0);
+				break;
+			}
+
+			m_sBeatmapName = UString::fmt("{:s} - {:s} [{:s}] ({:s})", diff2->getArtist().toUtf8(), diff2->getTitle().toUtf8(), diff2->getDifficultyName().toUtf8(), diff2->getMD5Hash());
+			debugLog("OsuRenderBenchmark: Playing {:s}\n", m_sBeatmapName.toUtf8());
+
+			osu->getModSelector()->enableAuto();
+			osu->getSongBrowser()->onDifficultySelected(diff2, true);
+			setState(STATE::GAMEPLAY_LOADING, 0);
+		}
+		break;
+
+	case STATE::GAMEPLAY_LOADING:
+		{
+			OsuBeatmap *beatmap = osu->getSelectedBeatmap();
+			if (!osu->isInPlayMode() || beatmap == NULL || !beatmap->isPlaying() || beatmap->isLoading())
+			{
+				if (--m_iTimeoutUpdates < 0)
+				{
+					debugLog("OsuRenderBenchmark: Timed out waiting for the beatmap to start, skipping gameplay.\n");
+					setState(STATE::DONE, 0);
+				}
+				break;
+			}
+
+			m_iGameplayPosition = 0;
+			beatmap->seekPercentPlayable(GAMEPLAY_POSITIONS[m_iGameplayPosition]);
+			setState(STATE::GAMEPLAY, cv::osu::bench_render_settle_updates.getInt());
+		}
+		break;
+
+	case STATE::GAMEPLAY:
+		{
+			OsuBeatmap *beatmap = osu->getSelectedBeatmap();
+			if (!osu->isInPlayMode() || beatmap == NULL)
+			{
+				debugLog("OsuRenderBenchmark: Gameplay ended unexpectedly, skipping the rest.\n");
+				setState(STATE::DONE, 0);
+				break;
+			}
+
+			if (!measure(UString::fmt("gameplay @ {:d}%", static_cast<int>(GAMEPLAY_POSITIONS[m_iGameplayPosition] * 100.0))))
+				break;
+
+			if (++m_iGameplayPosition < GAMEPLAY_POSITIONS.size())
+			{
+				beatmap->seekPercentPlayable(GAMEPLAY_POSITIONS[m_iGameplayPosition]);
+				m_iWaitUpdates = cv::osu::bench_render_settle_updates.getInt();
+			}
+			else
+			{
+				beatmap->stop();
+				setState(STATE::DONE, 0);
+			}
+		}
+		break;
+
+	case STATE::DONE:
+		finish();
+		break;
+	}
+}
+
+OsuDatabaseBeatmap *OsuRenderBenchmark::getBenchmarkBeatmap() const
+{
+	OsuDatabase *db = osu->getSongBrowser()->getDatabase();
+
+	const UString md5hash = cv::osu::bench_render_beatmap.getString();
+	if (md5hash.length() > 0)
+		return db->getBeatmapDifficulty(std::string(md5hash.toUtf8()));
+
+	// (independent of database order and random seeds)
+	OsuDatabaseBeatmap *firstDiff2 = NULL;
+	for (const OsuDatabaseBeatmap *beatmap : db->getDatabaseBeatmaps())
+	{
+		for (OsuDatabaseBeatmap *diff2 : beatmap->getDifficulties())
+		{
+			if (firstDiff2 == NULL || diff2->getFilePath() < firstDiff2->getFilePath())
+				firstDiff2 = diff2;
+		}
+	}
+	return firstDiff2;
+}
+
+void OsuRenderBenchmark::setState(STATE state, int waitUpdates)
+{
+	m_state = state;
+	m_iWaitUpdates = waitUpdates;
+	m_iTimeoutUpdates = LOADING_TIMEOUT_UPDATES;
+}
+
+bool OsuRenderBenchmark::measure(const UString &name)
+{
+	auto *nullg = g->isNullRenderer() ? static_cast<NullGraphicsInterface *>(g.get()) : nullptr;
+
+	// the frames are painted by the normal main loop, with updates skipped until they are done
+	if (!m_bMeasuring)
+	{
+		const int numFrames = std::max(cv::osu::bench_render_frames.getInt(), 1);
+
+		m_bMeasuring = true;
+		m_frameTimesMS.clear();
+		m_frameTimesMS.reserve(numFrames);
+
+		if (nullg != nullptr)
+			nullg->resetStats();
+
+		engine->requestPaintOnlyFrames(numFrames, SA::MakeDelegate<&OsuRenderBenchmark::onMeasuredFrame>(this));
+		return false;
+	}
+
+	m_bMeasuring = false;
+
+	// (the engine stops early when minimized)
+	if (m_frameTimesMS.empty())
+	{
+		debugLog("OsuRenderBenchmark: No frames painted for \"{:s}\", skipping.\n", name.toUtf8());
+		return true;
+	}
+
+	std::vector<double> &frameTimesMS = m_frameTimesMS;
+	const int numFrames = static_cast<int>(frameTimesMS.size());
+
+	RESULT result{};
+	result.name = name;
+	result.numFrames = numFrames;
+
+	double sumMS = 0.0;
+	for (const double frameTimeMS : frameTimesMS)
+	{
+		sumMS += frameTimeMS;
+	}
+	result.avgMS = sumMS / numFrames;
+
+	std::ranges::sort(frameTimesMS);
+	result.medianMS = frameTimesMS[numFrames / 2];
+	result.p99MS = frameTimesMS[std::min(static_cast<int>(numFrames * 0.99), numFrames - 1)];
+	result.maxMS = frameTimesMS.back();
+
+	// the stats are rotated at the beginning of a frame, so this is the second to last frame (which drew the same state)
+	result.numDrawCalls = g->getDrawStats().numDrawCalls;
+	result.numBatchedImages = g->getDrawStats().numBatchedImages;
+	result.numBatchFlushes = g->getDrawStats().numBatchFlushes;
+
+	result.hasCommandStats = (nullg != nullptr);
+	if (nullg != nullptr)
+	{
+		using CMD = NullGraphicsInterface::CMD;
+		const NullGraphicsInterface::STATS &stats = nullg->getStats();
+
+		uint64_t numCommands = 0;
+		for (const uint64_t count : stats.numCommands)
+		{
+			numCommands += count;
+		}
+
+		const uint64_t numStateChanges = stats.get(CMD::SET_STATE) + stats.get(CMD::SET_CLIPRECT) + stats.get(CMD::STENCIL) + stats.get(CMD::BIND_TEXTURE) +
+		                                 stats.get(CMD::BIND_SHADER) + stats.get(CMD::BIND_RENDERTARGET);
+
+		const double frames = static_cast<double>(std::max<uint64_t>(stats.numFrames, 1));
+		result.numCommands = numCommands / frames;
+		result.numVertices = stats.numVertices / frames;
+		result.numStateChanges = numStateChanges / frames;
+	}
+
+	debugLog("OsuRenderBenchmark: Measured \"{:s}\": avg = {:.3f} ms\n", result.name.toUtf8(), result.avgMS);
+
+	m_results.push_back(std::move(result));
+
+	return true;
+}
+
+void OsuRenderBenchmark::onMeasuredFrame(uint64_t paintTimeNS)
+{
+	m_frameTimesMS.push_back(static_cast<double>(paintTimeNS) / static_cast<double>(Timing::NS_PER_MS));
+}
+
+void OsuRenderBenchmark::finish()
+{
+	m_state = STATE::IDLE;
+
+	debugLog("\nOsuRenderBenchmark: Results ({:s}, {:d}x{:d}):\n", g->getModel().toUtf8(), (int)g->getResolution().x, (int)g->getResolution().y);
+	debugLog("{:<18s} {:>8s} {:>8s} {:>8s} {:>8s} | {:>6s} {:>8s} {:>8s} | {:>9s} {:>10s} {:>8s}\n", "screen", "avg ms", "med ms", "p99 ms", "max ms", "draws", "batched",
+	         "batches", "commands", "vertices", "states");
+	for (const RESULT &result : m_results)
+	{
+		if (result.hasCommandStats)
+			debugLog("{:<18s} {:>8.3f} {:>8.3f} {:>8.3f} {:>8.3f} | {:>6d} {:>8d} {:>8d} | {:>9.1f} {:>10.1f} {:>8.1f}\n", result.name.toUtf8(), result.avgMS, result.medianMS, result.p99MS,
+			         result.maxMS, result.numDrawCalls, result.numBatchedImages, result.numBatchFlushes, result.numCommands, result.numVertices, result.numStateChanges);
+		else
+			debugLog("{:<18s} {:>8.3f} {:>8.3f} {:>8.3f} {:>8.3f} | {:>6d} {:>8d} {:>8d} | {:>9s} {:>10s} {:>8s}\n", result.name.toUtf8(), result.avgMS, result.medianMS, result.p99MS,
+			         result.maxMS, result.numDrawCalls, result.numBatchedImages, result.numBatchFlushes, "-", "-", "-");
+	}
+	if (m_sBeatmapName.length() > 0)
+		debugLog("(gameplay: {:s})\n", m_sBeatmapName.toUtf8());
+	debugLog("\n");
+
+	if (m_bQuitWhenDone)
+		engine->shutdown();
+	else
+		osu->getNotificationOverlay()->addNotification("Render benchmark finished, see console/log for results.");
+}
@@ -0,0 +1,83 @@
+//================ Copyright (c) 2025, WH, All rights reserved. =================//
+//
+// Purpose:		renders representative screens back to back and reports cpu frame times
+//
+// $NoKeywords: $osubench
+//===============================================================================//
+
+#pragma once
+#ifndef OSURENDERBENCHMARK_H
+#define OSURENDERBENCHMARK_H
+
+#include "cbase.h"
+
+class OsuDatabaseBeatmap;
+
+// Walks through main menu, song browser and gameplay (autoplay, at fixed positions of osu_bench_render_beatmap),
+// lets each screen settle for a few updates and then has the engine paint a number of frames without updating
+// in between (see Engine::requestPaintOnlyFrames()), so every measured frame draws exactly the same state.
+// Most useful together with the null renderer ("-nullgfx"), which also reports command/vertex counts.
+// Started with osu_bench_render, or with the "-benchrender" launch argument (which quits when done).
+class OsuRenderBenchmark
+{
+public:
+	OsuRenderBenchmark();
+
+	void start();
+	void update(); // called by Osu::update()
+
+	[[nodiscard]] inline bool isRunning() const {return m_state != STATE::IDLE;}
+
+private:
+	enum class STATE : uint8_t
+	{
+		IDLE,
+		MAINMENU,
+		SONGBROWSER,
+		GAMEPLAY_LOADING,
+		GAMEPLAY,
+		DONE
+	};
+
+	struct RESULT
+	{
+		UString name;
+		int numFrames;
+
+		double avgMS;
+		double medianMS;
+		double p99MS;
+		double maxMS;
+
+		// of the last measured frame
+		uint32_t numDrawCalls;
+		uint32_t numBatchedImages;
+		uint32_t numBatchFlushes;
+
+		// per frame averages, only available with the null renderer
+		bool hasCommandStats;
+		double numCommands;
+		double numVertices;
+		double numStateChanges;
+	};
+
+	[[nodiscard]] OsuDatabaseBeatmap *getBenchmarkBeatmap() const;
+	void setState(STATE state, int waitUpdates);
+	bool measure(const UString &name); // returns true once the measured frames have been painted
+	void onMeasuredFrame(uint64_t paintTimeNS);
+	void finish();
+
+	STATE m_state;
+	int m_iWaitUpdates;
+	int m_iTimeoutUpdates;
+	size_t m_iGameplayPosition;
+	bool m_bQuitWhenDone;
+
+	bool m_bMeasuring;
+	std::vector<double> m_frameTimesMS;
+
+	std::vector<RESULT> m_results;
+	UString m_sBeatmapName;
+};
+
+#endif
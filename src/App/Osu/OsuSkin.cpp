@@ -14,6 +14,7 @@
 #include "SteamworksInterface.h"
 #include "ConVar.h"
 #include "File.h"
+#include "JobSystem.h"
 
 #include "Osu.h"
 #include "OsuSkinImage.h"
@@ -347,10 +348,14 @@ void OsuSkin::update()
 
 	const bool useEngineTimeForAnimations = !osu->isInPlayMode();
 	const long curMusicPos = osu->getSelectedBeatmap() != NULL ? osu->getSelectedBeatmap()->getCurMusicPosWithOffsets() : 0;
-	for (int i=0; i<m_images.size(); i++)
-	{
-		m_images[i]->update(useEngineTimeForAnimations, curMusicPos);
-	}
+
+	// (every image only advances its own animation frame counters)
+	jobSystem->parallelFor("OsuSkin::updateImages", m_images.size(), 64, [&](size_t begin, size_t end) -> void {
+		for (size_t i=begin; i<end; i++)
+		{
+			m_images[i]->update(useEngineTimeForAnimations, curMusicPos);
+		}
+	});
 }
 
 void OsuSkin::onJustBeforeReady()
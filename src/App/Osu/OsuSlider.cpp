@@ -23,6 +23,7 @@
 #include "RenderTarget.h"
 
 #include "Osu.h"
+#include "OsuConVarSnapshot.h"
 #include "OsuCircle.h"
 #include "OsuSkin.h"
 #include "OsuSkinImage.h"
@@ -41,6 +42,7 @@ ConVar slider_end_inside_check_offset("osu_slider_end_inside_check_offset", 36,
 ConVar slider_end_miss_breaks_combo("osu_slider_end_miss_breaks_combo", false, FCVAR_NONE, "should a missed sliderend break combo (aka cause a regular sliderbreak)");
 ConVar slider_break_epilepsy("osu_slider_break_epilepsy", false, FCVAR_NONE);
 ConVar slider_scorev2("osu_slider_scorev2", false, FCVAR_NONE);
+ConVar slider_follow_cursor_samples("osu_slider_follow_cursor_samples", true, FCVAR_NONE, "check repeats/ticks against where the cursor was at their exact time (from all mouse motion of the frame), instead of where it is at the end of the frame");
 
 ConVar slider_draw_body("osu_slider_draw_body", true, FCVAR_NONE);
 ConVar slider_shrink("osu_slider_shrink", false, FCVAR_NONE);
@@ -304,12 +306,12 @@ void OsuSlider::draw()
 				{
 					/*Vector2 pos = m_beatmap->osuCoords2Pixels(m_curve->pointAt(sliderSnake));*/ // osu doesn't snake the reverse arrow
 					Vector2 pos = m_beatmap->osuCoords2Pixels(m_curve->pointAt(1.0f));
-					float rotation = m_curve->getEndAngle() - cv::osu::playfield_rotation.getFloat() - m_beatmap->getPlayfieldRotation();
+					float rotation = m_curve->getEndAngle() - OsuConVarSnapshot::get().playfieldRotation - m_beatmap->getPlayfieldRotation();
 					if (osu->getModHR())
 						rotation = 360.0f - rotation;
-					if (cv::osu::playfield_mirror_horizontal.getBool())
+					if (OsuConVarSnapshot::get().playfieldMirrorHorizontal)
 						rotation = 360.0f - rotation;
-					if (cv::osu::playfield_mirror_vertical.getBool())
+					if (OsuConVarSnapshot::get().playfieldMirrorVertical)
 						rotation = 180.0f - rotation;
 
 					const float osuCoordScaleMultiplier = m_beatmap->getHitcircleDiameter() / m_beatmap->getRawHitcircleDiameter();
@@ -333,12 +335,12 @@ void OsuSlider::draw()
 				if (m_iReverseArrowPos == 1 || m_iReverseArrowPos == 3)
 				{
 					Vector2 pos = m_beatmap->osuCoords2Pixels(m_curve->pointAt(0.0f));
-					float rotation = m_curve->getStartAngle() - cv::osu::playfield_rotation.getFloat() - m_beatmap->getPlayfieldRotation();
+					float rotation = m_curve->getStartAngle() - OsuConVarSnapshot::get().playfieldRotation - m_beatmap->getPlayfieldRotation();
 					if (osu->getModHR())
 						rotation = 360.0f - rotation;
-					if (cv::osu::playfield_mirror_horizontal.getBool())
+					if (OsuConVarSnapshot::get().playfieldMirrorHorizontal)
 						rotation = 360.0f - rotation;
-					if (cv::osu::playfield_mirror_vertical.getBool())
+					if (OsuConVarSnapshot::get().playfieldMirrorVertical)
 						rotation = 180.0f - rotation;
 
 					const float osuCoordScaleMultiplier = m_beatmap->getHitcircleDiameter() / m_beatmap->getRawHitcircleDiameter();
@@ -385,7 +387,8 @@ void OsuSlider::draw()
 
 		g->pushTransform();
 		{
-			g->scale((1.0f + scale*cv::osu::stdrules::circle_fade_out_scale.getFloat()), (1.0f + scale*cv::osu::stdrules::circle_fade_out_scale.getFloat()));
+			const float fadeOutScale = 1.0f + scale*OsuConVarSnapshot::get().circleFadeOutScale;
+			g->scale(fadeOutScale, fadeOutScale);
 			if (m_iCurRepeat < 1)
 			{
 				m_beatmap->getSkin()->getHitCircleOverlay2()->setAnimationTimeOffset(!m_beatmap->isInMafhamRenderChunk() ? m_iTime - m_iApproachTime : m_beatmap->getCurMusicPosWithOffsets());
@@ -413,7 +416,8 @@ void OsuSlider::draw()
 
 		g->pushTransform();
 		{
-			g->scale((1.0f + scale*cv::osu::stdrules::circle_fade_out_scale.getFloat()), (1.0f + scale*cv::osu::stdrules::circle_fade_out_scale.getFloat()));
+			const float fadeOutScale = 1.0f + scale*OsuConVarSnapshot::get().circleFadeOutScale;
+			g->scale(fadeOutScale, fadeOutScale);
 			{
 				m_beatmap->getSkin()->getHitCircleOverlay2()->setAnimationTimeOffset(!m_beatmap->isInMafhamRenderChunk() ? m_iTime - m_iFadeInTime : m_beatmap->getCurMusicPosWithOffsets());
 				m_beatmap->getSkin()->getSliderEndCircleOverlay2()->setAnimationTimeOffset(!m_beatmap->isInMafhamRenderChunk() ? m_iTime - m_iFadeInTime : m_beatmap->getCurMusicPosWithOffsets());
@@ -683,12 +687,12 @@ void OsuSlider::draw3D()
 				if (m_iReverseArrowPos == 2 || m_iReverseArrowPos == 3)
 				{
 					Vector3 pos = m_beatmap->osuCoordsTo3D(m_curve->pointAt(1.0f), this);
-					float rotation = m_curve->getEndAngle() - cv::osu::playfield_rotation.getFloat() - m_beatmap->getPlayfieldRotation();
+					float rotation = m_curve->getEndAngle() - OsuConVarSnapshot::get().playfieldRotation - m_beatmap->getPlayfieldRotation();
 					if (osu->getModHR())
 						rotation = 360.0f - rotation;
-					if (cv::osu::playfield_mirror_horizontal.getBool())
+					if (OsuConVarSnapshot::get().playfieldMirrorHorizontal)
 						rotation = 360.0f - rotation;
-					if (cv::osu::playfield_mirror_vertical.getBool())
+					if (OsuConVarSnapshot::get().playfieldMirrorVertical)
 						rotation = 180.0f - rotation;
 
 					float reverseArrowImageScale = skin->getReverseArrow()->getSize().x / (128.0f * (skin->isReverseArrow2x() ? 2.0f : 1.0f));
@@ -730,12 +734,12 @@ void OsuSlider::draw3D()
 				if (m_iReverseArrowPos == 1 || m_iReverseArrowPos == 3)
 				{
 					Vector3 pos = m_beatmap->osuCoordsTo3D(m_curve->pointAt(0.0f), this);
-					float rotation = m_curve->getStartAngle() - cv::osu::playfield_rotation.getFloat() - m_beatmap->getPlayfieldRotation();
+					float rotation = m_curve->getStartAngle() - OsuConVarSnapshot::get().playfieldRotation - m_beatmap->getPlayfieldRotation();
 					if (osu->getModHR())
 						rotation = 360.0f - rotation;
-					if (cv::osu::playfield_mirror_horizontal.getBool())
+					if (OsuConVarSnapshot::get().playfieldMirrorHorizontal)
 						rotation = 360.0f - rotation;
-					if (cv::osu::playfield_mirror_vertical.getBool())
+					if (OsuConVarSnapshot::get().playfieldMirrorVertical)
 						rotation = 180.0f - rotation;
 
 					float reverseArrowImageScale = skin->getReverseArrow()->getSize().x / (128.0f * (skin->isReverseArrow2x() ? 2.0f : 1.0f));
@@ -805,7 +809,7 @@ void OsuSlider::draw3D()
 			Matrix4 baseScale;
 			baseScale.scale(m_beatmap->getRawHitcircleDiameter() * OsuModFPoSu::SIZEDIV3D);
 			baseScale.scale(osu->getFPoSu()->get3DPlayfieldScale());
-			baseScale.scale((1.0f + scale*cv::osu::stdrules::circle_fade_out_scale.getFloat()));
+			baseScale.scale((1.0f + scale*OsuConVarSnapshot::get().circleFadeOutScale));
 
 			if (m_iCurRepeat < 1)
 			{
@@ -833,7 +837,7 @@ void OsuSlider::draw3D()
 			Matrix4 baseScale;
 			baseScale.scale(m_beatmap->getRawHitcircleDiameter() * OsuModFPoSu::SIZEDIV3D);
 			baseScale.scale(osu->getFPoSu()->get3DPlayfieldScale());
-			baseScale.scale((1.0f + scale*cv::osu::stdrules::circle_fade_out_scale.getFloat()));
+			baseScale.scale((1.0f + scale*OsuConVarSnapshot::get().circleFadeOutScale));
 
 			m_beatmap->getSkin()->getHitCircleOverlay2()->setAnimationTimeOffset(!m_beatmap->isInMafhamRenderChunk() ? m_iTime - m_iFadeInTime : m_beatmap->getCurMusicPosWithOffsets());
 			m_beatmap->getSkin()->getSliderEndCircleOverlay2()->setAnimationTimeOffset(!m_beatmap->isInMafhamRenderChunk() ? m_iTime - m_iFadeInTime : m_beatmap->getCurMusicPosWithOffsets());
@@ -1312,7 +1316,12 @@ void OsuSlider::update(long curPos)
 			if (!m_clicks[i].finished && curPos >= m_clicks[i].time)
 			{
 				m_clicks[i].finished = true;
-				m_clicks[i].successful = (isClickHeldSlider() && m_bCursorInside) || osu->getModAuto() || (osu->getModRelax() && m_bCursorInside);
+
+				bool isCursorInside = m_bCursorInside;
+				if (cv::osu::slider_follow_cursor_samples.getBool() && !osu->getModAuto())
+					isCursorInside = ((m_beatmap->getCursorPosAt(m_clicks[i].time) - m_beatmap->osuCoords2Pixels(getRawPosAt(m_clicks[i].time))).length() < followRadius);
+
+				m_clicks[i].successful = (isClickHeldSlider() && isCursorInside) || osu->getModAuto() || (osu->getModRelax() && isCursorInside);
 
 				if (m_clicks[i].type == 0)
 					onRepeatHit(m_clicks[i].successful, m_clicks[i].sliderend);
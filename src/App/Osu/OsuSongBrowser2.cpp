@@ -9,11 +9,14 @@
 #include "OsuSongBrowser2.h"
 
 #include "Engine.h"
+#include "Environment.h"
 #include "ConVar.h"
 #include "ResourceManager.h"
 #include "Keyboard.h"
 #include "Mouse.h"
 #include "Timing.h"
+#include "Profiler.h"
+#include "JobSystem.h"
 #include "SoundEngine.h"
 #include "AnimationHandler.h"
 #include "VertexArrayObject.h"
@@ -36,6 +39,7 @@
 #include "OsuOptionsMenu.h"
 #include "OsuKeyBindings.h"
 #include "OsuRichPresence.h"
+#include "OsuSongBrowserSearch.h"
 
 #include "OsuDatabaseBeatmap.h"
 
@@ -56,6 +60,10 @@
 #include "OsuUIUserStatsScreenLabel.h"
 
 #include <algorithm>
+#include <optional>
+#include <span>
+#include <unordered_map>
+#include <unordered_set>
 #include <utility>
 
 namespace cv::osu {
@@ -77,6 +85,7 @@ ConVar draw_songbrowser_strain_graph("osu_draw_songbrowser_strain_graph", false,
 ConVar songbrowser_scorebrowser_enabled("osu_songbrowser_scorebrowser_enabled", true, FCVAR_NONE);
 ConVar songbrowser_background_fade_in_duration("osu_songbrowser_background_fade_in_duration", 0.1f, FCVAR_NONE);
 
+ConVar songbrowser_search_threads("osu_songbrowser_search_threads", 0, FCVAR_NONE, "maximum number of job system threads used for searching (0 = all)");
 ConVar songbrowser_search_delay("osu_songbrowser_search_delay", 0.5f, FCVAR_NONE, "delay until search update when entering text");
 
 ConVar songbrowser_search_hardcoded_filter("osu_songbrowser_search_hardcoded_filter", "", FCVAR_NONE, "allows forcing the specified search filter to be active all the time",
@@ -87,6 +96,8 @@ ConVar songbrowser_search_hardcoded_filter("osu_songbrowser_search_hardcoded_fil
 ConVar songbrowser_background_star_calculation("osu_songbrowser_background_star_calculation", true, FCVAR_NONE, "precalculate stars for all loaded beatmaps while in songbrowser");
 ConVar songbrowser_dynamic_star_recalc("osu_songbrowser_dynamic_star_recalc", true, FCVAR_NONE, "dynamically recalculate displayed star value of currently selected beatmap in songbrowser");
 
+ConVar songbrowser_prefetch_audio_neighbours("osu_songbrowser_prefetch_audio_neighbours", 2, FCVAR_NONE, "number of song buttons above and below the selection whose audio files are read into memory ahead of time (see snd_prefetch)");
+
 ConVar songbrowser_debug("osu_songbrowser_debug", false, FCVAR_NONE);
 
 ConVar debug_background_star_calc("osu_debug_background_star_calc", false, FCVAR_NONE, "prints the name of the beatmap about to get its stars calculated (cmd/terminal window only, no in-game log!)");
@@ -105,9 +116,23 @@ public:
 	void kill() {m_bDead = true;}
 	void revive() {m_bDead = false;}
 
-	void setSongButtonsAndSearchString(const std::vector<OsuUISongBrowserSongButton*> &songButtons, const UString &searchString, const UString &hardcodedSearchString)
+	// must only be called while dead (and finished), whenever the database beatmaps get deleted
+	void clearIndex()
+	{
+		m_index.clear();
+		m_items.clear();
+		m_itemIndices.clear();
+		m_itemRows.clear();
+		m_activeItems.clear();
+		m_indexedSongButtons.clear();
+		m_previousQuery.reset();
+	}
+
+	// dataRevision must change whenever numeric beatmap data (stars, length, object counts) changes, since matches of expressions then can't be refined anymore
+	void setSongButtonsAndSearchString(const std::vector<OsuUISongBrowserSongButton*> &songButtons, const UString &searchString, const UString &hardcodedSearchString, uint64_t dataRevision)
 	{
 		m_songButtons = songButtons;
+		m_iDataRevision = dataRevision;
 
 		m_sSearchString.clear();
 		if (hardcodedSearchString.length() > 0)
@@ -133,25 +158,50 @@ protected:
 			return;
 		}
 
+		VPROF_TRACE("OsuSongBrowser2::search");
+
+		const OsuSongBrowserSearchQuery query(m_sSearchString, osu->getSpeedMultiplier());
+
+		// the shards only read the index, so everything has to be indexed beforehand
+		if (m_songButtons != m_indexedSongButtons)
+			updateActiveItems();
+		if (query.hasExpressions())
+			m_index.refreshNumericColumns();
+
+		// typing another character (or adding another term) can only remove matches, so only the previous ones have to be checked again
+		// (unless the previous matches depended on numbers which have changed since then)
+		const bool refine = (m_previousQuery.has_value() && query.refines(*m_previousQuery) &&
+		                     (!m_previousQuery->hasExpressions() || m_iDataRevision == m_iPreviousDataRevision));
+		const uint32_t previousSearch = m_iSearch++;
+
 		// flag matches across entire database
-		const std::vector<UString> searchStringTokens = m_sSearchString.split(" ");
-		for (auto & songButton : m_songButtons)
-		{
-			const std::vector<OsuUISongBrowserButton*> &children = songButton->getChildren();
-			if (children.size() > 0)
+		jobSystem->parallelFor("OsuSongBrowser2::searchShards", m_activeItems.size(), getMinItemsPerShard(), [&](size_t begin, size_t end) -> void {
+			for (size_t shardBegin = begin; shardBegin < end; shardBegin += ITEMS_PER_SHARD)
 			{
-				for (auto c : children)
+				// cancellation point
+				if (m_bDead.load())
+					break;
+
+				const size_t shardEnd = std::min(shardBegin + ITEMS_PER_SHARD, end);
+				for (size_t i = shardBegin; i < shardEnd; i++)
 				{
-					c->setIsSearchMatch(OsuSongBrowser2::searchMatcher(c->getDatabaseBeatmap(), searchStringTokens));
+					ITEM &item = m_items[m_activeItems[i]];
+
+					// (items which weren't part of the previous search have to be checked again)
+					const bool couldMatch = (!refine || item.search != previousSearch || item.matches);
+					item.matches = (couldMatch && query.matches(std::span(m_itemRows).subspan(item.rowsBegin, item.rowsEnd - item.rowsBegin), m_index));
+					item.search = m_iSearch;
+					item.button->setIsSearchMatch(item.matches);
 				}
 			}
-			else
-				songButton->setIsSearchMatch(OsuSongBrowser2::searchMatcher(songButton->getDatabaseBeatmap(), searchStringTokens));
+		});
 
-			// cancellation point
-			if (m_bDead.load())
-				break;
-		}
+		// a cancelled search leaves incomplete results behind
+		if (m_bDead.load())
+			m_previousQuery.reset();
+		else
+			m_previousQuery = query;
+		m_iPreviousDataRevision = m_iDataRevision;
 
 		m_bAsyncReady = true;
 	}
@@ -159,11 +209,101 @@ protected:
 	void destroy() override {;}
 
 private:
+	static constexpr size_t ITEMS_PER_SHARD = 512;
+
+	// every button which gets a match flag, with the index rows of its difficulties and the result of the last search it was part of
+	struct ITEM
+	{
+		OsuUISongBrowserButton *button;
+		const OsuDatabaseBeatmap *databaseBeatmap;
+		uint32_t rowsBegin;
+		uint32_t rowsEnd;
+		uint32_t search;
+		bool matches;
+	};
+
+	// a fixed number of search threads is approximated by not splitting into more batches than that
+	[[nodiscard]] size_t getMinItemsPerShard() const
+	{
+		const auto numThreads = static_cast<size_t>(std::max(cv::osu::songbrowser_search_threads.getInt(), 0));
+		return (numThreads > 0 ? std::max(ITEMS_PER_SHARD, (m_activeItems.size() + numThreads - 1) / numThreads) : ITEMS_PER_SHARD);
+	}
+
+	// items are keyed by button, so re-sorting/regrouping only has to look them up again (and keeps their previous results)
+	void updateActiveItems()
+	{
+		m_activeItems.clear();
+
+		const auto addItem = [this](OsuUISongBrowserButton *button) {
+			const OsuDatabaseBeatmap *databaseBeatmap = button->getDatabaseBeatmap();
+
+			const auto it = m_itemIndices.find(button);
+			if (it != m_itemIndices.end() && m_items[it->second].databaseBeatmap == databaseBeatmap)
+			{
+				m_activeItems.push_back(it->second);
+				return;
+			}
+
+			// new button (or a new one at the address of a deleted one)
+			ITEM item{.button = button, .databaseBeatmap = databaseBeatmap, .rowsBegin = static_cast<uint32_t>(m_itemRows.size()), .rowsEnd = 0, .search = 0, .matches = false};
+			if (databaseBeatmap != NULL)
+			{
+				const std::vector<OsuDatabaseBeatmap*> &diffs = databaseBeatmap->getDifficulties();
+				if (diffs.size() > 0)
+				{
+					for (const OsuDatabaseBeatmap *diff : diffs)
+					{
+						m_itemRows.push_back(m_index.addRow(diff));
+					}
+				}
+				else
+					m_itemRows.push_back(m_index.addRow(databaseBeatmap));
+			}
+			item.rowsEnd = static_cast<uint32_t>(m_itemRows.size());
+
+			const auto itemIndex = static_cast<uint32_t>(m_items.size());
+			m_items.push_back(item);
+			m_itemIndices[button] = itemIndex;
+			m_activeItems.push_back(itemIndex);
+		};
+
+		for (OsuUISongBrowserSongButton *songButton : m_songButtons)
+		{
+			const std::vector<OsuUISongBrowserButton*> &children = songButton->getChildren();
+			if (children.size() > 0)
+			{
+				for (OsuUISongBrowserButton *child : children)
+				{
+					addItem(child);
+				}
+			}
+			else
+				addItem(songButton);
+		}
+
+		m_indexedSongButtons = m_songButtons;
+	}
+
 	std::atomic<bool> m_bDead;
 
 	UString m_sSearchString;
 	UString m_sHardcodedSearchString;
 	std::vector<OsuUISongBrowserSongButton*> m_songButtons;
+	uint64_t m_iDataRevision{0};
+
+	// everything below is only touched by the matcher thread, and kept across searches
+
+	std::vector<ITEM> m_items;
+	std::unordered_map<OsuUISongBrowserButton*, uint32_t> m_itemIndices;
+	std::vector<OsuSongBrowserSearchIndex::ROW> m_itemRows;
+	std::vector<uint32_t> m_activeItems; // in m_songButtons order
+	std::vector<OsuUISongBrowserSongButton*> m_indexedSongButtons;
+
+	std::optional<OsuSongBrowserSearchQuery> m_previousQuery;
+	uint64_t m_iPreviousDataRevision{0};
+	uint32_t m_iSearch{1}; // (items start out as not having been part of any search)
+
+	OsuSongBrowserSearchIndex m_index;
 };
 
 
@@ -218,158 +358,14 @@ private:
 	UString m_sIconString;
 };
 
-namespace {
-
-bool sortByArtist(OsuUISongBrowserButton const *a, OsuUISongBrowserButton const *b)
-{
-	if (a->getDatabaseBeatmap() == NULL || b->getDatabaseBeatmap() == NULL)
-		return a->getSortHack() < b->getSortHack();
-
-	return a->getDatabaseBeatmap()->getArtist().lessThanIgnoreCaseStrict(b->getDatabaseBeatmap()->getArtist());
-}
-
-bool sortByBPM(OsuUISongBrowserButton const *a, OsuUISongBrowserButton const *b)
-{
-	if (a->getDatabaseBeatmap() == NULL || b->getDatabaseBeatmap() == NULL)
-		return a->getSortHack() < b->getSortHack();
-
-	int bpm1 = a->getDatabaseBeatmap()->getMostCommonBPM();
-	const std::vector<OsuDatabaseBeatmap *> &aDiffs = a->getDatabaseBeatmap()->getDifficulties();
-	for (auto aDiff : aDiffs)
-	{
-		if (aDiff->getMostCommonBPM() > bpm1)
-			bpm1 = aDiff->getMostCommonBPM();
-	}
-
-	int bpm2 = b->getDatabaseBeatmap()->getMostCommonBPM();
-	const std::vector<OsuDatabaseBeatmap *> &bDiffs = b->getDatabaseBeatmap()->getDifficulties();
-	for (auto bDiff : bDiffs)
-	{
-		if (bDiff->getMostCommonBPM() > bpm2)
-			bpm2 = bDiff->getMostCommonBPM();
-	}
-
-	// strict weak ordering!
-	if (bpm1 == bpm2)
-		return a->getSortHack() < b->getSortHack();
-
-	return bpm1 < bpm2;
-}
-
-bool sortByCreator(OsuUISongBrowserButton const *a, OsuUISongBrowserButton const *b)
-{
-	if (a->getDatabaseBeatmap() == NULL || b->getDatabaseBeatmap() == NULL)
-		return a->getSortHack() < b->getSortHack();
-
-	return a->getDatabaseBeatmap()->getCreator().lessThanIgnoreCaseStrict(b->getDatabaseBeatmap()->getCreator());
-}
-
-bool sortByDateAdded(OsuUISongBrowserButton const *a, OsuUISongBrowserButton const *b)
-{
-	if (a->getDatabaseBeatmap() == NULL || b->getDatabaseBeatmap() == NULL)
-		return a->getSortHack() < b->getSortHack();
-
-	long long time1 = a->getDatabaseBeatmap()->getLastModificationTime();
-	const std::vector<OsuDatabaseBeatmap *> &aDiffs = a->getDatabaseBeatmap()->getDifficulties();
-	for (auto aDiff : aDiffs)
-	{
-		if (aDiff->getLastModificationTime() > time1)
-			time1 = aDiff->getLastModificationTime();
-	}
-
-	long long time2 = b->getDatabaseBeatmap()->getLastModificationTime();
-	const std::vector<OsuDatabaseBeatmap *> &bDiffs = b->getDatabaseBeatmap()->getDifficulties();
-	for (auto bDiff : bDiffs)
-	{
-		if (bDiff->getLastModificationTime() > time2)
-			time2 = bDiff->getLastModificationTime();
-	}
-
-	// strict weak ordering!
-	if (time1 == time2)
-		return a->getSortHack() > b->getSortHack();
-
-	return time1 > time2;
-}
-
-bool sortByLength(OsuUISongBrowserButton const *a, OsuUISongBrowserButton const *b)
-{
-	if (a->getDatabaseBeatmap() == NULL || b->getDatabaseBeatmap() == NULL)
-		return a->getSortHack() < b->getSortHack();
-
-	unsigned long length1 = a->getDatabaseBeatmap()->getLengthMS();
-	const std::vector<OsuDatabaseBeatmap *> &aDiffs = a->getDatabaseBeatmap()->getDifficulties();
-	for (auto aDiff : aDiffs)
-	{
-		if (aDiff->getLengthMS() > length1)
-			length1 = aDiff->getLengthMS();
-	}
-
-	unsigned long length2 = b->getDatabaseBeatmap()->getLengthMS();
-	const std::vector<OsuDatabaseBeatmap *> &bDiffs = b->getDatabaseBeatmap()->getDifficulties();
-	for (auto bDiff : bDiffs)
-	{
-		if (bDiff->getLengthMS() > length2)
-			length2 = bDiff->getLengthMS();
-	}
-
-	// strict weak ordering!
-	if (length1 == length2)
-		return a->getSortHack() < b->getSortHack();
-
-	return length1 < length2;
-}
-
-bool sortByTitle(OsuUISongBrowserButton const *a, OsuUISongBrowserButton const *b)
-{
-	if (a->getDatabaseBeatmap() == NULL || b->getDatabaseBeatmap() == NULL)
-		return a->getSortHack() < b->getSortHack();
-
-	return a->getDatabaseBeatmap()->getTitle().lessThanIgnoreCaseStrict(b->getDatabaseBeatmap()->getTitle());
-}
-}
-
 // needed by OsuUISongBrowserSongButton
 bool OsuSongBrowser2::sortByDifficulty(OsuUISongBrowserButton const *a, OsuUISongBrowserButton const *b)
 {
 	if (a->getDatabaseBeatmap() == NULL || b->getDatabaseBeatmap() == NULL)
 		return a->getSortHack() < b->getSortHack();
 
-	auto getMaxDifficulty = [](const OsuDatabaseBeatmap *beatmap) -> float {
-		float maxDiff = 0.0f;
-		float stars = beatmap->getStarsNomod();
-
-		if (stars > 0)
-		{
-			maxDiff = stars;
-		}
-		else
-		{
-			// fallback calculation
-			maxDiff = (beatmap->getAR() + 1) * (beatmap->getCS() + 1) * (beatmap->getHP() + 1) * (beatmap->getOD() + 1) * (std::max(beatmap->getMostCommonBPM(), 1));
-		}
-
-		// check children for higher difficulty
-		const std::vector<OsuDatabaseBeatmap *> &diffs = beatmap->getDifficulties();
-		for (auto d : diffs)
-		{
-			float childStars = d->getStarsNomod();
-			if (childStars > 0)
-			{
-				maxDiff = std::max(maxDiff, childStars);
-			}
-			else
-			{
-				float childDiff = (d->getAR() + 1) * (d->getCS() + 1) * (d->getHP() + 1) * (d->getOD() + 1) * (std::max(d->getMostCommonBPM(), 1));
-				maxDiff = std::max(maxDiff, childDiff);
-			}
-		}
-
-		return maxDiff;
-	};
-
-	float diff1 = getMaxDifficulty(a->getDatabaseBeatmap());
-	float diff2 = getMaxDifficulty(b->getDatabaseBeatmap());
+	const float diff1 = OsuSongBrowserSortKeys::getMaxDifficulty(a->getDatabaseBeatmap());
+	const float diff2 = OsuSongBrowserSortKeys::getMaxDifficulty(b->getDatabaseBeatmap());
 
 	// strict weak ordering
 	if (diff1 == diff2)
@@ -400,14 +396,14 @@ OsuSongBrowser2::OsuSongBrowser2() : OsuScreenBackable()
 
 	m_sortingMethod = SORT::SORT_ARTIST;
     {
-        m_sortingMethods.push_back({SORT::SORT_ARTIST, "By Artist", sortByArtist});
-        m_sortingMethods.push_back({SORT::SORT_BPM, "By BPM", sortByBPM});
-        m_sortingMethods.push_back({SORT::SORT_CREATOR, "By Creator", sortByCreator});
-        m_sortingMethods.push_back({SORT::SORT_DATEADDED, "By Date Added", sortByDateAdded});
-        m_sortingMethods.push_back({SORT::SORT_DIFFICULTY, "By Difficulty", sortByDifficulty});
-        m_sortingMethods.push_back({SORT::SORT_LENGTH, "By Length", sortByLength});
-        ///m_sortingMethods.push_back({SORT::SORT_RANKACHIEVED, "By Rank Achieved", sortByRankAchieved}); // not yet possible
-        m_sortingMethods.push_back({SORT::SORT_TITLE, "By Title", sortByTitle});
+        m_sortingMethods.push_back({SORT::SORT_ARTIST, "By Artist", OsuSongBrowserSortKeys::KEY::ARTIST});
+        m_sortingMethods.push_back({SORT::SORT_BPM, "By BPM", OsuSongBrowserSortKeys::KEY::BPM});
+        m_sortingMethods.push_back({SORT::SORT_CREATOR, "By Creator", OsuSongBrowserSortKeys::KEY::CREATOR});
+        m_sortingMethods.push_back({SORT::SORT_DATEADDED, "By Date Added", OsuSongBrowserSortKeys::KEY::DATEADDED});
+        m_sortingMethods.push_back({SORT::SORT_DIFFICULTY, "By Difficulty", OsuSongBrowserSortKeys::KEY::DIFFICULTY});
+        m_sortingMethods.push_back({SORT::SORT_LENGTH, "By Length", OsuSongBrowserSortKeys::KEY::LENGTH});
+        ///m_sortingMethods.push_back({SORT::SORT_RANKACHIEVED, "By Rank Achieved", ...}); // not yet possible
+        m_sortingMethods.push_back({SORT::SORT_TITLE, "By Title", OsuSongBrowserSortKeys::KEY::TITLE});
     }
 
 	// convar callbacks
@@ -538,6 +534,7 @@ OsuSongBrowser2::OsuSongBrowser2() : OsuScreenBackable()
 	m_songBrowser->setDrawFrame(false);
 	m_songBrowser->setHorizontalScrolling(false);
 	m_songBrowser->setScrollResistance(15);
+	m_songBrowser->setVirtualized(true); // only the buttons around the visible area are updated/drawn
 
 	// beatmap database
 	m_db = new OsuDatabase();
@@ -562,6 +559,7 @@ OsuSongBrowser2::OsuSongBrowser2() : OsuScreenBackable()
 	// background star calculation (entire database)
 	m_fBackgroundStarCalculationWorkNotificationTime = 0.0f;
 	m_iBackgroundStarCalculationIndex = 0;
+	m_iSearchDataRevision = 0;
 	m_backgroundStarCalculator = new OsuDatabaseBeatmapStarCalculator();
 	m_backgroundStarCalcTempParent = NULL;
 
@@ -1070,7 +1068,6 @@ void OsuSongBrowser2::update()
 	{
 		m_contextMenu->update();
 		m_songBrowser->update();
-		m_songBrowser->getContainer()->update_pos(); // necessary due to constant animations
 		m_bottombar->update();
 		m_scoreBrowser->update();
 		m_topbarLeft->update();
@@ -1119,10 +1116,11 @@ void OsuSongBrowser2::update()
 
 				bool isMouseInsideAnySongButton = false;
 				{
-					const std::vector<CBaseUIElement*> &elements = m_songBrowser->getContainer()->getElements();
-					for (CBaseUIElement *songButton : elements)
+					const CBaseUIContainer *container = m_songBrowser->getContainer();
+					const std::vector<CBaseUIElement*> &elements = container->getElements();
+					for (size_t i=container->getActiveElementsBegin(); i<container->getActiveElementsEnd(); i++)
 					{
-						if (songButton->isMouseInside())
+						if (elements[i]->isMouseInside())
 						{
 							isMouseInsideAnySongButton = true;
 							break;
@@ -1219,14 +1217,15 @@ void OsuSongBrowser2::update()
 					calculatedDiff->setNumSliders(std::max(0, m_backgroundStarCalculator->getNumObjects() - m_backgroundStarCalculator->getNumCircles() - m_backgroundStarCalculator->getNumSpinners()));
 					calculatedDiff->setNumSpinners(m_backgroundStarCalculator->getNumSpinners());
 					calculatedDiff->setLengthMS(std::max(calculatedDiff->getLengthMS(), (unsigned long)m_backgroundStarCalculator->getLengthMS()));
+					m_iSearchDataRevision++;
 
-					// re-add (potentially changed stars, potentially changed length)
-					readdBeatmap(calculatedDiff);
-
-					// and update wrapper representative values (parent)
+					// update wrapper representative values (parent), before re-sorting the set
 					if (m_backgroundStarCalcTempParent != NULL)
 						m_backgroundStarCalcTempParent->updateSetHeuristics();
 
+					// and re-add (potentially changed stars, potentially changed length)
+					readdBeatmap(calculatedDiff);
+
 					m_backgroundStarCalculator->kill();
 				}
 
@@ -1837,6 +1836,58 @@ void OsuSongBrowser2::onDifficultySelected(OsuDatabaseBeatmap *diff2, bool play,
 
 	// trigger dynamic star calc (including current mods etc.)
 	recalculateStarsForSelectedBeatmap();
+
+	// the next selection is most likely one of the neighbours
+	if (!m_bHasSelectedAndIsPlaying)
+		prefetchNeighbourAudio(diff2);
+}
+
+void OsuSongBrowser2::prefetchNeighbourAudio(const OsuDatabaseBeatmap *diff2)
+{
+	const int numNeighbours = cv::osu::songbrowser_prefetch_audio_neighbours.getInt();
+	if (!cv::snd_prefetch.getBool() || numNeighbours < 1 || diff2 == NULL)
+		return;
+
+	const std::vector<CBaseUIElement*> &elements = m_songBrowser->getContainer()->getElements();
+
+	int selectedIndex = -1;
+	for (int i=0; i<elements.size(); i++)
+	{
+		const auto *button = elements[i]->as<const OsuUISongBrowserButton>();
+		if (button != NULL && button->getDatabaseBeatmap() == diff2)
+		{
+			selectedIndex = i;
+			break;
+		}
+	}
+	if (selectedIndex < 0)
+		return;
+
+	// closest first, alternating below/above (scrolling down is more common than scrolling up)
+	std::vector<UString> filePaths;
+	for (int offset=1; offset<=numNeighbours*2; offset++)
+	{
+		const int index = selectedIndex + ((offset % 2) == 1 ? (offset + 1)/2 : -(offset/2));
+		if (index < 0 || index >= elements.size())
+			continue;
+
+		const auto *button = elements[index]->as<const OsuUISongBrowserButton>();
+		const OsuDatabaseBeatmap *beatmap = (button != NULL ? button->getDatabaseBeatmap() : NULL);
+		if (beatmap == NULL)
+			continue;
+
+		// set buttons hold the set, all difficulties of a set (usually) share the same audio file
+		if (beatmap->getDifficulties().size() > 0)
+			beatmap = beatmap->getDifficulties()[0];
+
+		const UString &filePath = beatmap->getFullSoundFilePath();
+		if (filePath.length() < 1 || filePath == diff2->getFullSoundFilePath() || std::ranges::find(filePaths, filePath) != filePaths.end())
+			continue;
+
+		filePaths.push_back(filePath);
+	}
+
+	soundEngine->getPrefetcher()->prefetch(filePaths);
 }
 
 void OsuSongBrowser2::onDifficultySelectedMP(OsuDatabaseBeatmap *diff2, bool play)
@@ -1896,6 +1947,7 @@ void OsuSongBrowser2::refreshBeatmaps()
 	checkHandleKillBackgroundStarCalculator();
 	checkHandleKillDynamicStarCalculator(false);
 	checkHandleKillBackgroundSearchMatcher();
+	m_backgroundSearchMatcher->clearIndex();
 
 	SAFE_DELETE(m_selectedBeatmap);
 
@@ -1956,6 +2008,11 @@ void OsuSongBrowser2::refreshBeatmaps()
 	m_beatmaps.clear();
 	m_previousRandomBeatmaps.clear();
 
+	m_songButtonsByBeatmap.clear();
+	m_sortKeys.clear();
+	m_sortedSongButtonsCache.clear();
+	m_groupSortStamps.clear();
+
 	m_contextMenu->setVisible2(false);
 
 	// clear potentially active search
@@ -1984,7 +2041,14 @@ void OsuSongBrowser2::addBeatmap(OsuDatabaseBeatmap *beatmap)
 	else
 		songButton = new OsuUISongBrowserSongDifficultyButton(this, m_songBrowser, m_contextMenu, 250, 250 + m_beatmaps.size()*50, 200, 50, "", beatmap->getDifficulties()[0], NULL);
 
-	m_songButtons.push_back(songButton);
+	m_songButtonsByBeatmap[songButton->getDatabaseBeatmap()] = songButton;
+	for (OsuUISongBrowserButton *child : songButton->getChildren())
+	{
+		m_songButtonsByBeatmap.try_emplace(child->getDatabaseBeatmap(), songButton);
+	}
+
+	// (during the initial load nothing is sorted yet, this only does something for beatmaps added afterwards)
+	updateSortedCaches(songButton, true);
 
 	// prebuild temporary list of all relevant buttons, used by some groups
 	std::vector<OsuUISongBrowserButton*> tempChildrenForGroups;
@@ -2015,15 +2079,15 @@ void OsuSongBrowser2::addBeatmap(OsuDatabaseBeatmap *beatmap)
 				const bool isUpperCase = (firstChar >= 'A' && firstChar <= 'Z');
 
 				if (isNumber)
-					m_artistCollectionButtons[0]->getChildren().push_back(songButton);
+					addToGroup(GROUP::GROUP_ARTIST, m_artistCollectionButtons[0], songButton);
 				else if (isLowerCase || isUpperCase)
 				{
 					const int index = 1 + (25 - (isLowerCase ? 'z' - firstChar : 'Z' - firstChar));
 					if (index > 0 && index < 27)
-						m_artistCollectionButtons[index]->getChildren().push_back(songButton);
+						addToGroup(GROUP::GROUP_ARTIST, m_artistCollectionButtons[index], songButton);
 				}
 				else
-					m_artistCollectionButtons[27]->getChildren().push_back(songButton);
+					addToGroup(GROUP::GROUP_ARTIST, m_artistCollectionButtons[27], songButton);
 			}
 		}
 
@@ -2033,7 +2097,7 @@ void OsuSongBrowser2::addBeatmap(OsuDatabaseBeatmap *beatmap)
 			for (auto & tempChildrenForGroup : tempChildrenForGroups)
 			{
 				const int index = std::clamp<int>((int)tempChildrenForGroup->getDatabaseBeatmap()->getStarsNomod(), 0, 11);
-				m_difficultyCollectionButtons[index]->getChildren().push_back(tempChildrenForGroup);
+				addToGroup(GROUP::GROUP_DIFFICULTY, m_difficultyCollectionButtons[index], tempChildrenForGroup);
 			}
 		}
 
@@ -2057,15 +2121,15 @@ void OsuSongBrowser2::addBeatmap(OsuDatabaseBeatmap *beatmap)
 				const bool isUpperCase = (firstChar >= 'A' && firstChar <= 'Z');
 
 				if (isNumber)
-					m_creatorCollectionButtons[0]->getChildren().push_back(songButton);
+					addToGroup(GROUP::GROUP_CREATOR, m_creatorCollectionButtons[0], songButton);
 				else if (isLowerCase || isUpperCase)
 				{
 					const int index = 1 + (25 - (isLowerCase ? 'z' - firstChar : 'Z' - firstChar));
 					if (index > 0 && index < 27)
-						m_creatorCollectionButtons[index]->getChildren().push_back(songButton);
+						addToGroup(GROUP::GROUP_CREATOR, m_creatorCollectionButtons[index], songButton);
 				}
 				else
-					m_creatorCollectionButtons[27]->getChildren().push_back(songButton);
+					addToGroup(GROUP::GROUP_CREATOR, m_creatorCollectionButtons[27], songButton);
 			}
 		}
 
@@ -2081,19 +2145,19 @@ void OsuSongBrowser2::addBeatmap(OsuDatabaseBeatmap *beatmap)
 			{
 				const unsigned long lengthMS = tempChildrenForGroup->getDatabaseBeatmap()->getLengthMS();
 				if (lengthMS <= 1000UL*60)
-					m_lengthCollectionButtons[0]->getChildren().push_back(tempChildrenForGroup);
+					addToGroup(GROUP::GROUP_LENGTH, m_lengthCollectionButtons[0], tempChildrenForGroup);
 				else if (lengthMS <= 1000UL*60*2)
-					m_lengthCollectionButtons[1]->getChildren().push_back(tempChildrenForGroup);
+					addToGroup(GROUP::GROUP_LENGTH, m_lengthCollectionButtons[1], tempChildrenForGroup);
 				else if (lengthMS <= 1000UL*60*3)
-					m_lengthCollectionButtons[2]->getChildren().push_back(tempChildrenForGroup);
+					addToGroup(GROUP::GROUP_LENGTH, m_lengthCollectionButtons[2], tempChildrenForGroup);
 				else if (lengthMS <= 1000UL*60*4)
-					m_lengthCollectionButtons[3]->getChildren().push_back(tempChildrenForGroup);
+					addToGroup(GROUP::GROUP_LENGTH, m_lengthCollectionButtons[3], tempChildrenForGroup);
 				else if (lengthMS <= 1000UL*60*5)
-					m_lengthCollectionButtons[4]->getChildren().push_back(tempChildrenForGroup);
+					addToGroup(GROUP::GROUP_LENGTH, m_lengthCollectionButtons[4], tempChildrenForGroup);
 				else if (lengthMS <= 1000UL*60*10)
-					m_lengthCollectionButtons[5]->getChildren().push_back(tempChildrenForGroup);
+					addToGroup(GROUP::GROUP_LENGTH, m_lengthCollectionButtons[5], tempChildrenForGroup);
 				else
-					m_lengthCollectionButtons[6]->getChildren().push_back(tempChildrenForGroup);
+					addToGroup(GROUP::GROUP_LENGTH, m_lengthCollectionButtons[6], tempChildrenForGroup);
 			}
 		}
 
@@ -2110,15 +2174,15 @@ void OsuSongBrowser2::addBeatmap(OsuDatabaseBeatmap *beatmap)
 				const bool isUpperCase = (firstChar >= 'A' && firstChar <= 'Z');
 
 				if (isNumber)
-					m_titleCollectionButtons[0]->getChildren().push_back(songButton);
+					addToGroup(GROUP::GROUP_TITLE, m_titleCollectionButtons[0], songButton);
 				else if (isLowerCase || isUpperCase)
 				{
 					const int index = 1 + (25 - (isLowerCase ? 'z' - firstChar : 'Z' - firstChar));
 					if (index > 0 && index < 27)
-						m_titleCollectionButtons[index]->getChildren().push_back(songButton);
+						addToGroup(GROUP::GROUP_TITLE, m_titleCollectionButtons[index], songButton);
 				}
 				else
-					m_titleCollectionButtons[27]->getChildren().push_back(songButton);
+					addToGroup(GROUP::GROUP_TITLE, m_titleCollectionButtons[27], songButton);
 			}
 		}
 	}
@@ -2131,6 +2195,29 @@ void OsuSongBrowser2::readdBeatmap(OsuDatabaseBeatmap *diff2)
 
 	// NOTE: the difficulty and length groups only contain diffs (and no parent wrapper objects), makes searching for the button way easier
 
+	// stars/length changed, so only this set has to be moved within the sorted orderings
+	{
+		const auto it = m_songButtonsByBeatmap.find(diff2);
+		OsuUISongBrowserSongButton *songButton = (it != m_songButtonsByBeatmap.end() ? it->second : NULL);
+
+		m_sortKeys.invalidate(diff2);
+		if (songButton != NULL)
+		{
+			m_sortKeys.invalidate(songButton->getDatabaseBeatmap());
+			updateSortedCaches(songButton, false);
+		}
+
+		// groups containing the whole set can't be fixed up as easily, re-sort them when they are shown the next time (if their order depends on stars/length at all)
+		for (auto it = m_groupSortStamps.begin(); it != m_groupSortStamps.end();)
+		{
+			const bool isValueSort = (it->second.sort == SORT::SORT_DIFFICULTY || it->second.sort == SORT::SORT_LENGTH);
+			if (isValueSort && it->first != GROUP::GROUP_DIFFICULTY && it->first != GROUP::GROUP_LENGTH)
+				it = m_groupSortStamps.erase(it);
+			else
+				++it;
+		}
+	}
+
 	// difficulty group
 	{
 		// remove from difficulty group
@@ -2159,7 +2246,7 @@ void OsuSongBrowser2::readdBeatmap(OsuDatabaseBeatmap *diff2)
 			if (m_difficultyCollectionButtons.size() == 12)
 			{
 				const int index = std::clamp<int>((int)diff2->getStarsNomod(), 0, 11);
-				m_difficultyCollectionButtons[index]->getChildren().push_back(difficultyGroupButton);
+				addToGroup(GROUP::GROUP_DIFFICULTY, m_difficultyCollectionButtons[index], difficultyGroupButton);
 			}
 		}
 	}
@@ -2193,19 +2280,19 @@ void OsuSongBrowser2::readdBeatmap(OsuDatabaseBeatmap *diff2)
 			{
 				const unsigned long lengthMS = diff2->getLengthMS();
 				if (lengthMS <= 1000UL*60)
-					m_lengthCollectionButtons[0]->getChildren().push_back(lengthGroupButton);
+					addToGroup(GROUP::GROUP_LENGTH, m_lengthCollectionButtons[0], lengthGroupButton);
 				else if (lengthMS <= 1000UL*60*2)
-					m_lengthCollectionButtons[1]->getChildren().push_back(lengthGroupButton);
+					addToGroup(GROUP::GROUP_LENGTH, m_lengthCollectionButtons[1], lengthGroupButton);
 				else if (lengthMS <= 1000UL*60*3)
-					m_lengthCollectionButtons[2]->getChildren().push_back(lengthGroupButton);
+					addToGroup(GROUP::GROUP_LENGTH, m_lengthCollectionButtons[2], lengthGroupButton);
 				else if (lengthMS <= 1000UL*60*4)
-					m_lengthCollectionButtons[3]->getChildren().push_back(lengthGroupButton);
+					addToGroup(GROUP::GROUP_LENGTH, m_lengthCollectionButtons[3], lengthGroupButton);
 				else if (lengthMS <= 1000UL*60*5)
-					m_lengthCollectionButtons[4]->getChildren().push_back(lengthGroupButton);
+					addToGroup(GROUP::GROUP_LENGTH, m_lengthCollectionButtons[4], lengthGroupButton);
 				else if (lengthMS <= 1000UL*60*10)
-					m_lengthCollectionButtons[5]->getChildren().push_back(lengthGroupButton);
+					addToGroup(GROUP::GROUP_LENGTH, m_lengthCollectionButtons[5], lengthGroupButton);
 				else
-					m_lengthCollectionButtons[6]->getChildren().push_back(lengthGroupButton);
+					addToGroup(GROUP::GROUP_LENGTH, m_lengthCollectionButtons[6], lengthGroupButton);
 			}
 		}
 	}
@@ -2392,336 +2479,6 @@ void OsuSongBrowser2::updateSongButtonSorting()
 	onSortChange(cv::osu::songbrowser_scores_sortingtype.getString());
 }
 
-bool OsuSongBrowser2::searchMatcher(const OsuDatabaseBeatmap *databaseBeatmap, const std::vector<UString> &searchStringTokens)
-{
-	if (databaseBeatmap == NULL) return false;
-
-	const std::vector<OsuDatabaseBeatmap*> &diffs = databaseBeatmap->getDifficulties();
-	const bool isContainer = (diffs.size() > 0);
-	const int numDiffs = (isContainer ? diffs.size() : 1);
-
-	// TODO: optimize this dumpster fire. can at least cache the parsed tokens and literal strings array instead of parsing every single damn time
-
-	// intelligent search parser
-	// all strings which are not expressions get appended with spaces between, then checked with one call to findSubstringInDifficulty()
-	// the rest is interpreted
-	// NOTE: this code is quite shitty. the order of the operators array does matter, because find() is used to detect their presence (and '=' would then break '<=' etc.)
-	enum operatorId
-	{
-		EQ,
-		LT,
-		GT,
-		LE,
-		GE,
-		NE
-	};
-	static const std::vector<std::pair<UString, operatorId>> operators =
-	{
-		std::pair<UString, operatorId>("<=",LE),
-		std::pair<UString, operatorId>(">=",GE),
-		std::pair<UString, operatorId>("<", LT),
-		std::pair<UString, operatorId>(">", GT),
-		std::pair<UString, operatorId>("!=",NE),
-		std::pair<UString, operatorId>("==",EQ),
-		std::pair<UString, operatorId>("=", EQ),
-	};
-
-	enum keywordId
-	{
-		AR,
-		CS,
-		OD,
-		HP,
-		BPM,
-		OPM,
-		CPM,
-		SPM,
-		OBJECTS,
-		CIRCLES,
-		SLIDERS,
-		SPINNERS,
-		LENGTH,
-		STARS,
-	};
-	static const std::vector<std::pair<UString, keywordId>> keywords =
-	{
-		std::pair<UString, keywordId>("ar", AR),
-		std::pair<UString, keywordId>("cs", CS),
-		std::pair<UString, keywordId>("od", OD),
-		std::pair<UString, keywordId>("hp", HP),
-		std::pair<UString, keywordId>("bpm",BPM),
-		std::pair<UString, keywordId>("opm",OPM),
-		std::pair<UString, keywordId>("cpm",CPM),
-		std::pair<UString, keywordId>("spm",SPM),
-		std::pair<UString, keywordId>("object",OBJECTS),
-		std::pair<UString, keywordId>("objects",OBJECTS),
-		std::pair<UString, keywordId>("circle",CIRCLES),
-		std::pair<UString, keywordId>("circles",CIRCLES),
-		std::pair<UString, keywordId>("slider",SLIDERS),
-		std::pair<UString, keywordId>("sliders",SLIDERS),
-		std::pair<UString, keywordId>("spinner",SPINNERS),
-		std::pair<UString, keywordId>("spinners",SPINNERS),
-		std::pair<UString, keywordId>("length", LENGTH),
-		std::pair<UString, keywordId>("len", LENGTH),
-		std::pair<UString, keywordId>("stars", STARS),
-		std::pair<UString, keywordId>("star", STARS)
-	};
-
-	// split search string into tokens
-	// parse over all difficulties
-	bool expressionMatches = false; // if any diff matched all expressions
-	std::vector<UString> literalSearchStrings;
-	for (size_t d=0; std::cmp_less(d,numDiffs); d++)
-	{
-		const OsuDatabaseBeatmap *diff = (isContainer ? diffs[d] : databaseBeatmap);
-
-		bool expressionsMatch = true; // if the current search string (meaning only the expressions in this case) matches the current difficulty
-
-		for (const auto & searchStringToken : searchStringTokens)
-		{
-			//debugLog("token[{}] = {:s}\n", i, tokens[i].toUtf8());
-			// determine token type, interpret expression
-			bool expression = false;
-			for (const auto & o : operators)
-			{
-				if (searchStringToken.find(o.first) != -1)
-				{
-					// split expression into left and right parts (only accept singular expressions, things like "0<bpm<1" will not work with this)
-					//debugLog("splitting by string {:s}\n", operators[o].first.toUtf8());
-					std::vector<UString> values = searchStringToken.split(o.first);
-					if (values.size() == 2 && values[0].length() > 0 && values[1].length() > 0)
-					{
-						const UString& lvalue = values[0];
-						const int rvaluePercentIndex = values[1].find("%");
-						const bool rvalueIsPercent = (rvaluePercentIndex != -1);
-						const float rvalue = (rvaluePercentIndex == -1 ? values[1].toFloat() : values[1].substr(0, rvaluePercentIndex).toFloat()); // this must always be a number (at least, assume it is)
-
-						// find lvalue keyword in array (only continue if keyword exists)
-						for (const auto & keyword : keywords)
-						{
-							if (keyword.first == lvalue)
-							{
-								expression = true;
-
-								// we now have a valid expression: the keyword, the operator and the value
-
-								// solve keyword
-								float compareValue = 5.0f;
-								switch (keyword.second)
-								{
-								case AR:
-									compareValue = diff->getAR();
-									break;
-								case CS:
-									compareValue = diff->getCS();
-									break;
-								case OD:
-									compareValue = diff->getOD();
-									break;
-								case HP:
-									compareValue = diff->getHP();
-									break;
-								case BPM:
-									compareValue = diff->getMostCommonBPM();
-									break;
-								case OPM:
-									compareValue = (diff->getLengthMS() > 0 ? ((float)diff->getNumObjects() / (float)(diff->getLengthMS() / 1000.0f / 60.0f)) : 0.0f) * osu->getSpeedMultiplier();
-									break;
-								case CPM:
-									compareValue = (diff->getLengthMS() > 0 ? ((float)diff->getNumCircles() / (float)(diff->getLengthMS() / 1000.0f / 60.0f)) : 0.0f) * osu->getSpeedMultiplier();
-									break;
-								case SPM:
-									compareValue = (diff->getLengthMS() > 0 ? ((float)diff->getNumSliders() / (float)(diff->getLengthMS() / 1000.0f / 60.0f)) : 0.0f) * osu->getSpeedMultiplier();
-									break;
-								case OBJECTS:
-									compareValue = diff->getNumObjects();
-									break;
-								case CIRCLES:
-									compareValue = (rvalueIsPercent ? ((float)diff->getNumCircles() / (float)diff->getNumObjects())*100.0f : diff->getNumCircles());
-									break;
-								case SLIDERS:
-									compareValue = (rvalueIsPercent ? ((float)diff->getNumSliders() / (float)diff->getNumObjects())*100.0f : diff->getNumSliders());
-									break;
-								case SPINNERS:
-									compareValue = (rvalueIsPercent ? ((float)diff->getNumSpinners() / (float)diff->getNumObjects())*100.0f : diff->getNumSpinners());
-									break;
-								case LENGTH:
-									compareValue = diff->getLengthMS() / 1000;
-									break;
-								case STARS:
-									compareValue = std::round(diff->getStarsNomod() * 100.0f) / 100.0f; // round to 2 decimal places
-									break;
-								}
-
-								// solve operator
-								bool matches = false;
-								switch (o.second)
-								{
-								case LE:
-									if (compareValue <= rvalue)
-										matches = true;
-									break;
-								case GE:
-									if (compareValue >= rvalue)
-										matches = true;
-									break;
-								case LT:
-									if (compareValue < rvalue)
-										matches = true;
-									break;
-								case GT:
-									if (compareValue > rvalue)
-										matches = true;
-									break;
-								case NE:
-									if (compareValue != rvalue)
-										matches = true;
-									break;
-								case EQ:
-									if (compareValue == rvalue)
-										matches = true;
-									break;
-								}
-
-								//debugLog("comparing {:f} {:s} {:f} (operatorId = {}) = {}\n", compareValue, operators[o].first.toUtf8(), rvalue, (int)operators[o].second, (int)matches);
-
-								if (!matches) // if a single expression doesn't match, then the whole diff doesn't match
-									expressionsMatch = false;
-
-								break;
-							}
-						}
-					}
-
-					break;
-				}
-			}
-
-			// if this is not an expression, add the token to the literalSearchStrings array
-			if (!expression)
-			{
-				// only add it if it doesn't exist yet
-				// this check is only necessary due to multiple redundant parser executions (one per diff!)
-				bool exists = false;
-				for (const auto & literalSearchString : literalSearchStrings)
-				{
-					if (literalSearchString == searchStringToken)
-					{
-						exists = true;
-						break;
-					}
-				}
-
-				if (!exists)
-				{
-					const UString litAdd = searchStringToken.trim();
-					if (litAdd.length() > 0 && !litAdd.isWhitespaceOnly())
-						literalSearchStrings.push_back(litAdd);
-				}
-			}
-		}
-
-		if (expressionsMatch) // as soon as one difficulty matches all expressions, we are done here
-		{
-			expressionMatches = true;
-			break;
-		}
-	}
-
-	// if no diff matched any expression, then we can already stop here
-	if (!expressionMatches)
-		return false;
-
-	bool hasAnyValidLiteralSearchString = false;
-	for (const auto & literalSearchString : literalSearchStrings)
-	{
-		if (literalSearchString.length() > 0)
-		{
-			hasAnyValidLiteralSearchString = true;
-			break;
-		}
-	}
-
-	// early return here for literal match/contains
-	if (hasAnyValidLiteralSearchString)
-	{
-		for (size_t i=0; std::cmp_less(i,numDiffs); i++)
-		{
-			const OsuDatabaseBeatmap *diff = (isContainer ? diffs[i] : databaseBeatmap);
-
-			bool atLeastOneFullMatch = true;
-
-			for (const auto & literalSearchString : literalSearchStrings)
-			{
-				if (!findSubstringInDifficulty(diff, literalSearchString))
-					atLeastOneFullMatch = false;
-			}
-
-			// as soon as one diff matches all strings, we are done
-			if (atLeastOneFullMatch)
-				return true;
-		}
-
-		// expression may have matched, but literal didn't match, so the entire beatmap doesn't match
-		return false;
-	}
-
-	return expressionMatches;
-}
-
-bool OsuSongBrowser2::findSubstringInDifficulty(const OsuDatabaseBeatmap *diff, const UString &searchString)
-{
-	if (diff->getTitle().length() > 0)
-	{
-		if (diff->getTitle().findIgnoreCase(searchString) != -1)
-			return true;
-	}
-
-	if (diff->getArtist().length() > 0)
-	{
-		if (diff->getArtist().findIgnoreCase(searchString) != -1)
-			return true;
-	}
-
-	if (diff->getCreator().length() > 0)
-	{
-		if (diff->getCreator().findIgnoreCase(searchString) != -1)
-			return true;
-	}
-
-	if (diff->getDifficultyName().length() > 0)
-	{
-		if (diff->getDifficultyName().findIgnoreCase(searchString) != -1)
-			return true;
-	}
-
-	if (diff->getSource().length() > 0)
-	{
-		if (diff->getSource().findIgnoreCase(searchString) != -1)
-			return true;
-	}
-
-	if (diff->getTags().length() > 0)
-	{
-		if (diff->getTags().findIgnoreCase(searchString) != -1)
-			return true;
-	}
-
-	if (diff->getID() > 0)
-	{
-		if (UString::format("%i", diff->getID()).findIgnoreCase(searchString) != -1)
-			return true;
-	}
-
-	if (diff->getSetID() > 0)
-	{
-		if (UString::format("%i", diff->getSetID()).findIgnoreCase(searchString) != -1)
-			return true;
-	}
-
-	return false;
-}
-
 void OsuSongBrowser2::updateLayout()
 {
 	OsuScreenBackable::updateLayout();
@@ -3314,7 +3071,7 @@ void OsuSongBrowser2::onSearchUpdate()
 
 			m_backgroundSearchMatcher->revive();
 			m_backgroundSearchMatcher->release();
-			m_backgroundSearchMatcher->setSongButtonsAndSearchString(m_songButtons, m_sSearchString, cv::osu::songbrowser_search_hardcoded_filter.getString());
+			m_backgroundSearchMatcher->setSongButtonsAndSearchString(m_songButtons, m_sSearchString, cv::osu::songbrowser_search_hardcoded_filter.getString(), m_iSearchDataRevision);
 
 			resourceManager->requestNextLoadAsync();
 			resourceManager->loadResource(m_backgroundSearchMatcher);
@@ -3597,9 +3354,57 @@ std::vector<OsuUISongBrowserCollectionButton *> *OsuSongBrowser2::getCollectionB
 	return nullptr;
 }
 
-void OsuSongBrowser2::rebuildAfterGroupOrSortChange(GROUP group, bool autoScroll, SORT_COMPARATOR sortComp)
+const OsuSongBrowser2::SORTING_METHOD *OsuSongBrowser2::findSortingMethod(SORT type) const
+{
+	for (const auto &sortingMethod : m_sortingMethods)
+	{
+		if (sortingMethod.type == type)
+			return &sortingMethod;
+	}
+	return nullptr;
+}
+
+void OsuSongBrowser2::updateSortedCaches(OsuUISongBrowserSongButton *songButton, bool isNew)
+{
+	// (re)insert into every still valid ordering, the master list is always a copy of the one for the current sorting method (if valid)
+	bool isSongButtonsSorted = false;
+	for (auto &[sort, sorted] : m_sortedSongButtonsCache)
+	{
+		const SORTING_METHOD *sortingMethod = findSortingMethod(sort);
+		if (sortingMethod == nullptr || sorted.sortKeysGeneration != m_sortKeys.getGeneration())
+			continue;
+
+		if (!isNew)
+			std::erase(sorted.songButtons, songButton);
+		m_sortKeys.insert(sorted.songButtons, songButton, sortingMethod->key);
+
+		if (sort == m_sortingMethod)
+		{
+			if (!isNew)
+				std::erase(m_songButtons, songButton);
+			m_sortKeys.insert(m_songButtons, songButton, sortingMethod->key);
+			isSongButtonsSorted = true;
+		}
+	}
+
+	if (isNew && !isSongButtonsSorted)
+		m_songButtons.push_back(songButton);
+}
+
+void OsuSongBrowser2::addToGroup(GROUP group, OsuUISongBrowserCollectionButton *groupButton, OsuUISongBrowserButton *button)
+{
+	// keep the group sorted if it already is, otherwise it gets sorted once it's shown
+	const auto stamp = m_groupSortStamps.find(group);
+	const SORTING_METHOD *sortingMethod = (stamp != m_groupSortStamps.end() && stamp->second.sortKeysGeneration == m_sortKeys.getGeneration() ? findSortingMethod(stamp->second.sort) : nullptr);
+
+	if (sortingMethod != nullptr)
+		m_sortKeys.insert(groupButton->getChildren(), button, sortingMethod->key);
+	else
+		groupButton->getChildren().push_back(button);
+}
+
+void OsuSongBrowser2::rebuildAfterGroupOrSortChange(GROUP group, bool autoScroll)
 {
-	GROUP previousGroup = m_group;
 	m_group = group;
 
 	m_visibleSongButtons.clear();
@@ -3617,8 +3422,11 @@ void OsuSongBrowser2::rebuildAfterGroupOrSortChange(GROUP group, bool autoScroll
 			m_visibleSongButtons.reserve(groupButtons->size());
 			m_visibleSongButtons.insert(m_visibleSongButtons.end(), groupButtons->begin(), groupButtons->end());
 
-			// only sort if switching TO this group/sorting method (not from it)
-			if (previousGroup != group || sortComp != nullptr)
+			// only sort if this group isn't already sorted by the current sorting method (deferred until the group is active)
+			const SORTING_METHOD *currentSortMethod = findSortingMethod(m_sortingMethod);
+
+			const auto stamp = m_groupSortStamps.find(group);
+			if (currentSortMethod != nullptr && (stamp == m_groupSortStamps.end() || stamp->second.sort != m_sortingMethod || stamp->second.sortKeysGeneration != m_sortKeys.getGeneration()))
 			{
 				// collections are always sorted alphabetically
 				if (group == GROUP::GROUP_COLLECTIONS)
@@ -3626,34 +3434,17 @@ void OsuSongBrowser2::rebuildAfterGroupOrSortChange(GROUP group, bool autoScroll
 					std::ranges::sort(*groupButtons, UString::ncasecomp{}, [](const OsuUISongBrowserCollectionButton *btn) { return btn->getCollectionName(); });
 				}
 
-				// sort children only if needed (defer until group is active)
-				if (!sortComp)
-				{
-					// need to get the current sorting method if we're called from onGroupChange...
-					SORTING_METHOD *currentSortMethod = nullptr;
-					for (auto &sortingMethodI : m_sortingMethods)
-					{
-						if (sortingMethodI.type == m_sortingMethod)
-						{
-							currentSortMethod = &sortingMethodI;
-							break;
-						}
-					}
-					if (currentSortMethod != nullptr)
-						sortComp = currentSortMethod->comparator;
-				}
-				if (sortComp)
+				for (auto &groupButton : *groupButtons)
 				{
-					for (auto &groupButton : *groupButtons)
+					std::vector<OsuUISongBrowserButton *> &children = groupButton->getChildren();
+					if (!children.empty())
 					{
-						std::vector<OsuUISongBrowserButton *> &children = groupButton->getChildren();
-						if (!children.empty())
-						{
-							std::ranges::sort(children, sortComp);
-							groupButton->setChildren(children);
-						}
+						m_sortKeys.sort(children, currentSortMethod->key);
+						groupButton->setChildren(children);
 					}
 				}
+
+				m_groupSortStamps[group] = GROUP_SORT_STAMP{.sort = m_sortingMethod, .sortKeysGeneration = m_sortKeys.getGeneration()};
 			}
 		}
 	}
@@ -3715,17 +3506,22 @@ void OsuSongBrowser2::onSortChangeInt(const UString &text, bool autoScroll)
 	if (sortingMethod == nullptr)
 		return;
 
-	SORT previousSort = m_sortingMethod;
-
 	m_sortingMethod = sortingMethod->type;
 	m_sortButton->setText(sortingMethod->name);
 	cv::osu::songbrowser_sortingtype.setValue(sortingMethod->name);
 
-	// always sort the master list (needed for all views)
-	std::ranges::sort(m_songButtons, sortingMethod->comparator);
+	// always sort the master list (needed for all views), or reuse the previous result for this sorting method
+	SORTED_SONG_BUTTONS &sorted = m_sortedSongButtonsCache[m_sortingMethod];
+	if (sorted.sortKeysGeneration != m_sortKeys.getGeneration() || sorted.songButtons.size() != m_songButtons.size())
+	{
+		m_sortKeys.sort(m_songButtons, sortingMethod->key);
+		sorted = SORTED_SONG_BUTTONS{.sortKeysGeneration = m_sortKeys.getGeneration(), .songButtons = m_songButtons};
+	}
+	else
+		m_songButtons = sorted.songButtons;
 
 	// reuse the group update logic instead of duplicating it
-	rebuildAfterGroupOrSortChange(m_group, autoScroll, previousSort == m_sortingMethod ? nullptr : sortingMethod->comparator);
+	rebuildAfterGroupOrSortChange(m_group, autoScroll);
 }
 
 void OsuSongBrowser2::onGroupTabButtonClicked(CBaseUIButton *groupTabButton)
@@ -3973,6 +3769,7 @@ void OsuSongBrowser2::onSongButtonContextMenu(OsuUISongBrowserSongButton *songBu
 	};
 
 	bool updateUIScheduled = false;
+	UString changedCollectionName = text;
 	{
 		if (id == 1)
 		{
@@ -4014,6 +3811,7 @@ void OsuSongBrowser2::onSongButtonContextMenu(OsuUISongBrowserSongButton *songBu
 
 			m_db->removeBeatmapFromCollection(collectionName, songButton->getDatabaseBeatmap()->getMD5Hash());
 
+			changedCollectionName = collectionName;
 			updateUIScheduled = true;
 		}
 		else if (id == 4)
@@ -4040,6 +3838,7 @@ void OsuSongBrowser2::onSongButtonContextMenu(OsuUISongBrowserSongButton *songBu
 			}
 			m_db->triggerSaveCollections(); // (but do save here once at the end)
 
+			changedCollectionName = collectionName;
 			updateUIScheduled = true;
 		}
 		else if (id == -2 || id == -4)
@@ -4077,29 +3876,14 @@ void OsuSongBrowser2::onSongButtonContextMenu(OsuUISongBrowserSongButton *songBu
 
 	if (updateUIScheduled)
 	{
-		const float prevScrollPosY = m_songBrowser->getScrollPosY(); // usability
-		const UString previouslySelectedCollectionName = (m_selectionPreviousCollectionButton != NULL ? m_selectionPreviousCollectionButton->getCollectionName() : ""); // usability
-		{
-			recreateCollectionsButtons();
-			rebuildSongButtonsAndVisibleSongButtonsWithSearchMatchSupport(false, false);	// (last false = skipping rebuildSongButtons() here)
-			onSortChangeInt(cv::osu::songbrowser_sortingtype.getString(), false);				// (because this does the rebuildSongButtons())
-		}
-		if (previouslySelectedCollectionName.length() > 0)
-		{
-			for (auto & collectionButton : m_collectionButtons)
-			{
-				if (collectionButton->getCollectionName() == previouslySelectedCollectionName)
-				{
-					collectionButton->select();
-					m_songBrowser->scrollToY(prevScrollPosY, false);
-					break;
-				}
-			}
-		}
+		// only this one collection changed, all other buttons (and the selection/scroll state) stay as they are
+		recreateCollectionButton(changedCollectionName);
+		if (m_group == GROUP::GROUP_COLLECTIONS)
+			rebuildAfterGroupOrSortChange(GROUP::GROUP_COLLECTIONS, false);
 	}
 }
 
-void OsuSongBrowser2::onCollectionButtonContextMenu(OsuUISongBrowserCollectionButton * /*collectionButton*/, const UString& text, int id)
+void OsuSongBrowser2::onCollectionButtonContextMenu(OsuUISongBrowserCollectionButton *collectionButton, const UString& text, int id)
 {
 	if (id == 2) // delete collection
 	{
@@ -4127,10 +3911,16 @@ void OsuSongBrowser2::onCollectionButtonContextMenu(OsuUISongBrowserCollectionBu
 	}
 	else if (id == 3) // collection has been renamed
 	{
-		// update UI
+		// move it to its new alphabetical position (if the collections are sorted already, otherwise that happens once they are shown)
+		if (m_groupSortStamps.contains(GROUP::GROUP_COLLECTIONS) && std::erase(m_collectionButtons, collectionButton) > 0)
 		{
-			onSortChangeInt(cv::osu::songbrowser_sortingtype.getString(), false);
+			const auto it = std::ranges::upper_bound(m_collectionButtons, collectionButton->getCollectionName(), UString::ncasecomp{}, [](const OsuUISongBrowserCollectionButton *btn) { return btn->getCollectionName(); });
+			m_collectionButtons.insert(it, collectionButton);
 		}
+
+		// update UI
+		if (m_group == GROUP::GROUP_COLLECTIONS)
+			rebuildAfterGroupOrSortChange(GROUP::GROUP_COLLECTIONS, false);
 	}
 }
 
@@ -4293,6 +4083,49 @@ void OsuSongBrowser2::playSelectedDifficulty()
 	}
 }
 
+namespace
+{
+// songButtonsByBeatmap maps sets and all of their diffs to their top level song button
+std::vector<OsuUISongBrowserButton *> getCollectionChildren(const OsuDatabase *db, const OsuDatabase::Collection &collection,
+                                                            const std::unordered_map<const OsuDatabaseBeatmap *, OsuUISongBrowserSongButton *> &songButtonsByBeatmap)
+{
+	// find all song buttons with at least one diff in this collection
+	std::vector<OsuUISongBrowserSongButton *> songButtons;
+	std::unordered_set<const OsuUISongBrowserSongButton *> songButtonsFound;
+	collection.entries.forEach([&](uint32_t id) {
+		const OsuDatabaseBeatmap *beatmap = db->getCollectionEntryBeatmap(id);
+		if (beatmap == NULL)
+			return;
+
+		const auto songButtonIt = songButtonsByBeatmap.find(beatmap);
+		if (songButtonIt != songButtonsByBeatmap.end() && songButtonsFound.insert(songButtonIt->second).second)
+			songButtons.push_back(songButtonIt->second);
+	});
+
+	// now add the buttons to the collection based on which of their diffs are in it
+	std::vector<OsuUISongBrowserButton *> children;
+	for (OsuUISongBrowserSongButton *songButton : songButtons)
+	{
+		const std::vector<OsuUISongBrowserButton *> &diffChildren = songButton->getChildren();
+
+		std::vector<OsuUISongBrowserButton *> matchingDiffs;
+		for (OsuUISongBrowserButton *diffButton : diffChildren)
+		{
+			if (diffButton->getDatabaseBeatmap() != NULL && db->isInCollection(collection, diffButton->getDatabaseBeatmap()->getMD5Hash()))
+				matchingDiffs.push_back(diffButton);
+		}
+
+		// if all diffs match, add the set button instead
+		if (diffChildren.size() == matchingDiffs.size() && !diffChildren.empty())
+			children.push_back(songButton);
+		else if (!matchingDiffs.empty()) // otherwise add only the matching diffs
+			children.insert(children.end(), matchingDiffs.begin(), matchingDiffs.end());
+	}
+
+	return children;
+}
+} // namespace
+
 void OsuSongBrowser2::recreateCollectionsButtons()
 {
 	// reset
@@ -4303,6 +4136,7 @@ void OsuSongBrowser2::recreateCollectionsButtons()
 			delete m_collectionButton;
 		}
 		m_collectionButtons.clear();
+		m_groupSortStamps.erase(GROUP::GROUP_COLLECTIONS);
 
 		// sanity
 		if (m_group == GROUP::GROUP_COLLECTIONS)
@@ -4312,102 +4146,46 @@ void OsuSongBrowser2::recreateCollectionsButtons()
 		}
 	}
 
-	// build lookup maps for faster collection creation
-	std::unordered_map<OsuDatabaseBeatmap *, OsuUISongBrowserButton *> beatmapToSongButton;
-	std::unordered_map<OsuDatabaseBeatmap *, std::vector<OsuUISongBrowserButton *>> beatmapToDiffButtons;
-	std::unordered_map<OsuUISongBrowserButton *, OsuUISongBrowserButton *> diffButtonToSongButton;
-
-	// populate lookup maps
-	for (auto songButton : m_songButtons)
+	// create collection buttons
+	for (const auto &collection : m_db->getCollections())
 	{
-		OsuDatabaseBeatmap *dbBeatmap = songButton->getDatabaseBeatmap();
-
-		// map the songButton itself
-		if (dbBeatmap != NULL)
-			beatmapToSongButton[dbBeatmap] = songButton;
-
-		// map all its children
-		const std::vector<OsuUISongBrowserButton *> &children = songButton->getChildren();
-		for (auto c : children)
-		{
-			OsuDatabaseBeatmap *childDbBeatmap = c->getDatabaseBeatmap();
-			if (childDbBeatmap != NULL)
-			{
-				beatmapToDiffButtons[childDbBeatmap].push_back(c);
-
-				// also track which song button contains this diff
-				if (beatmapToSongButton.find(childDbBeatmap) == beatmapToSongButton.end())
-					beatmapToSongButton[childDbBeatmap] = songButton;
-			}
-
-			// map diff button to its parent song button
-			diffButtonToSongButton[c] = songButton;
-		}
+		auto *collectionButton = new OsuUISongBrowserCollectionButton(this, m_songBrowser, m_contextMenu, 250, 250 + m_beatmaps.size() * 50, 200, 50, "", collection.name,
+		                                                              getCollectionChildren(m_db, collection, m_songButtonsByBeatmap));
+		m_collectionButtons.push_back(collectionButton);
 	}
+}
 
-	// create collection buttons using the lookup maps
-	const std::vector<OsuDatabase::Collection> &collections = m_db->getCollections();
-	for (const auto &collection : collections)
-	{
-		std::vector<OsuUISongBrowserButton *> children;
-		std::unordered_map<OsuUISongBrowserButton *, std::vector<OsuUISongBrowserButton *>> songButtonToMatchingDiffs;
-
-		// process all beatmaps in this collection
-		for (const auto &beatmap : collection.beatmaps)
-		{
-			const OsuDatabaseBeatmap *collectionBeatmap = beatmap.first;
-			const std::vector<OsuDatabaseBeatmap *> &colDiffs = beatmap.second;
+void OsuSongBrowser2::recreateCollectionButton(const UString &collectionName)
+{
+	const OsuDatabase::Collection *collection = m_db->getCollection(collectionName);
+	if (collection == NULL)
+		return;
 
-			// find matching song button and its diffs
-			auto songButtonIt = beatmapToSongButton.find(const_cast<OsuDatabaseBeatmap *>(collectionBeatmap));
-			if (songButtonIt != beatmapToSongButton.end())
-			{
-				OsuUISongBrowserButton *matchingSongButton = songButtonIt->second;
+	std::vector<OsuUISongBrowserButton *> children = getCollectionChildren(m_db, *collection, m_songButtonsByBeatmap);
 
-				// find matching diffs
-				std::vector<OsuUISongBrowserButton *> matchingDiffs;
-				const std::vector<OsuUISongBrowserButton *> &diffChildren = matchingSongButton->getChildren();
+	// keep everything sorted if the collections group already is, otherwise it gets sorted once it's shown
+	const auto stamp = m_groupSortStamps.find(GROUP::GROUP_COLLECTIONS);
+	const SORTING_METHOD *sortingMethod = (stamp != m_groupSortStamps.end() && stamp->second.sortKeysGeneration == m_sortKeys.getGeneration() ? findSortingMethod(stamp->second.sort) : nullptr);
+	if (sortingMethod != nullptr)
+		m_sortKeys.sort(children, sortingMethod->key);
 
-				// only process diffs if the matching song button has children
-				if (!diffChildren.empty())
-				{
-					for (auto colDiff : colDiffs)
-					{
-						auto diffButtonsIt = beatmapToDiffButtons.find(const_cast<OsuDatabaseBeatmap *>(colDiff));
-						if (diffButtonsIt != beatmapToDiffButtons.end())
-						{
-							for (OsuUISongBrowserButton *diffButton : diffButtonsIt->second)
-							{
-								// lookup the hash
-								auto parentSongButtonIt = diffButtonToSongButton.find(diffButton);
-								if (parentSongButtonIt != diffButtonToSongButton.end() && parentSongButtonIt->second == matchingSongButton)
-									matchingDiffs.push_back(diffButton);
-							}
-						}
-					}
-
-					// store for later
-					songButtonToMatchingDiffs[matchingSongButton] = matchingDiffs;
-				}
-			}
-		}
-
-		// now add the buttons to the collection based on the matches we found
-		for (auto &pair : songButtonToMatchingDiffs)
+	for (auto *collectionButton : m_collectionButtons)
+	{
+		if (collectionButton->getCollectionName() == collectionName)
 		{
-			OsuUISongBrowserButton *songButton = pair.first;
-			const std::vector<OsuUISongBrowserButton *> &matchingDiffs = pair.second;
-			const std::vector<OsuUISongBrowserButton *> &diffChildren = songButton->getChildren();
-
-			// if all diffs match, add the set button instead
-			if (diffChildren.size() == matchingDiffs.size() && !diffChildren.empty())
-				children.push_back(songButton);
-			else if (!matchingDiffs.empty()) // otherwise add only the matching diffs
-				children.insert(children.end(), matchingDiffs.begin(), matchingDiffs.end());
+			collectionButton->setChildren(std::move(children));
+			return;
 		}
+	}
 
-		auto *collectionButton =
-		    new OsuUISongBrowserCollectionButton(this, m_songBrowser, m_contextMenu, 250, 250 + m_beatmaps.size() * 50, 200, 50, "", collection.name, children);
-		m_collectionButtons.push_back(collectionButton);
+	// new collection
+	auto *collectionButton = new OsuUISongBrowserCollectionButton(this, m_songBrowser, m_contextMenu, 250, 250 + m_beatmaps.size() * 50, 200, 50, "", collection->name, children);
+	if (sortingMethod != nullptr)
+	{
+		// collections are always sorted alphabetically
+		const auto it = std::ranges::upper_bound(m_collectionButtons, collectionButton->getCollectionName(), UString::ncasecomp{}, [](const OsuUISongBrowserCollectionButton *btn) { return btn->getCollectionName(); });
+		m_collectionButtons.insert(it, collectionButton);
 	}
+	else
+		m_collectionButtons.push_back(collectionButton);
 }
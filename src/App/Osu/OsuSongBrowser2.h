@@ -10,8 +10,11 @@
 #define OSUSONGBROWSER2_H
 
 #include "OsuScreenBackable.h"
+#include "OsuSongBrowserSort.h"
 #include "MouseListener.h"
 
+#include <unordered_map>
+
 class Osu;
 class OsuBeatmap;
 class OsuDatabase;
@@ -104,6 +107,7 @@ public:
 	void scrollToSelectedSongButton();
 	void rebuildSongButtons();
 	void recreateCollectionsButtons();
+	void recreateCollectionButton(const UString &collectionName); // only updates this one (membership changed, or newly added)
 	void rebuildScoreButtons();
 	void updateSongButtonLayout();
 	void updateSongButtonSorting();
@@ -136,12 +140,23 @@ private:
 		SORT_TITLE
 	};
 
-	using SORT_COMPARATOR = std::function<bool(OsuUISongBrowserButton const*, OsuUISongBrowserButton const*)>;
 	struct SORTING_METHOD
 	{
 		SORT type;
 		UString name;
-		SORT_COMPARATOR comparator;
+		OsuSongBrowserSortKeys::KEY key;
+	};
+
+	struct SORTED_SONG_BUTTONS
+	{
+		uint64_t sortKeysGeneration;
+		std::vector<OsuUISongBrowserSongButton*> songButtons;
+	};
+
+	struct GROUP_SORT_STAMP
+	{
+		SORT sort;
+		uint64_t sortKeysGeneration;
 	};
 
 	struct GROUPING
@@ -152,10 +167,6 @@ private:
 	};
 
 private:
-	static bool searchMatcher(const OsuDatabaseBeatmap *databaseBeatmap, const std::vector<UString> &searchStringTokens);
-	static bool findSubstringInDifficulty(const OsuDatabaseBeatmap *diff, const UString &searchString);
-
-
 	void updateLayout() override;
 	void onBack() override;
 
@@ -193,7 +204,7 @@ private:
 	[[nodiscard]] std::vector<OsuUISongBrowserCollectionButton*>* getCollectionButtonsForGroup(GROUP group);
 
 	void onGroupTabButtonClicked(CBaseUIButton *groupTabButton);
-	void rebuildAfterGroupOrSortChange(GROUP group, bool autoScroll = true, SORT_COMPARATOR sortComp = nullptr);
+	void rebuildAfterGroupOrSortChange(GROUP group, bool autoScroll = true);
 
 	void onAfterSortingOrGroupChangeUpdateInt(bool autoScroll);
 
@@ -210,15 +221,23 @@ private:
 
 	void onScoreClicked(CBaseUIButton *button);
 
+	[[nodiscard]] const SORTING_METHOD *findSortingMethod(SORT type) const;
+	void updateSortedCaches(OsuUISongBrowserSongButton *songButton, bool isNew); // after adding a song button, or after its sort keys changed
+	void addToGroup(GROUP group, OsuUISongBrowserCollectionButton *groupButton, OsuUISongBrowserButton *button);
+
 	void selectSongButton(OsuUISongBrowserButton *songButton);
 	void selectPreviousRandomBeatmap();
 	void playSelectedDifficulty();
+	void prefetchNeighbourAudio(const OsuDatabaseBeatmap *diff2);
 
 	std::mt19937 m_rngalg;
 	GROUP m_group;
 	std::vector<GROUPING> m_groupings;
 	SORT m_sortingMethod;
 	std::vector<SORTING_METHOD> m_sortingMethods;
+	OsuSongBrowserSortKeys m_sortKeys;
+	std::unordered_map<SORT, SORTED_SONG_BUTTONS> m_sortedSongButtonsCache; // m_songButtons per sorting method, as long as the sort keys stay valid
+	std::unordered_map<GROUP, GROUP_SORT_STAMP> m_groupSortStamps; // how the children of each group were last sorted
 
 	// top bar
 	float m_fSongSelectTopScale;
@@ -275,6 +294,7 @@ private:
 	OsuDatabase *m_db;
 	std::vector<OsuDatabaseBeatmap*> m_beatmaps;
 	std::vector<OsuUISongBrowserSongButton*> m_songButtons;
+	std::unordered_map<const OsuDatabaseBeatmap*, OsuUISongBrowserSongButton*> m_songButtonsByBeatmap; // (also all diffs of each set) for incremental updates
 	std::vector<OsuUISongBrowserButton*> m_visibleSongButtons;
 	std::vector<OsuUISongBrowserCollectionButton*> m_collectionButtons;
 	std::vector<OsuUISongBrowserCollectionButton*> m_artistCollectionButtons;
@@ -319,6 +339,7 @@ private:
 	// background star calculation (entire database)
 	float m_fBackgroundStarCalculationWorkNotificationTime;
 	int m_iBackgroundStarCalculationIndex;
+	uint64_t m_iSearchDataRevision; // bumped whenever the background star calculation changes numbers which searches can filter by
 	OsuDatabaseBeatmapStarCalculator *m_backgroundStarCalculator;
 	OsuDatabaseBeatmap *m_backgroundStarCalcTempParent;
 
@@ -0,0 +1,365 @@
+//================ Copyright (c) 2025, WH, All rights reserved. =================//
+//
+// Purpose:		precompiled song browser search queries, and the index they run against
+//
+// $NoKeywords: $osusbsearch
+//===============================================================================//
+
+#include "OsuSongBrowserSearch.h"
+
+#include "OsuDatabaseBeatmap.h"
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <utility>
+
+//*****************************//
+//	OsuSongBrowserSearchIndex  //
+//*****************************//
+
+OsuSongBrowserSearchIndex::BIGRAMS OsuSongBrowserSearchIndex::getBigrams(std::string_view text)
+{
+	BIGRAMS bigrams{};
+	for (size_t i=1; i<text.length(); i++)
+	{
+		const uint8_t hash = static_cast<uint8_t>(static_cast<uint8_t>(text[i - 1]) * 31u + static_cast<uint8_t>(text[i]));
+		bigrams[hash >> 6] |= (1ull << (hash & 63));
+	}
+	return bigrams;
+}
+
+OsuSongBrowserSearchIndex::ROW OsuSongBrowserSearchIndex::addRow(const OsuDatabaseBeatmap *diff)
+{
+	const auto it = m_rows.find(diff);
+	if (it != m_rows.end())
+		return it->second;
+
+	const auto row = static_cast<ROW>(m_diffs.size());
+	m_rows.emplace(diff, row);
+	m_diffs.push_back(diff);
+
+	// text
+	const size_t textStart = m_text.length();
+	{
+		const auto appendField = [this](const UString &field) {
+			if (field.length() > 0)
+			{
+				UString folded = field;
+				folded.lowerCase();
+				m_text.append(folded.utf8View());
+			}
+			m_text.push_back('\0');
+		};
+
+		appendField(diff->getTitle());
+		appendField(diff->getArtist());
+		appendField(diff->getCreator());
+		appendField(diff->getDifficultyName());
+		appendField(diff->getSource());
+		appendField(diff->getTags());
+
+		if (diff->getID() > 0)
+			m_text.append(std::to_string(diff->getID()));
+		m_text.push_back('\0');
+
+		if (diff->getSetID() > 0)
+			m_text.append(std::to_string(diff->getSetID()));
+		m_text.push_back('\0');
+	}
+	m_textOffsets.push_back(static_cast<uint32_t>(m_text.length()));
+	m_textBigrams.push_back(getBigrams(std::string_view(m_text).substr(textStart)));
+
+	// numbers
+	setNumericRow(row, diff);
+
+	return row;
+}
+
+void OsuSongBrowserSearchIndex::refreshNumericColumns()
+{
+	for (size_t row=0; row<m_diffs.size(); row++)
+	{
+		setNumericRow(static_cast<ROW>(row), m_diffs[row]);
+	}
+}
+
+void OsuSongBrowserSearchIndex::clear()
+{
+	m_rows.clear();
+	m_diffs.clear();
+
+	m_text.clear();
+	m_textOffsets.assign(1, 0);
+	m_textBigrams.clear();
+
+	m_numeric = NUMERIC_COLUMNS{};
+}
+
+void OsuSongBrowserSearchIndex::setNumericRow(ROW row, const OsuDatabaseBeatmap *diff)
+{
+	if (row >= m_numeric.ar.size())
+	{
+		const size_t numRows = static_cast<size_t>(row) + 1;
+		m_numeric.ar.resize(numRows);
+		m_numeric.cs.resize(numRows);
+		m_numeric.od.resize(numRows);
+		m_numeric.hp.resize(numRows);
+		m_numeric.starsNomod.resize(numRows);
+		m_numeric.mostCommonBPM.resize(numRows);
+		m_numeric.numObjects.resize(numRows);
+		m_numeric.numCircles.resize(numRows);
+		m_numeric.numSliders.resize(numRows);
+		m_numeric.numSpinners.resize(numRows);
+		m_numeric.lengthMS.resize(numRows);
+	}
+
+	m_numeric.ar[row] = diff->getAR();
+	m_numeric.cs[row] = diff->getCS();
+	m_numeric.od[row] = diff->getOD();
+	m_numeric.hp[row] = diff->getHP();
+	m_numeric.starsNomod[row] = diff->getStarsNomod();
+	m_numeric.mostCommonBPM[row] = diff->getMostCommonBPM();
+	m_numeric.numObjects[row] = diff->getNumObjects();
+	m_numeric.numCircles[row] = diff->getNumCircles();
+	m_numeric.numSliders[row] = diff->getNumSliders();
+	m_numeric.numSpinners[row] = diff->getNumSpinners();
+	m_numeric.lengthMS[row] = diff->getLengthMS();
+}
+
+//*****************************//
+//	OsuSongBrowserSearchQuery  //
+//*****************************//
+
+OsuSongBrowserSearchQuery::OsuSongBrowserSearchQuery(const UString &searchString, float speedMultiplier)
+{
+	m_fSpeedMultiplier = speedMultiplier;
+
+	// NOTE: the order of the operators does matter, because find() is used to detect their presence (and '=' would then break '<=' etc.)
+	static const std::array<std::pair<UString, OPERATOR>, 7> operators =
+	{{
+		{"<=", OPERATOR::LE},
+		{">=", OPERATOR::GE},
+		{"<", OPERATOR::LT},
+		{">", OPERATOR::GT},
+		{"!=", OPERATOR::NE},
+		{"==", OPERATOR::EQ},
+		{"=", OPERATOR::EQ},
+	}};
+
+	static const std::array<std::pair<UString, KEYWORD>, 20> keywords =
+	{{
+		{"ar", KEYWORD::AR},
+		{"cs", KEYWORD::CS},
+		{"od", KEYWORD::OD},
+		{"hp", KEYWORD::HP},
+		{"bpm", KEYWORD::BPM},
+		{"opm", KEYWORD::OPM},
+		{"cpm", KEYWORD::CPM},
+		{"spm", KEYWORD::SPM},
+		{"object", KEYWORD::OBJECTS},
+		{"objects", KEYWORD::OBJECTS},
+		{"circle", KEYWORD::CIRCLES},
+		{"circles", KEYWORD::CIRCLES},
+		{"slider", KEYWORD::SLIDERS},
+		{"sliders", KEYWORD::SLIDERS},
+		{"spinner", KEYWORD::SPINNERS},
+		{"spinners", KEYWORD::SPINNERS},
+		{"length", KEYWORD::LENGTH},
+		{"len", KEYWORD::LENGTH},
+		{"stars", KEYWORD::STARS},
+		{"star", KEYWORD::STARS},
+	}};
+
+	// every token is either an expression (keyword, operator, number), or a literal
+	// only singular expressions are accepted, things like "0<bpm<1" end up as literals
+	for (const UString &token : searchString.split(" "))
+	{
+		bool isExpression = false;
+		for (const auto &[operatorString, op] : operators)
+		{
+			if (token.find(operatorString) == -1)
+				continue;
+
+			const std::vector<UString> values = token.split(operatorString);
+			if (values.size() == 2 && values[0].length() > 0 && values[1].length() > 0)
+			{
+				const auto keyword = std::ranges::find(keywords, values[0], &std::pair<UString, KEYWORD>::first);
+				if (keyword != keywords.end())
+				{
+					const int rvaluePercentIndex = values[1].find("%");
+
+					EXPRESSION expression{};
+					expression.keyword = keyword->second;
+					expression.op = op;
+					expression.isPercent = (rvaluePercentIndex != -1);
+					expression.value = (rvaluePercentIndex == -1 ? values[1].toFloat() : values[1].substr(0, rvaluePercentIndex).toFloat()); // (assume that this is always a number)
+
+					m_expressions.push_back(expression);
+					isExpression = true;
+				}
+			}
+
+			break;
+		}
+
+		if (isExpression)
+			continue;
+
+		UString literal = token.trim();
+		if (literal.length() < 1 || literal.isWhitespaceOnly())
+			continue;
+
+		literal.lowerCase();
+		std::string text(literal.utf8View());
+		if (std::ranges::any_of(m_literals, [&](const LITERAL &existing) { return existing.text == text; }))
+			continue;
+
+		const OsuSongBrowserSearchIndex::BIGRAMS bigrams = OsuSongBrowserSearchIndex::getBigrams(text);
+		m_literals.push_back(LITERAL{.text = std::move(text), .bigrams = bigrams});
+	}
+}
+
+bool OsuSongBrowserSearchQuery::matches(std::span<const OsuSongBrowserSearchIndex::ROW> rows, const OsuSongBrowserSearchIndex &index) const
+{
+	if (rows.empty()) return false;
+
+	// the expressions and the literals don't have to match on the same difficulty
+	if (m_expressions.size() > 0 && std::ranges::none_of(rows, [&](OsuSongBrowserSearchIndex::ROW row) { return matchesExpressions(index, row); }))
+		return false;
+
+	if (m_literals.empty())
+		return true;
+
+	return std::ranges::any_of(rows, [&](OsuSongBrowserSearchIndex::ROW row) { return matchesLiterals(index, row); });
+}
+
+bool OsuSongBrowserSearchQuery::refines(const OsuSongBrowserSearchQuery &previous) const
+{
+	if (m_fSpeedMultiplier != previous.m_fSpeedMultiplier)
+		return false;
+
+	// every previous expression must still be there unchanged
+	for (const EXPRESSION &expression : previous.m_expressions)
+	{
+		if (std::ranges::find(m_expressions, expression) == m_expressions.end())
+			return false;
+	}
+
+	// and every previous literal must be contained in one of the new ones (any text containing the new one then also contains the previous one)
+	for (const LITERAL &literal : previous.m_literals)
+	{
+		if (std::ranges::none_of(m_literals, [&](const LITERAL &newLiteral) { return newLiteral.text.find(literal.text) != std::string::npos; }))
+			return false;
+	}
+
+	return true;
+}
+
+bool OsuSongBrowserSearchQuery::matchesExpressions(const OsuSongBrowserSearchIndex &index, OsuSongBrowserSearchIndex::ROW row) const
+{
+	const OsuSongBrowserSearchIndex::NUMERIC_COLUMNS &columns = index.getNumericColumns();
+
+	const unsigned long lengthMS = columns.lengthMS[row];
+	const float lengthMinutes = (float)(lengthMS / 1000.0f / 60.0f);
+
+	for (const EXPRESSION &expression : m_expressions)
+	{
+		float compareValue = 5.0f;
+		switch (expression.keyword)
+		{
+		case KEYWORD::AR:
+			compareValue = columns.ar[row];
+			break;
+		case KEYWORD::CS:
+			compareValue = columns.cs[row];
+			break;
+		case KEYWORD::OD:
+			compareValue = columns.od[row];
+			break;
+		case KEYWORD::HP:
+			compareValue = columns.hp[row];
+			break;
+		case KEYWORD::BPM:
+			compareValue = columns.mostCommonBPM[row];
+			break;
+		case KEYWORD::OPM:
+			compareValue = (lengthMS > 0 ? ((float)columns.numObjects[row] / lengthMinutes) : 0.0f) * m_fSpeedMultiplier;
+			break;
+		case KEYWORD::CPM:
+			compareValue = (lengthMS > 0 ? ((float)columns.numCircles[row] / lengthMinutes) : 0.0f) * m_fSpeedMultiplier;
+			break;
+		case KEYWORD::SPM:
+			compareValue = (lengthMS > 0 ? ((float)columns.numSliders[row] / lengthMinutes) : 0.0f) * m_fSpeedMultiplier;
+			break;
+		case KEYWORD::OBJECTS:
+			compareValue = columns.numObjects[row];
+			break;
+		case KEYWORD::CIRCLES:
+			compareValue = (expression.isPercent ? ((float)columns.numCircles[row] / (float)columns.numObjects[row])*100.0f : columns.numCircles[row]);
+			break;
+		case KEYWORD::SLIDERS:
+			compareValue = (expression.isPercent ? ((float)columns.numSliders[row] / (float)columns.numObjects[row])*100.0f : columns.numSliders[row]);
+			break;
+		case KEYWORD::SPINNERS:
+			compareValue = (expression.isPercent ? ((float)columns.numSpinners[row] / (float)columns.numObjects[row])*100.0f : columns.numSpinners[row]);
+			break;
+		case KEYWORD::LENGTH:
+			compareValue = lengthMS / 1000;
+			break;
+		case KEYWORD::STARS:
+			compareValue = std::round(columns.starsNomod[row] * 100.0f) / 100.0f; // round to 2 decimal places
+			break;
+		}
+
+		bool matches = false;
+		switch (expression.op)
+		{
+		case OPERATOR::LE:
+			matches = (compareValue <= expression.value);
+			break;
+		case OPERATOR::GE:
+			matches = (compareValue >= expression.value);
+			break;
+		case OPERATOR::LT:
+			matches = (compareValue < expression.value);
+			break;
+		case OPERATOR::GT:
+			matches = (compareValue > expression.value);
+			break;
+		case OPERATOR::NE:
+			matches = (compareValue != expression.value);
+			break;
+		case OPERATOR::EQ:
+			matches = (compareValue == expression.value);
+			break;
+		}
+
+		if (!matches) // if a single expression doesn't match, then the whole diff doesn't match
+			return false;
+	}
+
+	return true;
+}
+
+bool OsuSongBrowserSearchQuery::matchesLiterals(const OsuSongBrowserSearchIndex &index, OsuSongBrowserSearchIndex::ROW row) const
+{
+	const OsuSongBrowserSearchIndex::BIGRAMS &rowBigrams = index.getTextBigrams(row);
+	const std::string_view text = index.getText(row);
+
+	for (const LITERAL &literal : m_literals)
+	{
+		// cheap reject first, most rows don't even contain all bigrams of a literal
+		for (size_t i=0; i<rowBigrams.size(); i++)
+		{
+			if ((rowBigrams[i] & literal.bigrams[i]) != literal.bigrams[i])
+				return false;
+		}
+
+		// (the fields are '\0' separated, so this can't match across fields)
+		if (text.find(literal.text) == std::string_view::npos)
+			return false;
+	}
+
+	return true;
+}
@@ -0,0 +1,141 @@
+//================ Copyright (c) 2025, WH, All rights reserved. =================//
+//
+// Purpose:		precompiled song browser search queries, and the index they run against
+//
+// $NoKeywords: $osusbsearch
+//===============================================================================//
+
+#pragma once
+#ifndef OSUSONGBROWSERSEARCH_H
+#define OSUSONGBROWSERSEARCH_H
+
+#include "cbase.h"
+
+#include <array>
+#include <span>
+#include <unordered_map>
+
+class OsuDatabaseBeatmap;
+
+// Columns of every difficulty the search has seen so far (rows are added by addRow(), before searching).
+// The text column holds all searchable strings of a difficulty lowercase folded and '\0' separated, plus a bigram bloom filter
+// to skip most rows without searching them. Text never changes after loading, but the numeric columns have to be refreshed
+// before every search, since the background star calculation keeps updating stars/length/objects of already indexed difficulties.
+// NOT thread safe while adding rows or refreshing, owned by the background search matcher (the search shards only read it).
+class OsuSongBrowserSearchIndex
+{
+public:
+	using ROW = uint32_t;
+	using BIGRAMS = std::array<uint64_t, 4>;
+
+	static BIGRAMS getBigrams(std::string_view text);
+
+	struct NUMERIC_COLUMNS
+	{
+		std::vector<float> ar;
+		std::vector<float> cs;
+		std::vector<float> od;
+		std::vector<float> hp;
+		std::vector<float> starsNomod;
+		std::vector<int> mostCommonBPM;
+		std::vector<int> numObjects;
+		std::vector<int> numCircles;
+		std::vector<int> numSliders;
+		std::vector<int> numSpinners;
+		std::vector<unsigned long> lengthMS;
+	};
+
+public:
+	ROW addRow(const OsuDatabaseBeatmap *diff); // returns the existing row if there already is one
+
+	void refreshNumericColumns();
+	void clear(); // must be called whenever indexed difficulties get deleted
+
+	[[nodiscard]] inline size_t getNumRows() const {return m_diffs.size();}
+	[[nodiscard]] inline std::string_view getText(ROW row) const {return std::string_view(m_text).substr(m_textOffsets[row], m_textOffsets[row + 1] - m_textOffsets[row]);}
+	[[nodiscard]] inline const BIGRAMS &getTextBigrams(ROW row) const {return m_textBigrams[row];}
+	[[nodiscard]] inline const NUMERIC_COLUMNS &getNumericColumns() const {return m_numeric;}
+
+private:
+	void setNumericRow(ROW row, const OsuDatabaseBeatmap *diff);
+
+	std::unordered_map<const OsuDatabaseBeatmap*, ROW> m_rows;
+	std::vector<const OsuDatabaseBeatmap*> m_diffs;
+
+	std::string m_text;
+	std::vector<uint32_t> m_textOffsets{0};
+	std::vector<BIGRAMS> m_textBigrams;
+
+	NUMERIC_COLUMNS m_numeric;
+};
+
+// A search string parsed once into numeric expressions ("ar>9", "circles>=50%") and lowercase literals.
+// A beatmap (set) matches if any difficulty matches all expressions, and any difficulty contains all literals.
+class OsuSongBrowserSearchQuery
+{
+public:
+	OsuSongBrowserSearchQuery(const UString &searchString, float speedMultiplier);
+
+	// rows of all difficulties of one beatmap (set)
+	[[nodiscard]] bool matches(std::span<const OsuSongBrowserSearchIndex::ROW> rows, const OsuSongBrowserSearchIndex &index) const;
+
+	// true if everything matching this query is guaranteed to also match the previous one (e.g. one more character typed)
+	[[nodiscard]] bool refines(const OsuSongBrowserSearchQuery &previous) const;
+
+	[[nodiscard]] inline bool hasExpressions() const {return m_expressions.size() > 0;}
+
+private:
+	enum class OPERATOR : uint8_t
+	{
+		EQ,
+		LT,
+		GT,
+		LE,
+		GE,
+		NE
+	};
+
+	enum class KEYWORD : uint8_t
+	{
+		AR,
+		CS,
+		OD,
+		HP,
+		BPM,
+		OPM,
+		CPM,
+		SPM,
+		OBJECTS,
+		CIRCLES,
+		SLIDERS,
+		SPINNERS,
+		LENGTH,
+		STARS
+	};
+
+	struct EXPRESSION
+	{
+		KEYWORD keyword;
+		OPERATOR op;
+		float value;
+		bool isPercent;
+
+		bool operator==(const EXPRESSION &) const = default;
+	};
+
+	struct LITERAL
+	{
+		std::string text; // lowercase
+		OsuSongBrowserSearchIndex::BIGRAMS bigrams;
+	};
+
+	[[nodiscard]] bool matchesExpressions(const OsuSongBrowserSearchIndex &index, OsuSongBrowserSearchIndex::ROW row) const;
+	[[nodiscard]] bool matchesLiterals(const OsuSongBrowserSearchIndex &index, OsuSongBrowserSearchIndex::ROW row) const;
+
+	float m_fSpeedMultiplier;
+
+	std::vector<EXPRESSION> m_expressions;
+	std::vector<LITERAL> m_literals;
+};
+
+#endif
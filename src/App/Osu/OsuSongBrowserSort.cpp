@@ -0,0 +1,159 @@
+//================ Copyright (c) 2025, WH, All rights reserved. =================//
+//
+// Purpose:		precomputed sort keys for the song browser sorting methods
+//
+// $NoKeywords: $osusbsort
+//===============================================================================//
+
+#include "OsuSongBrowserSort.h"
+
+#include "OsuDatabaseBeatmap.h"
+#include "OsuUISongBrowserButton.h"
+
+#include <algorithm>
+#include <numeric>
+
+float OsuSongBrowserSortKeys::getMaxDifficulty(const OsuDatabaseBeatmap *beatmap)
+{
+	const auto getDifficulty = [](const OsuDatabaseBeatmap *diff) -> float {
+		const float stars = diff->getStarsNomod();
+		if (stars > 0)
+			return stars;
+
+		// fallback calculation
+		return (diff->getAR() + 1) * (diff->getCS() + 1) * (diff->getHP() + 1) * (diff->getOD() + 1) * (std::max(diff->getMostCommonBPM(), 1));
+	};
+
+	float maxDiff = getDifficulty(beatmap);
+
+	// check children for higher difficulty
+	for (const OsuDatabaseBeatmap *diff : beatmap->getDifficulties())
+	{
+		maxDiff = std::max(maxDiff, getDifficulty(diff));
+	}
+
+	return maxDiff;
+}
+
+OsuSongBrowserSortKeys::OsuSongBrowserSortKeys()
+{
+	m_iGeneration = 1; // (0 is never valid, see getKeys())
+}
+
+void OsuSongBrowserSortKeys::clear()
+{
+	m_keys = std::unordered_map<const OsuDatabaseBeatmap*, KEYS>();
+	m_iGeneration++;
+}
+
+const OsuSongBrowserSortKeys::KEYS &OsuSongBrowserSortKeys::getKeys(const OsuDatabaseBeatmap *beatmap)
+{
+	KEYS &keys = m_keys[beatmap];
+	if (keys.generation == m_iGeneration)
+		return keys;
+
+	keys.generation = m_iGeneration;
+
+	keys.artist = UString::ncasecomp::collationKey(beatmap->getArtist());
+	keys.creator = UString::ncasecomp::collationKey(beatmap->getCreator());
+	keys.title = UString::ncasecomp::collationKey(beatmap->getTitle());
+
+	keys.maxBPM = beatmap->getMostCommonBPM();
+	keys.maxLastModificationTime = beatmap->getLastModificationTime();
+	keys.maxLengthMS = beatmap->getLengthMS();
+	for (const OsuDatabaseBeatmap *diff : beatmap->getDifficulties())
+	{
+		keys.maxBPM = std::max(keys.maxBPM, diff->getMostCommonBPM());
+		keys.maxLastModificationTime = std::max(keys.maxLastModificationTime, diff->getLastModificationTime());
+		keys.maxLengthMS = std::max(keys.maxLengthMS, diff->getLengthMS());
+	}
+	keys.maxDifficulty = getMaxDifficulty(beatmap);
+
+	return keys;
+}
+
+template <typename FUNC>
+void OsuSongBrowserSortKeys::visitKey(KEY key, FUNC &&func)
+{
+	switch (key)
+	{
+	case KEY::ARTIST:
+		func([](const KEYS &keys) -> const std::wstring & { return keys.artist; }, false);
+		break;
+	case KEY::BPM:
+		func([](const KEYS &keys) -> const int & { return keys.maxBPM; }, false);
+		break;
+	case KEY::CREATOR:
+		func([](const KEYS &keys) -> const std::wstring & { return keys.creator; }, false);
+		break;
+	case KEY::DATEADDED:
+		func([](const KEYS &keys) -> const long long & { return keys.maxLastModificationTime; }, true);
+		break;
+	case KEY::DIFFICULTY:
+		func([](const KEYS &keys) -> const float & { return keys.maxDifficulty; }, false);
+		break;
+	case KEY::LENGTH:
+		func([](const KEYS &keys) -> const unsigned long & { return keys.maxLengthMS; }, false);
+		break;
+	case KEY::TITLE:
+		func([](const KEYS &keys) -> const std::wstring & { return keys.title; }, false);
+		break;
+	}
+}
+
+template <typename PROJECTION>
+bool OsuSongBrowserSortKeys::isLess(const ENTRY &a, const ENTRY &b, PROJECTION projection, bool descending)
+{
+	if (a.keys == NULL || b.keys == NULL)
+	{
+		if ((a.keys == NULL) != (b.keys == NULL))
+			return a.keys == NULL;
+
+		return a.sortHack < b.sortHack;
+	}
+
+	const auto &keyA = projection(*a.keys);
+	const auto &keyB = projection(*b.keys);
+
+	// strict weak ordering!
+	if (keyA == keyB)
+		return descending ? a.sortHack > b.sortHack : a.sortHack < b.sortHack;
+
+	return descending ? keyB < keyA : keyA < keyB;
+}
+
+OsuSongBrowserSortKeys::ENTRY OsuSongBrowserSortKeys::getEntry(const OsuUISongBrowserButton *button)
+{
+	const OsuDatabaseBeatmap *beatmap = button->getDatabaseBeatmap();
+	return ENTRY{.keys = (beatmap != NULL ? &getKeys(beatmap) : NULL), .sortHack = button->getSortHack()};
+}
+
+bool OsuSongBrowserSortKeys::isLess(const OsuUISongBrowserButton *a, const OsuUISongBrowserButton *b, KEY key)
+{
+	const ENTRY entryA = getEntry(a);
+	const ENTRY entryB = getEntry(b);
+
+	bool less = false;
+	visitKey(key, [&](auto projection, bool descending) {less = isLess(entryA, entryB, projection, descending);});
+	return less;
+}
+
+std::vector<uint32_t> OsuSongBrowserSortKeys::getSortedPermutation(const std::vector<const OsuUISongBrowserButton*> &buttons, KEY key)
+{
+	// (the map only grows here, so references into it stay valid while collecting)
+	std::vector<ENTRY> entries;
+	entries.reserve(buttons.size());
+	for (const OsuUISongBrowserButton *button : buttons)
+	{
+		entries.push_back(getEntry(button));
+	}
+
+	std::vector<uint32_t> permutation(buttons.size());
+	std::iota(permutation.begin(), permutation.end(), 0);
+
+	visitKey(key, [&](auto projection, bool descending) {
+		std::ranges::sort(permutation, [&](uint32_t a, uint32_t b) {return isLess(entries[a], entries[b], projection, descending);});
+	});
+
+	return permutation;
+}
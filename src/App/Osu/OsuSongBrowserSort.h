@@ -0,0 +1,112 @@
+//================ Copyright (c) 2025, WH, All rights reserved. =================//
+//
+// Purpose:		precomputed sort keys for the song browser sorting methods
+//
+// $NoKeywords: $osusbsort
+//===============================================================================//
+
+#pragma once
+#ifndef OSUSONGBROWSERSORT_H
+#define OSUSONGBROWSERSORT_H
+
+#include "cbase.h"
+
+#include <algorithm>
+#include <unordered_map>
+
+class OsuDatabaseBeatmap;
+class OsuUISongBrowserButton;
+
+// Sort keys of every beatmap (set) sorted so far: case folded collation keys for the text sorts, and the maximum over all
+// difficulties for the numeric ones. Comparisons are then plain key compares, instead of walking all difficulties and
+// case folding both strings inside every single comparison.
+// Keys are computed on first use and stay valid until invalidate(), which has to be called whenever beatmap data
+// or the set of song buttons changes (getGeneration() can be used to validate anything derived from the keys).
+class OsuSongBrowserSortKeys
+{
+public:
+	enum class KEY : uint8_t
+	{
+		ARTIST,
+		BPM,
+		CREATOR,
+		DATEADDED, // descending
+		DIFFICULTY,
+		LENGTH,
+		TITLE
+	};
+
+	// stars, or a fallback heuristic if they haven't been calculated yet (maximum over all difficulties)
+	[[nodiscard]] static float getMaxDifficulty(const OsuDatabaseBeatmap *beatmap);
+
+public:
+	OsuSongBrowserSortKeys();
+
+	// ties (and buttons without beatmap) are ordered by button creation order
+	template <typename T>
+	void sort(std::vector<T*> &buttons, KEY key)
+	{
+		const std::vector<uint32_t> permutation = getSortedPermutation(std::vector<const OsuUISongBrowserButton*>(buttons.begin(), buttons.end()), key);
+
+		std::vector<T*> sorted;
+		sorted.reserve(buttons.size());
+		for (const uint32_t index : permutation)
+		{
+			sorted.push_back(buttons[index]);
+		}
+		buttons = std::move(sorted);
+	}
+
+	// inserts into a list which is already sorted by the same key (after all equal ones), for incremental updates
+	template <typename T>
+	void insert(std::vector<T*> &sortedButtons, T *button, KEY key)
+	{
+		const auto it = std::upper_bound(sortedButtons.begin(), sortedButtons.end(), button, [&](const T *a, const T *b) {return isLess(a, b, key);});
+		sortedButtons.insert(it, button);
+	}
+
+	[[nodiscard]] bool isLess(const OsuUISongBrowserButton *a, const OsuUISongBrowserButton *b, KEY key);
+
+	void invalidate() {m_iGeneration++;}
+	void invalidate(const OsuDatabaseBeatmap *beatmap) {m_keys.erase(beatmap);} // only this beatmap changed, everything derived from the other keys stays valid
+	void clear(); // must be called before beatmaps get deleted
+
+	[[nodiscard]] inline uint64_t getGeneration() const {return m_iGeneration;}
+
+private:
+	struct KEYS
+	{
+		uint64_t generation;
+
+		std::wstring artist;
+		std::wstring creator;
+		std::wstring title;
+
+		int maxBPM;
+		long long maxLastModificationTime;
+		unsigned long maxLengthMS;
+		float maxDifficulty;
+	};
+
+	struct ENTRY
+	{
+		const KEYS *keys; // NULL for buttons without beatmap (always sorted first)
+		int sortHack;
+	};
+
+	// calls func(projection, descending) with the projection of KEYS to the sort key
+	template <typename FUNC>
+	static void visitKey(KEY key, FUNC &&func);
+
+	template <typename PROJECTION>
+	static bool isLess(const ENTRY &a, const ENTRY &b, PROJECTION projection, bool descending);
+
+	ENTRY getEntry(const OsuUISongBrowserButton *button);
+	const KEYS &getKeys(const OsuDatabaseBeatmap *beatmap);
+	std::vector<uint32_t> getSortedPermutation(const std::vector<const OsuUISongBrowserButton*> &buttons, KEY key);
+
+	std::unordered_map<const OsuDatabaseBeatmap*, KEYS> m_keys;
+	uint64_t m_iGeneration;
+};
+
+#endif
@@ -46,13 +46,6 @@ OsuUISongBrowserSongButton::OsuUISongBrowserSongButton(OsuSongBrowser2 *songBrow
 	// settings
 	setHideIfSelected(true);
 
-	// labels
-	/*
-	m_sTitle = "Title";
-	m_sArtist = "Artist";
-	m_sMapper = "Mapper";
-	*/
-
 	m_fThumbnailFadeInTime = 0.0f;
 	m_fTextOffset = 0.0f;
 	m_fGradeOffset = 0.0f;
@@ -348,48 +341,18 @@ void OsuUISongBrowserSongButton::triggerContextMenu(Vector2 pos)
 				// the entry could be either a set button, or an independent diff button
 				bool isLegacyEntry = false;
 				{
-					const std::vector<OsuDatabase::Collection> &collections = osu->getSongBrowser()->getDatabase()->getCollections();
-					for (size_t i=0; i<collections.size(); i++)
+					const OsuDatabase *db = osu->getSongBrowser()->getDatabase();
+					const OsuDatabase::Collection *collection = db->getCollection(collectionName);
+					if (collection != NULL)
 					{
-						if (collections[i].name == collectionName)
+						if (m_databaseBeatmap->getDifficulties().size() < 1)
+							isLegacyEntry = db->isLegacyCollectionEntry(*collection, m_databaseBeatmap->getMD5Hash()); // independent diff
+						else
 						{
-							for (size_t e=0; e<collections[i].hashes.size(); e++)
-							{
-								if (m_databaseBeatmap->getDifficulties().size() < 1)
-								{
-									// independent diff
-
-									if (collections[i].hashes[e].hash == m_databaseBeatmap->getMD5Hash())
-									{
-										isLegacyEntry = collections[i].hashes[e].isLegacyEntry;
-										break;
-									}
-								}
-								else
-								{
-									// set
-
-									const std::vector<OsuDatabaseBeatmap*> &diffs = m_databaseBeatmap->getDifficulties();
-
-									for (size_t d=0; d<diffs.size(); d++)
-									{
-										if (collections[i].hashes[e].hash == diffs[d]->getMD5Hash())
-										{
-											// one single entry of the set coming from osu! is enough to deny removing the set (as a whole)
-											if (collections[i].hashes[e].isLegacyEntry)
-											{
-												isLegacyEntry = true;
-												break;
-											}
-										}
-									}
-
-									if (isLegacyEntry)
-										break;
-								}
-							}
-
-							break;
+							// set: one single entry of the set coming from osu! is enough to deny removing the set (as a whole)
+							isLegacyEntry = std::ranges::any_of(m_databaseBeatmap->getDifficulties(), [&](const OsuDatabaseBeatmap *diff) {
+								return db->isLegacyCollectionEntry(*collection, diff->getMD5Hash());
+							});
 						}
 					}
 				}
@@ -442,89 +405,33 @@ void OsuUISongBrowserSongButton::onContextMenu(const UString& text, int id)
 				spacer->setTextColor(0xff888888);
 				spacer->setTextDarkColor(0xff000000);
 
+				const OsuDatabase *db = osu->getSongBrowser()->getDatabase();
 				for (size_t i=0; i<collections.size(); i++)
 				{
-					bool isDiffAndAlreadyContained = false;
-					if (m_databaseBeatmap != NULL && m_databaseBeatmap->getDifficulties().size() < 1)
-					{
-						for (size_t h=0; h<collections[i].hashes.size(); h++)
-						{
-							if (collections[i].hashes[h].hash == m_databaseBeatmap->getMD5Hash())
-							{
-								isDiffAndAlreadyContained = true;
-
-								// edge case: allow adding the set of this diff if it does not represent the entire set (and the set is not yet added completely)
-								if (id == 2)
-								{
-									const auto *diffButtonPointer = this->as<const OsuUISongBrowserSongDifficultyButton>();
-									if (diffButtonPointer != NULL && diffButtonPointer->getParentSongButton() != NULL && diffButtonPointer->getParentSongButton()->getDatabaseBeatmap() != NULL)
-									{
-										const OsuDatabaseBeatmap *setContainer = diffButtonPointer->getParentSongButton()->getDatabaseBeatmap();
-
-										if (setContainer->getDifficulties().size() > 1)
-										{
-											const std::vector<OsuDatabaseBeatmap*> &diffs = setContainer->getDifficulties();
-
-											bool isSetAlreadyContained = true;
-											for (size_t s=0; s<diffs.size(); s++)
-											{
-												bool isDiffAlreadyContained = false;
-												for (size_t h2=0; h2<collections[i].hashes.size(); h2++)
-												{
-													if (diffs[s]->getMD5Hash() == collections[i].hashes[h2].hash)
-													{
-														isDiffAlreadyContained = true;
-														break;
-													}
-												}
-
-												if (!isDiffAlreadyContained)
-												{
-													isSetAlreadyContained = false;
-													break;
-												}
-											}
-
-											if (!isSetAlreadyContained)
-												isDiffAndAlreadyContained = false;
-										}
-									}
-								}
-
-								break;
-							}
-						}
-					}
+					const auto isInCollection = [&](const OsuDatabaseBeatmap *diff) { return db->isInCollection(collections[i], diff->getMD5Hash()); };
 
-					bool isContainerAndSetAlreadyContained = false;
-					if (m_databaseBeatmap != NULL && m_databaseBeatmap->getDifficulties().size() > 0)
+					bool isDiffAndAlreadyContained = false;
+					if (m_databaseBeatmap != NULL && m_databaseBeatmap->getDifficulties().size() < 1 && isInCollection(m_databaseBeatmap))
 					{
-						const std::vector<OsuDatabaseBeatmap*> &diffs = m_databaseBeatmap->getDifficulties();
+						isDiffAndAlreadyContained = true;
 
-						bool foundAllDiffs = true;
-						for (size_t d=0; d<diffs.size(); d++)
+						// edge case: allow adding the set of this diff if it does not represent the entire set (and the set is not yet added completely)
+						if (id == 2)
 						{
-							const std::vector<OsuDatabaseBeatmap*> &diffs = m_databaseBeatmap->getDifficulties();
-
-							bool foundDiff = false;
-							for (size_t h=0; h<collections[i].hashes.size(); h++)
+							const auto *diffButtonPointer = this->as<const OsuUISongBrowserSongDifficultyButton>();
+							if (diffButtonPointer != NULL && diffButtonPointer->getParentSongButton() != NULL && diffButtonPointer->getParentSongButton()->getDatabaseBeatmap() != NULL)
 							{
-								if (collections[i].hashes[h].hash == diffs[d]->getMD5Hash())
-								{
-									foundDiff = true;
+								const OsuDatabaseBeatmap *setContainer = diffButtonPointer->getParentSongButton()->getDatabaseBeatmap();
 
-									break;
-								}
+								if (setContainer->getDifficulties().size() > 1 && !std::ranges::all_of(setContainer->getDifficulties(), isInCollection))
+									isDiffAndAlreadyContained = false;
 							}
-
-							foundAllDiffs = foundDiff;
-							if (!foundAllDiffs)
-								break;
 						}
-
-						isContainerAndSetAlreadyContained = foundAllDiffs;
 					}
 
+					const bool isContainerAndSetAlreadyContained = (m_databaseBeatmap != NULL && m_databaseBeatmap->getDifficulties().size() > 0 &&
+					                                                std::ranges::all_of(m_databaseBeatmap->getDifficulties(), isInCollection));
+
 					CBaseUIButton *collectionButton = m_contextMenu->addButtonJustified(collections[i].name, false, id);
 
 					if (isDiffAndAlreadyContained || isContainerAndSetAlreadyContained)
@@ -561,48 +468,18 @@ void OsuUISongBrowserSongButton::onContextMenu(const UString& text, int id)
 		// the entry could be either a set button, or an independent diff button
 		bool isLegacyEntry = false;
 		{
-			const std::vector<OsuDatabase::Collection> &collections = osu->getSongBrowser()->getDatabase()->getCollections();
-			for (size_t i=0; i<collections.size(); i++)
+			const OsuDatabase *db = osu->getSongBrowser()->getDatabase();
+			const OsuDatabase::Collection *collection = db->getCollection(collectionName);
+			if (collection != NULL)
 			{
-				if (collections[i].name == collectionName)
+				if (m_databaseBeatmap->getDifficulties().size() < 1)
+					isLegacyEntry = db->isLegacyCollectionEntry(*collection, m_databaseBeatmap->getMD5Hash()); // independent diff
+				else
 				{
-					for (size_t e=0; e<collections[i].hashes.size(); e++)
-					{
-						if (m_databaseBeatmap->getDifficulties().size() < 1)
-						{
-							// independent diff
-
-							if (collections[i].hashes[e].hash == m_databaseBeatmap->getMD5Hash())
-							{
-								isLegacyEntry = collections[i].hashes[e].isLegacyEntry;
-								break;
-							}
-						}
-						else
-						{
-							// set
-
-							const std::vector<OsuDatabaseBeatmap*> &diffs = m_databaseBeatmap->getDifficulties();
-
-							for (size_t d=0; d<diffs.size(); d++)
-							{
-								if (collections[i].hashes[e].hash == diffs[d]->getMD5Hash())
-								{
-									// one single entry of the set coming from osu! is enough to deny removing the set (as a whole)
-									if (collections[i].hashes[e].isLegacyEntry)
-									{
-										isLegacyEntry = true;
-										break;
-									}
-								}
-							}
-
-							if (isLegacyEntry)
-								break;
-						}
-					}
-
-					break;
+					// set: one single entry of the set coming from osu! is enough to deny removing the set (as a whole)
+					isLegacyEntry = std::ranges::any_of(m_databaseBeatmap->getDifficulties(), [&](const OsuDatabaseBeatmap *diff) {
+						return db->isLegacyCollectionEntry(*collection, diff->getMD5Hash());
+					});
 				}
 			}
 		}
@@ -685,8 +562,6 @@ void OsuUISongBrowserSongButton::updateRepresentativeDatabaseBeatmap()
 {
 	if (m_databaseBeatmap != NULL && m_children.size() > 0)
 	{
-		const OsuDatabaseBeatmap *previousRepresentativeDatabaseBeatmap = m_representativeDatabaseBeatmap;
-
 		// use the bottom child (hardest diff, assuming default sorting, and respecting the current search matches)
 		for (int i=m_children.size()-1; i>=0; i--)
 		{
@@ -696,12 +571,31 @@ void OsuUISongBrowserSongButton::updateRepresentativeDatabaseBeatmap()
 				break;
 			}
 		}
-
-		if (m_representativeDatabaseBeatmap != NULL && m_representativeDatabaseBeatmap != previousRepresentativeDatabaseBeatmap)
-		{
-			m_sTitle = m_representativeDatabaseBeatmap->getTitle();
-			m_sArtist = m_representativeDatabaseBeatmap->getArtist();
-			m_sMapper = m_representativeDatabaseBeatmap->getCreator();
-		}
 	}
 }
+
+const OsuDatabaseBeatmap *OsuUISongBrowserSongButton::getTextDatabaseBeatmap() const
+{
+	return (m_representativeDatabaseBeatmap != NULL ? m_representativeDatabaseBeatmap : m_databaseBeatmap);
+}
+
+const UString &OsuUISongBrowserSongButton::buildTitleString() const
+{
+	static const UString emptyString;
+
+	const OsuDatabaseBeatmap *databaseBeatmap = getTextDatabaseBeatmap();
+	return (databaseBeatmap != NULL ? databaseBeatmap->getTitle() : emptyString);
+}
+
+UString OsuUISongBrowserSongButton::buildSubTitleString() const
+{
+	const OsuDatabaseBeatmap *databaseBeatmap = getTextDatabaseBeatmap();
+	if (databaseBeatmap == NULL)
+		return " // ";
+
+	UString subTitleString = databaseBeatmap->getArtist();
+	subTitleString.append(" // ");
+	subTitleString.append(databaseBeatmap->getCreator());
+
+	return subTitleString;
+}
@@ -52,25 +52,13 @@ protected:
 	float calculateGradeScale();
 	float calculateGradeWidth();
 
-	UString buildTitleString()
-	{
-		return m_sTitle;
-	}
-
-	UString buildSubTitleString()
-	{
-		UString subTitleString = m_sArtist;
-		subTitleString.append(" // ");
-		subTitleString.append(m_sMapper);
-
-		return subTitleString;
-	}
+	// the strings are read from the database beatmap when drawing, instead of keeping copies in every button (which adds up with large libraries)
+	[[nodiscard]] const OsuDatabaseBeatmap *getTextDatabaseBeatmap() const;
+	[[nodiscard]] const UString &buildTitleString() const;
+	[[nodiscard]] UString buildSubTitleString() const;
 
 	OsuDatabaseBeatmap *m_databaseBeatmap;
 
-	UString m_sTitle;
-	UString m_sArtist;
-	UString m_sMapper;
 	OsuScore::GRADE m_grade;
 	bool m_bHasGrade;
 
@@ -35,21 +35,6 @@ OsuUISongBrowserSongDifficultyButton::OsuUISongBrowserSongDifficultyButton(OsuSo
 	m_databaseBeatmap = diff2; // NOTE: can't use parent constructor for passing this argument, as it would otherwise try to build a full button (and not just a diff button)
 	m_parentSongButton = parentSongButton;
 
-
-
-
-	/*
-	m_sTitle = "Title";
-	m_sArtist = "Artist";
-	m_sMapper = "Mapper";
-	m_sDiff = "Difficulty";
-	*/
-
-	m_sTitle = m_databaseBeatmap->getTitle();
-	m_sArtist = m_databaseBeatmap->getArtist();
-	m_sMapper = m_databaseBeatmap->getCreator();
-	m_sDiff = m_databaseBeatmap->getDifficultyName();
-
 	m_fDiffScale = 0.18f;
 	m_fOffsetPercentAnim = (m_parentSongButton != NULL ? 1.0f : 0.0f);
 
@@ -226,6 +211,11 @@ bool OsuUISongBrowserSongDifficultyButton::isIndependentDiffButton() const
 	return (m_parentSongButton == NULL || !m_parentSongButton->isSelected());
 }
 
+const UString &OsuUISongBrowserSongDifficultyButton::buildDiffString() const
+{
+	return m_databaseBeatmap->getDifficultyName();
+}
+
 Color OsuUISongBrowserSongDifficultyButton::getInactiveBackgroundColor() const
 {
 	if (isIndependentDiffButton())
@@ -37,9 +37,7 @@ private:
 
 	void onSelected(bool wasSelected, bool autoSelectBottomMostChild, bool wasParentSelected) override;
 
-	UString buildDiffString() {return m_sDiff;}
-
-	UString m_sDiff;
+	[[nodiscard]] const UString &buildDiffString() const;
 
 	float m_fDiffScale;
 	float m_fOffsetPercentAnim;
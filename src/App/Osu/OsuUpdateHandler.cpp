@@ -12,6 +12,7 @@
 #include "NetworkHandler.h"
 #include "ConVar.h"
 #include "File.h"
+#include "Profiler.h"
 
 //#include "JSON.h"
 //#include "miniz.h"
@@ -28,6 +29,8 @@ void *OsuUpdateHandler::run(void *data)
 
 	OsuUpdateHandler *handler = (OsuUpdateHandler*)data;
 
+	VPROF_THREAD_NAME("OsuUpdateHandler");
+
 	if (handler->_m_bKYS) return NULL; // cancellation point
 
 	// check for updates
@@ -11,6 +11,7 @@
 
 #include "Engine.h"
 #include "ConVar.h"
+#include "JobSystem.h"
 #include "SoundEngine.h"
 #include "ResourceManager.h"
 #include "Mouse.h"
@@ -112,157 +113,170 @@ private:
 
 		debugLog("PPRecalc will recalculate {} scores ...\n", (int)numScoresToRecalculate);
 
+		// the diffs are all looked up beforehand, since loadMetadata() regenerates the md5 hash which the lookup compares against
+		std::unordered_map<std::string, OsuDatabaseBeatmap*> diffsByMD5Hash;
+		for (const OsuDatabaseBeatmap *beatmap : osu->getSongBrowser()->getDatabase()->getDatabaseBeatmaps())
+		{
+			for (OsuDatabaseBeatmap *diff : beatmap->getDifficulties())
+			{
+				diffsByMD5Hash.try_emplace(diff->getMD5Hash(), diff);
+			}
+		}
+
 		// actually recalculate them
+		// (split by beatmap, so that the same diff never gets its metadata reloaded by two jobs at once)
+		std::vector<std::pair<std::vector<OsuDatabase::Score> *, OsuDatabaseBeatmap *>> entries;
+		entries.reserve(scores->size());
 		for (auto &kv : *scores)
 		{
-			for (auto & score : kv.second)
+			const auto diff = diffsByMD5Hash.find(kv.first);
+			entries.emplace_back(&kv.second, diff != diffsByMD5Hash.end() ? diff->second : NULL);
+		}
+
+		jobSystem->parallelFor("OsuUserStatsScreen::recalculatePP", entries.size(), 1, [&](size_t begin, size_t end) -> void {
+			for (size_t i=begin; i<end; i++)
 			{
-				if ((!score.isLegacyScore || m_bImportLegacyScores) && score.playerName == m_sUserName)
+				for (auto &score : *entries[i].first)
 				{
 					if (m_bInterrupted.load())
-						break;
-					if (score.md5hash.length() < 1)
-						continue;
+						return;
 
-					// NOTE: avoid importing the same score twice
-					if (m_bImportLegacyScores && score.isLegacyScore)
-					{
-						const std::vector<OsuDatabase::Score> &otherScores = (*scores)[score.md5hash];
-
-						bool isScoreAlreadyImported = false;
-						for (const auto & otherScore : otherScores)
-						{
-							if (score.isLegacyScoreEqualToImportedLegacyScore(otherScore))
-							{
-								isScoreAlreadyImported = true;
-								break;
-							}
-						}
+					if ((!score.isLegacyScore || m_bImportLegacyScores) && score.playerName == m_sUserName)
+						recalculateScore(score, entries[i].second, *entries[i].first);
+				}
+			}
+		}, JobSystem::PRIORITY::LOW);
 
-						if (isScoreAlreadyImported)
-							continue;
-					}
+		m_bAsyncReady = true;
+	}
 
-					// 1) get matching beatmap from db
-					OsuDatabaseBeatmap *diff2 = osu->getSongBrowser()->getDatabase()->getBeatmapDifficulty(score.md5hash);
-					if (diff2 == NULL)
-					{
-						if (cv::osu::debug.getBool())
-							debugLog("PPRecalc couldn't find {:s}\n", score.md5hash.c_str());
+	// (runs on job system workers, so everything in here has to be thread safe)
+	void recalculateScore(OsuDatabase::Score &score, OsuDatabaseBeatmap *diff2, const std::vector<OsuDatabase::Score> &otherScores)
+	{
+		if (score.md5hash.length() < 1)
+			return;
 
-						continue;
-					}
+		// NOTE: avoid importing the same score twice
+		if (m_bImportLegacyScores && score.isLegacyScore)
+		{
+			for (const auto & otherScore : otherScores)
+			{
+				if (score.isLegacyScoreEqualToImportedLegacyScore(otherScore))
+					return;
+			}
+		}
 
-					// 1.5) reload metadata for sanity (maybe osu!.db has outdated AR/CS/OD/HP or some other shit)
-					if (!OsuDatabaseBeatmap::loadMetadata(diff2))
-						continue;
-
-					const OsuReplay::BEATMAP_VALUES legacyValues = OsuReplay::getBeatmapValuesForModsLegacy(score.modsLegacy, diff2->getAR(), diff2->getCS(), diff2->getOD(), diff2->getHP());
-					const UString &osuFilePath = diff2->getFilePath();
-					const Osu::GAMEMODE gameMode = Osu::GAMEMODE::STD;
-					const float AR = (score.isLegacyScore ? legacyValues.AR : score.AR);
-					const float CS = (score.isLegacyScore ? legacyValues.CS : score.CS);
-					const float OD = (score.isLegacyScore ? legacyValues.OD : score.OD);
-					const float HP = (score.isLegacyScore ? legacyValues.HP : score.HP);
-					const float speedMultiplier = (score.isLegacyScore ? legacyValues.speedMultiplier : score.speedMultiplier);
-					const bool relax = score.modsLegacy & OsuReplay::Mods::Relax;
-					const bool autopilot = score.modsLegacy & OsuReplay::Mods::Relax2;
-					const bool touchDevice = score.modsLegacy & OsuReplay::Mods::TouchDevice;
-
-					// 2) load hitobjects for diffcalc
-					OsuDatabaseBeatmap::LOAD_DIFFOBJ_RESULT diffres = OsuDatabaseBeatmap::loadDifficultyHitObjects(osuFilePath, gameMode, AR, CS, speedMultiplier);
-					if (diffres.diffobjects.size() < 1)
-					{
-						if (cv::osu::debug.getBool())
-							debugLog("PPRecalc couldn't load {:s}\n", osuFilePath.toUtf8());
+		// 1) matching beatmap from db
+		if (diff2 == NULL)
+		{
+			if (cv::osu::debug.getBool())
+				debugLog("PPRecalc couldn't find {:s}\n", score.md5hash.c_str());
 
-						continue;
-					}
+			return;
+		}
 
-					// 3) calculate stars
-					double aimStars = 0.0;
-					double aimSliderFactor = 0.0;
-					double aimDifficultSliders = 0.0;
-					double aimDifficultStrains = 0.0;
-					double speedStars = 0.0;
-					double speedNotes = 0.0;
-					double speedDifficultStrains = 0.0;
-					const double totalStars = OsuDifficultyCalculator::calculateStarDiffForHitObjects(diffres.diffobjects, CS, OD, speedMultiplier, relax, autopilot, touchDevice, &aimStars, &aimSliderFactor, &aimDifficultSliders, &aimDifficultStrains, &speedStars, &speedNotes, &speedDifficultStrains);
-
-					// 4) calculate pp
-					double pp = 0.0;
-					int numHitObjects = 0;
-					int numSpinners = 0;
-					int numCircles = 0;
-					int numSliders = 0;
-					int maxPossibleCombo = 0;
-					{
-						// calculate a few values fresh from the beatmap data necessary for pp calculation
-						numHitObjects = diffres.diffobjects.size();
+		// 1.5) reload metadata for sanity (maybe osu!.db has outdated AR/CS/OD/HP or some other shit)
+		if (!OsuDatabaseBeatmap::loadMetadata(diff2))
+			return;
+
+		const OsuReplay::BEATMAP_VALUES legacyValues = OsuReplay::getBeatmapValuesForModsLegacy(score.modsLegacy, diff2->getAR(), diff2->getCS(), diff2->getOD(), diff2->getHP());
+		const UString &osuFilePath = diff2->getFilePath();
+		const Osu::GAMEMODE gameMode = Osu::GAMEMODE::STD;
+		const float AR = (score.isLegacyScore ? legacyValues.AR : score.AR);
+		const float CS = (score.isLegacyScore ? legacyValues.CS : score.CS);
+		const float OD = (score.isLegacyScore ? legacyValues.OD : score.OD);
+		const float HP = (score.isLegacyScore ? legacyValues.HP : score.HP);
+		const float speedMultiplier = (score.isLegacyScore ? legacyValues.speedMultiplier : score.speedMultiplier);
+		const bool relax = score.modsLegacy & OsuReplay::Mods::Relax;
+		const bool autopilot = score.modsLegacy & OsuReplay::Mods::Relax2;
+		const bool touchDevice = score.modsLegacy & OsuReplay::Mods::TouchDevice;
+
+		// 2) load hitobjects for diffcalc
+		OsuDatabaseBeatmap::LOAD_DIFFOBJ_RESULT diffres = OsuDatabaseBeatmap::loadDifficultyHitObjects(osuFilePath, gameMode, AR, CS, speedMultiplier);
+		if (diffres.diffobjects.size() < 1)
+		{
+			if (cv::osu::debug.getBool())
+				debugLog("PPRecalc couldn't load {:s}\n", osuFilePath.toUtf8());
 
-						for (auto & diffobject : diffres.diffobjects)
-						{
-							if (diffobject.type == OsuDifficultyHitObject::TYPE::CIRCLE)
-								numCircles++;
-							if (diffobject.type == OsuDifficultyHitObject::TYPE::SLIDER)
-								numSliders++;
-							if (diffobject.type == OsuDifficultyHitObject::TYPE::SPINNER)
-								numSpinners++;
-						}
+			return;
+		}
 
-						maxPossibleCombo = diffres.maxPossibleCombo;
-						if (maxPossibleCombo < 1)
-							continue;
+		// 3) calculate stars
+		double aimStars = 0.0;
+		double aimSliderFactor = 0.0;
+		double aimDifficultSliders = 0.0;
+		double aimDifficultStrains = 0.0;
+		double speedStars = 0.0;
+		double speedNotes = 0.0;
+		double speedDifficultStrains = 0.0;
+		const double totalStars = OsuDifficultyCalculator::calculateStarDiffForHitObjects(diffres.diffobjects, CS, OD, speedMultiplier, relax, autopilot, touchDevice, &aimStars, &aimSliderFactor, &aimDifficultSliders, &aimDifficultStrains, &speedStars, &speedNotes, &speedDifficultStrains);
+
+		// 4) calculate pp
+		double pp = 0.0;
+		int numHitObjects = 0;
+		int numSpinners = 0;
+		int numCircles = 0;
+		int numSliders = 0;
+		int maxPossibleCombo = 0;
+		{
+			// calculate a few values fresh from the beatmap data necessary for pp calculation
+			numHitObjects = diffres.diffobjects.size();
 
-						pp = OsuDifficultyCalculator::calculatePPv2(score.modsLegacy, speedMultiplier, AR, OD, aimStars, aimSliderFactor, aimDifficultSliders, aimDifficultStrains, speedStars, speedNotes, speedDifficultStrains, numHitObjects, numCircles, numSliders, numSpinners, maxPossibleCombo, score.comboMax, score.numMisses, score.num300s, score.num100s, score.num50s);
-					}
+			for (auto & diffobject : diffres.diffobjects)
+			{
+				if (diffobject.type == OsuDifficultyHitObject::TYPE::CIRCLE)
+					numCircles++;
+				if (diffobject.type == OsuDifficultyHitObject::TYPE::SLIDER)
+					numSliders++;
+				if (diffobject.type == OsuDifficultyHitObject::TYPE::SPINNER)
+					numSpinners++;
+			}
 
-					// 5) overwrite score with new pp data (and handle imports)
-					const float oldPP = score.pp;
-					if (pp > 0.0f)
-					{
-						score.pp = pp;
-						score.version = OsuScore::VERSION;
+			maxPossibleCombo = diffres.maxPossibleCombo;
+			if (maxPossibleCombo < 1)
+				return;
 
-						if (m_bImportLegacyScores && score.isLegacyScore)
-						{
-							score.isLegacyScore = false;		// convert to McOsu (pp) score
-							score.isImportedLegacyScore = true;	// but remember that this score does not have all play data
-							{
-								score.numSliderBreaks = 0;
-								score.unstableRate = 0.0f;
-								score.hitErrorAvgMin = 0.0f;
-								score.hitErrorAvgMax = 0.0f;
-							}
-							score.starsTomTotal = totalStars;
-							score.starsTomAim = aimStars;
-							score.starsTomSpeed = speedStars;
-							score.speedMultiplier = speedMultiplier;
-							score.CS = CS;
-							score.AR = AR;
-							score.OD = OD;
-							score.HP = HP;
-							score.maxPossibleCombo = maxPossibleCombo;
-							score.numHitObjects = numHitObjects;
-							score.numCircles = numCircles;
-						}
-					}
+			pp = OsuDifficultyCalculator::calculatePPv2(score.modsLegacy, speedMultiplier, AR, OD, aimStars, aimSliderFactor, aimDifficultSliders, aimDifficultStrains, speedStars, speedNotes, speedDifficultStrains, numHitObjects, numCircles, numSliders, numSpinners, maxPossibleCombo, score.comboMax, score.numMisses, score.num300s, score.num100s, score.num50s);
+		}
 
-					m_iNumScoresRecalculated++;
+		// 5) overwrite score with new pp data (and handle imports)
+		const float oldPP = score.pp;
+		if (pp > 0.0f)
+		{
+			score.pp = pp;
+			score.version = OsuScore::VERSION;
 
-					if (cv::osu::debug.getBool())
-					{
-						debugLog("[{:s}] original = {:f}, new = {:f}, delta = {:f}\n", score.md5hash.c_str(), oldPP, score.pp, (score.pp - oldPP));
-						debugLog("at {}/{}\n", m_iNumScoresRecalculated.load(), m_iNumScoresToRecalculate.load());
-					}
+			if (m_bImportLegacyScores && score.isLegacyScore)
+			{
+				score.isLegacyScore = false;		// convert to McOsu (pp) score
+				score.isImportedLegacyScore = true;	// but remember that this score does not have all play data
+				{
+					score.numSliderBreaks = 0;
+					score.unstableRate = 0.0f;
+					score.hitErrorAvgMin = 0.0f;
+					score.hitErrorAvgMax = 0.0f;
 				}
+				score.starsTomTotal = totalStars;
+				score.starsTomAim = aimStars;
+				score.starsTomSpeed = speedStars;
+				score.speedMultiplier = speedMultiplier;
+				score.CS = CS;
+				score.AR = AR;
+				score.OD = OD;
+				score.HP = HP;
+				score.maxPossibleCombo = maxPossibleCombo;
+				score.numHitObjects = numHitObjects;
+				score.numCircles = numCircles;
 			}
-
-			if (m_bInterrupted.load())
-				break;
 		}
 
-		m_bAsyncReady = true;
+		m_iNumScoresRecalculated++;
+
+		if (cv::osu::debug.getBool())
+		{
+			debugLog("[{:s}] original = {:f}, new = {:f}, delta = {:f}\n", score.md5hash.c_str(), oldPP, score.pp, (score.pp - oldPP));
+			debugLog("at {}/{}\n", m_iNumScoresRecalculated.load(), m_iNumScoresToRecalculate.load());
+		}
 	}
 
 	void destroy() override {;}
@@ -0,0 +1,294 @@
+//================ Copyright (c) 2025, WH, All rights reserved. =================//
+//
+// Purpose:		global heap allocation counters (live bytes, per-frame counts, tags)
+//
+// $NoKeywords: $alloc
+//===============================================================================//
+
+#include "AllocTracker.h"
+
+#include "ConVar.h"
+#include "Engine.h"
+#include "Profiler.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+struct TAG_COUNTERS
+{
+	std::atomic<int64_t> liveBytes;
+	std::atomic<int64_t> liveAllocations;
+	std::atomic<uint64_t> numAllocations;
+	std::atomic<uint64_t> numBytes;
+};
+
+// these must be usable before any static constructors ran (the first allocations happen during static initialization)
+constinit std::array<TAG_COUNTERS, static_cast<size_t>(AllocTracker::TAG::COUNT)> s_counters{};
+constinit thread_local AllocTracker::TAG s_threadTag = AllocTracker::TAG::UNTAGGED;
+
+uint64_t s_iLastFrameNumAllocations = 0;
+uint64_t s_iLastFrameNumBytes = 0;
+AllocTracker::STATS s_lastFrameStats{};
+
+AllocTracker::STATS s_snapshot{};
+bool s_bHasSnapshot = false;
+} // namespace
+
+void AllocTracker::update()
+{
+	if constexpr (!isEnabled())
+		return;
+
+	s_lastFrameStats = getStats();
+
+	const TAG_STATS total = getTotal(s_lastFrameStats);
+	s_lastFrameStats.numAllocationsLastFrame = total.numAllocations - s_iLastFrameNumAllocations;
+	s_lastFrameStats.numBytesLastFrame = total.numBytes - s_iLastFrameNumBytes;
+	s_iLastFrameNumAllocations = total.numAllocations;
+	s_iLastFrameNumBytes = total.numBytes;
+
+	VPROF_COUNTER("Heap (MB)", static_cast<double>(total.liveBytes) / (1024.0 * 1024.0));
+	VPROF_COUNTER("Allocations/frame", static_cast<double>(s_lastFrameStats.numAllocationsLastFrame));
+}
+
+AllocTracker::STATS AllocTracker::getStats()
+{
+	STATS stats{};
+	for (size_t i=0; i<s_counters.size(); i++)
+	{
+		stats.tags[i] = TAG_STATS{.liveBytes = s_counters[i].liveBytes.load(std::memory_order_relaxed),
+		                          .liveAllocations = s_counters[i].liveAllocations.load(std::memory_order_relaxed),
+		                          .numAllocations = s_counters[i].numAllocations.load(std::memory_order_relaxed),
+		                          .numBytes = s_counters[i].numBytes.load(std::memory_order_relaxed)};
+	}
+	stats.numAllocationsLastFrame = s_lastFrameStats.numAllocationsLastFrame;
+	stats.numBytesLastFrame = s_lastFrameStats.numBytesLastFrame;
+	return stats;
+}
+
+AllocTracker::TAG_STATS AllocTracker::getTotal(const STATS &stats)
+{
+	TAG_STATS total{};
+	for (const TAG_STATS &tag : stats.tags)
+	{
+		total.liveBytes += tag.liveBytes;
+		total.liveAllocations += tag.liveAllocations;
+		total.numAllocations += tag.numAllocations;
+		total.numBytes += tag.numBytes;
+	}
+	return total;
+}
+
+const char *AllocTracker::getTagName(TAG tag)
+{
+	switch (tag)
+	{
+	case TAG::UNTAGGED:
+		return "Untagged";
+	case TAG::DATABASE:
+		return "Database";
+	case TAG::RESOURCES:
+		return "Resources";
+	case TAG::UI:
+		return "UI";
+	case TAG::GAMEPLAY:
+		return "Gameplay";
+	case TAG::AUDIO:
+		return "Audio";
+	default:
+		return "";
+	}
+}
+
+AllocTracker::TAG AllocTracker::setThreadTag(TAG tag)
+{
+	const TAG prevTag = s_threadTag;
+	s_threadTag = tag;
+	return prevTag;
+}
+
+AllocTracker::TAG AllocTracker::getThreadTag()
+{
+	return s_threadTag;
+}
+
+void AllocTracker::onAlloc(TAG tag, size_t size)
+{
+	TAG_COUNTERS &counters = s_counters[static_cast<size_t>(tag)];
+	counters.liveBytes.fetch_add(static_cast<int64_t>(size), std::memory_order_relaxed);
+	counters.liveAllocations.fetch_add(1, std::memory_order_relaxed);
+	counters.numAllocations.fetch_add(1, std::memory_order_relaxed);
+	counters.numBytes.fetch_add(size, std::memory_order_relaxed);
+}
+
+void AllocTracker::onFree(TAG tag, size_t size)
+{
+	TAG_COUNTERS &counters = s_counters[static_cast<size_t>(tag)];
+	counters.liveBytes.fetch_sub(static_cast<int64_t>(size), std::memory_order_relaxed);
+	counters.liveAllocations.fetch_sub(1, std::memory_order_relaxed);
+}
+
+
+
+//*******************************************//
+//	global operator new/delete replacements  //
+//*******************************************//
+
+#ifdef MCENGINE_FEATURE_ALLOCTRACKING
+
+namespace
+{
+// every block is prefixed with its size and tag (and how far into the malloc()ed memory it starts, for the aligned variants)
+struct ALLOC_HEADER
+{
+	uint64_t size;
+	uint32_t offset;
+	AllocTracker::TAG tag;
+};
+
+constexpr size_t HEADER_SIZE = 16;
+static_assert(sizeof(ALLOC_HEADER) <= HEADER_SIZE);
+static_assert(__STDCPP_DEFAULT_NEW_ALIGNMENT__ <= HEADER_SIZE);
+
+inline ALLOC_HEADER *getHeader(void *ptr)
+{
+	return reinterpret_cast<ALLOC_HEADER *>(static_cast<std::byte *>(ptr) - HEADER_SIZE);
+}
+
+void *trackedAlloc(size_t size, size_t alignment)
+{
+	const size_t padding = (alignment > HEADER_SIZE ? alignment - 1 : 0);
+
+	void *raw = std::malloc(HEADER_SIZE + padding + size);
+	while (raw == nullptr)
+	{
+		std::new_handler handler = std::get_new_handler();
+		if (handler == nullptr)
+			throw std::bad_alloc();
+
+		handler();
+		raw = std::malloc(HEADER_SIZE + padding + size);
+	}
+
+	auto user = reinterpret_cast<uintptr_t>(raw) + HEADER_SIZE;
+	user = (user + padding) & ~static_cast<uintptr_t>(padding);
+
+	const AllocTracker::TAG tag = AllocTracker::getThreadTag();
+	*getHeader(reinterpret_cast<void *>(user)) = ALLOC_HEADER{.size = size, .offset = static_cast<uint32_t>(user - reinterpret_cast<uintptr_t>(raw)), .tag = tag};
+	AllocTracker::onAlloc(tag, size);
+
+	return reinterpret_cast<void *>(user);
+}
+
+void trackedFree(void *ptr) noexcept
+{
+	if (ptr == nullptr)
+		return;
+
+	const ALLOC_HEADER *header = getHeader(ptr);
+	AllocTracker::onFree(header->tag, header->size);
+	std::free(static_cast<std::byte *>(ptr) - header->offset);
+}
+} // namespace
+
+// (the nothrow variants are implemented by the standard library in terms of these)
+void *operator new(size_t size) {return trackedAlloc(size, __STDCPP_DEFAULT_NEW_ALIGNMENT__);}
+void *operator new[](size_t size) {return trackedAlloc(size, __STDCPP_DEFAULT_NEW_ALIGNMENT__);}
+void *operator new(size_t size, std::align_val_t alignment) {return trackedAlloc(size, static_cast<size_t>(alignment));}
+void *operator new[](size_t size, std::align_val_t alignment) {return trackedAlloc(size, static_cast<size_t>(alignment));}
+
+void operator delete(void *ptr) noexcept {trackedFree(ptr);}
+void operator delete[](void *ptr) noexcept {trackedFree(ptr);}
+void operator delete(void *ptr, size_t) noexcept {trackedFree(ptr);}
+void operator delete[](void *ptr, size_t) noexcept {trackedFree(ptr);}
+void operator delete(void *ptr, std::align_val_t) noexcept {trackedFree(ptr);}
+void operator delete[](void *ptr, std::align_val_t) noexcept {trackedFree(ptr);}
+void operator delete(void *ptr, size_t, std::align_val_t) noexcept {trackedFree(ptr);}
+void operator delete[](void *ptr, size_t, std::align_val_t) noexcept {trackedFree(ptr);}
+
+#endif
+
+
+
+//****************************//
+//	AllocTracker ConCommands  //
+//****************************//
+
+namespace
+{
+bool checkEnabled()
+{
+	if constexpr (!AllocTracker::isEnabled())
+		Engine::logRaw("allocation tracking is not compiled in (configure with --enable-alloc-tracking)\n");
+	return AllocTracker::isEnabled();
+}
+
+void _alloc_stats()
+{
+	if (!checkEnabled())
+		return;
+
+	const AllocTracker::STATS stats = AllocTracker::getStats();
+	Engine::logRaw("{:<10s} {:>12s} {:>12s} {:>14s} {:>14s}\n", "tag", "live KB", "live allocs", "total allocs", "total MB");
+	for (size_t i=0; i<stats.tags.size(); i++)
+	{
+		const AllocTracker::TAG_STATS &tag = stats.tags[i];
+		Engine::logRaw("{:<10s} {:>12d} {:>12d} {:>14d} {:>14d}\n", AllocTracker::getTagName(static_cast<AllocTracker::TAG>(i)), tag.liveBytes / 1024,
+		               tag.liveAllocations, tag.numAllocations, tag.numBytes / (1024 * 1024));
+	}
+
+	const AllocTracker::TAG_STATS total = AllocTracker::getTotal(stats);
+	Engine::logRaw("{:<10s} {:>12d} {:>12d} {:>14d} {:>14d}\n", "Total", total.liveBytes / 1024, total.liveAllocations, total.numAllocations,
+	               total.numBytes / (1024 * 1024));
+	Engine::logRaw("last frame: {} allocations, {} KB\n", stats.numAllocationsLastFrame, stats.numBytesLastFrame / 1024);
+}
+
+void _alloc_snapshot()
+{
+	if (!checkEnabled())
+		return;
+
+	s_snapshot = AllocTracker::getStats();
+	s_bHasSnapshot = true;
+
+	const AllocTracker::TAG_STATS total = AllocTracker::getTotal(s_snapshot);
+	Engine::logRaw("snapshot taken ({} KB live in {} allocations), use alloc_diff to compare against it later\n", total.liveBytes / 1024,
+	               total.liveAllocations);
+}
+
+void _alloc_diff()
+{
+	if (!checkEnabled())
+		return;
+
+	if (!s_bHasSnapshot)
+	{
+		Engine::logRaw("no snapshot, use alloc_snapshot first\n");
+		return;
+	}
+
+	const AllocTracker::STATS stats = AllocTracker::getStats();
+	Engine::logRaw("{:<10s} {:>14s} {:>14s} {:>14s}\n", "tag", "live KB diff", "allocs diff", "allocs since");
+	for (size_t i=0; i<stats.tags.size(); i++)
+	{
+		const AllocTracker::TAG_STATS &now = stats.tags[i];
+		const AllocTracker::TAG_STATS &then = s_snapshot.tags[i];
+		Engine::logRaw("{:<10s} {:>+14d} {:>+14d} {:>14d}\n", AllocTracker::getTagName(static_cast<AllocTracker::TAG>(i)),
+		               (now.liveBytes - then.liveBytes) / 1024, now.liveAllocations - then.liveAllocations, now.numAllocations - then.numAllocations);
+	}
+
+	const AllocTracker::TAG_STATS totalNow = AllocTracker::getTotal(stats);
+	const AllocTracker::TAG_STATS totalThen = AllocTracker::getTotal(s_snapshot);
+	Engine::logRaw("{:<10s} {:>+14d} {:>+14d} {:>14d}\n", "Total", (totalNow.liveBytes - totalThen.liveBytes) / 1024,
+	               totalNow.liveAllocations - totalThen.liveAllocations, totalNow.numAllocations - totalThen.numAllocations);
+}
+} // namespace
+
+namespace cv {
+ConVar alloc_stats("alloc_stats", FCVAR_NONE, "print live heap memory and allocation counts per tag (needs a build with --enable-alloc-tracking)", CFUNC(_alloc_stats));
+ConVar alloc_snapshot("alloc_snapshot", FCVAR_NONE, "remember the current heap allocation counters, for alloc_diff", CFUNC(_alloc_snapshot));
+ConVar alloc_diff("alloc_diff", FCVAR_NONE, "print how much live heap memory each tag gained or lost since alloc_snapshot (to find leaks)", CFUNC(_alloc_diff));
+}
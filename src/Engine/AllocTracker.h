@@ -0,0 +1,96 @@
+//================ Copyright (c) 2025, WH, All rights reserved. =================//
+//
+// Purpose:		global heap allocation counters (live bytes, per-frame counts, tags)
+//
+// $NoKeywords: $alloc
+//===============================================================================//
+
+#pragma once
+#ifndef ALLOCTRACKER_H
+#define ALLOCTRACKER_H
+
+#include "EngineFeatures.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+// Replaces the global operator new/delete (only if built with --enable-alloc-tracking, see MCENGINE_FEATURE_ALLOCTRACKING),
+// and accounts every allocation to the tag of the innermost ALLOC_TAG() scope on the allocating thread.
+// Frees are accounted to the tag the memory was allocated with, so the live counters of a tag only ever contain its own memory.
+// NOTE: plain malloc()/free() (e.g. from C libraries) is not seen
+class AllocTracker final
+{
+public:
+	enum class TAG : uint8_t
+	{
+		UNTAGGED,
+		DATABASE,
+		RESOURCES,
+		UI,
+		GAMEPLAY,
+		AUDIO,
+		COUNT
+	};
+
+	struct TAG_STATS
+	{
+		int64_t liveBytes;
+		int64_t liveAllocations;
+		uint64_t numAllocations; // since startup
+		uint64_t numBytes;       // since startup
+	};
+
+	struct STATS
+	{
+		std::array<TAG_STATS, static_cast<size_t>(TAG::COUNT)> tags;
+		uint64_t numAllocationsLastFrame;
+		uint64_t numBytesLastFrame;
+	};
+
+	AllocTracker() = delete;
+
+	[[nodiscard]] static constexpr bool isEnabled()
+	{
+#ifdef MCENGINE_FEATURE_ALLOCTRACKING
+		return true;
+#else
+		return false;
+#endif
+	}
+
+	static void update(); // main thread, once per frame
+
+	[[nodiscard]] static STATS getStats();
+	[[nodiscard]] static TAG_STATS getTotal(const STATS &stats);
+	[[nodiscard]] static const char *getTagName(TAG tag);
+
+	// used by ALLOC_TAG()
+	static TAG setThreadTag(TAG tag);
+
+	// used by the operator new/delete replacements
+	static void onAlloc(TAG tag, size_t size);
+	static void onFree(TAG tag, size_t size);
+	[[nodiscard]] static TAG getThreadTag(); // (also used by JobSystem, jobs inherit the tag of the thread which scheduled them)
+};
+
+class AllocTagScope final
+{
+public:
+	explicit AllocTagScope(AllocTracker::TAG tag) : m_prevTag(AllocTracker::setThreadTag(tag)) {}
+	~AllocTagScope() {AllocTracker::setThreadTag(m_prevTag);}
+
+	AllocTagScope(const AllocTagScope &) = delete;
+	AllocTagScope &operator=(const AllocTagScope &) = delete;
+
+private:
+	AllocTracker::TAG m_prevTag;
+};
+
+#ifdef MCENGINE_FEATURE_ALLOCTRACKING
+#define ALLOC_TAG(tag)		AllocTagScope AllocTag_(AllocTracker::TAG::tag);
+#else
+#define ALLOC_TAG(tag)
+#endif
+
+#endif
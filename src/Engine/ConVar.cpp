@@ -24,6 +24,8 @@ namespace cv
 ConVar emptyDummyConVar("emptyDummyConVar", 42.0f, FCVAR_NONE, "this placeholder convar is returned by ConVar::getConVarByName() if no matching convar is found");
 }
 
+std::atomic<uint64_t> ConVar::s_iValueVersion{0};
+
 // lazy init on first use
 std::vector<ConVar *> &ConVar::getConVarArray()
 {
@@ -250,6 +252,7 @@ void ConVar::setDefaultFloatInt(float defaultValue)
 {
 	m_fDefaultValue = defaultValue;
 	m_sDefaultValue = UString::format("%g", defaultValue);
+	s_iValueVersion.fetch_add(1, std::memory_order_release);
 }
 
 void ConVar::setDefaultString(const UString &defaultValue)
@@ -83,6 +83,9 @@ public:
 	// for restart without closing (TODO)
 	static void resetAllConVarCallbacks();
 
+	// incremented whenever any value (or default value) changes, for caching values outside of ConVar (see OsuConVarSnapshot)
+	[[nodiscard]] static inline uint64_t getValueVersion() { return s_iValueVersion.load(std::memory_order_acquire); }
+
 private:
 	[[nodiscard]] float getRaw() const { return m_fValue.load(); } // forward def
 
@@ -373,6 +376,7 @@ private:
 		// set new values
 		m_fValue = newFloat;
 		m_sValue = newString;
+		s_iValueVersion.fetch_add(1, std::memory_order_release);
 
 		if (doCallback)
 		{
@@ -409,6 +413,8 @@ private:
 	}
 
 private:
+	static std::atomic<uint64_t> s_iValueVersion;
+
 	bool m_bHasValue{false};
 	CONVAR_TYPE m_type{CONVAR_TYPE::CONVAR_TYPE_FLOAT};
 	uint8_t m_iFlags{FCVAR_NONE};
@@ -12,6 +12,11 @@ class ConVar;
 #define CVDEFS_H
 namespace cv {
 
+// from AllocTracker.cpp
+extern ConVar alloc_diff;
+extern ConVar alloc_snapshot;
+extern ConVar alloc_stats;
+
 // from AnimationHandler.cpp
 extern ConVar debug_anim;
 
@@ -29,6 +34,7 @@ extern ConVar win_snd_wasapi_shared_volume_affects_device;
 extern ConVar debug_box_shadows;
 
 // from CBaseUIScrollView.cpp
+extern ConVar ui_scrollview_culling;
 extern ConVar ui_scrollview_kinetic_approach_time;
 extern ConVar ui_scrollview_kinetic_energy_multiplier;
 extern ConVar ui_scrollview_mousewheel_multiplier;
@@ -106,6 +112,11 @@ extern ConVar fullscreen_windowed_borderless;
 extern ConVar monitor;
 extern ConVar processpriority;
 
+// from FPSLimiter.cpp
+extern ConVar fps_limiter_spin;
+extern ConVar fps_limiter_stats;
+extern ConVar fps_limiter_vblank_latency;
+
 // from File.cpp
 extern ConVar debug_file;
 extern ConVar file_size_max;
@@ -114,13 +125,26 @@ extern ConVar file_size_max;
 extern ConVar r_debug_drawstring_unbind;
 extern ConVar r_debug_font_atlas_padding;
 extern ConVar r_drawstring_max_string_length;
+extern ConVar r_drawstring_glyph_run_cache_kb;
 extern ConVar r_debug_font_unicode;
 extern ConVar font_load_system;
 
+// from FontRasterizer.cpp
+extern ConVar font_load_async;
+extern ConVar font_load_async_threads;
+
+// from FrameArena.cpp
+extern ConVar frame_arena_stats;
+
+// from FrameTimeStats.cpp
+extern ConVar frametime_stats;
+extern ConVar frametime_stats_reset;
+
 // from Graphics.cpp
 extern ConVar mat_wireframe;
 extern ConVar r_3dscene_zf;
 extern ConVar r_3dscene_zn;
+extern ConVar r_batch_images;
 extern ConVar r_debug_disable_3dscene;
 extern ConVar r_debug_disable_cliprect;
 extern ConVar r_debug_drawimage;
@@ -181,6 +205,8 @@ extern ConVar debug_rt;
 
 // from ResourceManager.cpp
 extern ConVar debug_rm;
+extern ConVar rm_image_sharing;
+extern ConVar rm_image_sharing_stats;
 extern ConVar rm_interrupt_on_destroy;
 
 // from SDLGLInterface.cpp
@@ -217,6 +243,16 @@ extern ConVar snd_restrict_play_frame;
 extern ConVar volume;
 extern ConVar win_snd_fallback_dsound;
 
+// from SoundPrefetcher.cpp
+extern ConVar snd_prefetch;
+extern ConVar snd_prefetch_cache_size_mb;
+extern ConVar snd_prefetch_stats;
+
+// from SoundSampleCache.cpp
+extern ConVar snd_sample_cache;
+extern ConVar snd_sample_cache_size_mb;
+extern ConVar snd_sample_cache_stats;
+
 // from SoundTouchFilter.cpp
 extern ConVar snd_enable_auto_offset;
 extern ConVar snd_st_debug;
@@ -228,6 +264,9 @@ extern ConVar steam_timeout;
 // from Thread.cpp
 extern ConVar debug_thread;
 
+// from TraceProfiler.cpp
+extern ConVar profile_capture;
+
 // from VSControlBar.cpp
 extern ConVar vs_repeat;
 extern ConVar vs_shuffle;
@@ -256,6 +295,7 @@ extern ConVar fps_max;
 extern ConVar fps_max_background;
 extern ConVar fps_unlimited;
 extern ConVar fps_yield;
+extern ConVar input_poll_rate;
 
 } // namespace cv
 
@@ -7,9 +7,11 @@
 
 #include <cstdio>
 
+#include "AllocTracker.h"
 #include "AnimationHandler.h"
 #include "ConVar.h"
 #include "DiscordInterface.h"
+#include "JobSystem.h"
 #include "Keyboard.h"
 #include "Mouse.h"
 #include "NetworkHandler.h"
@@ -17,7 +19,10 @@
 #include "ResourceManager.h"
 #include "SoundEngine.h"
 #include "SteamworksInterface.h"
+#include "FrameArena.h"
+#include "FrameTimeStats.h"
 #include "Timing.h"
+#include "TraceProfiler.h"
 
 #include "CBaseUIContainer.h"
 
@@ -42,6 +47,7 @@ std::unique_ptr<NetworkHandler> networkHandler = nullptr;
 std::unique_ptr<AnimationHandler> animationHandler = nullptr;
 std::unique_ptr<SteamworksInterface> steam = nullptr;
 std::unique_ptr<DiscordInterface> discord = nullptr;
+std::unique_ptr<JobSystem> jobSystem = nullptr;
 
 Engine *engine = NULL;
 
@@ -156,6 +162,7 @@ ConVar dpiinfo("dpiinfo", FCVAR_NONE, []() -> void {env ? Engine::logRaw("[Engin
 Engine::Engine()
 {
 	engine = this;
+	VPROF_THREAD_NAME("Main");
 
 	m_guiContainer = nullptr;
 	m_visualProfiler = nullptr;
@@ -177,6 +184,8 @@ Engine::Engine()
 	m_iVsyncFrameCount = 0;
 	m_fVsyncFrameCounterTime = 0.0f;
 	m_dFrameTime = 0.016;
+	m_frameTimeStats = new FrameTimeStats();
+	m_iPaintOnlyFrames = 0;
 
 	cv::engine_throttle.setCallback(SA::MakeDelegate<&Engine::onEngineThrottleChanged>(this));
 
@@ -208,6 +217,14 @@ Engine::Engine()
 	// safely dereference the global object refs
 	debugLog("\nEngine: Initializing subsystems ...\n");
 	{
+		// job system (first, everything after it may schedule jobs)
+		{
+			auto args = env->getLaunchArgs();
+			const auto jobThreadsString = args["-jobthreads"]; // e.g. "-jobthreads 0" for debugging
+			jobSystem = std::make_unique<JobSystem>(jobThreadsString.has_value() ? jobThreadsString->toInt() : -1);
+		}
+		runtime_assert(jobSystem.get(), "Job system failed to initialize!");
+
 		// input devices
 		mouse = std::make_unique<Mouse>();
 		runtime_assert(mouse.get(), "Mouse failed to initialize!");
@@ -309,6 +326,9 @@ Engine::~Engine()
 	debugLog("Engine: Freeing graphics...\n");
 	g.reset();
 
+	debugLog("Engine: Freeing job system...\n");
+	jobSystem.reset();
+
 	debugLog("Engine: Freeing input devices...\n");
 	// first remove the mouse and keyboard from the input devices
 	std::erase_if(m_inputDevices, [](InputDevice *device) { return device == mouse.get() || device == keyboard.get(); });
@@ -335,6 +355,8 @@ Engine::~Engine()
 	debugLog("Engine: Freeing math...\n");
 	SAFE_DELETE(m_math);
 
+	SAFE_DELETE(m_frameTimeStats);
+
 	if (m_bIsRestarting)
 	{
 		debugLog("Engine: Resetting ConVar callbacks...\n");
@@ -405,7 +427,13 @@ void Engine::onPaint()
 {
 	VPROF_BUDGET("Engine::onPaint", VPROF_BUDGETGROUP_DRAW);
 	if (m_bBlackout || m_bIsMinimized)
+	{
+		FrameArena::reset(); // (update still runs while minimized)
+		m_iPaintOnlyFrames = 0; // (nothing would be drawn, don't hold back updates until restored)
 		return;
+	}
+
+	const uint64_t drawStartNS = Timing::getTicksNS();
 
 	m_bDrawing = true;
 	{
@@ -439,14 +467,28 @@ void Engine::onPaint()
 			}
 		}
 
+		const uint64_t presentStartNS = Timing::getTicksNS();
+		m_frameTimeStats->record(FrameTimeStats::STAGE::DRAW, presentStartNS - drawStartNS);
+
 		// end
 		{
 			VPROF_BUDGET("Graphics::endScene", VPROF_BUDGETGROUP_DRAW_SWAPBUFFERS);
 			g->endScene();
 		}
+
+		m_frameTimeStats->record(FrameTimeStats::STAGE::PRESENT, Timing::getTicksNS() - presentStartNS);
 	}
 	m_bDrawing = false;
 
+	if (m_iPaintOnlyFrames > 0)
+	{
+		m_iPaintOnlyFrames--;
+		m_paintOnlyFrameCallback(Timing::getTicksNS() - drawStartNS);
+	}
+
+	// everything allocated from the frame arena during this update and draw is dead now
+	FrameArena::reset();
+
 	m_iFrameCount++;
 }
 
@@ -454,13 +496,23 @@ void Engine::onUpdate()
 {
 	VPROF_BUDGET("Engine::onUpdate", VPROF_BUDGETGROUP_UPDATE);
 
+	// finish running profile_capture traces (also while minimized)
+	TraceProfiler::update();
+	AllocTracker::update();
+
 	if (m_bBlackout || (m_bIsMinimized && !(networkHandler->isClient() || networkHandler->isServer())))
 		return;
 
+	if (m_iPaintOnlyFrames > 0)
+		return;
+
+	const uint64_t updateStartNS = Timing::getTicksNS();
+
 	// update time
 	{
 		m_timer->update();
 		m_dRunTime = m_timer->getElapsedTime();
+		VPROF_COUNTER("Frametime (ms)", m_dFrameTime * 1000.0);
 		m_dFrameTime *= (double)cv::host_timescale.getFloat();
 		m_dTime += m_dFrameTime;
 		if (cv::engine_throttle.getBool())
@@ -541,6 +593,14 @@ void Engine::onUpdate()
 		VPROF_BUDGET("Environment::update", VPROF_BUDGETGROUP_UPDATE);
 		env->update();
 	}
+
+	m_frameTimeStats->record(FrameTimeStats::STAGE::UPDATE, Timing::getTicksNS() - updateStartNS);
+}
+
+void Engine::requestPaintOnlyFrames(int numFrames, const PaintFrameCallback &callback)
+{
+	m_iPaintOnlyFrames = std::max(numFrames, 0);
+	m_paintOnlyFrameCallback = callback;
 }
 
 void Engine::onFocusGained()
@@ -776,6 +836,9 @@ void Engine::requestResolutionChange(Vector2 newResolution)
 
 void Engine::setFrameTime(double delta)
 {
+	if (!m_bIsMinimized) // (nothing is drawn, and background fps would only skew the distribution)
+		m_frameTimeStats->record(FrameTimeStats::STAGE::FRAME, static_cast<uint64_t>(std::max(delta, 0.0) * (double)Timing::NS_PER_SECOND));
+
 	// NOTE: clamp to between 10000 fps and 1 fps, very small/big timesteps could cause problems
 	m_dFrameTime = std::clamp<double>(delta, 0.0001, 1.0);
 }
@@ -28,12 +28,14 @@ class ResourceManager;
 class AnimationHandler;
 class SteamworksInterface;
 class DiscordInterface;
+class JobSystem;
 
 class CBaseUIContainer;
 class VisualProfiler;
 class ConsoleBox;
 class Console;
 class McMath;
+class FrameTimeStats;
 
 #ifdef _DEBUG
 #define debugLog(...) Engine::ContextLogger::log(std::source_location::current(), __FUNCTION__, __VA_ARGS__)
@@ -54,6 +56,11 @@ public:
 	void onPaint();
 	void onUpdate();
 
+	// skips onUpdate() for the next numFrames frames, so that every onPaint() in between draws exactly the same state (for render benchmarks)
+	// the callback gets the cpu time of each of those onPaint() calls
+	using PaintFrameCallback = SA::delegate<void(uint64_t)>;
+	void requestPaintOnlyFrames(int numFrames, const PaintFrameCallback &callback);
+
 	// window messages
 	void onFocusGained();
 	void onFocusLost();
@@ -120,6 +127,7 @@ public:
 	}
 
 	[[nodiscard]] inline uint64_t getFrameCount() const { return m_iFrameCount; }
+	[[nodiscard]] inline FrameTimeStats *getFrameTimeStats() const { return m_frameTimeStats; }
 	// clang-format off
 	// NOTE: if engine_throttle cvar is off, this will always return true
 	[[nodiscard]] inline bool throttledShouldRun(unsigned int howManyVsyncFramesToWaitBetweenExecutions) { return (m_fVsyncFrameCounterTime == 0.0f) && !(m_iVsyncFrameCount % howManyVsyncFramesToWaitBetweenExecutions);}
@@ -151,6 +159,9 @@ private:
 	uint8_t m_iVsyncFrameCount; // this will wrap quickly, and that's fine, it should be used as a dividend in a modular expression anyways
 	float m_fVsyncFrameCounterTime;
 	double m_dFrameTime;
+	FrameTimeStats *m_frameTimeStats;
+	int m_iPaintOnlyFrames;
+	PaintFrameCallback m_paintOnlyFrameCallback;
 	void onEngineThrottleChanged(float newVal);
 
 	// primary screen
@@ -259,6 +270,7 @@ extern std::unique_ptr<NetworkHandler> networkHandler;
 extern std::unique_ptr<AnimationHandler> animationHandler;
 extern std::unique_ptr<SteamworksInterface> steam;
 extern std::unique_ptr<DiscordInterface> discord;
+extern std::unique_ptr<JobSystem> jobSystem;
 
 extern Engine *engine;
 
@@ -11,6 +11,7 @@
 #include "Mouse.h"
 
 #include "DirectX11Interface.h"
+#include "NullGraphicsInterface.h"
 #include "SDLGLInterface.h"
 
 #include "File.h"
@@ -93,6 +94,7 @@ Environment::Environment(int argc, char *argv[])
 
 	m_engine = nullptr; // will be initialized by the mainloop once setup is complete
 	m_window = nullptr;
+	m_bNullRenderer = m_mArgMap.contains("-nullgfx");
 
 	m_bRunning = true;
 	m_bDrawing = false;
@@ -160,6 +162,9 @@ void Environment::update()
 
 Graphics *Environment::createRenderer()
 {
+	if (m_bNullRenderer)
+		return new NullGraphicsInterface();
+
 #ifndef MCENGINE_FEATURE_DIRECTX11
 	// need to load stuff dynamically before the base class constructors
 	SDLGLInterface::load();
@@ -31,6 +31,7 @@ public:
 
 	// engine/factory
 	Graphics *createRenderer();
+	[[nodiscard]] inline bool isNullRenderer() const { return m_bNullRenderer; } // "-nullgfx", no gpu context is created
 
 	// system
 	void shutdown();
@@ -152,6 +153,7 @@ protected:
 	Engine *m_engine;
 
 	SDL_Window *m_window;
+	bool m_bNullRenderer;
 
 	bool m_bRunning;
 	bool m_bDrawing;
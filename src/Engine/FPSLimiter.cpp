@@ -8,30 +8,161 @@
 #include "FPSLimiter.h"
 #include "Timing.h"
 #include "ConVar.h"
+#include "Engine.h"
+
+#include <SDL3/SDL_atomic.h>
+
+namespace cv
+{
+ConVar fps_limiter_spin("fps_limiter_spin", true, FCVAR_NONE, "sleep until shortly before the next frame is due and spin-wait the rest, the margin is calibrated from how late the OS wakes us up (more precise pacing at high fps_max, at the cost of some CPU time)");
+ConVar fps_limiter_vblank_latency("fps_limiter_vblank_latency", 0.0f, FCVAR_NONE, "if > 0, delay starting each frame until this many milliseconds before the next vblank, for lower input latency (needs vsync, and should be a bit more than a frame takes to update and draw)");
+ConVar fps_limiter_stats("fps_limiter_stats", FCVAR_NONE, "print how precisely the fps limiter has been hitting its target times (reset on fps_max changes)", []() -> void {
+	const FPSLimiter::STATS stats = FPSLimiter::getStats();
+	Engine::logRaw("waits: {}, wakeup error: {:.1f} us mean, {:.1f} us max, sleep overshoot: {:.1f} us, busy: {:.1f}%\n", stats.numWaits,
+	               (double)stats.meanErrorNS / (double)Timing::NS_PER_US, (double)stats.maxErrorNS / (double)Timing::NS_PER_US,
+	               (double)stats.sleepOvershootNS / (double)Timing::NS_PER_US, stats.busyFraction * 100.0);
+});
+} // namespace cv
+
+namespace
+{
+// the calibration starts out pessimistic (1 ms is common for Windows timer resolution), and learns quickly from there.
+// single extreme outliers (e.g. from a suspended process) must not turn into a long spin every frame, hence the limit.
+constexpr uint64_t INITIAL_SLEEP_OVERSHOOT_NS = 1 * Timing::NS_PER_MS;
+constexpr uint64_t MAX_SLEEP_OVERSHOOT_NS = 4 * Timing::NS_PER_MS;
+} // namespace
 
 unsigned long long FPSLimiter::s_iNextFrameTime{0};
+uint64_t FPSLimiter::s_iSleepOvershootNS{INITIAL_SLEEP_OVERSHOOT_NS};
+
+uint64_t FPSLimiter::s_iNumWaits{0};
+uint64_t FPSLimiter::s_iSumErrorNS{0};
+uint64_t FPSLimiter::s_iMaxErrorNS{0};
+uint64_t FPSLimiter::s_iSumWaitNS{0};
+uint64_t FPSLimiter::s_iSumSleepNS{0};
 
-void FPSLimiter::limitFrames(unsigned int targetFPS)
+void FPSLimiter::limitFrames(unsigned int targetFPS, const std::function<void()> &pollInput)
 {
+	// NOTE: called right after presenting, so with vsync on now is (close to) the last vblank
+	const uint64_t now = Timing::getTicksNS();
+	uint64_t deadline = 0;
+
 	if (targetFPS > 0)
 	{
 		const uint64_t frameTimeNS = Timing::NS_PER_SECOND / static_cast<uint64_t>(targetFPS);
-		const uint64_t now = Timing::getTicksNS();
 
-		// if we're ahead of schedule, sleep until next frame
-		if (s_iNextFrameTime > now)
-		{
-			const uint64_t sleepTime = s_iNextFrameTime - now;
-			Timing::sleepNS(sleepTime);
-		}
-		else
-		{
-			// behind schedule or exactly on time, reset to now
+		// frames which were only a little late keep the schedule (the next wait is just shorter), so that the average rate stays on target.
+		// if we're more than a whole frame behind (a hitch, or the limit was just changed), start over from now instead of catching up.
+		if (s_iNextFrameTime + frameTimeNS <= now)
 			s_iNextFrameTime = now;
-		}
-		// set time for next frame
+
+		deadline = s_iNextFrameTime;
 		s_iNextFrameTime += frameTimeNS;
 	}
+
+	const float vblankLatencyMS = cv::fps_limiter_vblank_latency.getFloat();
+	if (vblankLatencyMS > 0.0f && env->getDisplayRefreshTime() > 0.0f)
+	{
+		const auto displayPeriodNS = static_cast<uint64_t>(env->getDisplayRefreshTime() * (float)Timing::NS_PER_SECOND);
+		const auto latencyNS = static_cast<uint64_t>(vblankLatencyMS * (float)Timing::NS_PER_MS);
+		if (latencyNS < displayPeriodNS)
+			deadline = std::max(deadline, now + displayPeriodNS - latencyNS);
+	}
+
+	if (deadline > now)
+		waitUntil(deadline, pollInput);
+
 	if (cv::fps_yield.getBool())
 		Timing::sleep(0);
 }
+
+void FPSLimiter::waitUntil(uint64_t deadlineNS, const std::function<void()> &pollInput)
+{
+	const bool spin = cv::fps_limiter_spin.getBool();
+
+	// keep handling input while waiting, otherwise it would only be sampled at the frame rate
+	const int pollRate = cv::input_poll_rate.getInt();
+	const uint64_t pollIntervalNS = (pollInput && pollRate > 0 ? Timing::NS_PER_SECOND / static_cast<uint64_t>(pollRate) : UINT64_MAX);
+
+	const uint64_t startNS = Timing::getTicksNS();
+	uint64_t nextPollNS = (pollIntervalNS != UINT64_MAX ? startNS + pollIntervalNS : UINT64_MAX);
+	uint64_t sleptNS = 0;
+
+	uint64_t now = startNS;
+	while (now < deadlineNS)
+	{
+		if (now >= nextPollNS)
+		{
+			pollInput();
+			nextPollNS = now + pollIntervalNS;
+		}
+		else if (nextPollNS < deadlineNS && deadlineNS - nextPollNS > s_iSleepOvershootNS)
+		{
+			// poll times don't need to be precise, just sleep (the margin only makes sure a late wakeup can't push us past the deadline)
+			const uint64_t requestedNS = nextPollNS - now;
+			Timing::sleepNSCoarse(requestedNS);
+
+			const uint64_t afterSleepNS = Timing::getTicksNS();
+			sleptNS += afterSleepNS - now;
+			calibrate(requestedNS, afterSleepNS - now);
+		}
+		else if (!spin)
+		{
+			const uint64_t requestedNS = deadlineNS - now;
+			Timing::sleepNS(requestedNS);
+
+			sleptNS += Timing::getTicksNS() - now;
+		}
+		else if (deadlineNS > now + s_iSleepOvershootNS)
+		{
+			const uint64_t requestedNS = deadlineNS - now - s_iSleepOvershootNS;
+			Timing::sleepNSCoarse(requestedNS);
+
+			const uint64_t afterSleepNS = Timing::getTicksNS();
+			sleptNS += afterSleepNS - now;
+			calibrate(requestedNS, afterSleepNS - now);
+		}
+		else
+			SDL_CPUPauseInstruction(); // the last stretch until the deadline, sleeping would overshoot
+
+		now = Timing::getTicksNS();
+	}
+
+	const uint64_t errorNS = now - deadlineNS;
+	s_iNumWaits++;
+	s_iSumErrorNS += errorNS;
+	s_iMaxErrorNS = std::max(s_iMaxErrorNS, errorNS);
+	s_iSumWaitNS += now - startNS;
+	s_iSumSleepNS += sleptNS;
+}
+
+void FPSLimiter::calibrate(uint64_t requestedNS, uint64_t sleptNS)
+{
+	const uint64_t overshootNS = std::min(sleptNS > requestedNS ? sleptNS - requestedNS : 0, MAX_SLEEP_OVERSHOOT_NS);
+
+	// rise fast (waking up too late is what we want to avoid), decay slowly (spinning a bit longer is cheap)
+	if (overshootNS > s_iSleepOvershootNS)
+		s_iSleepOvershootNS += (overshootNS - s_iSleepOvershootNS + 1) / 2;
+	else
+		s_iSleepOvershootNS -= (s_iSleepOvershootNS - overshootNS) / 64;
+}
+
+void FPSLimiter::reset()
+{
+	s_iNextFrameTime = 0;
+
+	s_iNumWaits = 0;
+	s_iSumErrorNS = 0;
+	s_iMaxErrorNS = 0;
+	s_iSumWaitNS = 0;
+	s_iSumSleepNS = 0;
+}
+
+FPSLimiter::STATS FPSLimiter::getStats()
+{
+	return STATS{.numWaits = s_iNumWaits,
+	             .meanErrorNS = (s_iNumWaits > 0 ? s_iSumErrorNS / s_iNumWaits : 0),
+	             .maxErrorNS = s_iMaxErrorNS,
+	             .sleepOvershootNS = s_iSleepOvershootNS,
+	             .busyFraction = (s_iSumWaitNS > 0 ? 1.0 - static_cast<double>(s_iSumSleepNS) / static_cast<double>(s_iSumWaitNS) : 0.0)};
+}
@@ -7,9 +7,22 @@
 
 #pragma once
 
+#include <cstdint>
+#include <functional>
+
 class FPSLimiter final
 {
 public:
+	// how close the waits ended to their target time, since the last reset()
+	struct STATS
+	{
+		uint64_t numWaits;
+		uint64_t meanErrorNS;		// wakeup time - target time
+		uint64_t maxErrorNS;
+		uint64_t sleepOvershootNS;	// current calibration, see fps_limiter_spin
+		double busyFraction;		// share of the waiting time spent spinning or polling input instead of sleeping
+	};
+
 	FPSLimiter() = delete;
 	~FPSLimiter() = delete;
 	FPSLimiter &operator=(const FPSLimiter &) = delete;
@@ -17,9 +30,22 @@ public:
 	FPSLimiter(const FPSLimiter &) = delete;
 	FPSLimiter(FPSLimiter &&) = delete;
 
-	static void limitFrames(unsigned int targetFPS);
-	static inline void reset() { s_iNextFrameTime = 0; }
+	// pollInput (optional) is called input_poll_rate times per second while waiting
+	static void limitFrames(unsigned int targetFPS, const std::function<void()> &pollInput = nullptr);
+	static void reset();
+
+	[[nodiscard]] static STATS getStats();
 
 private:
+	static void waitUntil(uint64_t deadlineNS, const std::function<void()> &pollInput);
+	static void calibrate(uint64_t requestedNS, uint64_t sleptNS);
+
 	static unsigned long long s_iNextFrameTime;
+	static uint64_t s_iSleepOvershootNS;
+
+	static uint64_t s_iNumWaits;
+	static uint64_t s_iSumErrorNS;
+	static uint64_t s_iMaxErrorNS;
+	static uint64_t s_iSumWaitNS;
+	static uint64_t s_iSumSleepNS;
 };
@@ -41,6 +41,7 @@ static constexpr auto VERTS_PER_VAO = Env::cfg(REND::GLES32) ? 6 : 4;
 namespace cv
 {
 ConVar r_drawstring_max_string_length("r_drawstring_max_string_length", 65536, FCVAR_CHEAT, "maximum number of characters per call, sanity/memory buffer limit");
+ConVar r_drawstring_glyph_run_cache_kb("r_drawstring_glyph_run_cache_kb", 512, FCVAR_NONE, "per font memory budget for caching the geometry of drawn strings, in kilobytes (0 = disabled)");
 ConVar r_debug_drawstring_unbind("r_debug_drawstring_unbind", false, FCVAR_NONE);
 ConVar r_debug_font_atlas_padding("r_debug_font_atlas_padding", 1, FCVAR_NONE, "padding between glyphs in the atlas to prevent bleeding");
 ConVar r_debug_font_unicode("r_debug_font_unicode", false, FCVAR_NONE, "debug messages for unicode/fallback font related stuff");
@@ -52,6 +53,7 @@ FT_Library McFont::s_sharedFtLibrary = nullptr;
 bool McFont::s_sharedFtLibraryInitialized = false;
 std::vector<McFont::FallbackFont> McFont::s_sharedFallbackFonts;
 bool McFont::s_sharedFallbacksInitialized = false;
+std::unique_ptr<FontRasterizer> McFont::s_sharedRasterizer;
 
 McFont::McFont(const UString &filepath, int fontSize, bool antialiasing, int fontDPI)
     : Resource(filepath),
@@ -83,11 +85,15 @@ void McFont::constructor(const std::vector<wchar_t> &characters, int fontSize, b
 	m_batchActive = false;
 	m_batchQueue.totalVerts = 0;
 	m_batchQueue.usedEntries = 0;
+	m_fastGlyphMetrics.fill(nullptr);
+	m_iGlyphRunsBytes = 0;
 
 	// per-instance freetype initialization state
 	m_ftFace = nullptr;
 	m_bFreeTypeInitialized = false;
 	m_bAtlasNeedsRebuild = false;
+	m_iNumRasterizingGlyphs = 0;
+	m_iLastRasterizedGlyphsFrame = 0;
 
 	// setup error glyph
 	m_errorGlyph = {.character = UNKNOWN_CHAR,
@@ -120,6 +126,8 @@ void McFont::init()
 	// setup the static fallbacks once
 	initializeSharedFallbackFonts();
 
+	m_rasterizedGlyphs = std::make_shared<FontRasterizer::RESULTS>();
+
 	// load metrics for all initial glyphs
 	for (wchar_t ch : m_vGlyphs)
 	{
@@ -197,6 +205,7 @@ bool McFont::loadGlyphDynamic(wchar_t ch)
 		{
 			// successfully packed, render to atlas using the correct font face
 			renderGlyphToAtlas(ch, singleRect[0].x, singleRect[0].y, targetFace);
+			m_textureAtlas->upload();
 		}
 		else
 		{
@@ -210,6 +219,114 @@ bool McFont::loadGlyphDynamic(wchar_t ch)
 	return true;
 }
 
+void McFont::requestGlyph(wchar_t ch)
+{
+	if (!m_requestedGlyphs.insert(ch).second)
+		return;
+
+	m_iNumRasterizingGlyphs++;
+	s_sharedRasterizer->rasterize(FontRasterizer::REQUEST{.results = m_rasterizedGlyphs,
+	                                                      .fontFilePath = m_sFilePath,
+	                                                      .ch = ch,
+	                                                      .fontSize = m_iFontSize,
+	                                                      .fontDPI = m_iFontDPI,
+	                                                      .antialiasing = m_bAntialiasing});
+}
+
+void McFont::addRasterizedGlyphs()
+{
+	// batched, at most once per frame
+	if (m_iNumRasterizingGlyphs < 1 || m_iLastRasterizedGlyphsFrame == engine->getFrameCount())
+		return;
+
+	m_iLastRasterizedGlyphsFrame = engine->getFrameCount();
+
+	std::vector<FontRasterizer::GLYPH> glyphs;
+	{
+		std::scoped_lock lock(m_rasterizedGlyphs->mutex);
+		glyphs.swap(m_rasterizedGlyphs->glyphs);
+	}
+
+	if (glyphs.empty())
+		return;
+
+	m_iNumRasterizingGlyphs -= std::min(glyphs.size(), m_iNumRasterizingGlyphs);
+
+	std::vector<TextureAtlas::PackRect> packRects;
+	for (size_t i = 0; i < glyphs.size(); i++)
+	{
+		const FontRasterizer::GLYPH &glyph = glyphs[i];
+		if (glyph.fontIndex < 0)
+		{
+			if (cv::r_debug_font_unicode.getBool())
+				debugLog("Font Warning: Character U+{:04X} not supported by any font\n", (unsigned int)glyph.ch);
+			continue;
+		}
+
+		if (cv::r_debug_font_unicode.getBool() && glyph.fontIndex > 0)
+			debugLog("Font Info: Using fallback font #{:d} for character U+{:04X}\n", glyph.fontIndex, (unsigned int)glyph.ch);
+
+		m_vGlyphMetrics[glyph.ch] = GLYPH_METRICS{.character = glyph.ch,
+		                                          .uvPixelsX = 0,
+		                                          .uvPixelsY = 0,
+		                                          .sizePixelsX = static_cast<unsigned int>(glyph.width),
+		                                          .sizePixelsY = static_cast<unsigned int>(glyph.rows),
+		                                          .left = glyph.left,
+		                                          .top = glyph.top,
+		                                          .width = glyph.width,
+		                                          .rows = glyph.rows,
+		                                          .advance_x = glyph.advanceX,
+		                                          .fontIndex = glyph.fontIndex};
+		addGlyph(glyph.ch);
+
+		if (glyph.width > 0 && glyph.rows > 0)
+			packRects.push_back({0, 0, glyph.width, glyph.rows, static_cast<int>(i)});
+	}
+
+	if (packRects.empty())
+	{
+		clearGlyphRunCache(); // (placeholders of whitespace etc.)
+		return;
+	}
+
+	// grow the atlas in place if it's full, everything already in it stays where it is
+	bool packed = m_textureAtlas->packRects(packRects);
+	while (!packed && std::cmp_less(m_textureAtlas->getWidth(), MAX_ATLAS_SIZE))
+	{
+		const int newSize = std::min(m_textureAtlas->getWidth() * 2, static_cast<int>(MAX_ATLAS_SIZE));
+		if (!m_textureAtlas->grow(newSize, newSize))
+			break;
+
+		m_textureAtlas->getAtlasImage()->setFilterMode(m_bAntialiasing ? Graphics::FILTER_MODE::FILTER_MODE_LINEAR : Graphics::FILTER_MODE::FILTER_MODE_NONE);
+		packed = m_textureAtlas->packRects(packRects);
+	}
+
+	if (packed)
+	{
+		for (const auto &rect : packRects)
+		{
+			FontRasterizer::GLYPH &glyph = glyphs[rect.id];
+			m_textureAtlas->putAt(rect.x, rect.y, glyph.width, glyph.rows, false, true, glyph.pixels.data());
+
+			GLYPH_METRICS &metrics = m_vGlyphMetrics[glyph.ch];
+			metrics.uvPixelsX = static_cast<unsigned int>(rect.x);
+			metrics.uvPixelsY = static_cast<unsigned int>(rect.y);
+		}
+		m_textureAtlas->upload();
+	}
+	else
+	{
+		// full even at the maximum size, a rebuild packs everything tightly again
+		for (const auto &rect : packRects)
+		{
+			m_vPendingGlyphs.push_back(glyphs[rect.id].ch);
+		}
+		m_bAtlasNeedsRebuild = true;
+	}
+
+	clearGlyphRunCache(); // (runs still containing placeholders, and normalized uvs if the atlas grew)
+}
+
 FT_Face McFont::getFontFaceForGlyph(wchar_t ch, int &fontIndex)
 {
 	// check primary font first
@@ -316,6 +433,17 @@ bool McFont::initializeSharedFallbackFonts()
 	if (!Env::cfg(OS::WASM) && cv::font_load_system.getBool())
 		discoverSystemFallbacks();
 
+	// the workers open their own faces, so they only need to know where the fallbacks are
+	if (!Env::cfg(OS::WASM))
+	{
+		std::vector<UString> fallbackFontPaths;
+		for (const auto &fallbackFont : s_sharedFallbackFonts)
+		{
+			fallbackFontPaths.push_back(fallbackFont.fontPath);
+		}
+		s_sharedRasterizer = std::make_unique<FontRasterizer>(std::move(fallbackFontPaths));
+	}
+
 	s_sharedFallbacksInitialized = true;
 	return true;
 }
@@ -417,6 +545,7 @@ void McFont::rebuildAtlas()
 
 	// destroy old atlas
 	SAFE_DELETE(m_textureAtlas);
+	clearGlyphRunCache(); // (all uvs change)
 
 	// create new atlas and render all glyphs
 	if (!createAndPackAtlas(allGlyphs))
@@ -470,28 +599,6 @@ bool McFont::loadGlyphMetrics(wchar_t ch)
 	return loadGlyphFromFace(ch, face, fontIndex);
 }
 
-std::unique_ptr<std::vector<Color>> McFont::createExpandedBitmapData(const FT_Bitmap &bitmap)
-{
-	std::unique_ptr<std::vector<Color>> expandedData = std::make_unique<std::vector<Color>>(static_cast<size_t>(bitmap.width) * bitmap.rows);
-
-	std::vector<Channel> monoBitmapUnpacked;
-	if (!m_bAntialiasing)
-		monoBitmapUnpacked = unpackMonoBitmap(bitmap);
-
-	for (unsigned int j = 0; j < bitmap.rows; j++)
-	{
-		for (unsigned int k = 0; k < bitmap.width; k++)
-		{
-			const ssize_t expandedIdx = (k + (bitmap.rows - j - 1) * bitmap.width);
-
-			Channel alpha = m_bAntialiasing ? bitmap.buffer[k + bitmap.width * j] : monoBitmapUnpacked.begin()[k + bitmap.width * j] > 0 ? 255 : 0;
-			expandedData->begin()[expandedIdx] = argb(alpha, 0xff, 0xff, 0xff); // ARGB
-		}
-	}
-
-	return expandedData;
-}
-
 void McFont::renderGlyphToAtlas(wchar_t ch, int x, int y, FT_Face face)
 {
 	if (!face)
@@ -522,8 +629,8 @@ void McFont::renderGlyphToAtlas(wchar_t ch, int x, int y, FT_Face face)
 
 	if (bitmap.width > 0 && bitmap.rows > 0)
 	{
-		auto expandedData = createExpandedBitmapData(bitmap);
-		m_textureAtlas->putAt(x, y, static_cast<int>(bitmap.width), static_cast<int>(bitmap.rows), false, true, expandedData->data());
+		std::vector<Color> expandedData = FontRasterizer::expandBitmap(bitmap, m_bAntialiasing);
+		m_textureAtlas->putAt(x, y, static_cast<int>(bitmap.width), static_cast<int>(bitmap.rows), false, true, expandedData.data());
 
 		// update metrics with atlas coordinates
 		GLYPH_METRICS &metrics = m_vGlyphMetrics[ch];
@@ -594,7 +701,7 @@ bool McFont::createAndPackAtlas(const std::vector<wchar_t> &glyphs)
 	return true;
 }
 
-void McFont::buildGlyphGeometry(const GLYPH_METRICS &gm, const Vector3 &basePos, float advanceX, size_t &vertexCount)
+void McFont::buildGlyphGeometry(const GLYPH_METRICS &gm, const Vector3 &basePos, float advanceX, FrameVector<Vector3> &vertices, FrameVector<Vector2> &texcoords, size_t &vertexCount)
 {
 	const auto &atlasWidth{m_textureAtlas->getAtlasImage()->getWidth()};
 	const auto &atlasHeight{m_textureAtlas->getAtlasImage()->getHeight()};
@@ -627,58 +734,131 @@ void McFont::buildGlyphGeometry(const GLYPH_METRICS &gm, const Vector3 &basePos,
 	if constexpr (Env::cfg(REND::GLES32))
 	{
 		// first triangle (bottom-left, top-left, top-right)
-		m_vertices[idx] = bottomLeft;
-		m_vertices[idx + 1] = topLeft;
-		m_vertices[idx + 2] = topRight;
+		vertices[idx] = bottomLeft;
+		vertices[idx + 1] = topLeft;
+		vertices[idx + 2] = topRight;
 
-		m_texcoords[idx] = texBottomLeft;
-		m_texcoords[idx + 1] = texTopLeft;
-		m_texcoords[idx + 2] = texTopRight;
+		texcoords[idx] = texBottomLeft;
+		texcoords[idx + 1] = texTopLeft;
+		texcoords[idx + 2] = texTopRight;
 
 		// second triangle (bottom-left, top-right, bottom-right)
-		m_vertices[idx + 3] = bottomLeft;
-		m_vertices[idx + 4] = topRight;
-		m_vertices[idx + 5] = bottomRight;
+		vertices[idx + 3] = bottomLeft;
+		vertices[idx + 4] = topRight;
+		vertices[idx + 5] = bottomRight;
 
-		m_texcoords[idx + 3] = texBottomLeft;
-		m_texcoords[idx + 4] = texTopRight;
-		m_texcoords[idx + 5] = texBottomRight;
+		texcoords[idx + 3] = texBottomLeft;
+		texcoords[idx + 4] = texTopRight;
+		texcoords[idx + 5] = texBottomRight;
 	}
 	else
 	{
-		m_vertices[idx] = bottomLeft;      // bottom-left
-		m_vertices[idx + 1] = topLeft;     // top-left
-		m_vertices[idx + 2] = topRight;    // top-right
-		m_vertices[idx + 3] = bottomRight; // bottom-right
-
-		m_texcoords[idx] = texBottomLeft;
-		m_texcoords[idx + 1] = texTopLeft;
-		m_texcoords[idx + 2] = texTopRight;
-		m_texcoords[idx + 3] = texBottomRight;
+		vertices[idx] = bottomLeft;      // bottom-left
+		vertices[idx + 1] = topLeft;     // top-left
+		vertices[idx + 2] = topRight;    // top-right
+		vertices[idx + 3] = bottomRight; // bottom-right
+
+		texcoords[idx] = texBottomLeft;
+		texcoords[idx + 1] = texTopLeft;
+		texcoords[idx + 2] = texTopRight;
+		texcoords[idx + 3] = texBottomRight;
 	}
 	vertexCount += VERTS_PER_VAO;
 }
 
-void McFont::buildStringGeometry(const UString &text, size_t &vertexCount)
+void McFont::buildStringGeometry(const UString &text, FrameVector<Vector3> &vertices, FrameVector<Vector2> &texcoords, size_t &vertexCount)
 {
 	if (!m_bReady || text.length() == 0 || text.length() > cv::r_drawstring_max_string_length.getInt())
 		return;
 
-	// check if atlas needs rebuilding before geometry generation
-	if (m_bAtlasNeedsRebuild)
-		rebuildAtlas();
-
 	float advanceX = 0.0f;
-	const int maxGlyphs = std::min(text.length(), (int)(m_vertices.size() - vertexCount) / VERTS_PER_VAO);
+	const int maxGlyphs = std::min(text.length(), (int)(vertices.size() - vertexCount) / VERTS_PER_VAO);
 
 	for (int i = 0; i < maxGlyphs; i++)
 	{
 		const GLYPH_METRICS &gm = getGlyphMetrics(text[i]);
-		buildGlyphGeometry(gm, Vector3(), advanceX, vertexCount);
+		buildGlyphGeometry(gm, Vector3(), advanceX, vertices, texcoords, vertexCount);
 		advanceX += gm.advance_x;
 	}
 }
 
+void McFont::loadGlyphs(const UString &text)
+{
+	// (cached runs only contain loaded glyphs)
+	if (m_glyphRuns.contains(text))
+		return;
+
+	for (int i = 0; i < text.length(); i++)
+	{
+		getGlyphMetrics(text[i]);
+	}
+}
+
+void McFont::updateAtlas()
+{
+	addRasterizedGlyphs();
+
+	if (m_bAtlasNeedsRebuild)
+		rebuildAtlas();
+}
+
+const McFont::GLYPH_RUN &McFont::getGlyphRun(const UString &text)
+{
+	const auto cachedRun = m_glyphRuns.find(text);
+	if (cachedRun != m_glyphRuns.end())
+	{
+		m_glyphRunsLRU.splice(m_glyphRunsLRU.begin(), m_glyphRunsLRU, cachedRun->second.lruPosition);
+		return cachedRun->second;
+	}
+
+	// (scratch geometry lives in the frame arena, only cached runs get their own copy)
+	const size_t totalVerts = static_cast<size_t>(text.length()) * VERTS_PER_VAO;
+	FrameVector<Vector3> vertices(totalVerts);
+	FrameVector<Vector2> texcoords(totalVerts);
+
+	size_t vertexCount = 0;
+	buildStringGeometry(text, vertices, texcoords, vertexCount);
+
+	const size_t numBytes = vertexCount * (sizeof(Vector3) + sizeof(Vector2)) + text.length() * sizeof(wchar_t) + text.lengthUtf8() + sizeof(GLYPH_RUN);
+
+	// don't cache anything which still references glyphs waiting for the next atlas rebuild
+	const size_t maxBytes = static_cast<size_t>(std::max(cv::r_drawstring_glyph_run_cache_kb.getInt(), 0)) * 1024;
+	if (m_bAtlasNeedsRebuild || numBytes > maxBytes)
+	{
+		m_uncachedGlyphRun.vertices.assign(vertices.begin(), vertices.begin() + vertexCount);
+		m_uncachedGlyphRun.texcoords.assign(texcoords.begin(), texcoords.begin() + vertexCount);
+		m_uncachedGlyphRun.numBytes = numBytes;
+		return m_uncachedGlyphRun;
+	}
+
+	GLYPH_RUN run{.vertices = std::vector<Vector3>(vertices.begin(), vertices.begin() + vertexCount),
+	              .texcoords = std::vector<Vector2>(texcoords.begin(), texcoords.begin() + vertexCount),
+	              .numBytes = numBytes,
+	              .lruPosition = {}};
+
+	const auto [it, inserted] = m_glyphRuns.emplace(text, std::move(run));
+	m_glyphRunsLRU.push_front(&it->first);
+	it->second.lruPosition = m_glyphRunsLRU.begin();
+	m_iGlyphRunsBytes += it->second.numBytes;
+
+	while (m_iGlyphRunsBytes > maxBytes)
+	{
+		const auto leastRecentlyUsed = m_glyphRuns.find(*m_glyphRunsLRU.back());
+		m_iGlyphRunsBytes -= leastRecentlyUsed->second.numBytes;
+		m_glyphRunsLRU.pop_back();
+		m_glyphRuns.erase(leastRecentlyUsed);
+	}
+
+	return it->second;
+}
+
+void McFont::clearGlyphRunCache()
+{
+	m_glyphRuns.clear();
+	m_glyphRunsLRU.clear();
+	m_iGlyphRunsBytes = 0;
+}
+
 void McFont::drawString(const UString &text)
 {
 	if (!m_bReady)
@@ -688,19 +868,16 @@ void McFont::drawString(const UString &text)
 	if (text.length() == 0 || text.length() > maxNumGlyphs)
 		return;
 
-	m_vao.empty();
+	loadGlyphs(text);
+	updateAtlas();
 
-	const int totalVerts = text.length() * VERTS_PER_VAO;
-	m_vertices.resize(totalVerts);
-	m_texcoords.resize(totalVerts);
+	const GLYPH_RUN &run = getGlyphRun(text);
 
-	size_t vertexCount = 0;
-	buildStringGeometry(text, vertexCount);
-
-	for (int i = 0; i < vertexCount; i++)
+	m_vao.empty();
+	for (size_t i = 0; i < run.vertices.size(); i++)
 	{
-		m_vao.addVertex(m_vertices[i]);
-		m_vao.addTexcoord(m_texcoords[i]);
+		m_vao.addVertex(run.vertices[i]);
+		m_vao.addTexcoord(run.texcoords[i]);
 	}
 
 	m_textureAtlas->getAtlasImage()->bind();
@@ -748,22 +925,29 @@ void McFont::flushBatch()
 		return;
 	}
 
-	m_vertices.resize(m_batchQueue.totalVerts);
-	m_texcoords.resize(m_batchQueue.totalVerts);
+	const int maxNumGlyphs = cv::r_drawstring_max_string_length.getInt();
+
+	for (size_t i = 0; i < m_batchQueue.usedEntries; i++)
+	{
+		const auto &entry = m_batchQueue.entryList[i];
+		if (m_bReady && entry.text.length() <= maxNumGlyphs)
+			loadGlyphs(entry.text);
+	}
+	updateAtlas();
+
 	m_vao.empty();
 
-	size_t currentVertex = 0;
 	for (size_t i = 0; i < m_batchQueue.usedEntries; i++)
 	{
 		const auto &entry = m_batchQueue.entryList[i];
-		const size_t stringStart = currentVertex;
-		buildStringGeometry(entry.text, currentVertex);
+		if (!m_bReady || entry.text.length() > maxNumGlyphs)
+			continue;
 
-		for (size_t j = stringStart; j < currentVertex; j++)
+		const GLYPH_RUN &run = getGlyphRun(entry.text);
+		for (size_t j = 0; j < run.vertices.size(); j++)
 		{
-			m_vertices[j] += entry.pos;
-			m_vao.addVertex(m_vertices[j]);
-			m_vao.addTexcoord(m_texcoords[j]);
+			m_vao.addVertex(run.vertices[j] + entry.pos);
+			m_vao.addTexcoord(run.texcoords[j]);
 			m_vao.addColor(entry.color);
 		}
 	}
@@ -806,16 +990,32 @@ float McFont::getStringHeight(const UString &text) const
 
 const McFont::GLYPH_METRICS &McFont::getGlyphMetrics(wchar_t ch) const
 {
+	const bool isFastGlyph = (static_cast<size_t>(ch) < NUM_FAST_GLYPH_METRICS);
+	if (isFastGlyph && m_fastGlyphMetrics[ch] != nullptr)
+		return *m_fastGlyphMetrics[ch];
+
 	auto it = m_vGlyphMetrics.find(ch);
 	if (it != m_vGlyphMetrics.end())
+	{
+		if (isFastGlyph)
+			m_fastGlyphMetrics[ch] = &it->second;
+
 		return it->second;
+	}
 
-	// attempt dynamic loading for unicode characters
-	if (const_cast<McFont *>(this)->loadGlyphDynamic(ch))
+	// attempt dynamic loading for unicode characters (in the background if possible, the placeholder is used until then)
+	if (s_sharedRasterizer != nullptr && cv::font_load_async.getBool() && m_rasterizedGlyphs != nullptr)
+		const_cast<McFont *>(this)->requestGlyph(ch);
+	else if (const_cast<McFont *>(this)->loadGlyphDynamic(ch))
 	{
 		it = m_vGlyphMetrics.find(ch);
 		if (it != m_vGlyphMetrics.end())
+		{
+			if (isFastGlyph)
+				m_fastGlyphMetrics[ch] = &it->second;
+
 			return it->second;
+		}
 	}
 
 	// fallback to unknown character glyph
@@ -848,14 +1048,22 @@ void McFont::destroy()
 	}
 
 	SAFE_DELETE(m_textureAtlas);
+	clearGlyphRunCache();
+	m_fastGlyphMetrics.fill(nullptr);
 	m_vGlyphMetrics.clear();
 	m_vPendingGlyphs.clear();
+	m_rasterizedGlyphs.reset(); // (requests still in flight keep their own reference)
+	m_requestedGlyphs.clear();
+	m_iNumRasterizingGlyphs = 0;
 	m_fHeight = 1.0f;
 	m_bAtlasNeedsRebuild = false;
 }
 
 void McFont::cleanupSharedResources()
 {
+	// (joins the workers)
+	s_sharedRasterizer.reset();
+
 	// clean up shared fallback fonts
 	for (auto &fallbackFont : s_sharedFallbackFonts)
 	{
@@ -886,27 +1094,3 @@ bool McFont::addGlyph(wchar_t ch)
 	m_vGlyphExistence[ch] = true;
 	return true;
 }
-
-std::vector<Channel> McFont::unpackMonoBitmap(const FT_Bitmap &bitmap)
-{
-	std::vector<Channel> result(static_cast<size_t>(bitmap.rows) * bitmap.width);
-
-	for (int y = 0; std::cmp_less(y, bitmap.rows); y++)
-	{
-		for (int byteIdx = 0; byteIdx < bitmap.pitch; byteIdx++)
-		{
-			const unsigned char byteValue = bitmap.buffer[y * bitmap.pitch + byteIdx];
-			const unsigned int numBitsDone = byteIdx * 8;
-			const unsigned int rowstart = y * bitmap.width + byteIdx * 8;
-
-			const int bits = std::min(8, static_cast<int>(bitmap.width - numBitsDone));
-
-			for (int bitIdx = 0; bitIdx < bits; bitIdx++)
-			{
-				result[rowstart + bitIdx] = (byteValue & (1 << (7 - bitIdx))) ? 1 : 0;
-			}
-		}
-	}
-
-	return result;
-}
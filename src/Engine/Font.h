@@ -9,10 +9,15 @@
 #ifndef FONT_H
 #define FONT_H
 
+#include "FontRasterizer.h"
+#include "FrameArena.h"
 #include "Resource.h"
 #include "VertexArrayObject.h"
 
-typedef struct FT_Bitmap_ FT_Bitmap;
+#include <array>
+#include <list>
+#include <unordered_set>
+
 typedef struct FT_FaceRec_ *FT_Face;
 typedef struct FT_LibraryRec_ *FT_Library;
 
@@ -95,16 +100,29 @@ private:
 		std::vector<BatchEntry> entryList;
 	};
 
+	// prebuilt geometry of a whole string (at the origin), most UI text is drawn unchanged every frame
+	struct GLYPH_RUN
+	{
+		std::vector<Vector3> vertices;
+		std::vector<Vector2> texcoords;
+		size_t numBytes;
+		std::list<const UString *>::iterator lruPosition;
+	};
+
+	// the latin ranges are looked up through a flat array instead of hashing
+	static constexpr size_t NUM_FAST_GLYPH_METRICS = 0x250;
+
 	forceinline bool hasGlyph(wchar_t ch) const { return m_vGlyphMetrics.find(ch) != m_vGlyphMetrics.end(); };
 	bool addGlyph(wchar_t ch);
 	bool loadGlyphDynamic(wchar_t ch);
+	void requestGlyph(wchar_t ch);
+	void addRasterizedGlyphs();
 	bool ensureAtlasSpace(int requiredWidth, int requiredHeight);
 	void rebuildAtlas();
 
 	// consolidated glyph processing methods
 	bool initializeFreeType();
 	bool loadGlyphMetrics(wchar_t ch);
-	std::unique_ptr<std::vector<Color>> createExpandedBitmapData(const FT_Bitmap &bitmap);
 	void renderGlyphToAtlas(wchar_t ch, int x, int y, FT_Face face = nullptr);
 	bool createAndPackAtlas(const std::vector<wchar_t> &glyphs);
 
@@ -112,17 +130,26 @@ private:
 	FT_Face getFontFaceForGlyph(wchar_t ch, int &fontIndex);
 	bool loadGlyphFromFace(wchar_t ch, FT_Face face, int fontIndex);
 
-	void buildGlyphGeometry(const GLYPH_METRICS &gm, const Vector3 &basePos, float advanceX, size_t &vertexCount);
-	void buildStringGeometry(const UString &text, size_t &vertexCount);
+	void buildGlyphGeometry(const GLYPH_METRICS &gm, const Vector3 &basePos, float advanceX, FrameVector<Vector3> &vertices, FrameVector<Vector2> &texcoords, size_t &vertexCount);
+	void buildStringGeometry(const UString &text, FrameVector<Vector3> &vertices, FrameVector<Vector2> &texcoords, size_t &vertexCount);
+
+	// all glyphs of everything about to be drawn must be loaded before any geometry is built,
+	// adding one can grow or rebuild the atlas (which invalidates the uvs of everything built before)
+	void loadGlyphs(const UString &text);
+	void updateAtlas();
+
+	// valid until the next call
+	const GLYPH_RUN &getGlyphRun(const UString &text);
+	void clearGlyphRunCache();
 
 	const GLYPH_METRICS &getGlyphMetrics(wchar_t ch) const;
-	std::vector<Channel> unpackMonoBitmap(const FT_Bitmap &bitmap);
 
 	// shared freetype resources
 	static FT_Library s_sharedFtLibrary;
 	static bool s_sharedFtLibraryInitialized;
 	static std::vector<FallbackFont> s_sharedFallbackFonts;
 	static bool s_sharedFallbacksInitialized;
+	static std::unique_ptr<FontRasterizer> s_sharedRasterizer; // (nullptr if unavailable)
 
 	// shared resource initialization
 	static bool initializeSharedFreeType();
@@ -147,16 +174,27 @@ private:
 	std::vector<wchar_t> m_vGlyphs;
 	std::unordered_map<wchar_t, bool> m_vGlyphExistence;
 	std::unordered_map<wchar_t, GLYPH_METRICS> m_vGlyphMetrics;
+	mutable std::array<const GLYPH_METRICS *, NUM_FAST_GLYPH_METRICS> m_fastGlyphMetrics; // (pointers into m_vGlyphMetrics, nodes are never erased before destroy())
 
 	VertexArrayObject m_vao;
 	TextBatch m_batchQueue;
-	std::vector<Vector3> m_vertices;
-	std::vector<Vector2> m_texcoords;
 	bool m_batchActive;
 
+	// LRU cache of glyph runs, bounded by r_drawstring_glyph_run_cache_kb, cleared whenever the atlas changes
+	std::unordered_map<UString, GLYPH_RUN> m_glyphRuns;
+	std::list<const UString *> m_glyphRunsLRU; // most recently used first
+	size_t m_iGlyphRunsBytes;
+	GLYPH_RUN m_uncachedGlyphRun; // (reused, to keep its capacity)
+
 	// atlas management
 	mutable bool m_bAtlasNeedsRebuild;
 	std::vector<wchar_t> m_vPendingGlyphs;
+
+	// glyphs rendered by s_sharedRasterizer, drawn as UNKNOWN_CHAR until they are added to the atlas (at most once per frame)
+	std::shared_ptr<FontRasterizer::RESULTS> m_rasterizedGlyphs;
+	std::unordered_set<wchar_t> m_requestedGlyphs; // (also keeps characters without any font from being requested again)
+	size_t m_iNumRasterizingGlyphs;
+	uint64_t m_iLastRasterizedGlyphsFrame;
 };
 
 #endif
@@ -0,0 +1,185 @@
+//================ Copyright (c) 2025, WH, All rights reserved. =================//
+//
+// Purpose:		renders glyph bitmaps for McFont on background threads
+//
+// $NoKeywords: $fntrast
+//===============================================================================//
+
+#include "FontRasterizer.h"
+
+#include "ConVar.h"
+#include "Engine.h"
+#include "Profiler.h"
+#include "Thread.h"
+
+#include <ft2build.h>
+#include <freetype/freetype.h>
+#include <freetype/ftbitmap.h>
+#include <freetype/ftglyph.h>
+
+#include <algorithm>
+#include <unordered_map>
+
+namespace cv
+{
+ConVar font_load_async("font_load_async", true, FCVAR_NONE, "render glyphs which aren't in a font's atlas yet on background threads (they are drawn as a placeholder until ready)");
+ConVar font_load_async_threads("font_load_async_threads", 2, FCVAR_NONE, "number of threads used by font_load_async (only applies on startup)");
+} // namespace cv
+
+std::vector<Color> FontRasterizer::expandBitmap(const FT_Bitmap &bitmap, bool antialiasing)
+{
+	std::vector<Color> expandedData(static_cast<size_t>(bitmap.width) * bitmap.rows);
+
+	for (unsigned int j = 0; j < bitmap.rows; j++)
+	{
+		const unsigned char *row = bitmap.buffer + static_cast<ptrdiff_t>(j) * bitmap.pitch;
+		for (unsigned int k = 0; k < bitmap.width; k++)
+		{
+			const Channel alpha = antialiasing ? row[k] : ((row[k / 8] & (0x80 >> (k % 8))) ? 255 : 0);
+			expandedData[k + (bitmap.rows - j - 1) * bitmap.width] = argb(alpha, 0xff, 0xff, 0xff); // ARGB
+		}
+	}
+
+	return expandedData;
+}
+
+FontRasterizer::FontRasterizer(std::vector<UString> fallbackFontPaths)
+{
+	m_fallbackFontPaths = std::move(fallbackFontPaths);
+}
+
+FontRasterizer::~FontRasterizer()
+{
+	// (McThread requests stop and joins, which also wakes up the condition variable wait)
+	for (McThread *thread : m_threads)
+	{
+		delete thread;
+	}
+	m_threads.clear();
+}
+
+void FontRasterizer::rasterize(REQUEST request)
+{
+	{
+		std::scoped_lock lock(m_mutex);
+		m_requests.push_back(std::move(request));
+	}
+
+	if (m_threads.empty())
+	{
+		const int numThreads = std::clamp(cv::font_load_async_threads.getInt(), 1, 16);
+		for (int i = 0; i < numThreads; i++)
+		{
+			m_threads.push_back(new McThread([this](const std::stop_token &stopToken) { threadFunc(stopToken); }));
+		}
+	}
+	else
+		m_requestCond.notify_one();
+}
+
+void FontRasterizer::threadFunc(const std::stop_token &stopToken)
+{
+	VPROF_THREAD_NAME("FontRasterizer");
+
+	FT_Library library{};
+	if (FT_Init_FreeType(&library))
+	{
+		debugLog("FontRasterizer Error: FT_Init_FreeType() failed!\n");
+		return;
+	}
+
+	// this thread's faces, by file path (nullptr if the file couldn't be loaded)
+	std::unordered_map<UString, FT_Face> faces;
+	const auto getFace = [&](const UString &fontFilePath) -> FT_Face {
+		const auto it = faces.find(fontFilePath);
+		if (it != faces.end())
+			return it->second;
+
+		FT_Face face{};
+		if (FT_New_Face(library, fontFilePath.toUtf8(), 0, &face))
+			face = nullptr;
+		else if (FT_Select_Charmap(face, ft_encoding_unicode))
+		{
+			FT_Done_Face(face);
+			face = nullptr;
+		}
+
+		faces[fontFilePath] = face;
+		return face;
+	};
+
+	while (!stopToken.stop_requested())
+	{
+		REQUEST request;
+		{
+			std::unique_lock lock(m_mutex);
+			if (!m_requestCond.wait(lock, stopToken, [this] { return !m_requests.empty(); }))
+				break; // stop requested
+
+			request = std::move(m_requests.front());
+			m_requests.pop_front();
+		}
+
+		VPROF_TRACE("FontRasterizer::rasterize");
+
+		GLYPH glyph{.ch = request.ch, .fontIndex = -1, .left = 0, .top = 0, .width = 0, .rows = 0, .advanceX = 0.0f, .pixels = {}};
+
+		// same search order as McFont::getFontFaceForGlyph()
+		FT_Face face = getFace(request.fontFilePath);
+		if (face != nullptr && FT_Get_Char_Index(face, request.ch) != 0)
+			glyph.fontIndex = 0;
+		else
+		{
+			face = nullptr;
+			for (size_t i = 0; i < m_fallbackFontPaths.size(); i++)
+			{
+				FT_Face fallbackFace = getFace(m_fallbackFontPaths[i]);
+				if (fallbackFace != nullptr && FT_Get_Char_Index(fallbackFace, request.ch) != 0)
+				{
+					face = fallbackFace;
+					glyph.fontIndex = static_cast<int>(i + 1);
+					break;
+				}
+			}
+		}
+
+		if (face != nullptr)
+		{
+			FT_Set_Char_Size(face, static_cast<FT_F26Dot6>(request.fontSize) * 64, static_cast<FT_F26Dot6>(request.fontSize) * 64, request.fontDPI,
+			                 request.fontDPI);
+
+			FT_Glyph ftGlyph{};
+			if (FT_Load_Glyph(face, FT_Get_Char_Index(face, request.ch), request.antialiasing ? FT_LOAD_TARGET_NORMAL : FT_LOAD_TARGET_MONO) ||
+			    FT_Get_Glyph(face->glyph, &ftGlyph))
+			{
+				debugLog("FontRasterizer Error: Failed to load glyph for character {:d} from font index {:d}\n", (int)request.ch, glyph.fontIndex);
+				glyph.fontIndex = -1;
+			}
+			else
+			{
+				FT_Glyph_To_Bitmap(&ftGlyph, request.antialiasing ? FT_RENDER_MODE_NORMAL : FT_RENDER_MODE_MONO, nullptr, 1);
+
+				const auto bitmapGlyph = reinterpret_cast<FT_BitmapGlyph>(ftGlyph);
+				glyph.left = bitmapGlyph->left;
+				glyph.top = bitmapGlyph->top;
+				glyph.width = static_cast<int>(bitmapGlyph->bitmap.width);
+				glyph.rows = static_cast<int>(bitmapGlyph->bitmap.rows);
+				glyph.advanceX = static_cast<float>(face->glyph->advance.x >> 6);
+				if (glyph.width > 0 && glyph.rows > 0)
+					glyph.pixels = expandBitmap(bitmapGlyph->bitmap, request.antialiasing);
+
+				FT_Done_Glyph(ftGlyph);
+			}
+		}
+
+		std::scoped_lock lock(request.results->mutex);
+		request.results->glyphs.push_back(std::move(glyph));
+	}
+
+	for (auto &[fontFilePath, face] : faces)
+	{
+		if (face != nullptr)
+			FT_Done_Face(face);
+	}
+	FT_Done_FreeType(library);
+}
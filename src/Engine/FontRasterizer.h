@@ -0,0 +1,81 @@
+//================ Copyright (c) 2025, WH, All rights reserved. =================//
+//
+// Purpose:		renders glyph bitmaps for McFont on background threads
+//
+// $NoKeywords: $fntrast
+//===============================================================================//
+
+#pragma once
+#ifndef FONTRASTERIZER_H
+#define FONTRASTERIZER_H
+
+#include "cbase.h"
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+
+typedef struct FT_Bitmap_ FT_Bitmap;
+
+class McThread;
+
+// Loads and renders glyphs which aren't in a font's atlas yet, so that e.g. a song list full of CJK titles doesn't stall
+// the frame on FreeType. FreeType objects must not be shared between threads, so every worker has its own FT_Library and
+// opens its own faces (per font file, on first use). The font picks the results up once per frame and packs them all at once.
+class FontRasterizer final
+{
+public:
+	struct GLYPH
+	{
+		wchar_t ch;
+		int fontIndex; // 0 = primary font, >0 = fallback font, -1 = not supported by any font
+		int left, top, width, rows;
+		float advanceX;
+		std::vector<Color> pixels; // width * rows, bottom row first (see expandBitmap())
+	};
+
+	// one per font, shared with the workers so that fonts can be destroyed while requests are still in flight
+	struct RESULTS
+	{
+		std::mutex mutex;
+		std::vector<GLYPH> glyphs;
+	};
+
+	struct REQUEST
+	{
+		std::shared_ptr<RESULTS> results;
+		UString fontFilePath;
+		wchar_t ch;
+		int fontSize;
+		int fontDPI;
+		bool antialiasing;
+	};
+
+	// ARGB pixels of a rendered glyph bitmap, rows flipped
+	[[nodiscard]] static std::vector<Color> expandBitmap(const FT_Bitmap &bitmap, bool antialiasing);
+
+public:
+	// the fallback fonts are searched in order if the requested font doesn't have a glyph
+	FontRasterizer(std::vector<UString> fallbackFontPaths);
+	~FontRasterizer();
+
+	FontRasterizer &operator=(const FontRasterizer &) = delete;
+	FontRasterizer &operator=(FontRasterizer &&) = delete;
+	FontRasterizer(const FontRasterizer &) = delete;
+	FontRasterizer(FontRasterizer &&) = delete;
+
+	// the result is appended to request.results->glyphs when done (also if no font has the character)
+	void rasterize(REQUEST request);
+
+private:
+	void threadFunc(const std::stop_token &stopToken);
+
+	std::vector<UString> m_fallbackFontPaths;
+	std::vector<McThread *> m_threads; // only started on the first rasterize()
+
+	std::mutex m_mutex;
+	std::condition_variable_any m_requestCond;
+	std::deque<REQUEST> m_requests;
+};
+
+#endif
@@ -0,0 +1,110 @@
+//================ Copyright (c) 2025, WH, All rights reserved. =================//
+//
+// Purpose:		linear allocator for temporaries which only live for one frame
+//
+// $NoKeywords: $framearena
+//===============================================================================//
+
+#include "FrameArena.h"
+
+#include "AllocTracker.h"
+#include "ConVar.h"
+#include "Engine.h"
+#include "Profiler.h"
+
+std::vector<FrameArena::BLOCK> FrameArena::s_blocks;
+size_t FrameArena::s_iCurBlock = 0;
+size_t FrameArena::s_iCurOffset = 0;
+size_t FrameArena::s_iNumBytesUsed = 0;
+uint64_t FrameArena::s_iNumAllocations = 0;
+
+size_t FrameArena::s_iNumBytesLastFrame = 0;
+uint64_t FrameArena::s_iNumAllocationsLastFrame = 0;
+size_t FrameArena::s_iNumBytesPeak = 0;
+uint64_t FrameArena::s_iNumBlockAllocations = 0;
+
+void *FrameArena::allocate(size_t size, size_t alignment)
+{
+	if (s_iCurBlock < s_blocks.size())
+	{
+		BLOCK &block = s_blocks[s_iCurBlock];
+		const auto base = reinterpret_cast<uintptr_t>(block.data.get());
+		const size_t offset = ((base + s_iCurOffset + alignment - 1) & ~(uintptr_t)(alignment - 1)) - base;
+		if (offset + size <= block.size)
+		{
+			s_iCurOffset = offset + size;
+			s_iNumBytesUsed += size;
+			s_iNumAllocations++;
+			return block.data.get() + offset;
+		}
+	}
+
+	return allocateSlow(size, alignment);
+}
+
+void *FrameArena::allocateSlow(size_t size, size_t alignment)
+{
+	// the rest of the current block is wasted, which is fine, this only happens while growing
+	s_iCurBlock = (s_iCurBlock < s_blocks.size() ? s_iCurBlock + 1 : s_blocks.size());
+	s_iCurOffset = 0;
+
+	if (s_iCurBlock >= s_blocks.size() || s_blocks[s_iCurBlock].size < size + alignment)
+	{
+		const size_t blockSize = std::max(MIN_BLOCK_SIZE, size + alignment);
+		s_blocks.insert(s_blocks.begin() + static_cast<ptrdiff_t>(s_iCurBlock), BLOCK{.data = std::make_unique<std::byte[]>(blockSize), .size = blockSize});
+		s_iNumBlockAllocations++;
+	}
+
+	return allocate(size, alignment);
+}
+
+void FrameArena::reset()
+{
+	s_iNumBytesLastFrame = s_iNumBytesUsed;
+	s_iNumAllocationsLastFrame = s_iNumAllocations;
+	s_iNumBytesPeak = std::max(s_iNumBytesPeak, s_iNumBytesUsed);
+
+	VPROF_COUNTER("Frame arena allocations/frame", static_cast<double>(s_iNumAllocationsLastFrame));
+
+	// merge everything into one block if this frame didn't fit into the first one
+	if (s_iCurBlock > 0)
+	{
+		size_t capacity = 0;
+		for (const BLOCK &block : s_blocks)
+		{
+			capacity += block.size;
+		}
+
+		s_blocks.clear();
+		s_blocks.push_back(BLOCK{.data = std::make_unique<std::byte[]>(capacity), .size = capacity});
+		s_iNumBlockAllocations++;
+	}
+
+	s_iCurBlock = 0;
+	s_iCurOffset = 0;
+	s_iNumBytesUsed = 0;
+	s_iNumAllocations = 0;
+}
+
+FrameArena::STATS FrameArena::getStats()
+{
+	size_t capacity = 0;
+	for (const BLOCK &block : s_blocks)
+	{
+		capacity += block.size;
+	}
+
+	return STATS{.numBytesLastFrame = s_iNumBytesLastFrame, .numAllocationsLastFrame = s_iNumAllocationsLastFrame, .numBytesPeak = s_iNumBytesPeak, .capacity = capacity, .numBlockAllocations = s_iNumBlockAllocations};
+}
+
+namespace cv {
+ConVar frame_arena_stats("frame_arena_stats", FCVAR_NONE, "print how much memory per-frame temporaries used, and how many heap allocations the last frame still did", []() -> void {
+	const FrameArena::STATS stats = FrameArena::getStats();
+	Engine::logRaw("last frame: {} allocations, {} KB, peak: {} KB, capacity: {} KB, block allocations: {}\n", stats.numAllocationsLastFrame, stats.numBytesLastFrame / 1024,
+	               stats.numBytesPeak / 1024, stats.capacity / 1024, stats.numBlockAllocations);
+	if constexpr (AllocTracker::isEnabled())
+		Engine::logRaw("heap allocations last frame: {}\n", AllocTracker::getStats().numAllocationsLastFrame);
+	else
+		Engine::logRaw("(heap allocations per frame need a build with --enable-alloc-tracking)\n");
+});
+}
@@ -0,0 +1,82 @@
+//================ Copyright (c) 2025, WH, All rights reserved. =================//
+//
+// Purpose:		linear allocator for temporaries which only live for one frame
+//
+// $NoKeywords: $framearena
+//===============================================================================//
+
+#pragma once
+#ifndef FRAMEARENA_H
+#define FRAMEARENA_H
+
+#include "cbase.h"
+
+// Bump allocator which is rewound at the end of every Engine::onPaint(), so anything allocated from it (during update or draw)
+// must not be used after the current frame. Freeing is a no-op. If a frame needs more than the current capacity, more blocks
+// are allocated, and they are merged into a single block of the combined size on the next reset, so in steady state there
+// are no heap allocations at all.
+// NOTE: main thread only
+class FrameArena final
+{
+public:
+	struct STATS
+	{
+		size_t numBytesLastFrame;
+		uint64_t numAllocationsLastFrame;
+		size_t numBytesPeak;
+		size_t capacity;
+		uint64_t numBlockAllocations; // heap allocations done by the arena itself, since startup
+	};
+
+	FrameArena() = delete;
+
+	[[nodiscard]] static void *allocate(size_t size, size_t alignment);
+	static void reset();
+
+	[[nodiscard]] static STATS getStats();
+
+private:
+	static constexpr size_t MIN_BLOCK_SIZE = 256 * 1024;
+
+	struct BLOCK
+	{
+		std::unique_ptr<std::byte[]> data;
+		size_t size;
+	};
+
+	static void *allocateSlow(size_t size, size_t alignment);
+
+	static std::vector<BLOCK> s_blocks;
+	static size_t s_iCurBlock;
+	static size_t s_iCurOffset;
+	static size_t s_iNumBytesUsed;
+	static uint64_t s_iNumAllocations;
+
+	static size_t s_iNumBytesLastFrame;
+	static uint64_t s_iNumAllocationsLastFrame;
+	static size_t s_iNumBytesPeak;
+	static uint64_t s_iNumBlockAllocations;
+};
+
+// STL adapter, e.g. for FrameVector<T>
+template <typename T>
+class FrameAllocator
+{
+public:
+	using value_type = T;
+
+	FrameAllocator() noexcept = default;
+	template <typename U>
+	FrameAllocator(const FrameAllocator<U> &) noexcept {}
+
+	[[nodiscard]] inline T *allocate(size_t n) {return static_cast<T *>(FrameArena::allocate(n * sizeof(T), alignof(T)));}
+	inline void deallocate(T *, size_t) noexcept {}
+
+	template <typename U>
+	inline bool operator==(const FrameAllocator<U> &) const noexcept {return true;}
+};
+
+template <typename T>
+using FrameVector = std::vector<T, FrameAllocator<T>>;
+
+#endif
@@ -0,0 +1,146 @@
+//================ Copyright (c) 2025, WH, All rights reserved. =================//
+//
+// Purpose:		frame time distribution (percentiles, spikes)
+//
+// $NoKeywords: $frametimes
+//===============================================================================//
+
+#include "FrameTimeStats.h"
+
+#include "ConVar.h"
+#include "Engine.h"
+#include "Environment.h"
+
+#include <bit>
+
+size_t FrameTimeHistogram::valueToBucket(uint64_t us)
+{
+	if (us < 2 * NUM_SUB_BUCKETS)
+		return static_cast<size_t>(us);
+
+	// keep the SUB_BUCKET_BITS bits below the highest set bit
+	const unsigned int shift = static_cast<unsigned int>(std::bit_width(us)) - (SUB_BUCKET_BITS + 1);
+	return static_cast<size_t>(2 * NUM_SUB_BUCKETS + (shift - 1) * NUM_SUB_BUCKETS + ((us >> shift) - NUM_SUB_BUCKETS));
+}
+
+uint64_t FrameTimeHistogram::bucketToLowestValue(size_t bucket)
+{
+	if (bucket < 2 * NUM_SUB_BUCKETS)
+		return bucket;
+
+	const uint64_t shift = (bucket - 2 * NUM_SUB_BUCKETS) / NUM_SUB_BUCKETS + 1;
+	const uint64_t subBucket = (bucket - 2 * NUM_SUB_BUCKETS) % NUM_SUB_BUCKETS + NUM_SUB_BUCKETS;
+	return subBucket << shift;
+}
+
+uint64_t FrameTimeHistogram::bucketToHighestValue(size_t bucket)
+{
+	return (bucket + 1 < NUM_BUCKETS ? bucketToLowestValue(bucket + 1) - 1 : MAX_VALUE_US);
+}
+
+void FrameTimeHistogram::record(uint64_t ns)
+{
+	m_buckets[valueToBucket(std::min<uint64_t>(ns / Timing::NS_PER_US, MAX_VALUE_US))]++;
+	m_iCount++;
+	m_iSumNS += ns;
+	m_iMaxNS = std::max(m_iMaxNS, ns);
+}
+
+void FrameTimeHistogram::reset()
+{
+	m_buckets.fill(0);
+	m_iCount = 0;
+	m_iSumNS = 0;
+	m_iMaxNS = 0;
+}
+
+uint64_t FrameTimeHistogram::getPercentileNS(double percentile) const
+{
+	if (m_iCount < 1)
+		return 0;
+
+	const auto target = static_cast<uint64_t>(std::ceil(std::clamp(percentile, 0.0, 100.0) / 100.0 * static_cast<double>(m_iCount)));
+
+	uint64_t numSeen = 0;
+	for (size_t i=0; i<NUM_BUCKETS; i++)
+	{
+		numSeen += m_buckets[i];
+		if (numSeen >= std::max<uint64_t>(target, 1))
+			return std::min(bucketToHighestValue(i) * Timing::NS_PER_US, m_iMaxNS); // (the highest value which is equivalent to the recorded ones, like HdrHistogram)
+	}
+
+	return m_iMaxNS;
+}
+
+uint64_t FrameTimeHistogram::getNumAboveNS(uint64_t thresholdNS) const
+{
+	uint64_t numAbove = 0;
+	for (size_t i=valueToBucket(std::min<uint64_t>(thresholdNS / Timing::NS_PER_US, MAX_VALUE_US)) + 1; i<NUM_BUCKETS; i++)
+	{
+		numAbove += m_buckets[i];
+	}
+	return numAbove;
+}
+
+
+
+const char *FrameTimeStats::getStageName(STAGE stage)
+{
+	switch (stage)
+	{
+	case STAGE::FRAME:
+		return "Frame";
+	case STAGE::UPDATE:
+		return "Update";
+	case STAGE::DRAW:
+		return "Draw";
+	case STAGE::PRESENT:
+		return "Present";
+	default:
+		return "";
+	}
+}
+
+void FrameTimeStats::reset()
+{
+	for (FrameTimeHistogram &histogram : m_histograms)
+	{
+		histogram.reset();
+	}
+}
+
+std::string FrameTimeStats::toString() const
+{
+	const auto displayPeriodNS = static_cast<uint64_t>(env->getDisplayRefreshTime() * (float)Timing::NS_PER_SECOND);
+	const auto toMS = [](uint64_t ns) -> double { return static_cast<double>(ns) / (double)Timing::NS_PER_MS; };
+
+	std::string string = fmt::format("{:<8s} {:>8s} {:>8s} {:>8s} {:>8s} {:>8s} {:>8s}   > {:.2f} ms (display)\n", "ms", "mean", "p50", "p99", "p99.9",
+	                                 "max", "count", toMS(displayPeriodNS));
+	for (size_t i=0; i<m_histograms.size(); i++)
+	{
+		const FrameTimeHistogram &histogram = m_histograms[i];
+		const uint64_t numAbove = histogram.getNumAboveNS(displayPeriodNS);
+
+		string += fmt::format("{:<8s} {:>8.3f} {:>8.3f} {:>8.3f} {:>8.3f} {:>8.3f} {:>8d}   {:d} ({:.2f}%)\n", getStageName(static_cast<STAGE>(i)),
+		                      toMS(histogram.getMeanNS()), toMS(histogram.getPercentileNS(50.0)), toMS(histogram.getPercentileNS(99.0)),
+		                      toMS(histogram.getPercentileNS(99.9)), toMS(histogram.getMaxNS()), histogram.getCount(), numAbove,
+		                      histogram.getCount() > 0 ? 100.0 * static_cast<double>(numAbove) / static_cast<double>(histogram.getCount()) : 0.0);
+	}
+
+	return string;
+}
+
+
+
+//******************************//
+//	FrameTimeStats ConCommands  //
+//******************************//
+
+namespace cv {
+ConVar frametime_stats("frametime_stats", FCVAR_NONE, "print the frame time distribution (per stage) since startup or the last frametime_stats_reset", []() -> void {
+	Engine::logRaw("{:s}", engine->getFrameTimeStats()->toString());
+});
+ConVar frametime_stats_reset("frametime_stats_reset", FCVAR_NONE, "reset the frame time distribution printed by frametime_stats", []() -> void {
+	engine->getFrameTimeStats()->reset();
+});
+}
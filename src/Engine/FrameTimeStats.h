@@ -0,0 +1,79 @@
+//================ Copyright (c) 2025, WH, All rights reserved. =================//
+//
+// Purpose:		frame time distribution (percentiles, spikes)
+//
+// $NoKeywords: $frametimes
+//===============================================================================//
+
+#pragma once
+#ifndef FRAMETIMESTATS_H
+#define FRAMETIMESTATS_H
+
+#include "cbase.h"
+
+#include <array>
+
+// Log-linear histogram of durations in microseconds (like HdrHistogram): every power of two range is split into
+// NUM_SUB_BUCKETS equally sized buckets, so any recorded value is known to within ~3%, independent of its magnitude.
+// Recording is a couple of shifts and an increment, there is no allocation and no sorting.
+class FrameTimeHistogram
+{
+public:
+	FrameTimeHistogram() {reset();}
+
+	void record(uint64_t ns);
+	void reset();
+
+	[[nodiscard]] uint64_t getPercentileNS(double percentile) const; // [0, 100]
+	[[nodiscard]] uint64_t getNumAboveNS(uint64_t thresholdNS) const; // (bucket precision)
+
+	[[nodiscard]] inline uint64_t getCount() const {return m_iCount;}
+	[[nodiscard]] inline uint64_t getMaxNS() const {return m_iMaxNS;}
+	[[nodiscard]] inline uint64_t getMeanNS() const {return (m_iCount > 0 ? m_iSumNS / m_iCount : 0);}
+
+private:
+	static constexpr unsigned int SUB_BUCKET_BITS = 5;
+	static constexpr uint64_t NUM_SUB_BUCKETS = 1 << SUB_BUCKET_BITS;
+	static constexpr uint64_t MAX_VALUE_US = (1 << 24) - 1; // ~16.7 seconds, anything longer is clamped
+
+	// values below 2 * NUM_SUB_BUCKETS get one bucket each, above that NUM_SUB_BUCKETS per power of two
+	static constexpr size_t NUM_BUCKETS = 2 * NUM_SUB_BUCKETS + (24 - SUB_BUCKET_BITS - 1) * NUM_SUB_BUCKETS;
+
+	[[nodiscard]] static size_t valueToBucket(uint64_t us);
+	[[nodiscard]] static uint64_t bucketToLowestValue(size_t bucket);
+	[[nodiscard]] static uint64_t bucketToHighestValue(size_t bucket);
+
+	std::array<uint32_t, NUM_BUCKETS> m_buckets;
+	uint64_t m_iCount;
+	uint64_t m_iSumNS;
+	uint64_t m_iMaxNS;
+};
+
+// kept by the engine, always on
+class FrameTimeStats
+{
+public:
+	enum class STAGE : uint8_t
+	{
+		FRAME,		// full frame interval (what the user sees)
+		UPDATE,		// Engine::onUpdate()
+		DRAW,		// Engine::onPaint() without swapping buffers
+		PRESENT,	// swapping buffers (Graphics::endScene())
+		COUNT
+	};
+
+	static const char *getStageName(STAGE stage);
+
+	inline void record(STAGE stage, uint64_t ns) {m_histograms[static_cast<size_t>(stage)].record(ns);}
+	void reset();
+
+	// multi-line summary of all stages: percentiles, worst frame and frames which took longer than the display refresh time
+	[[nodiscard]] std::string toString() const;
+
+	[[nodiscard]] inline const FrameTimeHistogram &getHistogram(STAGE stage) const {return m_histograms[static_cast<size_t>(stage)];}
+
+private:
+	std::array<FrameTimeHistogram, static_cast<size_t>(STAGE::COUNT)> m_histograms;
+};
+
+#endif
@@ -9,14 +9,19 @@
 #include "Engine.h"
 #include "Environment.h"
 #include "File.h"
+#include "ConVar.h"
+#include "MD5.h"
 
 #include <png.h>
 #include <turbojpeg.h>
 #include <zlib.h>
 
+#include <array>
+#include <condition_variable>
 #include <csetjmp>
 #include <cstddef>
 #include <cstring>
+#include <limits>
 #include <mutex>
 #include <utility>
 
@@ -89,8 +94,80 @@ void pngReadFromMemory(png_structp png_ptr, png_bytep outBytes, png_size_t byteC
 	memcpy(outBytes, reader->data + reader->offset, byteCountToRead);
 	reader->offset += byteCountToRead;
 }
+
+// identifies the contents of an image file (md5 + size)
+struct SHARED_KEY
+{
+	size_t fileSize;
+	std::array<unsigned char, 16> md5;
+	bool mipmapped; // separate textures
+
+	bool operator==(const SHARED_KEY &) const = default;
+};
+
+struct SHARED_KEY_HASH
+{
+	size_t operator()(const SHARED_KEY &key) const noexcept
+	{
+		uint64_t md5Prefix;
+		std::memcpy(&md5Prefix, key.md5.data(), sizeof(md5Prefix));
+		return std::hash<uint64_t>{}(md5Prefix) ^ (key.fileSize << 1) ^ static_cast<size_t>(key.mipmapped);
+	}
+};
 } // namespace
 
+struct Image::SHARED_DATA
+{
+	SHARED_KEY key;
+
+	// immutable once decoded
+	Image::TYPE type{Image::TYPE::TYPE_PNG};
+	int width{0};
+	int height{0};
+	int numChannels{4};
+
+	std::vector<unsigned char> pixels; // freed as soon as the texture exists
+	uintptr_t texture{0};              // backend handle, 0 until the first user uploaded it
+
+	// for backends which store sampler state in the texture object, as last set up by any user
+	Graphics::FILTER_MODE textureFilterMode{Graphics::FILTER_MODE::FILTER_MODE_LINEAR};
+	Graphics::WRAP_MODE textureWrapMode{Graphics::WRAP_MODE::WRAP_MODE_CLAMP};
+
+	int numUsers{0};
+	bool decoded{false}; // false while the first user is still decoding
+	bool failed{false};
+};
+
+struct Image::SHARED_CACHE
+{
+	std::mutex mutex;
+	std::condition_variable decodedCond;
+	std::unordered_map<SHARED_KEY, std::shared_ptr<SHARED_DATA>, SHARED_KEY_HASH> entries;
+
+	uint64_t numHits{0};
+	uint64_t numMisses{0};
+	uint64_t numBytesSaved{0};
+};
+
+Image::SHARED_CACHE &Image::getSharedCache()
+{
+	static SHARED_CACHE cache;
+	return cache;
+}
+
+Image::SHARING_STATS Image::getSharingStats()
+{
+	SHARED_CACHE &cache = getSharedCache();
+	std::scoped_lock lock(cache.mutex);
+
+	SHARING_STATS stats{.numHits = cache.numHits, .numMisses = cache.numMisses, .numBytesSaved = cache.numBytesSaved, .numEntries = cache.entries.size(), .numPendingBytes = 0};
+	for (const auto &[key, entry] : cache.entries)
+	{
+		stats.numPendingBytes += entry->pixels.size();
+	}
+	return stats;
+}
+
 bool Image::decodePNGFromMemory(const unsigned char *data, size_t size, std::vector<unsigned char> &outData, int &outWidth, int &outHeight, int &outChannels)
 {
 	garbage_zlib();
@@ -301,6 +378,17 @@ Image::Image(int width, int height, bool mipmapped, bool keepInSystemMemory)
 }
 
 bool Image::loadRawImage()
+{
+	const bool loaded = loadRawImageInt();
+
+	// wake up everyone waiting for us to decode the shared pixels
+	if (m_shared != nullptr && !m_shared->decoded)
+		finishSharedData(loaded);
+
+	return loaded;
+}
+
+bool Image::loadRawImageInt()
 {
 	bool alreadyLoaded = m_rawImage.size() > 0;
 
@@ -350,6 +438,10 @@ bool Image::loadRawImage()
 		if (m_bInterrupted) // cancellation point
 			return false;
 
+		// another image with exactly the same file contents already decoded it, nothing left to do
+		if (acquireSharedData(fileBuffer))
+			return true;
+
 		const char *data{fileBuffer.data()};
 
 		// determine file type by magic number (png/jpg)
@@ -482,6 +574,147 @@ bool Image::loadRawImage()
 	return true;
 }
 
+bool Image::acquireSharedData(const std::vector<char> &fileBuffer)
+{
+	if (m_bKeepInSystemMemory || !cv::rm_image_sharing.getBool()) // system memory copies are expected to be modified
+		return false;
+
+	MD5 md5;
+	for (size_t offset = 0; offset < fileBuffer.size(); offset += std::numeric_limits<MD5::size_type>::max())
+	{
+		md5.update(fileBuffer.data() + offset, static_cast<MD5::size_type>(std::min<size_t>(fileBuffer.size() - offset, std::numeric_limits<MD5::size_type>::max())));
+	}
+	md5.finalize();
+
+	SHARED_KEY key{.fileSize = fileBuffer.size(), .md5 = {}, .mipmapped = m_bMipmapped};
+	std::memcpy(key.md5.data(), md5.getDigest(), key.md5.size());
+
+	SHARED_CACHE &cache = getSharedCache();
+	std::unique_lock lock(cache.mutex);
+
+	const auto it = cache.entries.find(key);
+	if (it == cache.entries.end())
+	{
+		// we are the first, decode normally and publish the result in finishSharedData()
+		m_shared = std::make_shared<SHARED_DATA>();
+		m_shared->key = key;
+		m_shared->numUsers = 1;
+		cache.entries.emplace(key, m_shared);
+		cache.numMisses++;
+		return false;
+	}
+
+	m_shared = it->second;
+	m_shared->numUsers++;
+
+	// someone else is decoding these exact bytes right now, wait for them instead of doing the same work again
+	// (they are guaranteed to be running on another thread, since they claimed the entry before returning from their loadRawImage())
+	cache.decodedCond.wait(lock, [this] { return m_shared->decoded || m_shared->failed; });
+
+	if (m_shared->failed)
+	{
+		// (the decoder already removed the entry, just try again on our own)
+		m_shared->numUsers--;
+		m_shared.reset();
+		return false;
+	}
+
+	m_type = m_shared->type;
+	m_iWidth = m_shared->width;
+	m_iHeight = m_shared->height;
+	m_iNumChannels = m_shared->numChannels;
+	m_bHasAlphaChannel = true;
+
+	cache.numHits++;
+	cache.numBytesSaved += static_cast<uint64_t>(m_iWidth) * m_iHeight * m_iNumChannels;
+
+	if (cv::debug_rm.getBool())
+		debugLog("Resource Manager: Sharing {:s} ({:d} users)\n", m_sFilePath, m_shared->numUsers);
+
+	return true;
+}
+
+void Image::finishSharedData(bool decoded)
+{
+	SHARED_CACHE &cache = getSharedCache();
+	{
+		std::scoped_lock lock(cache.mutex);
+
+		if (decoded)
+		{
+			m_shared->type = m_type;
+			m_shared->width = m_iWidth;
+			m_shared->height = m_iHeight;
+			m_shared->numChannels = m_iNumChannels;
+			m_shared->pixels = std::move(m_rawImage);
+			m_shared->decoded = true;
+		}
+		else
+		{
+			m_shared->failed = true;
+			m_shared->numUsers--;
+			cache.entries.erase(m_shared->key);
+			cache.numMisses--;
+			m_shared.reset();
+		}
+	}
+	cache.decodedCond.notify_all();
+}
+
+const unsigned char *Image::getRawPixels() const
+{
+	if (m_shared == nullptr)
+		return m_rawImage.empty() ? nullptr : m_rawImage.data();
+
+	// only touched by init()/destroy() on the main thread after decoding, no need to lock
+	return m_shared->pixels.empty() ? nullptr : m_shared->pixels.data();
+}
+
+uintptr_t Image::getSharedTexture() const
+{
+	return m_shared != nullptr ? m_shared->texture : 0;
+}
+
+void Image::setSharedTexture(uintptr_t texture)
+{
+	if (m_shared == nullptr || m_shared->texture != 0)
+		return;
+
+	std::scoped_lock lock(getSharedCache().mutex);
+	m_shared->texture = texture;
+	m_shared->pixels = std::vector<unsigned char>();
+}
+
+uintptr_t Image::releaseSharedTexture(uintptr_t ownTexture)
+{
+	if (m_shared == nullptr)
+		return ownTexture;
+
+	SHARED_CACHE &cache = getSharedCache();
+	std::scoped_lock lock(cache.mutex);
+
+	uintptr_t textureToFree = 0;
+	if (--m_shared->numUsers < 1)
+	{
+		// last one, whoever uploaded it doesn't matter anymore
+		textureToFree = (m_shared->texture != 0 ? m_shared->texture : ownTexture);
+		cache.entries.erase(m_shared->key);
+	}
+	m_shared.reset();
+
+	return textureToFree;
+}
+
+bool Image::claimSharedTextureState()
+{
+	if (m_shared == nullptr || (m_shared->textureFilterMode == m_filterMode && m_shared->textureWrapMode == m_wrapMode))
+		return false;
+
+	m_shared->textureFilterMode = m_filterMode;
+	m_shared->textureWrapMode = m_wrapMode;
+	return true;
+}
+
 void Image::setFilterMode(Graphics::FILTER_MODE filterMode)
 {
 	m_filterMode = filterMode;
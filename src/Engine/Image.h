@@ -46,6 +46,18 @@ public:
 	[[nodiscard]] inline Vector2 getSize() const { return {m_iWidth, m_iHeight}; }
 
 	[[nodiscard]] inline const bool &hasAlphaChannel() const { return m_bHasAlphaChannel; }
+	[[nodiscard]] inline bool isShared() const { return m_shared != nullptr; }
+
+	// images loaded from byte-identical files share one decoded pixel buffer and one texture (rm_image_sharing)
+	struct SHARING_STATS
+	{
+		uint64_t numHits;		// loads which didn't have to decode anything
+		uint64_t numMisses;		// loads which decoded (and published) a new pixel buffer
+		uint64_t numBytesSaved; // decoded bytes which weren't decoded/uploaded again because of hits
+		size_t numEntries;		// distinct file contents currently in use
+		size_t numPendingBytes; // shared pixel buffers which haven't been uploaded yet
+	};
+	static SHARING_STATS getSharingStats();
 
 	// type inspection
 	[[nodiscard]] Type getResType() const final { return IMAGE; }
@@ -60,6 +72,13 @@ protected:
 
 	bool loadRawImage();
 
+	// backend helpers for shared images, all of them are no-ops for unshared images
+	[[nodiscard]] const unsigned char *getRawPixels() const;	// pixels to upload (nullptr if the shared buffer is already gone)
+	[[nodiscard]] uintptr_t getSharedTexture() const;			// texture uploaded by another image with the same contents (or 0)
+	void setSharedTexture(uintptr_t texture);					// publish after uploading, frees the shared pixel buffer
+	[[nodiscard]] uintptr_t releaseSharedTexture(uintptr_t ownTexture); // returns the texture to free, 0 if other images still use it
+	[[nodiscard]] bool claimSharedTextureState();				// true if the shared texture was last set up with another filter/wrap mode
+
 	Image::TYPE m_type;
 	Graphics::FILTER_MODE m_filterMode;
 	Graphics::WRAP_MODE m_wrapMode;
@@ -76,6 +95,16 @@ protected:
 	std::vector<unsigned char> m_rawImage;
 
 private:
+	struct SHARED_DATA;
+	struct SHARED_CACHE;
+	static SHARED_CACHE &getSharedCache();
+
+	bool loadRawImageInt();
+	bool acquireSharedData(const std::vector<char> &fileBuffer);
+	void finishSharedData(bool decoded);
+
+	std::shared_ptr<SHARED_DATA> m_shared;
+
 	[[nodiscard]] bool isCompletelyTransparent() const;
 	static bool canHaveTransparency(const unsigned char *data, size_t size);	
 
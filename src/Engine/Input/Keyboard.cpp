@@ -51,7 +51,7 @@ void Keyboard::reset()
 	m_bSuperDown = false;
 }
 
-void Keyboard::onKeyDown(KEYCODE keyCode)
+void Keyboard::onKeyDown(KEYCODE keyCode, uint64_t timestampNS)
 {
 	switch (keyCode)
 	{
@@ -73,7 +73,7 @@ void Keyboard::onKeyDown(KEYCODE keyCode)
 		break;
 	}
 
-	KeyboardEvent e(keyCode);
+	KeyboardEvent e(keyCode, timestampNS);
 
 	for (auto & listener : m_listeners)
 	{
@@ -83,7 +83,7 @@ void Keyboard::onKeyDown(KEYCODE keyCode)
 	}
 }
 
-void Keyboard::onKeyUp(KEYCODE keyCode)
+void Keyboard::onKeyUp(KEYCODE keyCode, uint64_t timestampNS)
 {
 	switch (keyCode)
 	{
@@ -105,7 +105,7 @@ void Keyboard::onKeyUp(KEYCODE keyCode)
 		break;
 	}
 
-	KeyboardEvent e(keyCode);
+	KeyboardEvent e(keyCode, timestampNS);
 
 	for (auto & listener : m_listeners)
 	{
@@ -24,8 +24,8 @@ public:
 	void removeListener(KeyboardListener *keyboardListener);
 	void reset();
 
-	void onKeyDown(KEYCODE keyCode);
-	void onKeyUp(KEYCODE keyCode);
+	void onKeyDown(KEYCODE keyCode, uint64_t timestampNS = 0);
+	void onKeyUp(KEYCODE keyCode, uint64_t timestampNS = 0);
 	void onChar(KEYCODE charCode);
 
 	[[nodiscard]] inline const bool &isControlDown() const {return m_bControlDown;}
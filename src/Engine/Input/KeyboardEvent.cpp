@@ -7,9 +7,12 @@
 
 #include "KeyboardEvent.h"
 
-KeyboardEvent::KeyboardEvent(KEYCODE keyCode)
+#include "Timing.h"
+
+KeyboardEvent::KeyboardEvent(KEYCODE keyCode, uint64_t timestampNS)
 {
 	m_keyCode = keyCode;
+	m_iTimestampNS = (timestampNS != 0 ? timestampNS : Timing::getTicksNS());
 	m_bConsumed = false;
 }
 
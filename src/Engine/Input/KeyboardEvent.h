@@ -15,13 +15,14 @@ using KEYCODE = uint_fast16_t;
 class KeyboardEvent
 {
 public:
-	KeyboardEvent(KEYCODE keyCode);
+	KeyboardEvent(KEYCODE keyCode, uint64_t timestampNS = 0); // timestampNS: when the key was actually pressed (Timing::getTicksNS() time base), 0 = now
 
 	void consume();
 
 	[[nodiscard]] inline const bool &isConsumed() const {return m_bConsumed;}
 	[[nodiscard]] inline const KEYCODE &getKeyCode() const {return m_keyCode;}
 	[[nodiscard]] inline const KEYCODE &getCharCode() const {return m_keyCode;}
+	[[nodiscard]] inline uint64_t getTimestampNS() const {return m_iTimestampNS;}
 
 	inline bool operator == (const KEYCODE &rhs) const {return m_keyCode == rhs;}
 	inline bool operator != (const KEYCODE &rhs) const {return m_keyCode != rhs;}
@@ -30,6 +31,7 @@ public:
 
 private:
 	KEYCODE m_keyCode;
+	uint64_t m_iTimestampNS;
 	bool m_bConsumed;
 };
 
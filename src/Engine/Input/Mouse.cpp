@@ -24,6 +24,7 @@ ConVar tablet_sensitivity_ignore("tablet_sensitivity_ignore", false, FCVAR_NONE)
 Mouse::Mouse() : InputDevice()
 {
 	m_bMouseButtonDown.fill(false);
+	m_iButtonChangeTimestampNS = 0;
 
 	m_iWheelDeltaVertical = 0;
 	m_iWheelDeltaHorizontal = 0;
@@ -153,11 +154,19 @@ void Mouse::update()
 
 	m_bLastFrameHadMotion = false;
 
+	// hand out this frame's motion samples
+	std::swap(m_motionSamples, m_pendingMotionSamples);
+	m_pendingMotionSamples.clear();
+	for (MOTION_SAMPLE &sample : m_motionSamples)
+	{
+		sample.pos += m_vOffset;
+	}
+
 	if (unlikely(cv::mouse_fakelag.getBool()))
 		updateFakelagBuffer();
 }
 
-void Mouse::onMotion(float x, float y, float xRel, float yRel, bool preTransformed)
+void Mouse::onMotion(float x, float y, float xRel, float yRel, bool preTransformed, uint64_t timestampNS)
 {
 	Vector2 newRel{xRel, yRel}, newAbs{x, y};
 
@@ -208,6 +217,15 @@ void Mouse::onMotion(float x, float y, float xRel, float yRel, bool preTransform
 	// for the absolute position, we can just update it directly
 	m_vPosWithoutOffset = newAbs;
 
+	if (likely(cv::mouse_fakelag.getFloat() <= 0.0f))
+	{
+		// update() doesn't run on every frame (e.g. while minimized or during paint-only frames), only keep the most recent ones until then
+		if (m_pendingMotionSamples.size() >= MAX_PENDING_MOTION_SAMPLES)
+			m_pendingMotionSamples.erase(m_pendingMotionSamples.begin(), m_pendingMotionSamples.begin() + MAX_PENDING_MOTION_SAMPLES / 2);
+
+		m_pendingMotionSamples.push_back(MOTION_SAMPLE{.timestampNS = (timestampNS != 0 ? timestampNS : Timing::getTicksNS()), .pos = newAbs});
+	}
+
 	m_bLastFrameHadMotion = true;
 
 	if (unlikely(cv::debug_mouse.getBool()))
@@ -287,7 +305,7 @@ void Mouse::onWheelHorizontal(int delta)
 	}
 }
 
-void Mouse::onButtonChange(MouseButton::Index button, bool down)
+void Mouse::onButtonChange(MouseButton::Index button, bool down, uint64_t timestampNS)
 {
 	if (button < 1 || button >= BUTTON_COUNT)
 		return;
@@ -296,6 +314,7 @@ void Mouse::onButtonChange(MouseButton::Index button, bool down)
 		debugLog("Mouse::onButtonChange({}, {})\n", (int)button, (int)down);
 
 	m_bMouseButtonDown[button] = down;
+	m_iButtonChangeTimestampNS = (timestampNS != 0 ? timestampNS : Timing::getTicksNS());
 
 	// notify listeners
 	for (auto & listener : m_listeners)
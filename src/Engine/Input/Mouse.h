@@ -17,6 +17,13 @@
 
 class Mouse final : public InputDevice
 {
+public:
+	struct MOTION_SAMPLE
+	{
+		uint64_t timestampNS; // Timing::getTicksNS() time base
+		Vector2 pos;          // same space as getPos()
+	};
+
 public:
 	Mouse();
 	~Mouse() override { ; }
@@ -32,10 +39,10 @@ public:
 
 	// input handling
 	void onPosChange(Vector2 pos);
-	void onMotion(float x, float y, float xRel, float yRel, bool preTransformed);
+	void onMotion(float x, float y, float xRel, float yRel, bool preTransformed, uint64_t timestampNS = 0);
 	void onWheelVertical(int delta);
 	void onWheelHorizontal(int delta);
-	void onButtonChange(MouseButton::Index button, bool down);
+	void onButtonChange(MouseButton::Index button, bool down, uint64_t timestampNS = 0); // timestampNS: see KeyboardEvent
 
 	// position/coordinate handling
 	void setPos(Vector2 pos);
@@ -55,6 +62,9 @@ public:
 	[[nodiscard]] inline const Vector2 &getDelta() const { return m_vDelta; }
 	[[nodiscard]] inline const Vector2 &getRawDelta() const { return m_vRawDelta; }
 
+	// every position the cursor moved through before the last update(), oldest first (empty if it didn't move, or with mouse_fakelag)
+	[[nodiscard]] inline const std::vector<MOTION_SAMPLE> &getMotionSamples() const { return m_motionSamples; }
+
 	[[nodiscard]] inline const Vector2 &getOffset() const { return m_vOffset; }
 	[[nodiscard]] inline const Vector2 &getScale() const { return m_vScale; }
 	[[nodiscard]] inline const float &getSensitivity() const { return m_fSensitivity; }
@@ -69,6 +79,9 @@ public:
 	[[nodiscard]] inline const int &getWheelDeltaVertical() const { return m_iWheelDeltaVertical; }
 	[[nodiscard]] inline const int &getWheelDeltaHorizontal() const { return m_iWheelDeltaHorizontal; }
 
+	// when the button change currently being handled by the listeners actually happened (Timing::getTicksNS() time base)
+	[[nodiscard]] inline uint64_t getButtonChangeTimestampNS() const { return m_iButtonChangeTimestampNS; }
+
 	void resetWheelDelta();
 
 	// input mode control
@@ -91,6 +104,11 @@ private:
 	Vector2 m_vRawDelta;         // movement delta in the current frame, without consideration for clipping or sensitivity
 	Vector2 m_vActualPos;        // final cursor position after all transformations
 
+	static constexpr size_t MAX_PENDING_MOTION_SAMPLES = 4096; // (the older half gets dropped once full)
+
+	std::vector<MOTION_SAMPLE> m_motionSamples;
+	std::vector<MOTION_SAMPLE> m_pendingMotionSamples; // collected by onMotion() until the next update(), without offset
+
 	// mode tracking
 	bool m_bLastFrameHadMotion; // whether setPos was called in the previous frame
 	bool m_bAbsolute;                 // whether using absolute input (tablets)
@@ -100,6 +118,7 @@ private:
 
 	// button state (using our internal button index)
 	std::array<bool, BUTTON_COUNT> m_bMouseButtonDown;
+	uint64_t m_iButtonChangeTimestampNS;
 
 	// wheel state
 	int m_iWheelDeltaVertical;
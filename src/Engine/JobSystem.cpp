@@ -0,0 +1,322 @@
+//================ Copyright (c) 2025, WH, All rights reserved. =================//
+//
+// Purpose:		work-stealing job system with explicit dependencies and priorities
+//
+// $NoKeywords: $jobs
+//===============================================================================//
+
+#include "JobSystem.h"
+
+#include "Engine.h"
+#include "Environment.h"
+#include "Profiler.h"
+#include "Thread.h"
+
+#include <algorithm>
+
+namespace
+{
+constinit thread_local JobSystem::WORKER *s_currentWorker = nullptr;
+
+void *jobSystemWorkerThread(void *data, std::stop_token stopToken)
+{
+	auto *worker = static_cast<JobSystem::WORKER *>(data);
+	JobSystem *jobSystem = worker->jobSystem;
+
+	VPROF_THREAD_NAME("JobSystem");
+	s_currentWorker = worker;
+
+	while (!stopToken.stop_requested())
+	{
+		const JobSystem::JobHandle job = jobSystem->popJob();
+		if (!job)
+		{
+			jobSystem->waitForJobs(stopToken);
+			continue;
+		}
+
+		jobSystem->execute(job);
+	}
+
+	s_currentWorker = nullptr;
+	return nullptr;
+}
+} // namespace
+
+JobSystem::JobSystem(int numThreads)
+{
+	if (numThreads < 0)
+		numThreads = std::clamp(env->getLogicalCPUCount() - 1, 1, 32);
+	else
+		numThreads = std::min(numThreads, 32);
+
+	// all workers must exist before the first thread starts, since they steal from each other
+	for (int i=0; i<numThreads; i++)
+	{
+		auto worker = std::make_unique<WORKER>();
+		worker->jobSystem = this;
+		worker->index = static_cast<size_t>(i);
+		m_workers.push_back(std::move(worker));
+	}
+
+	for (auto &worker : m_workers)
+	{
+		worker->thread = std::make_unique<McThread>(jobSystemWorkerThread, worker.get());
+		if (!worker->thread->isReady())
+			engine->showMessageError("JobSystem Error", "Couldn't create worker thread!");
+	}
+
+	debugLog("JobSystem: {} worker thread(s)\n", m_workers.size());
+}
+
+JobSystem::~JobSystem()
+{
+	for (auto &worker : m_workers)
+	{
+		if (worker->thread)
+			worker->thread->requestStop();
+	}
+
+	// (joins)
+	for (auto &worker : m_workers)
+	{
+		worker->thread.reset();
+	}
+	m_workers.clear();
+
+	// anything still queued is dropped, nobody can be waiting for it anymore at this point
+	for (auto &queue : m_sharedQueues)
+	{
+		queue.clear();
+	}
+}
+
+JobSystem::JobHandle JobSystem::schedule(const char *name, std::function<void()> func, std::initializer_list<JobHandle> dependencies, PRIORITY priority)
+{
+	JobHandle job{new Job(name, std::move(func), priority)};
+	job->m_allocTag = AllocTracker::getThreadTag();
+
+	for (const JobHandle &dependency : dependencies)
+	{
+		if (!dependency)
+			continue;
+
+		std::lock_guard<std::mutex> lock(dependency->m_dependentsMutex);
+		if (dependency->isFinished())
+			continue;
+
+		job->m_iNumPendingDependencies.fetch_add(1, std::memory_order_relaxed);
+		dependency->m_dependents.push_back(job);
+	}
+
+	if (job->m_iNumPendingDependencies.fetch_sub(1, std::memory_order_acq_rel) == 1)
+		enqueue(job);
+
+	return job;
+}
+
+JobSystem::JobHandle JobSystem::then(const JobHandle &job, const char *name, std::function<void()> func, PRIORITY priority)
+{
+	return schedule(name, std::move(func), {job}, priority);
+}
+
+void JobSystem::wait(const JobHandle &job)
+{
+	if (!job)
+		return;
+
+	VPROF_TRACE("JobSystem::wait");
+
+	// without any workers nobody else would ever run the lower priority jobs, so everything has to be fair game then
+	const PRIORITY lowestPriority = (m_workers.empty() ? PRIORITY::LOW : job->m_priority);
+
+	while (!job->isFinished())
+	{
+		// help out instead of sleeping, this is also what makes waiting inside of a job (or without any workers) work
+		const JobHandle other = popJob(lowestPriority);
+		if (other)
+			execute(other);
+		else
+			Timing::sleep(0); // everything left is already running on other threads
+	}
+}
+
+void JobSystem::waitAll(const std::vector<JobHandle> &jobs)
+{
+	for (const JobHandle &job : jobs)
+	{
+		wait(job);
+	}
+}
+
+void JobSystem::runQueuedJobs()
+{
+	if (!m_workers.empty())
+		return;
+
+	// (only as many as are queued now, jobs which schedule more jobs would otherwise keep us here forever)
+	size_t numJobs = 0;
+	for (const std::atomic<size_t> &numQueued : m_numQueued)
+	{
+		numJobs += numQueued.load(std::memory_order_relaxed);
+	}
+
+	for (; numJobs > 0; numJobs--)
+	{
+		const JobHandle job = popJob(PRIORITY::LOW);
+		if (!job)
+			break;
+
+		execute(job);
+	}
+}
+
+void JobSystem::parallelFor(const char *name, size_t count, size_t minBatchSize, const std::function<void(size_t begin, size_t end)> &func, PRIORITY priority)
+{
+	if (count < 1)
+		return;
+
+	// a few batches per thread, so that stealing can even out batches which take longer than others
+	const size_t maxNumBatches = (m_workers.size() + 1) * 4;
+	const size_t batchSize = std::max({minBatchSize, (count + maxNumBatches - 1) / maxNumBatches, (size_t)1});
+
+	if (m_workers.empty() || batchSize >= count)
+	{
+		func(0, count);
+		return;
+	}
+
+	std::vector<JobHandle> jobs;
+	jobs.reserve(count / batchSize);
+	for (size_t begin=batchSize; begin<count; begin+=batchSize)
+	{
+		const size_t end = std::min(begin + batchSize, count);
+		jobs.push_back(schedule(name, [&func, begin, end]() -> void { func(begin, end); }, {}, priority));
+	}
+
+	// the first batch runs right here
+	func(0, batchSize);
+
+	waitAll(jobs);
+}
+
+bool JobSystem::isWorkerThread()
+{
+	return s_currentWorker != nullptr;
+}
+
+JobSystem::JobHandle JobSystem::popJob(PRIORITY lowestPriority)
+{
+	WORKER *self = (s_currentWorker != nullptr && s_currentWorker->jobSystem == this ? s_currentWorker : nullptr);
+
+	for (size_t p=0; p<=static_cast<size_t>(lowestPriority); p++)
+	{
+		if (m_numQueued[p].load(std::memory_order_relaxed) < 1)
+			continue;
+
+		JobHandle job;
+
+		// own jobs first (newest first, they are the most likely to still be in cache)
+		if (self != nullptr)
+		{
+			std::lock_guard<std::mutex> lock(self->queueMutex);
+			if (!self->queues[p].empty())
+			{
+				job = std::move(self->queues[p].back());
+				self->queues[p].pop_back();
+			}
+		}
+
+		if (!job)
+		{
+			std::lock_guard<std::mutex> lock(m_sharedQueueMutex);
+			if (!m_sharedQueues[p].empty())
+			{
+				job = std::move(m_sharedQueues[p].front());
+				m_sharedQueues[p].pop_front();
+			}
+		}
+
+		// steal the oldest job of someone else, starting at the next worker so that not everyone hammers the first one
+		const size_t start = (self != nullptr ? self->index + 1 : 0);
+		for (size_t i=0; !job && i<m_workers.size(); i++)
+		{
+			WORKER *victim = m_workers[(start + i) % m_workers.size()].get();
+			if (victim == self)
+				continue;
+
+			std::lock_guard<std::mutex> lock(victim->queueMutex);
+			if (!victim->queues[p].empty())
+			{
+				job = std::move(victim->queues[p].front());
+				victim->queues[p].pop_front();
+			}
+		}
+
+		if (job)
+		{
+			m_numQueued[p].fetch_sub(1, std::memory_order_relaxed);
+			return job;
+		}
+	}
+
+	return nullptr;
+}
+
+void JobSystem::waitForJobs(const std::stop_token &stopToken)
+{
+	std::unique_lock<std::mutex> lock(m_wakeMutex);
+	m_wakeCond.wait(lock, stopToken, [this]() {
+		return std::ranges::any_of(m_numQueued, [](const std::atomic<size_t> &numQueued) { return numQueued.load(std::memory_order_relaxed) > 0; });
+	});
+}
+
+void JobSystem::execute(const JobHandle &job)
+{
+	{
+		VPROF_TRACE(job->m_sName);
+		AllocTagScope allocTag(job->m_allocTag);
+
+		job->m_func();
+	}
+	job->m_func = nullptr; // (free captures right away, the handle may be kept around for a while)
+
+	std::vector<JobHandle> dependents;
+	{
+		std::lock_guard<std::mutex> lock(job->m_dependentsMutex);
+		job->m_bFinished.store(true, std::memory_order_release);
+		dependents.swap(job->m_dependents);
+	}
+
+	for (JobHandle &dependent : dependents)
+	{
+		if (dependent->m_iNumPendingDependencies.fetch_sub(1, std::memory_order_acq_rel) == 1)
+			enqueue(std::move(dependent));
+	}
+}
+
+void JobSystem::enqueue(JobHandle job)
+{
+	WORKER *self = (s_currentWorker != nullptr && s_currentWorker->jobSystem == this ? s_currentWorker : nullptr);
+	const auto p = static_cast<size_t>(job->m_priority);
+
+	// (counted before it's actually in a queue, so that popJob() can never decrement below zero)
+	m_numQueued[p].fetch_add(1, std::memory_order_relaxed);
+
+	if (self != nullptr)
+	{
+		std::lock_guard<std::mutex> lock(self->queueMutex);
+		self->queues[p].push_back(std::move(job));
+	}
+	else
+	{
+		std::lock_guard<std::mutex> lock(m_sharedQueueMutex);
+		m_sharedQueues[p].push_back(std::move(job));
+	}
+
+	// (lock/unlock so that a worker can't miss this between checking m_numQueued and going to sleep)
+	{
+		std::lock_guard<std::mutex> lock(m_wakeMutex);
+	}
+	m_wakeCond.notify_one();
+}
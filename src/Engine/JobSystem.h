@@ -0,0 +1,131 @@
+//================ Copyright (c) 2025, WH, All rights reserved. =================//
+//
+// Purpose:		work-stealing job system with explicit dependencies and priorities
+//
+// $NoKeywords: $jobs
+//===============================================================================//
+
+#pragma once
+#ifndef JOBSYSTEM_H
+#define JOBSYSTEM_H
+
+#include "AllocTracker.h"
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <mutex>
+#include <stop_token>
+#include <vector>
+
+class McThread;
+
+// The CPU thread pool of the engine: short CPU-bound pieces of work split off from (and waited on by) the main thread within a frame,
+// as well as asynchronous resource loads and CPU-bound background work.
+// Anything which blocks for a long time (network requests, database loading, ...) must get a thread of its own instead,
+// every worker it occupies is missing for everything else (and there may only be one).
+// A job only becomes runnable once all the jobs it was scheduled with as dependencies have finished.
+// Every worker has its own deques (one per priority), it pushes and pops its own jobs at the back, and idle workers steal from the front of the others.
+// Jobs scheduled from outside of the workers (e.g. the main thread) go into shared queues instead.
+// Higher priority jobs are always picked first, regardless of whose queue they are in.
+// wait() runs other runnable jobs on the calling thread until the waited-for job has finished, so waiting inside of a job is fine.
+// It only picks jobs of at least the priority of the waited-for job though, so that e.g. the main thread waiting on a HIGH job
+// never gets stuck inside of a LOW background job. Dependencies should therefore never have a lower priority than their dependents.
+// NOTE: jobs must not touch anything that is main thread only (Graphics, ResourceManager, AnimationHandler, the UI, ...)
+// NOTE: job names must be string literals (they are passed through to the profiler as is)
+class JobSystem final
+{
+public:
+	class Job;
+	using JobHandle = std::shared_ptr<Job>;
+
+	enum class PRIORITY : uint8_t
+	{
+		HIGH,   // somebody is waiting for it (within the current frame)
+		NORMAL, // asynchronous loads which are needed soon
+		LOW,    // background work nobody waits for
+		COUNT
+	};
+
+	explicit JobSystem(int numThreads); // < 0 = number of logical cores - 1, 0 = run all jobs (including asynchronous resource loads) on the waiting thread
+	~JobSystem();
+
+	JobSystem(const JobSystem &) = delete;
+	JobSystem &operator=(const JobSystem &) = delete;
+	JobSystem(JobSystem &&) = delete;
+	JobSystem &operator=(JobSystem &&) = delete;
+
+	JobHandle schedule(const char *name, std::function<void()> func, std::initializer_list<JobHandle> dependencies = {}, PRIORITY priority = PRIORITY::HIGH);
+	JobHandle then(const JobHandle &job, const char *name, std::function<void()> func, PRIORITY priority = PRIORITY::HIGH); // continuation, runs after job
+	void wait(const JobHandle &job);
+	void waitAll(const std::vector<JobHandle> &jobs);
+
+	// without any workers ("-jobthreads 0"), runs everything which is queued right now on the calling thread, since wait() only runs jobs until
+	// the waited-for one is done (and nobody waits for most NORMAL/LOW jobs). must be called regularly by the main thread, no-op otherwise
+	void runQueuedJobs();
+
+	// splits [0, count) into batches of at least minBatchSize, calls func(begin, end) for each of them in parallel, and returns once all are done
+	void parallelFor(const char *name, size_t count, size_t minBatchSize, const std::function<void(size_t begin, size_t end)> &func,
+	                 PRIORITY priority = PRIORITY::HIGH);
+
+	[[nodiscard]] inline size_t getNumWorkers() const { return m_workers.size(); }
+	[[nodiscard]] static bool isWorkerThread();
+
+	static constexpr size_t NUM_PRIORITIES = static_cast<size_t>(PRIORITY::COUNT);
+
+	struct WORKER
+	{
+		JobSystem *jobSystem;
+		size_t index;
+
+		std::array<std::deque<JobHandle>, NUM_PRIORITIES> queues;
+		std::mutex queueMutex;
+
+		std::unique_ptr<McThread> thread;
+	};
+
+	// used by the worker threads
+	JobHandle popJob(PRIORITY lowestPriority = PRIORITY::LOW);
+	void waitForJobs(const std::stop_token &stopToken);
+	void execute(const JobHandle &job);
+
+private:
+	void enqueue(JobHandle job);
+
+	std::vector<std::unique_ptr<WORKER>> m_workers;
+
+	std::array<std::deque<JobHandle>, NUM_PRIORITIES> m_sharedQueues;
+	std::mutex m_sharedQueueMutex;
+
+	std::array<std::atomic<size_t>, NUM_PRIORITIES> m_numQueued{}; // (per priority, so that popJob() can skip empty levels without locking anything)
+	std::condition_variable_any m_wakeCond;
+	std::mutex m_wakeMutex;
+};
+
+class JobSystem::Job final
+{
+public:
+	[[nodiscard]] inline bool isFinished() const { return m_bFinished.load(std::memory_order_acquire); }
+
+private:
+	friend class JobSystem;
+
+	Job(const char *name, std::function<void()> func, PRIORITY priority) : m_sName(name), m_func(std::move(func)), m_priority(priority) {}
+
+	const char *m_sName;
+	std::function<void()> m_func;
+	PRIORITY m_priority;
+	AllocTracker::TAG m_allocTag{AllocTracker::TAG::UNTAGGED};
+
+	std::atomic<int> m_iNumPendingDependencies{1}; // (+1 held by schedule() until all dependencies are registered)
+	std::atomic<bool> m_bFinished{false};
+
+	std::mutex m_dependentsMutex;
+	std::vector<JobHandle> m_dependents;
+};
+
+#endif
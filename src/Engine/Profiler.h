@@ -10,6 +10,7 @@
 #define PROFILER_H
 
 #include "EngineFeatures.h"
+#include "TraceProfiler.h"
 
 #if defined(_DEBUG) || defined(MCENGINE_FEATURE_PROFILING)
 
@@ -26,6 +27,12 @@
 #define VPROF_ENTER_SCOPE(name)				g_profCurrentProfile.enterScope(name, VPROF_BUDGETGROUP_ROOT)
 #define VPROF_EXIT_SCOPE()					g_profCurrentProfile.exitScope()
 
+// these work on any thread, but only show up in profile_capture traces (not in the visual profiler)
+#define VPROF_TRACE(name)					VPROF_TRACE_(name, VPROF_BUDGETGROUP_ASYNC)
+#define VPROF_TRACE_(name, group)			TraceProfilerScope TraceProf_(name, group);
+#define VPROF_COUNTER(name, value)			TraceProfiler::recordCounter(name, value)
+#define VPROF_THREAD_NAME(name)				TraceProfiler::setThreadName(name)
+
 #else
 
 #define VPROF_MAIN()
@@ -41,6 +48,11 @@
 #define VPROF_ENTER_SCOPE(name)
 #define VPROF_EXIT_SCOPE()
 
+#define VPROF_TRACE(name)
+#define VPROF_TRACE_(name, group)
+#define VPROF_COUNTER(name, value)
+#define VPROF_THREAD_NAME(name)
+
 #endif
 
 #define VPROF_BUDGETGROUP_ROOT				"Root"
@@ -49,6 +61,7 @@
 #define VPROF_BUDGETGROUP_UPDATE			"Update"
 #define VPROF_BUDGETGROUP_DRAW				"Draw"
 #define VPROF_BUDGETGROUP_DRAW_SWAPBUFFERS	"SwapBuffers"
+#define VPROF_BUDGETGROUP_ASYNC				"Async"
 
 #define VPROF_MAX_NUM_BUDGETGROUPS			32
 #define VPROF_MAX_NUM_NODES					32
@@ -213,8 +226,11 @@ extern ProfilerProfile g_profCurrentProfile;
 class ProfilerScope
 {
 public:
-	inline ProfilerScope(const char *name, const char *group) {g_profCurrentProfile.enterScope(name, group);}
+	inline ProfilerScope(const char *name, const char *group) : m_trace(name, group) {g_profCurrentProfile.enterScope(name, group);}
 	inline ~ProfilerScope() {g_profCurrentProfile.exitScope();}
+
+private:
+	TraceProfilerScope m_trace;
 };
 
 #endif
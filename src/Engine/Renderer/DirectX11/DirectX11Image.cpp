@@ -16,6 +16,8 @@
 #include "DirectX11Interface.h"
 #include "DirectX11Shader.h"
 
+#include <cstring>
+
 DirectX11Image::DirectX11Image(UString filepath, bool mipmapped, bool keepInSystemMemory) : Image(filepath, mipmapped, keepInSystemMemory)
 {
 	m_texture = NULL;
@@ -52,6 +54,15 @@ void DirectX11Image::init()
 	if (m_interfaceOverrideHack != NULL)
 		graphics = m_interfaceOverrideHack;
 
+	// a byte-identical file has already been uploaded, reference its texture (still needs our own view and sampler below)
+	const bool sharedTexture = (m_texture == NULL && getSharedTexture() != 0);
+	if (sharedTexture)
+	{
+		m_texture = reinterpret_cast<ID3D11Texture2D*>(getSharedTexture());
+		m_texture->AddRef();
+	}
+	const unsigned char *pixels = getRawPixels();
+
 	// create texture (with initial data)
 	D3D11_TEXTURE2D_DESC textureDesc;
 	D3D11_SUBRESOURCE_DATA initData;
@@ -76,11 +87,11 @@ void DirectX11Image::init()
 		{
 			// initData
 			{
-				initData.pSysMem = (void*)&m_rawImage[0];
+				initData.pSysMem = (const void*)pixels;
 				initData.SysMemPitch = static_cast<UINT>(m_iWidth * m_iNumChannels * sizeof(unsigned char));
 				initData.SysMemSlicePitch = 0;
 			}
-			hr = graphics->getDevice()->CreateTexture2D(&textureDesc, (!m_bMipmapped && m_rawImage.size() >= m_iWidth * m_iHeight * m_iNumChannels ? &initData : NULL), &m_texture);
+			hr = graphics->getDevice()->CreateTexture2D(&textureDesc, (!m_bMipmapped && pixels != NULL ? &initData : NULL), &m_texture);
 			if (FAILED(hr) || m_texture == NULL)
 			{
 				debugLog("DirectX Image Error: Couldn't CreateTexture2D({}, {:x}, {:x}) on file {:s}!\n", hr, hr, MAKE_DXGI_HRESULT(hr), m_sFilePath.toUtf8());
@@ -88,9 +99,22 @@ void DirectX11Image::init()
 				return;
 			}
 		}
-		else
+		else if (!sharedTexture && pixels != NULL)
 		{
-			// TODO: Map(), upload m_rawImage, Unmap()
+			// re-upload the (modified) system memory copy, only reachable for dynamic textures (m_bKeepInSystemMemory)
+			D3D11_MAPPED_SUBRESOURCE mappedResource;
+			hr = graphics->getDeviceContext()->Map(m_texture, 0, D3D11_MAP::D3D11_MAP_WRITE_DISCARD, 0, &mappedResource);
+			if (SUCCEEDED(hr))
+			{
+				const size_t rowBytes = static_cast<size_t>(m_iWidth) * m_iNumChannels;
+				for (int y = 0; y < m_iHeight; y++)
+				{
+					std::memcpy(static_cast<unsigned char*>(mappedResource.pData) + static_cast<size_t>(y) * mappedResource.RowPitch, pixels + y * rowBytes, rowBytes);
+				}
+				graphics->getDeviceContext()->Unmap(m_texture, 0);
+			}
+			else
+				debugLog("DirectX Image Error: Couldn't Map({}, {:x}, {:x}) on file {:s}!\n", hr, hr, MAKE_DXGI_HRESULT(hr), m_sFilePath.toUtf8());
 		}
 	}
 
@@ -123,7 +147,7 @@ void DirectX11Image::init()
 		}
 
 		// upload new/overwrite data (mipmapped) (2/2)
-		if (m_bMipmapped)
+		if (m_bMipmapped && !sharedTexture)
 			graphics->getDeviceContext()->UpdateSubresource(m_texture, 0, NULL, initData.pSysMem, initData.SysMemPitch, initData.SysMemPitch * (UINT)m_iHeight);
 	}
 
@@ -132,9 +156,16 @@ void DirectX11Image::init()
 		m_rawImage = std::vector<unsigned char>();
 
 	// create mipmaps
-	if (m_bMipmapped)
+	if (m_bMipmapped && !sharedTexture)
 		graphics->getDeviceContext()->GenerateMips(m_shaderResourceView);
 
+	// publish for other images with the same contents, the cache holds its own reference (released by the last user in destroy())
+	if (!sharedTexture && isShared() && getSharedTexture() == 0)
+	{
+		m_texture->AddRef();
+		setSharedTexture(reinterpret_cast<uintptr_t>(m_texture));
+	}
+
 	// create sampler
 	{
 		// default sampler
@@ -259,6 +290,10 @@ void DirectX11Image::destroy()
 		m_texture = NULL;
 	}
 
+	// the cache's reference on a shared texture
+	if (auto *sharedTexture = reinterpret_cast<ID3D11Texture2D*>(releaseSharedTexture(0)); sharedTexture != NULL)
+		sharedTexture->Release();
+
 	m_rawImage = std::vector<unsigned char>();
 }
 
@@ -406,6 +406,8 @@ DirectX11Interface::~DirectX11Interface()
 
 void DirectX11Interface::beginScene()
 {
+	resetDrawStats();
+
 #ifndef NO_FLIP
 	// ensure render targets are bound (needed because onResolutionChange might skip setup during init)
 	if (m_frameBuffer != NULL)
@@ -617,6 +619,7 @@ void DirectX11Interface::drawPixel(int x, int y)
 		m_deviceContext->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY::D3D11_PRIMITIVE_TOPOLOGY_POINTLIST);
 		m_deviceContext->Draw(m_vertices.size(), numVertexOffset);
 		m_iStatsNumDrawCalls++;
+		countDrawCall();
 	}
 }
 
@@ -831,6 +834,7 @@ void DirectX11Interface::drawVAO(VertexArrayObject *vao)
 		}
 
 		vao->draw();
+		countDrawCall();
 		return;
 	}
 
@@ -1039,6 +1043,7 @@ void DirectX11Interface::drawVAO(VertexArrayObject *vao)
 		m_deviceContext->IASetPrimitiveTopology((D3D_PRIMITIVE_TOPOLOGY)primitiveToDirectX(primitive));
 		m_deviceContext->Draw(m_vertices.size(), numVertexOffset);
 		m_iStatsNumDrawCalls++;
+		countDrawCall();
 	}
 }
 
@@ -10,6 +10,9 @@
 #include "Engine.h"
 #include "ConVar.h"
 #include "Camera.h"
+#include "Image.h"
+#include "VertexArrayObject.h"
+
 namespace cv {
 ConVar r_3dscene_zn("r_3dscene_zn", 5.0f, FCVAR_CHEAT);
 ConVar r_3dscene_zf("r_3dscene_zf", 5000.0f, FCVAR_CHEAT);
@@ -20,6 +23,7 @@ ConVar r_debug_disable_cliprect("r_debug_disable_cliprect", false, FCVAR_CHEAT);
 ConVar r_debug_disable_3dscene("r_debug_disable_3dscene", false, FCVAR_CHEAT);
 ConVar r_debug_flush_drawstring("r_debug_flush_drawstring", false, FCVAR_NONE);
 ConVar r_debug_drawimage("r_debug_drawimage", false, FCVAR_CHEAT);
+ConVar r_batch_images("r_batch_images", true, FCVAR_NONE, "merge consecutive drawImage() calls with the same texture into a single draw call (if supported by the renderer)");
 }
 
 Graphics::Graphics()
@@ -32,6 +36,9 @@ Graphics::Graphics()
 	// init 3d gui scene stack
 	m_bIs3dScene = false;
 	m_3dSceneStack.push(false);
+
+	// sprite batching
+	m_bFlushingBatch = false;
 }
 
 void Graphics::pushTransform()
@@ -226,6 +233,9 @@ void Graphics::forceUpdateTransform()
 
 void Graphics::updateTransform(bool force)
 {
+	// every draw goes through here before touching the api, so anything batched until now has to be submitted first to keep the draw order
+	flushBatch();
+
 	if (!m_bTransformUpToDate || force)
 	{
 		m_worldMatrix = m_worldTransformStack.top();
@@ -268,6 +278,62 @@ void Graphics::checkStackLeaks()
 }
 
 
+bool Graphics::batchImage(Image *image, Color color)
+{
+	if (!cv::r_batch_images.getBool() || cv::r_debug_drawimage.getBool())
+		return false;
+
+	// same matrices which updateTransform() would apply
+	const Matrix4 &projectionMatrix = (m_bIs3dScene ? m_3dSceneProjectionMatrix : m_projectionTransformStack.top());
+	const Matrix4 worldMatrix = (m_bIs3dScene ? m_3dSceneWorldMatrix * m_worldTransformStack.top() : m_worldTransformStack.top());
+
+	if (!m_spriteBatch.canAppend(image, projectionMatrix))
+		flushBatch();
+
+	const float width = image->getWidth();
+	const float height = image->getHeight();
+
+	m_spriteBatch.addQuad(image, projectionMatrix, worldMatrix, -width / 2, -height / 2, width, height, color);
+	m_drawStats.numBatchedImages++;
+
+	return true;
+}
+
+void Graphics::drawBatch(SpriteBatch &batch)
+{
+	batch.getImage()->bind();
+	{
+		drawVAO(batch.buildVAO());
+	}
+	batch.getImage()->unbind();
+}
+
+void Graphics::submitBatch()
+{
+	m_bFlushingBatch = true;
+	{
+		// the vertices are already in world space, so draw them with an identity world matrix and the projection they were batched with
+		Matrix4 projectionMatrix = m_spriteBatch.getProjectionMatrix();
+		Matrix4 worldMatrix;
+		onTransformUpdate(projectionMatrix, worldMatrix);
+		m_bTransformUpToDate = true; // don't let drawVAO() re-apply the transform stack
+
+		drawBatch(m_spriteBatch);
+
+		m_bTransformUpToDate = false; // the next draw has to restore the real transform
+		m_drawStats.numBatchFlushes++;
+	}
+	m_spriteBatch.clear();
+	m_bFlushingBatch = false;
+}
+
+void Graphics::resetDrawStats()
+{
+	m_lastFrameDrawStats = m_drawStats;
+	m_drawStats = DRAW_STATS{};
+}
+
+
 
 //************************//
 //	Graphics ConCommands  //
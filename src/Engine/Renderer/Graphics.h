@@ -18,6 +18,7 @@
 #include "Vectors.h"
 #include "Rect.h"
 #include "Color.h"
+#include "SpriteBatch.h"
 
 class ConVar;
 class UString;
@@ -95,6 +96,13 @@ public:
 		COMPARE_FUNC_ALWAYS
 	};
 
+	struct DRAW_STATS
+	{
+		uint32_t numDrawCalls = 0;		// submissions which actually reached the api (including batch flushes)
+		uint32_t numBatchedImages = 0;	// drawImage() calls which were merged into a sprite batch
+		uint32_t numBatchFlushes = 0;	// sprite batches which were submitted
+	};
+
 public:
 	friend class Engine;
 
@@ -167,6 +175,7 @@ public:
 	virtual UString getVersion() = 0;
 	virtual int getVRAMTotal() = 0;
 	virtual int getVRAMRemaining() = 0;
+	[[nodiscard]] virtual bool isNullRenderer() const {return false;} // true if nothing is ever submitted to a gpu (headless benchmarking)
 
 	// callbacks
 	virtual void onResolutionChange(Vector2 newResolution) = 0;
@@ -213,6 +222,10 @@ public:
 	Matrix4 getProjectionMatrix();
 	inline Matrix4 getMVP() const {return m_MP;}
 
+	// sprite batching
+	void flushBatch() {if (!m_spriteBatch.isEmpty() && !m_bFlushingBatch) submitBatch();} // must be called before any api state change which would affect pending batched draws
+	[[nodiscard]] inline const DRAW_STATS &getDrawStats() const {return m_lastFrameDrawStats;} // stats of the last completed frame
+
 	// 3d gui scenes
 	void push3DScene(McRect region);
 	void pop3DScene();
@@ -228,6 +241,12 @@ protected:
 	void updateTransform(bool force = false);
 	void checkStackLeaks();
 
+	// sprite batching
+	bool batchImage(Image *image, Color color); // returns false if the image has to be drawn immediately instead
+	virtual void drawBatch(SpriteBatch &batch); // default implementation draws the batch as one unbaked quad vao through drawVAO()
+	void resetDrawStats(); // call in beginScene()
+	inline void countDrawCall() {m_drawStats.numDrawCalls++;} // call once per submission which actually reaches the api
+
 	// transforms
 	bool m_bTransformUpToDate;
 	std::stack<Matrix4> m_worldTransformStack;
@@ -243,6 +262,15 @@ protected:
 	Vector3 m_v3dSceneOffset;
 	Matrix4 m_3dSceneWorldMatrix;
 	Matrix4 m_3dSceneProjectionMatrix;
+
+	// sprite batching
+	SpriteBatch m_spriteBatch;
+	bool m_bFlushingBatch;
+	DRAW_STATS m_drawStats;
+	DRAW_STATS m_lastFrameDrawStats;
+
+private:
+	void submitBatch();
 };
 
 extern std::unique_ptr<Graphics> g; // defined in Engine, declared here for convenience
@@ -0,0 +1,480 @@
+//================ Copyright (c) 2025, WH, All rights reserved. =================//
+//
+// Purpose:		gpu-less graphics interface, records all submitted work into memory
+//
+// $NoKeywords: $nullgi
+//===============================================================================//
+
+#include "NullGraphicsInterface.h"
+
+#include "Camera.h"
+#include "ConVar.h"
+#include "Engine.h"
+#include "Font.h"
+#include "NullResources.h"
+
+#include <utility>
+
+namespace cv
+{
+ConVar r_null_dump_frame("r_null_dump_frame", FCVAR_NONE, "print all commands recorded by the null renderer during the last frame", []() -> void {
+	if (!g || !g->isNullRenderer())
+	{
+		debugLog("r_null_dump_frame: not running with the null renderer (-nullgfx)\n");
+		return;
+	}
+
+	const auto &log = static_cast<NullGraphicsInterface *>(g.get())->getFrameLog();
+	for (size_t i = 0; i < log.size(); i++)
+	{
+		debugLog("{:5d} {:<18s} vertices = {:<6d} resource = {:p}\n", i, NullGraphicsInterface::getCommandName(log[i].type), log[i].numVertices, log[i].resource);
+	}
+	debugLog("{:d} commands\n", log.size());
+});
+} // namespace cv
+
+// vertex count of the legacy gl polygon approximation, for comparable numbers
+static constexpr uint32_t ROUNDED_RECT_VERTICES = 4 * 32;
+
+const char *NullGraphicsInterface::getCommandName(CMD type)
+{
+	switch (type)
+	{
+	case CMD::CLEAR_DEPTH:
+		return "CLEAR_DEPTH";
+	case CMD::DRAW_PIXELS:
+		return "DRAW_PIXELS";
+	case CMD::DRAW_PIXEL:
+		return "DRAW_PIXEL";
+	case CMD::DRAW_LINE:
+		return "DRAW_LINE";
+	case CMD::DRAW_RECT:
+		return "DRAW_RECT";
+	case CMD::FILL_RECT:
+		return "FILL_RECT";
+	case CMD::FILL_ROUNDED_RECT:
+		return "FILL_ROUNDED_RECT";
+	case CMD::FILL_GRADIENT:
+		return "FILL_GRADIENT";
+	case CMD::DRAW_QUAD:
+		return "DRAW_QUAD";
+	case CMD::DRAW_IMAGE:
+		return "DRAW_IMAGE";
+	case CMD::DRAW_STRING:
+		return "DRAW_STRING";
+	case CMD::DRAW_VAO:
+		return "DRAW_VAO";
+	case CMD::DRAW_BATCH:
+		return "DRAW_BATCH";
+	case CMD::SET_CLIPRECT:
+		return "SET_CLIPRECT";
+	case CMD::STENCIL:
+		return "STENCIL";
+	case CMD::SET_STATE:
+		return "SET_STATE";
+	case CMD::SET_TRANSFORM:
+		return "SET_TRANSFORM";
+	case CMD::BIND_TEXTURE:
+		return "BIND_TEXTURE";
+	case CMD::BIND_SHADER:
+		return "BIND_SHADER";
+	case CMD::BIND_RENDERTARGET:
+		return "BIND_RENDERTARGET";
+	case CMD::FLUSH:
+		return "FLUSH";
+	case CMD::COUNT:
+		break;
+	}
+	return "???";
+}
+
+NullGraphicsInterface::NullGraphicsInterface() : Graphics()
+{
+	// renderer
+	m_bInScene = false;
+	m_vResolution = engine->getScreenSize(); // initial viewport size = window size
+	m_color = 0xffffffff;
+
+	m_frameLog.reserve(4096);
+	m_lastFrameLog.reserve(4096);
+}
+
+void NullGraphicsInterface::record(CMD type, uint32_t numVertices, const void *resource)
+{
+	m_frameLog.push_back({type, numVertices, resource});
+
+	m_stats.numCommands[static_cast<size_t>(type)]++;
+	m_stats.numVertices += numVertices;
+
+	// (strings are submitted through drawVAO(), which records them again, and empty vaos never reach the api)
+	if (type >= CMD::DRAW_PIXELS && type <= CMD::DRAW_BATCH && type != CMD::DRAW_STRING && !(type == CMD::DRAW_VAO && numVertices < 1))
+		countDrawCall();
+}
+
+void NullGraphicsInterface::beginScene()
+{
+	m_bInScene = true;
+
+	resetDrawStats();
+	m_frameLog.clear();
+
+	Matrix4 defaultProjectionMatrix = Camera::buildMatrixOrtho2D(0, m_vResolution.x, m_vResolution.y, 0, -1.0f, 1.0f);
+
+	// push main transforms
+	pushTransform();
+	setProjectionMatrix(defaultProjectionMatrix);
+	translate(cv::r_globaloffset_x.getFloat(), cv::r_globaloffset_y.getFloat());
+
+	// and apply them
+	updateTransform();
+}
+
+void NullGraphicsInterface::endScene()
+{
+	flushBatch();
+
+	popTransform();
+
+#ifdef _DEBUG
+	checkStackLeaks();
+
+	if (m_clipRectStack.size() > 0)
+	{
+		engine->showMessageErrorFatal("ClipRect Stack Leak", "Make sure all push*() have a pop*()!");
+		engine->shutdown();
+	}
+#endif
+
+	// keep the log of the completed frame around for inspection, reuse the other buffer
+	std::swap(m_frameLog, m_lastFrameLog);
+	m_stats.numFrames++;
+
+	m_bInScene = false;
+}
+
+void NullGraphicsInterface::clearDepthBuffer()
+{
+	flushBatch();
+	record(CMD::CLEAR_DEPTH);
+}
+
+void NullGraphicsInterface::setAlpha(float alpha)
+{
+	m_color = rgba(m_color.Rf(), m_color.Gf(), m_color.Bf(), alpha);
+}
+
+void NullGraphicsInterface::drawPixels(int /*x*/, int /*y*/, int /*width*/, int /*height*/, Graphics::DRAWPIXELS_TYPE /*type*/, const void * /*pixels*/)
+{
+	flushBatch();
+	record(CMD::DRAW_PIXELS);
+}
+
+void NullGraphicsInterface::drawPixel(int /*x*/, int /*y*/)
+{
+	updateTransform();
+	record(CMD::DRAW_PIXEL, 1);
+}
+
+void NullGraphicsInterface::drawLine(int /*x1*/, int /*y1*/, int /*x2*/, int /*y2*/)
+{
+	updateTransform();
+	record(CMD::DRAW_LINE, 2);
+}
+
+void NullGraphicsInterface::drawLine(Vector2 pos1, Vector2 pos2)
+{
+	drawLine(pos1.x, pos1.y, pos2.x, pos2.y);
+}
+
+void NullGraphicsInterface::drawRect(int /*x*/, int /*y*/, int /*width*/, int /*height*/)
+{
+	updateTransform();
+	record(CMD::DRAW_RECT, 8);
+}
+
+void NullGraphicsInterface::drawRect(int /*x*/, int /*y*/, int /*width*/, int /*height*/, Color /*top*/, Color /*right*/, Color /*bottom*/, Color /*left*/)
+{
+	updateTransform();
+	record(CMD::DRAW_RECT, 8);
+}
+
+void NullGraphicsInterface::fillRect(int /*x*/, int /*y*/, int /*width*/, int /*height*/)
+{
+	updateTransform();
+	record(CMD::FILL_RECT, 4);
+}
+
+void NullGraphicsInterface::fillRoundedRect(int /*x*/, int /*y*/, int /*width*/, int /*height*/, int /*radius*/)
+{
+	updateTransform();
+	record(CMD::FILL_ROUNDED_RECT, ROUNDED_RECT_VERTICES);
+}
+
+void NullGraphicsInterface::fillGradient(int /*x*/, int /*y*/, int /*width*/, int /*height*/, Color /*topLeftColor*/, Color /*topRightColor*/, Color /*bottomLeftColor*/,
+                                         Color /*bottomRightColor*/)
+{
+	updateTransform();
+	record(CMD::FILL_GRADIENT, 4);
+}
+
+void NullGraphicsInterface::drawQuad(int /*x*/, int /*y*/, int /*width*/, int /*height*/)
+{
+	updateTransform();
+	record(CMD::DRAW_QUAD, 4);
+}
+
+void NullGraphicsInterface::drawQuad(Vector2 /*topLeft*/, Vector2 /*topRight*/, Vector2 /*bottomRight*/, Vector2 /*bottomLeft*/, Color /*topLeftColor*/, Color /*topRightColor*/,
+                                     Color /*bottomRightColor*/, Color /*bottomLeftColor*/)
+{
+	updateTransform();
+	record(CMD::DRAW_QUAD, 4);
+}
+
+void NullGraphicsInterface::drawImage(Image *image)
+{
+	if (image == NULL)
+	{
+		debugLog("WARNING: Tried to draw image with NULL texture!\n");
+		return;
+	}
+	if (!image->isReady())
+		return;
+
+	// go through the same batching path as the real backends, so that the recorded numbers match
+	if (batchImage(image, m_color))
+		return;
+
+	updateTransform();
+
+	image->bind();
+	record(CMD::DRAW_IMAGE, 4, image);
+	image->unbind();
+}
+
+void NullGraphicsInterface::drawString(McFont *font, const UString &text)
+{
+	if (font == NULL || text.length() < 1 || !font->isReady())
+		return;
+
+	updateTransform();
+	record(CMD::DRAW_STRING, 0, font);
+
+	// builds the string geometry and submits it through drawVAO(), which records the actual vertex count
+	font->drawString(text);
+}
+
+void NullGraphicsInterface::drawVAO(VertexArrayObject *vao)
+{
+	if (vao == NULL)
+		return;
+
+	updateTransform();
+
+	// baked vaos may have freed their system memory copy already, but still know their size
+	const uint32_t numVertices = vao->isReady() ? vao->getNumVertices() : vao->getVertices().size();
+
+	if (vao->isReady())
+		vao->draw();
+
+	record(CMD::DRAW_VAO, numVertices, vao);
+}
+
+void NullGraphicsInterface::setClipRect(McRect /*clipRect*/)
+{
+	flushBatch();
+	if (cv::r_debug_disable_cliprect.getBool())
+		return;
+
+	record(CMD::SET_CLIPRECT);
+}
+
+void NullGraphicsInterface::pushClipRect(McRect clipRect)
+{
+	if (m_clipRectStack.size() > 0)
+		m_clipRectStack.push(m_clipRectStack.top().intersect(clipRect));
+	else
+		m_clipRectStack.push(clipRect);
+
+	setClipRect(m_clipRectStack.top());
+}
+
+void NullGraphicsInterface::popClipRect()
+{
+	m_clipRectStack.pop();
+
+	if (m_clipRectStack.size() > 0)
+		setClipRect(m_clipRectStack.top());
+	else
+		setClipping(false);
+}
+
+void NullGraphicsInterface::pushStencil()
+{
+	flushBatch();
+	record(CMD::STENCIL);
+}
+
+void NullGraphicsInterface::fillStencil(bool /*inside*/)
+{
+	flushBatch();
+	record(CMD::STENCIL);
+}
+
+void NullGraphicsInterface::popStencil()
+{
+	flushBatch();
+	record(CMD::STENCIL);
+}
+
+void NullGraphicsInterface::setClipping(bool /*enabled*/)
+{
+	flushBatch();
+	record(CMD::SET_STATE);
+}
+
+void NullGraphicsInterface::setAlphaTesting(bool /*enabled*/)
+{
+	flushBatch();
+	record(CMD::SET_STATE);
+}
+
+void NullGraphicsInterface::setAlphaTestFunc(COMPARE_FUNC /*alphaFunc*/, float /*ref*/)
+{
+	flushBatch();
+	record(CMD::SET_STATE);
+}
+
+void NullGraphicsInterface::setBlending(bool /*enabled*/)
+{
+	flushBatch();
+	record(CMD::SET_STATE);
+}
+
+void NullGraphicsInterface::setBlendMode(BLEND_MODE /*blendMode*/)
+{
+	flushBatch();
+	record(CMD::SET_STATE);
+}
+
+void NullGraphicsInterface::setDepthBuffer(bool /*enabled*/)
+{
+	flushBatch();
+	record(CMD::SET_STATE);
+}
+
+void NullGraphicsInterface::setCulling(bool /*culling*/)
+{
+	flushBatch();
+	record(CMD::SET_STATE);
+}
+
+void NullGraphicsInterface::setAntialiasing(bool /*aa*/)
+{
+	flushBatch();
+	record(CMD::SET_STATE);
+}
+
+void NullGraphicsInterface::setWireframe(bool /*enabled*/)
+{
+	flushBatch();
+	record(CMD::SET_STATE);
+}
+
+void NullGraphicsInterface::flush()
+{
+	flushBatch();
+	record(CMD::FLUSH);
+}
+
+std::vector<unsigned char> NullGraphicsInterface::getScreenshot()
+{
+	flushBatch();
+
+	// there is nothing to read back, return a black image of the correct size
+	return std::vector<unsigned char>(static_cast<size_t>(m_vResolution.x) * static_cast<size_t>(m_vResolution.y) * 3, 0);
+}
+
+UString NullGraphicsInterface::getVendor()
+{
+	return "McEngine";
+}
+
+UString NullGraphicsInterface::getModel()
+{
+	return "Null Renderer";
+}
+
+UString NullGraphicsInterface::getVersion()
+{
+	return "1.0";
+}
+
+void NullGraphicsInterface::onResolutionChange(Vector2 newResolution)
+{
+	flushBatch();
+
+	m_vResolution = newResolution;
+
+	// special case: custom rendertarget resolution rendering, update active projection matrix immediately
+	if (m_bInScene)
+	{
+		m_projectionTransformStack.top() = Camera::buildMatrixOrtho2D(0, m_vResolution.x, m_vResolution.y, 0, -1.0f, 1.0f);
+		m_bTransformUpToDate = false;
+	}
+}
+
+Image *NullGraphicsInterface::createImage(UString filePath, bool mipmapped, bool keepInSystemMemory)
+{
+	return new NullImage(std::move(filePath), mipmapped, keepInSystemMemory);
+}
+
+Image *NullGraphicsInterface::createImage(int width, int height, bool mipmapped, bool keepInSystemMemory)
+{
+	return new NullImage(width, height, mipmapped, keepInSystemMemory);
+}
+
+RenderTarget *NullGraphicsInterface::createRenderTarget(int x, int y, int width, int height, Graphics::MULTISAMPLE_TYPE multiSampleType)
+{
+	return new NullRenderTarget(x, y, width, height, multiSampleType);
+}
+
+Shader *NullGraphicsInterface::createShaderFromFile(UString /*vertexShaderFilePath*/, UString /*fragmentShaderFilePath*/)
+{
+	return new NullShader();
+}
+
+Shader *NullGraphicsInterface::createShaderFromSource(UString /*vertexShader*/, UString /*fragmentShader*/)
+{
+	return new NullShader();
+}
+
+Shader *NullGraphicsInterface::createShaderFromFile(UString /*shaderFilePath*/)
+{
+	return new NullShader();
+}
+
+Shader *NullGraphicsInterface::createShaderFromSource(UString /*shaderSource*/)
+{
+	return new NullShader();
+}
+
+VertexArrayObject *NullGraphicsInterface::createVertexArrayObject(Graphics::PRIMITIVE primitive, Graphics::USAGE_TYPE usage, bool keepInSystemMemory)
+{
+	return new NullVertexArrayObject(primitive, usage, keepInSystemMemory);
+}
+
+void NullGraphicsInterface::onTransformUpdate(Matrix4 & /*projectionMatrix*/, Matrix4 & /*worldMatrix*/)
+{
+	record(CMD::SET_TRANSFORM);
+}
+
+void NullGraphicsInterface::drawBatch(SpriteBatch &batch)
+{
+	// still build the vao, that cpu work is part of what a real backend pays for a batch
+	batch.getImage()->bind();
+	{
+		VertexArrayObject *vao = batch.buildVAO();
+		record(CMD::DRAW_BATCH, vao->getNumVertices(), batch.getImage());
+	}
+	batch.getImage()->unbind();
+}
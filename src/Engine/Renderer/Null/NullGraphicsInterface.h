@@ -0,0 +1,176 @@
+//================ Copyright (c) 2025, WH, All rights reserved. =================//
+//
+// Purpose:		gpu-less graphics interface, records all submitted work into memory
+//
+// $NoKeywords: $nullgi
+//===============================================================================//
+
+#pragma once
+#ifndef NULLGRAPHICSINTERFACE_H
+#define NULLGRAPHICSINTERFACE_H
+
+#include "cbase.h"
+
+#include <array>
+
+// Runs the complete CPU side of the rendering path (transforms, batching, vao building, font geometry, ...)
+// without a GL/DX context. Instead of drawing, every command is appended to a per-frame log, and cumulative
+// counters are kept until resetStats() is called. Selected with the "-nullgfx" launch argument.
+class NullGraphicsInterface final : public Graphics
+{
+public:
+	enum class CMD : uint8_t
+	{
+		CLEAR_DEPTH,
+		DRAW_PIXELS,
+		DRAW_PIXEL,
+		DRAW_LINE,
+		DRAW_RECT,
+		FILL_RECT,
+		FILL_ROUNDED_RECT,
+		FILL_GRADIENT,
+		DRAW_QUAD,
+		DRAW_IMAGE,
+		DRAW_STRING,
+		DRAW_VAO,
+		DRAW_BATCH,
+		SET_CLIPRECT,
+		STENCIL,
+		SET_STATE,
+		SET_TRANSFORM,
+		BIND_TEXTURE,
+		BIND_SHADER,
+		BIND_RENDERTARGET,
+		FLUSH,
+		COUNT
+	};
+
+	struct COMMAND
+	{
+		CMD type;
+		uint32_t numVertices;
+		const void *resource; // image/font/vao/shader/rendertarget, if any
+	};
+
+	struct STATS
+	{
+		uint64_t numFrames = 0;
+		uint64_t numVertices = 0;
+		std::array<uint64_t, static_cast<size_t>(CMD::COUNT)> numCommands{};
+
+		[[nodiscard]] inline uint64_t get(CMD type) const {return numCommands[static_cast<size_t>(type)];}
+	};
+
+	static const char *getCommandName(CMD type);
+
+public:
+	NullGraphicsInterface();
+	~NullGraphicsInterface() override = default;
+
+	// recording
+	void record(CMD type, uint32_t numVertices = 0, const void *resource = nullptr);
+	inline void resetStats() {m_stats = STATS{};}
+	[[nodiscard]] inline const STATS &getStats() const {return m_stats;}
+	[[nodiscard]] inline const std::vector<COMMAND> &getFrameLog() const {return m_lastFrameLog;} // commands of the last completed frame
+
+	// scene
+	void beginScene() override;
+	void endScene() override;
+
+	// depth buffer
+	void clearDepthBuffer() override;
+
+	// color
+	void setColor(Color color) override {m_color = color;}
+	void setAlpha(float alpha) override;
+
+	// 2d primitive drawing
+	void drawPixels(int x, int y, int width, int height, Graphics::DRAWPIXELS_TYPE type, const void *pixels) override;
+	void drawPixel(int x, int y) override;
+	void drawLine(int x1, int y1, int x2, int y2) override;
+	void drawLine(Vector2 pos1, Vector2 pos2) override;
+	void drawRect(int x, int y, int width, int height) override;
+	void drawRect(int x, int y, int width, int height, Color top, Color right, Color bottom, Color left) override;
+
+	void fillRect(int x, int y, int width, int height) override;
+	void fillRoundedRect(int x, int y, int width, int height, int radius) override;
+	void fillGradient(int x, int y, int width, int height, Color topLeftColor, Color topRightColor, Color bottomLeftColor, Color bottomRightColor) override;
+
+	void drawQuad(int x, int y, int width, int height) override;
+	void drawQuad(Vector2 topLeft, Vector2 topRight, Vector2 bottomRight, Vector2 bottomLeft, Color topLeftColor, Color topRightColor, Color bottomRightColor, Color bottomLeftColor) override;
+
+	// 2d resource drawing
+	void drawImage(Image *image) override;
+	void drawString(McFont *font, const UString &text) override;
+
+	// 3d type drawing
+	void drawVAO(VertexArrayObject *vao) override;
+
+	// DEPRECATED: 2d clipping
+	void setClipRect(McRect clipRect) override;
+	void pushClipRect(McRect clipRect) override;
+	void popClipRect() override;
+
+	// stencil
+	void pushStencil() override;
+	void fillStencil(bool inside) override;
+	void popStencil() override;
+
+	// renderer settings
+	void setClipping(bool enabled) override;
+	void setAlphaTesting(bool enabled) override;
+	void setAlphaTestFunc(COMPARE_FUNC alphaFunc, float ref) override;
+	void setBlending(bool enabled) override;
+	void setBlendMode(BLEND_MODE blendMode) override;
+	void setDepthBuffer(bool enabled) override;
+	void setCulling(bool culling) override;
+	void setVSync(bool /*vsync*/) override {;}
+	void setAntialiasing(bool aa) override;
+	void setWireframe(bool enabled) override;
+
+	// renderer actions
+	void flush() override;
+	std::vector<unsigned char> getScreenshot() override;
+
+	// renderer info
+	[[nodiscard]] Vector2 getResolution() const override {return m_vResolution;}
+	UString getVendor() override;
+	UString getModel() override;
+	UString getVersion() override;
+	int getVRAMTotal() override {return 0;}
+	int getVRAMRemaining() override {return 0;}
+	[[nodiscard]] bool isNullRenderer() const override {return true;}
+
+	// callbacks
+	void onResolutionChange(Vector2 newResolution) override;
+
+	// factory
+	Image *createImage(UString filePath, bool mipmapped, bool keepInSystemMemory) override;
+	Image *createImage(int width, int height, bool mipmapped, bool keepInSystemMemory) override;
+	RenderTarget *createRenderTarget(int x, int y, int width, int height, Graphics::MULTISAMPLE_TYPE multiSampleType) override;
+	Shader *createShaderFromFile(UString vertexShaderFilePath, UString fragmentShaderFilePath) override; // DEPRECATED
+	Shader *createShaderFromSource(UString vertexShader, UString fragmentShader) override;				 // DEPRECATED
+	Shader *createShaderFromFile(UString shaderFilePath) override;
+	Shader *createShaderFromSource(UString shaderSource) override;
+	VertexArrayObject *createVertexArrayObject(Graphics::PRIMITIVE primitive, Graphics::USAGE_TYPE usage, bool keepInSystemMemory) override;
+
+protected:
+	void onTransformUpdate(Matrix4 &projectionMatrix, Matrix4 &worldMatrix) override;
+	void drawBatch(SpriteBatch &batch) override;
+
+private:
+	// renderer
+	bool m_bInScene;
+	Vector2 m_vResolution;
+	Color m_color;
+
+	// clipping
+	std::stack<McRect> m_clipRectStack;
+
+	// recording
+	std::vector<COMMAND> m_frameLog;
+	std::vector<COMMAND> m_lastFrameLog;
+	STATS m_stats;
+};
+
+#endif
@@ -0,0 +1,147 @@
+//================ Copyright (c) 2025, WH, All rights reserved. =================//
+//
+// Purpose:		resource implementations for the null graphics interface
+//
+// $NoKeywords: $nullres
+//===============================================================================//
+
+#include "NullResources.h"
+
+#include <utility>
+
+#include "ConVar.h"
+#include "Engine.h"
+#include "NullGraphicsInterface.h"
+
+namespace
+{
+// null resources are only ever created by the null interface, so this is always valid
+inline NullGraphicsInterface *nullg() { return static_cast<NullGraphicsInterface *>(g.get()); }
+} // namespace
+
+//*************//
+//	NullImage  //
+//*************//
+
+NullImage::NullImage(UString filepath, bool mipmapped, bool keepInSystemMemory) : Image(std::move(filepath), mipmapped, keepInSystemMemory) {}
+
+NullImage::NullImage(int width, int height, bool mipmapped, bool keepInSystemMemory) : Image(width, height, mipmapped, keepInSystemMemory) {}
+
+void NullImage::init()
+{
+	if (m_bReady || !(m_bAsyncReady.load()))
+		return;
+
+	// there is no texture, but the shared pixels aren't needed anymore either
+	setSharedTexture(reinterpret_cast<uintptr_t>(this));
+	if (!m_bKeepInSystemMemory)
+		m_rawImage = std::vector<unsigned char>();
+
+	m_bReady = true;
+}
+
+void NullImage::initAsync()
+{
+	if (m_bReady)
+		return;
+
+	if (!m_bCreatedImage)
+	{
+		if (cv::debug_rm.getBool())
+			debugLog("Resource Manager: Loading {:s}\n", m_sFilePath.toUtf8());
+
+		m_bAsyncReady = loadRawImage();
+	}
+}
+
+void NullImage::destroy()
+{
+	(void)releaseSharedTexture(0);
+	m_rawImage = std::vector<unsigned char>();
+}
+
+void NullImage::bind(unsigned int /*textureUnit*/)
+{
+	if (!m_bReady)
+		return;
+
+	nullg()->flushBatch();
+	nullg()->record(NullGraphicsInterface::CMD::BIND_TEXTURE, 0, this);
+}
+
+//********************//
+//	NullRenderTarget  //
+//********************//
+
+NullRenderTarget::NullRenderTarget(int x, int y, int width, int height, Graphics::MULTISAMPLE_TYPE multiSampleType)
+    : RenderTarget(x, y, width, height, multiSampleType)
+{
+}
+
+void NullRenderTarget::enable()
+{
+	if (!m_bReady)
+		return;
+
+	nullg()->flushBatch();
+	nullg()->record(NullGraphicsInterface::CMD::BIND_RENDERTARGET, 0, this);
+}
+
+void NullRenderTarget::disable()
+{
+	if (!m_bReady)
+		return;
+
+	nullg()->flushBatch();
+	nullg()->record(NullGraphicsInterface::CMD::BIND_RENDERTARGET, 0, nullptr);
+}
+
+void NullRenderTarget::bind(unsigned int /*textureUnit*/)
+{
+	if (!m_bReady)
+		return;
+
+	nullg()->flushBatch();
+	nullg()->record(NullGraphicsInterface::CMD::BIND_TEXTURE, 0, this);
+}
+
+//**************//
+//	NullShader  //
+//**************//
+
+void NullShader::enable()
+{
+	if (!m_bReady)
+		return;
+
+	nullg()->flushBatch();
+	nullg()->record(NullGraphicsInterface::CMD::BIND_SHADER, 0, this);
+}
+
+void NullShader::disable()
+{
+	if (!m_bReady)
+		return;
+
+	nullg()->flushBatch();
+	nullg()->record(NullGraphicsInterface::CMD::BIND_SHADER, 0, nullptr);
+}
+
+//*************************//
+//	NullVertexArrayObject  //
+//*************************//
+
+void NullVertexArrayObject::init()
+{
+	if (!(m_bAsyncReady.load()) || m_vertices.size() < 2)
+		return;
+
+	// nothing to upload, but keep the same system memory behaviour as the real implementations
+	m_partialUpdateVertexIndices.clear();
+	m_partialUpdateColorIndices.clear();
+
+	if (!m_bKeepInSystemMemory)
+		empty();
+
+	m_bReady = true;
+}
@@ -0,0 +1,91 @@
+//================ Copyright (c) 2025, WH, All rights reserved. =================//
+//
+// Purpose:		resource implementations for the null graphics interface
+//
+// $NoKeywords: $nullres
+//===============================================================================//
+
+#pragma once
+#ifndef NULLRESOURCES_H
+#define NULLRESOURCES_H
+
+#include "Image.h"
+#include "RenderTarget.h"
+#include "Shader.h"
+#include "VertexArrayObject.h"
+
+// images are still decoded on the loader threads like with every other backend, only the upload is skipped
+class NullImage final : public Image
+{
+public:
+	NullImage(UString filepath, bool mipmapped = false, bool keepInSystemMemory = false);
+	NullImage(int width, int height, bool mipmapped = false, bool keepInSystemMemory = false);
+	~NullImage() override {destroy();}
+
+	void bind(unsigned int textureUnit = 0) override;
+	void unbind() override {;}
+
+private:
+	void init() override;
+	void initAsync() override;
+	void destroy() override;
+};
+
+class NullRenderTarget final : public RenderTarget
+{
+public:
+	NullRenderTarget(int x, int y, int width, int height, Graphics::MULTISAMPLE_TYPE multiSampleType = Graphics::MULTISAMPLE_TYPE::MULTISAMPLE_0X);
+	~NullRenderTarget() override {destroy();}
+
+	void enable() override;
+	void disable() override;
+
+	void bind(unsigned int textureUnit = 0) override;
+	void unbind() override {;}
+
+private:
+	void init() override {m_bReady = true;}
+	void initAsync() override {m_bAsyncReady = true;}
+	void destroy() override {;}
+};
+
+class NullShader final : public Shader
+{
+public:
+	NullShader() : Shader() {;}
+	~NullShader() override {destroy();}
+
+	void enable() override;
+	void disable() override;
+
+	void setUniform1f(const std::string_view &, float) override {;}
+	void setUniform1fv(const std::string_view &, int, float *) override {;}
+	void setUniform1i(const std::string_view &, int) override {;}
+	void setUniform2f(const std::string_view &, float, float) override {;}
+	void setUniform2fv(const std::string_view &, int, float *) override {;}
+	void setUniform3f(const std::string_view &, float, float, float) override {;}
+	void setUniform3fv(const std::string_view &, int, float *) override {;}
+	void setUniform4f(const std::string_view &, float, float, float, float) override {;}
+	void setUniformMatrix4fv(const std::string_view &, Matrix4 &) override {;}
+	void setUniformMatrix4fv(const std::string_view &, float *) override {;}
+
+private:
+	void init() override {m_bReady = true;}
+	void initAsync() override {m_bAsyncReady = true;}
+	void destroy() override {;}
+};
+
+class NullVertexArrayObject final : public VertexArrayObject
+{
+public:
+	NullVertexArrayObject(Graphics::PRIMITIVE primitive = Graphics::PRIMITIVE::PRIMITIVE_TRIANGLES, Graphics::USAGE_TYPE usage = Graphics::USAGE_TYPE::USAGE_STATIC, bool keepInSystemMemory = false)
+		: VertexArrayObject(primitive, usage, keepInSystemMemory) {;}
+	~NullVertexArrayObject() override {destroy();}
+
+	void draw() override {;} // recorded by NullGraphicsInterface::drawVAO()
+
+private:
+	void init() override;
+};
+
+#endif
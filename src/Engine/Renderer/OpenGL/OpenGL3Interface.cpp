@@ -10,6 +10,7 @@
 #ifdef MCENGINE_FEATURE_GL3
 
 #include "Engine.h"
+#include "FrameArena.h"
 #include "ConVar.h"
 #include "Camera.h"
 
@@ -22,6 +23,14 @@
 
 #include "SDLGLInterface.h"
 
+#include <array>
+
+namespace
+{
+// for the vertex order of all the textured quads below (top left, bottom left, bottom right, top right)
+const std::array<Vector2, 4> QUAD_TEXCOORDS = {Vector2(0, 0), Vector2(0, 1), Vector2(1, 1), Vector2(1, 0)};
+} // namespace
+
 OpenGL3Interface::OpenGL3Interface() : Graphics()
 {
 	// renderer
@@ -152,6 +161,8 @@ void OpenGL3Interface::beginScene()
 {
 	m_bInScene = true;
 
+	resetDrawStats();
+
 	Matrix4 defaultProjectionMatrix = Camera::buildMatrixOrtho2D(0, m_vResolution.x, m_vResolution.y, 0, -1.0f, 1.0f);
 
 	// push main transforms
@@ -221,20 +232,16 @@ void OpenGL3Interface::drawPixel(int x, int y)
 {
 	updateTransform();
 
-	VertexArrayObject vao(Graphics::PRIMITIVE::PRIMITIVE_LINES);
-	vao.addVertex(x - 0.45f, y - 0.45f);
-	vao.addVertex(x + 0.45f, y + 0.45f);
-	drawVAO(&vao);
+	const std::array<Vector3, 2> vertices = {Vector3(x - 0.45f, y - 0.45f, 0), Vector3(x + 0.45f, y + 0.45f, 0)};
+	drawImmediate(Graphics::PRIMITIVE::PRIMITIVE_LINES, vertices, {}, {});
 }
 
 void OpenGL3Interface::drawLine(int x1, int y1, int x2, int y2)
 {
 	updateTransform();
 
-	VertexArrayObject vao(Graphics::PRIMITIVE::PRIMITIVE_LINES);
-	vao.addVertex(x1 + 0.5f, y1 + 0.5f);
-	vao.addVertex(x2 + 0.5f, y2 + 0.5f);
-	drawVAO(&vao);
+	const std::array<Vector3, 2> vertices = {Vector3(x1 + 0.5f, y1 + 0.5f, 0), Vector3(x2 + 0.5f, y2 + 0.5f, 0)};
+	drawImmediate(Graphics::PRIMITIVE::PRIMITIVE_LINES, vertices, {}, {});
 }
 
 void OpenGL3Interface::drawLine(Vector2 pos1, Vector2 pos2)
@@ -266,12 +273,8 @@ void OpenGL3Interface::fillRect(int x, int y, int width, int height)
 {
 	updateTransform();
 
-	VertexArrayObject vao(Graphics::PRIMITIVE::PRIMITIVE_QUADS);
-	vao.addVertex(x, y);
-	vao.addVertex(x, y + height);
-	vao.addVertex(x + width, y + height);
-	vao.addVertex(x + width, y);
-	drawVAO(&vao);
+	const std::array<Vector3, 4> vertices = {Vector3(x, y, 0), Vector3(x, y + height, 0), Vector3(x + width, y + height, 0), Vector3(x + width, y, 0)};
+	drawImmediate(Graphics::PRIMITIVE::PRIMITIVE_QUADS, vertices, {}, {});
 }
 
 void OpenGL3Interface::fillRoundedRect(int x, int y, int width, int height, int radius)
@@ -320,52 +323,27 @@ void OpenGL3Interface::fillGradient(int x, int y, int width, int height, Color t
 {
 	updateTransform();
 
-	VertexArrayObject vao(Graphics::PRIMITIVE::PRIMITIVE_QUADS);
-	vao.addVertex(x, y);
-	vao.addColor(topLeftColor);
-	vao.addVertex(x + width, y);
-	vao.addColor(topRightColor);
-	vao.addVertex(x + width, y + height);
-	vao.addColor(bottomRightColor);
-	vao.addVertex(x, y + height);
-	vao.addColor(bottomLeftColor);
-	drawVAO(&vao);
+	const std::array<Vector3, 4> vertices = {Vector3(x, y, 0), Vector3(x + width, y, 0), Vector3(x + width, y + height, 0), Vector3(x, y + height, 0)};
+	const std::array<Color, 4> colors = {topLeftColor, topRightColor, bottomRightColor, bottomLeftColor};
+	drawImmediate(Graphics::PRIMITIVE::PRIMITIVE_QUADS, vertices, {}, colors);
 }
 
 void OpenGL3Interface::drawQuad(int x, int y, int width, int height)
 {
 	updateTransform();
 
-	VertexArrayObject vao(Graphics::PRIMITIVE::PRIMITIVE_QUADS);
-	vao.addVertex(x, y);
-	vao.addTexcoord(0, 0);
-	vao.addVertex(x, y + height);
-	vao.addTexcoord(0, 1);
-	vao.addVertex(x + width, y + height);
-	vao.addTexcoord(1, 1);
-	vao.addVertex(x + width, y);
-	vao.addTexcoord(1, 0);
-	drawVAO(&vao);
+	const std::array<Vector3, 4> vertices = {Vector3(x, y, 0), Vector3(x, y + height, 0), Vector3(x + width, y + height, 0), Vector3(x + width, y, 0)};
+	drawImmediate(Graphics::PRIMITIVE::PRIMITIVE_QUADS, vertices, QUAD_TEXCOORDS, {});
 }
 
 void OpenGL3Interface::drawQuad(Vector2 topLeft, Vector2 topRight, Vector2 bottomRight, Vector2 bottomLeft, Color topLeftColor, Color topRightColor, Color bottomRightColor, Color bottomLeftColor)
 {
 	updateTransform();
 
-	VertexArrayObject vao(Graphics::PRIMITIVE::PRIMITIVE_QUADS);
-	vao.addVertex(topLeft.x, topLeft.y);
-	vao.addColor(topLeftColor);
-	vao.addTexcoord(0, 0);
-	vao.addVertex(bottomLeft.x, bottomLeft.y);
-	vao.addColor(bottomLeftColor);
-	vao.addTexcoord(0, 1);
-	vao.addVertex(bottomRight.x, bottomRight.y);
-	vao.addColor(bottomRightColor);
-	vao.addTexcoord(1, 1);
-	vao.addVertex(topRight.x, topRight.y);
-	vao.addColor(topRightColor);
-	vao.addTexcoord(1, 0);
-	drawVAO(&vao);
+	const std::array<Vector3, 4> vertices = {Vector3(topLeft.x, topLeft.y, 0), Vector3(bottomLeft.x, bottomLeft.y, 0), Vector3(bottomRight.x, bottomRight.y, 0),
+	                                         Vector3(topRight.x, topRight.y, 0)};
+	const std::array<Color, 4> colors = {topLeftColor, bottomLeftColor, bottomRightColor, topRightColor};
+	drawImmediate(Graphics::PRIMITIVE::PRIMITIVE_QUADS, vertices, QUAD_TEXCOORDS, colors);
 }
 
 void OpenGL3Interface::drawImage(Image *image)
@@ -386,18 +364,10 @@ void OpenGL3Interface::drawImage(Image *image)
 	float x = -width/2;
 	float y = -height/2;
 
-	VertexArrayObject vao(Graphics::PRIMITIVE::PRIMITIVE_QUADS);
-	vao.addVertex(x, y);
-	vao.addTexcoord(0, 0);
-	vao.addVertex(x, y + height);
-	vao.addTexcoord(0, 1);
-	vao.addVertex(x + width, y + height);
-	vao.addTexcoord(1, 1);
-	vao.addVertex(x + width, y);
-	vao.addTexcoord(1, 0);
+	const std::array<Vector3, 4> vertices = {Vector3(x, y, 0), Vector3(x, y + height, 0), Vector3(x + width, y + height, 0), Vector3(x + width, y, 0)};
 
 	image->bind();
-	drawVAO(&vao);
+	drawImmediate(Graphics::PRIMITIVE::PRIMITIVE_QUADS, vertices, QUAD_TEXCOORDS, {});
 	image->unbind();
 
 	if (cv::r_debug_drawimage.getBool())
@@ -445,109 +415,88 @@ void OpenGL3Interface::drawVAO(VertexArrayObject *vao)
 
 		// draw
 		glvao->draw();
+		countDrawCall();
 		return;
 	}
 
-	const std::vector<Vector3> &vertices = vao->getVertices();
-	///const std::vector<Vector3> &normals = vao->getNormals();
 	const std::vector<std::vector<Vector2>> &texcoords = vao->getTexcoords();
-	const std::vector<Color> &vcolors = vao->getColors();
+	drawImmediate(vao->getPrimitive(), vao->getVertices(), (texcoords.size() > 0 ? std::span<const Vector2>(texcoords[0]) : std::span<const Vector2>()), vao->getColors());
+}
 
+void OpenGL3Interface::drawImmediate(Graphics::PRIMITIVE primitive, std::span<const Vector3> vertices, std::span<const Vector2> texcoords, std::span<const Color> vcolors)
+{
 	if (vertices.size() < 2) return;
 
-	// no support for quads, because fuck you
-	// rewrite all quads into triangles
-	std::vector<Vector3> finalVertices = vertices;
-	std::vector<std::vector<Vector2>> finalTexcoords = texcoords;
-	std::vector<Vector4> colors;
-	std::vector<Vector4> finalColors;
-
-	for (size_t i=0; i<vcolors.size(); i++)
+	// (temporaries live in the frame arena, this runs for every single non-baked draw call)
+	FrameVector<Vector4> colors;
+	colors.reserve(vcolors.size());
+	for (const Color &vcolor : vcolors)
 	{
-		Vector4 color = Vector4(vcolors[i].Rf(), vcolors[i].Gf(), vcolors[i].Bf(), vcolors[i].Af());
-		colors.push_back(color);
-		finalColors.push_back(color);
+		colors.emplace_back(vcolor.Rf(), vcolor.Gf(), vcolor.Bf(), vcolor.Af());
 	}
-	int maxColorIndex = colors.size() - 1;
+	const int maxColorIndex = colors.size() - 1;
 
-	Graphics::PRIMITIVE primitive = vao->getPrimitive();
+	std::span<const Vector3> finalVertices = vertices;
+	std::span<const Vector2> finalTexcoords = texcoords;
+	std::span<const Vector4> finalColors = colors;
+
+	// no support for quads, because fuck you
+	// rewrite all quads into triangles
+	FrameVector<Vector3> triangleVertices;
+	FrameVector<Vector2> triangleTexcoords;
+	FrameVector<Vector4> triangleColors;
 	if (primitive == Graphics::PRIMITIVE::PRIMITIVE_QUADS)
 	{
-		finalVertices.clear();
-		for (size_t t=0; t<finalTexcoords.size(); t++)
-		{
-			finalTexcoords[t].clear();
-		}
-		finalColors.clear();
 		primitive = Graphics::PRIMITIVE::PRIMITIVE_TRIANGLES;
 
-		if (vertices.size() > 3)
+		const size_t numQuads = (vertices.size() > 3 ? vertices.size() / 4 : 0);
+		triangleVertices.reserve(numQuads * 6);
+		triangleTexcoords.reserve(texcoords.size() > 0 ? numQuads * 6 : 0);
+		triangleColors.reserve(colors.size() > 0 ? numQuads * 6 : 0);
+
+		for (size_t q=0; q<numQuads; q++)
 		{
-			for (size_t i=0; i<vertices.size(); i+=4)
+			for (const size_t i : {q*4 + 0, q*4 + 1, q*4 + 2, q*4 + 0, q*4 + 2, q*4 + 3})
 			{
-				finalVertices.push_back(vertices[i + 0]);
-				finalVertices.push_back(vertices[i + 1]);
-				finalVertices.push_back(vertices[i + 2]);
-
-				for (size_t t=0; t<texcoords.size(); t++)
-				{
-					finalTexcoords[t].push_back(texcoords[t][i + 0]);
-					finalTexcoords[t].push_back(texcoords[t][i + 1]);
-					finalTexcoords[t].push_back(texcoords[t][i + 2]);
-				}
+				triangleVertices.push_back(vertices[i]);
 
-				if (colors.size() > 0)
-				{
-					finalColors.push_back(colors[std::clamp<int>(i + 0, 0, maxColorIndex)]);
-					finalColors.push_back(colors[std::clamp<int>(i + 1, 0, maxColorIndex)]);
-					finalColors.push_back(colors[std::clamp<int>(i + 2, 0, maxColorIndex)]);
-				}
-
-				finalVertices.push_back(vertices[i + 0]);
-				finalVertices.push_back(vertices[i + 2]);
-				finalVertices.push_back(vertices[i + 3]);
-
-				for (size_t t=0; t<texcoords.size(); t++)
-				{
-					finalTexcoords[t].push_back(texcoords[t][i + 0]);
-					finalTexcoords[t].push_back(texcoords[t][i + 2]);
-					finalTexcoords[t].push_back(texcoords[t][i + 3]);
-				}
+				if (texcoords.size() > 0)
+					triangleTexcoords.push_back(texcoords[i]);
 
 				if (colors.size() > 0)
-				{
-					finalColors.push_back(colors[std::clamp<int>(i + 0, 0, maxColorIndex)]);
-					finalColors.push_back(colors[std::clamp<int>(i + 2, 0, maxColorIndex)]);
-					finalColors.push_back(colors[std::clamp<int>(i + 3, 0, maxColorIndex)]);
-				}
+					triangleColors.push_back(colors[std::clamp<int>(i, 0, maxColorIndex)]);
 			}
 		}
+
+		finalVertices = triangleVertices;
+		finalTexcoords = triangleTexcoords;
+		finalColors = triangleColors;
 	}
 
 	// upload vertices to gpu
 	if (finalVertices.size() > 0)
 	{
 		glBindBuffer(GL_ARRAY_BUFFER, m_iVBOVertices);
-		glBufferSubData(GL_ARRAY_BUFFER, 0, finalVertices.size() * sizeof(Vector3), &(finalVertices[0]));
+		glBufferSubData(GL_ARRAY_BUFFER, 0, finalVertices.size() * sizeof(Vector3), finalVertices.data());
 	}
 
 	// upload texcoords to gpu
-	if (finalTexcoords.size() > 0 && finalTexcoords[0].size() > 0)
+	if (finalTexcoords.size() > 0)
 	{
 		glBindBuffer(GL_ARRAY_BUFFER, m_iVBOTexcoords);
-		glBufferSubData(GL_ARRAY_BUFFER, 0, finalTexcoords[0].size() * sizeof(Vector2), &(finalTexcoords[0][0]));
+		glBufferSubData(GL_ARRAY_BUFFER, 0, finalTexcoords.size() * sizeof(Vector2), finalTexcoords.data());
 	}
 
 	// upload vertex colors to gpu
 	if (finalColors.size() > 0)
 	{
 		glBindBuffer(GL_ARRAY_BUFFER, m_iVBOTexcolors);
-		glBufferSubData(GL_ARRAY_BUFFER, 0, finalColors.size() * sizeof(Vector4), &(finalColors[0]));
+		glBufferSubData(GL_ARRAY_BUFFER, 0, finalColors.size() * sizeof(Vector4), finalColors.data());
 	}
 
 	// TODO: multitexturing support
 	// TODO: textured vertexcolors
-	if (finalTexcoords.size() > 0 && finalTexcoords[0].size() > 0)
+	if (finalTexcoords.size() > 0)
 	{
 		if (!m_bShaderTexturedGenericIsTextureEnabled)
 		{
@@ -573,6 +522,7 @@ void OpenGL3Interface::drawVAO(VertexArrayObject *vao)
 
 	// draw it
 	glDrawArrays(SDLGLInterface::primitiveToOpenGLMap[primitive], 0, finalVertices.size());
+	countDrawCall();
 }
 
 void OpenGL3Interface::setClipRect(McRect clipRect)
@@ -11,6 +11,8 @@
 
 #include "cbase.h"
 
+#include <span>
+
 #ifdef MCENGINE_FEATURE_GL3
 
 class OpenGLShader;
@@ -103,6 +105,9 @@ protected:
 	virtual void onTransformUpdate(Matrix4 &projectionMatrix, Matrix4 &worldMatrix);
 
 private:
+	// draws vertices which aren't in any buffer yet (everything except baked VAOs)
+	void drawImmediate(Graphics::PRIMITIVE primitive, std::span<const Vector3> vertices, std::span<const Vector2> texcoords, std::span<const Color> vcolors);
+
 	void handleGLErrors();
 
 	// renderer
@@ -12,6 +12,7 @@
 #include "Camera.h"
 #include "ConVar.h"
 #include "Engine.h"
+#include "FrameArena.h"
 
 #include "Font.h"
 #include "OpenGLES32Shader.h"
@@ -177,6 +178,8 @@ void OpenGLES32Interface::beginScene()
 {
 	m_bInScene = true;
 
+	resetDrawStats();
+
 	// enable default shader (must happen before any uniform calls)
 	m_shaderTexturedGeneric->enable();
 
@@ -438,6 +441,7 @@ void OpenGLES32Interface::drawVAO(VertexArrayObject *vao)
 
 		// draw
 		glvao->draw();
+		countDrawCall();
 		return;
 	}
 
@@ -453,10 +457,18 @@ void OpenGLES32Interface::drawVAO(VertexArrayObject *vao)
 
 	// no support for quads, because fuck you
 	// rewrite all quads into triangles
-	std::vector<Vector3> finalVertices = vertices;
-	std::vector<std::vector<Vector2>> finalTexcoords = texcoords;
-	std::vector<Color> colors;
-	std::vector<Color> finalColors;
+	// (temporaries live in the frame arena, this runs for every single non-baked draw call)
+	FrameVector<Vector3> finalVertices(vertices.begin(), vertices.end());
+	FrameVector<FrameVector<Vector2>> finalTexcoords;
+	finalTexcoords.reserve(texcoords.size());
+	for (const std::vector<Vector2> &textureUnitTexcoords : texcoords)
+	{
+		finalTexcoords.emplace_back(textureUnitTexcoords.begin(), textureUnitTexcoords.end());
+	}
+	FrameVector<Color> colors;
+	FrameVector<Color> finalColors;
+	colors.reserve(vcolors.size());
+	finalColors.reserve(vcolors.size());
 
 	for (size_t i = 0; i < vcolors.size(); i++)
 	{
@@ -589,6 +601,7 @@ void OpenGLES32Interface::drawVAO(VertexArrayObject *vao)
 
 	// draw it
 	glDrawArrays(SDLGLInterface::primitiveToOpenGLMap[primitive], 0, finalVertices.size());
+	countDrawCall();
 }
 
 void OpenGLES32Interface::setClipRect(McRect clipRect)
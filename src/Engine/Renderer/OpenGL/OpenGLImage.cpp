@@ -35,6 +35,15 @@ void OpenGLImage::init()
 {
 	if ((m_GLTexture != 0 && !m_bKeepInSystemMemory) || !(m_bAsyncReady.load())) return; // only load if we are not already loaded
 
+	// a byte-identical file has already been uploaded, reuse its texture (filter/wrap mode is handled in bind())
+	if (m_GLTexture == 0 && (m_GLTexture = static_cast<unsigned int>(getSharedTexture())) != 0)
+	{
+		m_bReady = true;
+		return;
+	}
+
+	const unsigned char *pixels = getRawPixels();
+
 	// create texture object
 	if (m_GLTexture == 0)
 	{
@@ -71,7 +80,7 @@ void OpenGLImage::init()
 		const GLint internalFormat = (m_iNumChannels == 4 ? GL_RGBA : (m_iNumChannels == 3 ? GL_RGB : (m_iNumChannels == 1 ? GL_LUMINANCE : GL_RGBA)));
 		const GLint format = (m_iNumChannels == 4 ? GL_RGBA : (m_iNumChannels == 3 ? GL_RGB : (m_iNumChannels == 1 ? GL_LUMINANCE : GL_RGBA)));
 
-		glTexImage2D(GL_TEXTURE_2D, 0, internalFormat, m_iWidth, m_iHeight, 0, format, GL_UNSIGNED_BYTE, &m_rawImage[0]);
+		glTexImage2D(GL_TEXTURE_2D, 0, internalFormat, m_iWidth, m_iHeight, 0, format, GL_UNSIGNED_BYTE, pixels);
 		if (m_bMipmapped)
 		{
 			glGenerateMipmap(GL_TEXTURE_2D);
@@ -81,7 +90,7 @@ void OpenGLImage::init()
 			glPixelStorei(GL_UNPACK_ALIGNMENT, prevUnpackAlignment);
 	}
 
-	if (m_rawImage.empty())
+	if (pixels == nullptr)
 	{
 		auto GLerror = glGetError();
 		debugLog("OpenGL Image Error: {} on file {:s}!\n", GLerror, m_sFilePath.toUtf8());
@@ -90,6 +99,7 @@ void OpenGLImage::init()
 	}
 
 	// free memory
+	setSharedTexture(m_GLTexture);
 	if (!m_bKeepInSystemMemory)
 		m_rawImage = std::vector<unsigned char>();
 
@@ -117,6 +127,8 @@ void OpenGLImage::initAsync()
 
 void OpenGLImage::destroy()
 {
+	// shared textures are only deleted by their last user
+	m_GLTexture = static_cast<unsigned int>(releaseSharedTexture(m_GLTexture));
 	if (m_GLTexture != 0)
 	{
 		glDeleteTextures(1, &m_GLTexture);
@@ -130,6 +142,9 @@ void OpenGLImage::bind(unsigned int textureUnit)
 {
 	if (!m_bReady) return;
 
+	// anything batched so far has to be drawn with the previously bound texture
+	if (g) g->flushBatch();
+
 	m_iTextureUnitBackup = textureUnit;
 
 	// switch texture units before enabling+binding
@@ -138,6 +153,13 @@ void OpenGLImage::bind(unsigned int textureUnit)
 	// set texture
 	glBindTexture(GL_TEXTURE_2D, m_GLTexture);
 
+	// the texture parameters are shared too, restore ours if another user changed them
+	if (claimSharedTextureState())
+	{
+		applyFilterMode();
+		applyWrapMode();
+	}
+
 	// DEPRECATED LEGACY (2)
 	if constexpr (Env::cfg(REND::GL))
 		glEnable(GL_TEXTURE_2D);
@@ -161,24 +183,11 @@ void OpenGLImage::setFilterMode(Graphics::FILTER_MODE filterMode)
 	Image::setFilterMode(filterMode);
 	if (!m_bReady) return;
 
+	// sampler state is per texture, so quads of this image which are still batched would otherwise be drawn with the new mode
+	if (g) g->flushBatch();
+
 	bind();
-	{
-		switch (filterMode)
-		{
-		case Graphics::FILTER_MODE::FILTER_MODE_NONE:
-			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-			break;
-		case Graphics::FILTER_MODE::FILTER_MODE_LINEAR:
-			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-			break;
-		case Graphics::FILTER_MODE::FILTER_MODE_MIPMAP:
-			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
-			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-			break;
-		}
-	}
+	applyFilterMode();
 	unbind();
 }
 
@@ -187,21 +196,45 @@ void OpenGLImage::setWrapMode(Graphics::WRAP_MODE wrapMode)
 	Image::setWrapMode(wrapMode);
 	if (!m_bReady) return;
 
+	if (g) g->flushBatch();
+
 	bind();
+	applyWrapMode();
+	unbind();
+}
+
+void OpenGLImage::applyFilterMode()
+{
+	switch (m_filterMode)
 	{
-		switch (wrapMode)
-		{
-		case Graphics::WRAP_MODE::WRAP_MODE_CLAMP: // NOTE: there is also GL_CLAMP, which works a bit differently concerning the border color
-			glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-			glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-			break;
-		case Graphics::WRAP_MODE::WRAP_MODE_REPEAT:
-			glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-			glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-			break;
-		}
+	case Graphics::FILTER_MODE::FILTER_MODE_NONE:
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+		break;
+	case Graphics::FILTER_MODE::FILTER_MODE_LINEAR:
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+		break;
+	case Graphics::FILTER_MODE::FILTER_MODE_MIPMAP:
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+		break;
+	}
+}
+
+void OpenGLImage::applyWrapMode()
+{
+	switch (m_wrapMode)
+	{
+	case Graphics::WRAP_MODE::WRAP_MODE_CLAMP: // NOTE: there is also GL_CLAMP, which works a bit differently concerning the border color
+		glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+		glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+		break;
+	case Graphics::WRAP_MODE::WRAP_MODE_REPEAT:
+		glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+		glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+		break;
 	}
-	unbind();
 }
 
 void OpenGLImage::handleGLErrors()
@@ -31,6 +31,10 @@ private:
 	void initAsync() override;
 	void destroy() override;
 
+	// (on the currently bound texture)
+	void applyFilterMode();
+	void applyWrapMode();
+
 	void handleGLErrors();
 
 	unsigned int m_GLTexture;
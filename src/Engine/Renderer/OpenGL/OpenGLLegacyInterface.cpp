@@ -78,6 +78,8 @@ void OpenGLLegacyInterface::beginScene()
 {
 	m_bInScene = true;
 
+	resetDrawStats();
+
 	Matrix4 defaultProjectionMatrix = Camera::buildMatrixOrtho2D(0, m_vResolution.x, m_vResolution.y, 0, -1.0f, 1.0f);
 
 	// push main transforms
@@ -100,6 +102,8 @@ void OpenGLLegacyInterface::beginScene()
 
 void OpenGLLegacyInterface::endScene()
 {
+	flushBatch();
+
 	popTransform();
 
 #ifdef _DEBUG
@@ -118,6 +122,7 @@ void OpenGLLegacyInterface::endScene()
 
 void OpenGLLegacyInterface::clearDepthBuffer()
 {
+	flushBatch();
 	glClear(GL_DEPTH_BUFFER_BIT);
 }
 
@@ -139,8 +144,10 @@ void OpenGLLegacyInterface::setAlpha(float alpha)
 
 void OpenGLLegacyInterface::drawPixels(int x, int y, int width, int height, Graphics::DRAWPIXELS_TYPE type, const void *pixels)
 {
+	flushBatch();
 	glRasterPos2i(x, y + height); // '+height' because of opengl bottom left origin, but engine top left origin
 	glDrawPixels(width, height, GL_RGBA, (type == Graphics::DRAWPIXELS_TYPE::DRAWPIXELS_UBYTE ? GL_UNSIGNED_BYTE : GL_FLOAT), pixels);
+	countDrawCall();
 }
 
 void OpenGLLegacyInterface::drawPixel(int x, int y)
@@ -154,6 +161,7 @@ void OpenGLLegacyInterface::drawPixel(int x, int y)
 		glVertex2i(x, y);
 	}
 	glEnd();
+	countDrawCall();
 }
 
 void OpenGLLegacyInterface::drawLine(int x1, int y1, int x2, int y2)
@@ -168,6 +176,7 @@ void OpenGLLegacyInterface::drawLine(int x1, int y1, int x2, int y2)
 		glVertex2f(x2 + 0.5f, y2 + 0.5f);
 	}
 	glEnd();
+	countDrawCall();
 }
 
 void OpenGLLegacyInterface::drawLine(Vector2 pos1, Vector2 pos2)
@@ -196,6 +205,7 @@ void OpenGLLegacyInterface::drawRect(int x, int y, int width, int height)
 		glVertex2f((x + width) + 0.5f, (y + height) + 0.5f);
 	}
 	glEnd();
+	countDrawCall();
 }
 
 void OpenGLLegacyInterface::drawRect(int x, int y, int width, int height, Color top, Color right, Color bottom, Color left)
@@ -223,6 +233,7 @@ void OpenGLLegacyInterface::drawRect(int x, int y, int width, int height, Color
 		glVertex2f((x + width) + 0.5f, (y + height) + 0.5f);
 	}
 	glEnd();
+	countDrawCall();
 }
 
 void OpenGLLegacyInterface::fillRect(int x, int y, int width, int height)
@@ -239,6 +250,7 @@ void OpenGLLegacyInterface::fillRect(int x, int y, int width, int height)
 		glVertex2i((x + width), y);
 	}
 	glEnd();
+	countDrawCall();
 }
 
 void OpenGLLegacyInterface::fillRoundedRect(int x, int y, int width, int height, int radius)
@@ -283,6 +295,7 @@ void OpenGLLegacyInterface::fillRoundedRect(int x, int y, int width, int height,
 		}
 	}
 	glEnd();
+	countDrawCall();
 }
 
 void OpenGLLegacyInterface::fillGradient(int x, int y, int width, int height, Color topLeftColor, Color topRightColor, Color bottomLeftColor, Color bottomRightColor)
@@ -306,6 +319,7 @@ void OpenGLLegacyInterface::fillGradient(int x, int y, int width, int height, Co
 		glVertex2i(x, (y + height));
 	}
 	glEnd();
+	countDrawCall();
 }
 
 void OpenGLLegacyInterface::drawQuad(int x, int y, int width, int height)
@@ -327,6 +341,7 @@ void OpenGLLegacyInterface::drawQuad(int x, int y, int width, int height)
 		glVertex2f((x + width), y);
 	}
 	glEnd();
+	countDrawCall();
 }
 
 void OpenGLLegacyInterface::drawQuad(Vector2 topLeft, Vector2 topRight, Vector2 bottomRight, Vector2 bottomLeft, Color topLeftColor, Color topRightColor, Color bottomRightColor,
@@ -353,6 +368,7 @@ void OpenGLLegacyInterface::drawQuad(Vector2 topLeft, Vector2 topRight, Vector2
 		glVertex2f(topRight.x, topRight.y);
 	}
 	glEnd();
+	countDrawCall();
 }
 
 void OpenGLLegacyInterface::drawImage(Image *image)
@@ -365,6 +381,10 @@ void OpenGLLegacyInterface::drawImage(Image *image)
 	if (!image->isReady())
 		return;
 
+	// merged with the previous image draws if possible, submitted on the next state change
+	if (batchImage(image, m_color))
+		return;
+
 	updateTransform();
 
 	const float width = image->getWidth();
@@ -390,6 +410,7 @@ void OpenGLLegacyInterface::drawImage(Image *image)
 			glVertex2f((x + width), y);
 		}
 		glEnd();
+		countDrawCall();
 	}
 	if (cv::r_image_unbind_after_drawimage.getBool())
 		image->unbind();
@@ -434,10 +455,13 @@ void OpenGLLegacyInterface::drawVAO(VertexArrayObject *vao)
 	if (vao->isReady())
 	{
 		vao->draw();
+		countDrawCall();
 		return;
 	}
 
 	const std::vector<Vector3> &vertices = vao->getVertices();
+	if (vertices.empty())
+		return;
 	const std::vector<Vector3> &normals = vao->getNormals();
 	const std::vector<std::vector<Vector2>> &texcoords = vao->getTexcoords();
 	const std::vector<Color> &colors = vao->getColors();
@@ -460,10 +484,12 @@ void OpenGLLegacyInterface::drawVAO(VertexArrayObject *vao)
 		glVertex3f(vertices[i].x, vertices[i].y, vertices[i].z);
 	}
 	glEnd();
+	countDrawCall();
 }
 
 void OpenGLLegacyInterface::setClipRect(McRect clipRect)
 {
+	flushBatch();
 	if (cv::r_debug_disable_cliprect.getBool())
 		return;
 	// if (m_bIs3DScene) return; // HACKHACK:TODO:
@@ -504,6 +530,8 @@ void OpenGLLegacyInterface::popClipRect()
 
 void OpenGLLegacyInterface::pushStencil()
 {
+	flushBatch();
+
 	// init and clear
 	glClearStencil(0);
 	glClear(GL_STENCIL_BUFFER_BIT);
@@ -517,6 +545,8 @@ void OpenGLLegacyInterface::pushStencil()
 
 void OpenGLLegacyInterface::fillStencil(bool inside)
 {
+	flushBatch();
+
 	glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
 	glStencilFunc(GL_NOTEQUAL, inside ? 0 : 1, 1);
 	glStencilOp(GL_KEEP, GL_KEEP, GL_KEEP);
@@ -524,11 +554,15 @@ void OpenGLLegacyInterface::fillStencil(bool inside)
 
 void OpenGLLegacyInterface::popStencil()
 {
+	flushBatch();
+
 	glDisable(GL_STENCIL_TEST);
 }
 
 void OpenGLLegacyInterface::setClipping(bool enabled)
 {
+	flushBatch();
+
 	if (enabled)
 	{
 		if (m_clipRectStack.size() > 0)
@@ -540,6 +574,8 @@ void OpenGLLegacyInterface::setClipping(bool enabled)
 
 void OpenGLLegacyInterface::setAlphaTesting(bool enabled)
 {
+	flushBatch();
+
 	if (enabled)
 		glEnable(GL_ALPHA_TEST);
 	else
@@ -548,11 +584,15 @@ void OpenGLLegacyInterface::setAlphaTesting(bool enabled)
 
 void OpenGLLegacyInterface::setAlphaTestFunc(COMPARE_FUNC alphaFunc, float ref)
 {
+	flushBatch();
+
 	glAlphaFunc(SDLGLInterface::compareFuncToOpenGLMap[alphaFunc], ref);
 }
 
 void OpenGLLegacyInterface::setBlending(bool enabled)
 {
+	flushBatch();
+
 	if (enabled)
 		glEnable(GL_BLEND);
 	else
@@ -561,6 +601,8 @@ void OpenGLLegacyInterface::setBlending(bool enabled)
 
 void OpenGLLegacyInterface::setBlendMode(BLEND_MODE blendMode)
 {
+	flushBatch();
+
 	switch (blendMode)
 	{
 	case BLEND_MODE::BLEND_MODE_ALPHA:
@@ -580,6 +622,8 @@ void OpenGLLegacyInterface::setBlendMode(BLEND_MODE blendMode)
 
 void OpenGLLegacyInterface::setDepthBuffer(bool enabled)
 {
+	flushBatch();
+
 	if (enabled)
 		glEnable(GL_DEPTH_TEST);
 	else
@@ -588,6 +632,8 @@ void OpenGLLegacyInterface::setDepthBuffer(bool enabled)
 
 void OpenGLLegacyInterface::setCulling(bool culling)
 {
+	flushBatch();
+
 	if (culling)
 		glEnable(GL_CULL_FACE);
 	else
@@ -596,6 +642,8 @@ void OpenGLLegacyInterface::setCulling(bool culling)
 
 void OpenGLLegacyInterface::setAntialiasing(bool aa)
 {
+	flushBatch();
+
 	m_bAntiAliasing = aa;
 	if (aa)
 		glEnable(GL_MULTISAMPLE);
@@ -605,6 +653,8 @@ void OpenGLLegacyInterface::setAntialiasing(bool aa)
 
 void OpenGLLegacyInterface::setWireframe(bool enabled)
 {
+	flushBatch();
+
 	if (enabled)
 		glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
 	else
@@ -613,6 +663,8 @@ void OpenGLLegacyInterface::setWireframe(bool enabled)
 
 void OpenGLLegacyInterface::flush()
 {
+	flushBatch();
+
 	glFlush();
 }
 
@@ -631,6 +683,8 @@ std::vector<unsigned char> OpenGLLegacyInterface::getScreenshot()
 
 	unsigned int numElements = width * height * 3;
 
+	flushBatch();
+
 	// take screenshot
 	unsigned char *pixels = new unsigned char[numElements];
 	glFinish();
@@ -649,6 +703,8 @@ std::vector<unsigned char> OpenGLLegacyInterface::getScreenshot()
 
 void OpenGLLegacyInterface::onResolutionChange(Vector2 newResolution)
 {
+	flushBatch();
+
 	// rebuild viewport
 	m_vResolution = newResolution;
 	glViewport(0, 0, m_vResolution.x, m_vResolution.y);
@@ -704,6 +760,14 @@ VertexArrayObject *OpenGLLegacyInterface::createVertexArrayObject(Graphics::PRIM
 	return new OpenGLVertexArrayObject(primitive, usage, keepInSystemMemory);
 }
 
+void OpenGLLegacyInterface::drawBatch(SpriteBatch &batch)
+{
+	// the batch vao carries per-vertex colors, which overwrite the current color through setColor()
+	const Color prevColor = m_color;
+	Graphics::drawBatch(batch);
+	setColor(prevColor);
+}
+
 void OpenGLLegacyInterface::onTransformUpdate(Matrix4 &projectionMatrix, Matrix4 &worldMatrix)
 {
 	glMatrixMode(GL_PROJECTION);
@@ -97,6 +97,7 @@ public:
 
 protected:
 	void onTransformUpdate(Matrix4 &projectionMatrix, Matrix4 &worldMatrix) final;
+	void drawBatch(SpriteBatch &batch) final;
 
 private:
 
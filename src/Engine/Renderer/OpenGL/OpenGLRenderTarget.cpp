@@ -255,6 +255,9 @@ void OpenGLRenderTarget::enable()
 	if (!m_bReady)
 		return;
 
+	// flush sprite batch before switching framebuffers
+	if (g) g->flushBatch();
+
 	// use the state cache instead of querying OpenGL directly
 	m_iFrameBufferBackup = OpenGLStateCache::getInstance().getCurrentFramebuffer();
 	glBindFramebuffer(GL_FRAMEBUFFER, m_iFrameBuffer);
@@ -288,6 +291,8 @@ void OpenGLRenderTarget::disable()
 	if (!m_bReady)
 		return;
 
+	if (g) g->flushBatch();
+
 	// if multisampled, blit content for multisampling into resolve texture
 #if (defined(MCENGINE_FEATURE_OPENGL) || defined(MCENGINE_FEATURE_GLES32)) && !defined(MCENGINE_PLATFORM_WASM)
 
@@ -329,6 +334,8 @@ void OpenGLRenderTarget::bind(unsigned int textureUnit)
 	if (!m_bReady)
 		return;
 
+	if (g) g->flushBatch();
+
 	m_iTextureUnitBackup = textureUnit;
 
 	// switch texture units before enabling+binding
@@ -104,6 +104,9 @@ void OpenGLShader::enable()
 	if (!m_bReady)
 		return;
 
+	// flush sprite batch before switching programs
+	if (g) g->flushBatch();
+
 	int currentProgram = OpenGLStateCache::getInstance().getCurrentProgram();
 	if (currentProgram == m_iProgram) // already active
 		return;
@@ -120,6 +123,8 @@ void OpenGLShader::disable()
 	if (!m_bReady)
 		return;
 
+	if (g) g->flushBatch();
+
 	glUseProgram(m_iProgramBackup);
 
 	// update cache
@@ -131,6 +136,8 @@ void OpenGLShader::setUniform1f(const std::string_view &name, float value)
 	if (!m_bReady)
 		return;
 
+	if (g) g->flushBatch(); // (pending batched draws must still see the old value)
+
 	const int id = getAndCacheUniformLocation(name);
 	if (id != -1)
 		glUniform1fARB(id, value);
@@ -143,6 +150,8 @@ void OpenGLShader::setUniform1fv(const std::string_view &name, int count, float
 	if (!m_bReady)
 		return;
 
+	if (g) g->flushBatch();
+
 	const int id = getAndCacheUniformLocation(name);
 	if (id != -1)
 		glUniform1fvARB(id, count, values);
@@ -155,6 +164,8 @@ void OpenGLShader::setUniform1i(const std::string_view &name, int value)
 	if (!m_bReady)
 		return;
 
+	if (g) g->flushBatch();
+
 	const int id = getAndCacheUniformLocation(name);
 	if (id != -1)
 		glUniform1iARB(id, value);
@@ -167,6 +178,8 @@ void OpenGLShader::setUniform2f(const std::string_view &name, float value1, floa
 	if (!m_bReady)
 		return;
 
+	if (g) g->flushBatch();
+
 	const int id = getAndCacheUniformLocation(name);
 	if (id != -1)
 		glUniform2fARB(id, value1, value2);
@@ -179,6 +192,8 @@ void OpenGLShader::setUniform2fv(const std::string_view &name, int count, float
 	if (!m_bReady)
 		return;
 
+	if (g) g->flushBatch();
+
 	const int id = getAndCacheUniformLocation(name);
 	if (id != -1)
 		glUniform2fv(id, count, (float *)&vectors[0]);
@@ -191,6 +206,8 @@ void OpenGLShader::setUniform3f(const std::string_view &name, float x, float y,
 	if (!m_bReady)
 		return;
 
+	if (g) g->flushBatch();
+
 	const int id = getAndCacheUniformLocation(name);
 	if (id != -1)
 		glUniform3fARB(id, x, y, z);
@@ -203,6 +220,8 @@ void OpenGLShader::setUniform3fv(const std::string_view &name, int count, float
 	if (!m_bReady)
 		return;
 
+	if (g) g->flushBatch();
+
 	const int id = getAndCacheUniformLocation(name);
 	if (id != -1)
 		glUniform3fv(id, count, (float *)&vectors[0]);
@@ -215,6 +234,8 @@ void OpenGLShader::setUniform4f(const std::string_view &name, float x, float y,
 	if (!m_bReady)
 		return;
 
+	if (g) g->flushBatch();
+
 	const int id = getAndCacheUniformLocation(name);
 	if (id != -1)
 		glUniform4fARB(id, x, y, z, w);
@@ -227,6 +248,8 @@ void OpenGLShader::setUniformMatrix4fv(const std::string_view &name, Matrix4 &ma
 	if (!m_bReady)
 		return;
 
+	if (g) g->flushBatch();
+
 	const int id = getAndCacheUniformLocation(name);
 	if (id != -1)
 		glUniformMatrix4fv(id, 1, GL_FALSE, matrix.get());
@@ -239,6 +262,8 @@ void OpenGLShader::setUniformMatrix4fv(const std::string_view &name, float *v)
 	if (!m_bReady)
 		return;
 
+	if (g) g->flushBatch();
+
 	const int id = getAndCacheUniformLocation(name);
 	if (id != -1)
 		glUniformMatrix4fv(id, 1, GL_FALSE, v);
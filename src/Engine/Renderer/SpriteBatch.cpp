@@ -0,0 +1,72 @@
+//================ Copyright (c) 2025, WH, All rights reserved. =================//
+//
+// Purpose:		api independent accumulation of textured 2d quads into few draw calls
+//
+// $NoKeywords: $sprbatch
+//===============================================================================//
+
+#include "SpriteBatch.h"
+
+#include "VertexArrayObject.h"
+
+SpriteBatch::SpriteBatch()
+{
+	m_image = nullptr;
+
+	m_vertices.reserve(MAX_QUADS * 4);
+	m_texcoords.reserve(MAX_QUADS * 4);
+	m_colors.reserve(MAX_QUADS * 4);
+
+	m_vao = std::make_unique<VertexArrayObject>(Graphics::PRIMITIVE::PRIMITIVE_QUADS, Graphics::USAGE_TYPE::USAGE_STREAM, false);
+}
+
+SpriteBatch::~SpriteBatch() = default;
+
+bool SpriteBatch::canAppend(const Image *image, const Matrix4 &projectionMatrix) const
+{
+	if (isEmpty())
+		return true;
+
+	return image == m_image && !isFull() && projectionMatrix.getGLM() == m_projectionMatrix.getGLM();
+}
+
+void SpriteBatch::addQuad(Image *image, const Matrix4 &projectionMatrix, const Matrix4 &worldMatrix, float x, float y, float width, float height, Color color)
+{
+	if (isEmpty())
+	{
+		m_image = image;
+		m_projectionMatrix = projectionMatrix;
+	}
+
+	// same winding and texcoord layout as the unbatched drawImage() implementations
+	m_vertices.push_back(worldMatrix * Vector3(x, y, 0));
+	m_vertices.push_back(worldMatrix * Vector3(x, y + height, 0));
+	m_vertices.push_back(worldMatrix * Vector3(x + width, y + height, 0));
+	m_vertices.push_back(worldMatrix * Vector3(x + width, y, 0));
+
+	m_texcoords.emplace_back(0, 0);
+	m_texcoords.emplace_back(0, 1);
+	m_texcoords.emplace_back(1, 1);
+	m_texcoords.emplace_back(1, 0);
+
+	m_colors.insert(m_colors.end(), 4, color);
+}
+
+VertexArrayObject *SpriteBatch::buildVAO()
+{
+	m_vao->empty();
+	m_vao->setVertices(m_vertices);
+	m_vao->setTexcoords(m_texcoords);
+	m_vao->setColors(m_colors);
+
+	return m_vao.get();
+}
+
+void SpriteBatch::clear()
+{
+	m_image = nullptr;
+
+	m_vertices.clear();
+	m_texcoords.clear();
+	m_colors.clear();
+}
@@ -0,0 +1,72 @@
+//================ Copyright (c) 2025, WH, All rights reserved. =================//
+//
+// Purpose:		api independent accumulation of textured 2d quads into few draw calls
+//
+// $NoKeywords: $sprbatch
+//===============================================================================//
+
+#pragma once
+#ifndef SPRITEBATCH_H
+#define SPRITEBATCH_H
+
+#include <vector>
+#include <memory>
+#include <cstdint>
+
+#include "Matrices.h"
+#include "Vectors.h"
+#include "Color.h"
+
+class Image;
+class VertexArrayObject;
+
+// Collects consecutive drawImage() calls which share the same texture and projection.
+// Quads are transformed into world space on the CPU when they are added, so the current world matrix
+// may change freely between quads without breaking the batch. Submission order is never rearranged,
+// only runs of compatible draws are merged, so the result is identical to drawing them one by one.
+// Every other GPU state change (blending, clipping, shaders, rendertargets, ...) has to flush the batch
+// before it is applied, which is handled by Graphics and the backend implementations.
+class SpriteBatch
+{
+public:
+	static constexpr size_t MAX_QUADS = 4096; // soft limit, the owner should flush once this is reached
+
+	SpriteBatch();
+	~SpriteBatch();
+
+	SpriteBatch(const SpriteBatch &) = delete;
+	SpriteBatch &operator=(const SpriteBatch &) = delete;
+
+	// returns true if a quad with this state may be appended without flushing first
+	[[nodiscard]] bool canAppend(const Image *image, const Matrix4 &projectionMatrix) const;
+
+	// (x, y, width, height) are in object space, worldMatrix is applied to all four corners
+	void addQuad(Image *image, const Matrix4 &projectionMatrix, const Matrix4 &worldMatrix, float x, float y, float width, float height, Color color);
+
+	// fills the internal (unbaked) vao with all pending quads and returns it, ready for Graphics::drawVAO()
+	VertexArrayObject *buildVAO();
+
+	void clear();
+
+	[[nodiscard]] inline bool isEmpty() const {return m_vertices.empty();}
+	[[nodiscard]] inline bool isFull() const {return getNumQuads() >= MAX_QUADS;}
+	[[nodiscard]] inline size_t getNumQuads() const {return m_vertices.size() / 4;}
+	[[nodiscard]] inline Image *getImage() const {return m_image;}
+	[[nodiscard]] inline const Matrix4 &getProjectionMatrix() const {return m_projectionMatrix;}
+
+	[[nodiscard]] inline const std::vector<Vector3> &getVertices() const {return m_vertices;}
+	[[nodiscard]] inline const std::vector<Vector2> &getTexcoords() const {return m_texcoords;}
+	[[nodiscard]] inline const std::vector<Color> &getColors() const {return m_colors;}
+
+private:
+	Image *m_image;
+	Matrix4 m_projectionMatrix;
+
+	std::vector<Vector3> m_vertices;
+	std::vector<Vector2> m_texcoords;
+	std::vector<Color> m_colors;
+
+	std::unique_ptr<VertexArrayObject> m_vao;
+};
+
+#endif
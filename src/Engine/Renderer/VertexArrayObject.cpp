@@ -49,6 +49,7 @@ void VertexArrayObject::empty()
 	for (size_t i=0; i<m_texcoords.size(); i++)
 	{
 		m_texcoords[i].clear();
+		m_spareTexcoords.push_back(std::move(m_texcoords[i]));
 	}
 	m_texcoords.clear();
 	m_normals.clear();
@@ -183,8 +184,17 @@ void VertexArrayObject::updateTexcoordArraySize(unsigned int textureUnit)
 {
 	while (m_texcoords.size() < (textureUnit + 1))
 	{
-		std::vector<Vector2> emptyVector;
-		m_texcoords.push_back(emptyVector);
+		// dynamic vaos are refilled every frame, so don't reallocate the texcoords every time
+		if (!m_spareTexcoords.empty())
+		{
+			m_texcoords.push_back(std::move(m_spareTexcoords.back()));
+			m_spareTexcoords.pop_back();
+		}
+		else
+		{
+			std::vector<Vector2> emptyVector;
+			m_texcoords.push_back(emptyVector);
+		}
 	}
 }
 
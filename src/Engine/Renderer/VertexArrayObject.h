@@ -80,6 +80,7 @@ protected:
 
 	std::vector<Vector3> m_vertices;
 	std::vector<std::vector<Vector2>> m_texcoords;
+	std::vector<std::vector<Vector2>> m_spareTexcoords; // storage of the units removed by empty(), reused by the next fill
 	std::vector<Vector3> m_normals;
 	std::vector<Color> m_colors;
 
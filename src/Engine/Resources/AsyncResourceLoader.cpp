@@ -7,137 +7,15 @@
 
 #include "AsyncResourceLoader.h"
 
-#include "App.h"
+#include "AllocTracker.h"
 #include "ConVar.h"
 #include "Engine.h"
-#include "Environment.h"
+#include "Profiler.h"
 #include "Thread.h"
 
 #include <algorithm>
 
-using namespace std::chrono_literals;
-
-//==================================
-// LOADER THREAD
-//==================================
-class AsyncResourceLoader::LoaderThread final
-{
-public:
-	std::unique_ptr<McThread> thread;
-	AsyncResourceLoader *loader{};
-	size_t threadIndex{};
-	std::chrono::steady_clock::time_point lastWorkTime{};
-
-	LoaderThread(AsyncResourceLoader *loader_ptr, size_t index)
-	    : loader(loader_ptr),
-	      threadIndex(index)
-	{
-	}
-};
-
-namespace
-{
-void *asyncResourceLoaderThread(void *data, std::stop_token stopToken)
-{
-	auto *loaderThread = static_cast<AsyncResourceLoader::LoaderThread *>(data);
-	AsyncResourceLoader *loader = loaderThread->loader;
-	const size_t threadIndex = loaderThread->threadIndex;
-
-	loaderThread->lastWorkTime = std::chrono::steady_clock::now();
-	loader->m_activeThreadCount.fetch_add(1);
-
-	if (cv::debug_rm.getBool())
-		debugLog("AsyncResourceLoader: Thread #{} started\n", threadIndex);
-
-	while (!stopToken.stop_requested() && !loader->m_shuttingDown.load())
-	{
-		// yield in case we're sharing a logical CPU, like on a single-core system
-		Timing::sleep(0);
-
-		auto work = loader->getNextPendingWork();
-
-		if (!work)
-		{
-			std::unique_lock<std::mutex> lock(loader->m_workAvailableMutex);
-
-			std::stop_callback stopCallback(stopToken, [&]() { loader->m_workAvailable.notify_all(); });
-
-			auto waitTime = loader->m_threadIdleTimeout;
-			bool workAvailable = loader->m_workAvailable.wait_for(
-			    lock, waitTime, [&]() { return stopToken.stop_requested() || loader->m_shuttingDown.load() || loader->m_activeWorkCount.load() > 0; });
-
-			if (!workAvailable && !(app && app->isInCriticalInteractiveSession()))
-			{
-				if (cv::debug_rm.getBool())
-					debugLog("AsyncResourceLoader: Thread #{} terminating due to idle timeout\n", threadIndex);
-
-				loaderThread->thread->requestStop();
-				break;
-			}
-
-			if (stopToken.stop_requested() || loader->m_shuttingDown.load())
-				break;
-
-			continue;
-		}
-
-		loaderThread->lastWorkTime = std::chrono::steady_clock::now();
-
-		Resource *resource = work->resource;
-		work->state.store(AsyncResourceLoader::WorkState::ASYNC_IN_PROGRESS);
-
-		const bool debug = cv::debug_rm.getBool();
-		std::string debugName;
-		if (debug)
-		{
-			debugName = std::string{resource->getName().toUtf8()};
-			debugLog("AsyncResourceLoader: Thread #{} loading {:s}\n", threadIndex, debugName);
-		}
-
-		resource->loadAsync();
-
-		if (debug)
-			debugLog("AsyncResourceLoader: Thread #{} finished async loading {:s}\n", threadIndex, debugName);
-
-		work->state.store(AsyncResourceLoader::WorkState::ASYNC_COMPLETE);
-		loader->markWorkAsyncComplete(std::move(work));
-	}
-
-	loader->m_activeThreadCount.fetch_sub(1);
-
-	if (cv::debug_rm.getBool())
-		debugLog("AsyncResourceLoader: Thread #{} exiting\n", threadIndex);
-
-	return nullptr;
-}
-} // namespace
-
-//==================================
-// ASYNC RESOURCE LOADER
-//==================================
-
-AsyncResourceLoader::AsyncResourceLoader()
-{
-	m_maxThreads = std::clamp(env->getLogicalCPUCount() - 1, MIN_NUM_THREADS, 32);
-	m_threadIdleTimeout = THREAD_IDLE_TIMEOUT;
-
-	// create initial threads
-	for (size_t i = 0; i < MIN_NUM_THREADS; i++)
-	{
-		auto loaderThread = std::make_unique<LoaderThread>(this, m_totalThreadsCreated.fetch_add(1));
-
-		loaderThread->thread = std::make_unique<McThread>(asyncResourceLoaderThread, loaderThread.get());
-		if (!loaderThread->thread->isReady())
-		{
-			engine->showMessageError("AsyncResourceLoader Error", "Couldn't create core thread!");
-		}
-		else
-		{
-			std::lock_guard<std::mutex> lock(m_threadsMutex);
-			m_threads.push_back(std::move(loaderThread));
-		}
-	}
-}
+AsyncResourceLoader::AsyncResourceLoader() = default;
 
 AsyncResourceLoader::~AsyncResourceLoader()
 {
@@ -148,32 +26,15 @@ void AsyncResourceLoader::shutdown()
 {
 	m_shuttingDown = true;
 
-	// request all threads to stop
-	{
-		std::lock_guard<std::mutex> lock(m_threadsMutex);
-		for (auto &thread : m_threads)
-		{
-			if (thread->thread)
-				thread->thread->requestStop();
-		}
-	}
-
-	// wake up all threads so they can exit
-	m_workAvailable.notify_all();
-
-	// wait for threads to stop
-	{
-		std::lock_guard<std::mutex> lock(m_threadsMutex);
-		m_threads.clear();
-	}
+	// jobs which haven't started yet return immediately, the others still have to finish their loadAsync() (they reference us and the resource)
+	if (jobSystem)
+		jobSystem->waitAll(m_jobs);
+	m_jobs.clear();
+	m_backgroundThreads.clear(); // (joins)
 
 	// cleanup remaining work items
 	{
 		std::lock_guard<std::mutex> lock(m_workQueueMutex);
-		while (!m_pendingWork.empty())
-		{
-			m_pendingWork.pop();
-		}
 		while (!m_asyncCompleteWork.empty())
 		{
 			m_asyncCompleteWork.pop();
@@ -196,7 +57,7 @@ void AsyncResourceLoader::shutdown()
 
 void AsyncResourceLoader::requestAsyncLoad(Resource *resource)
 {
-	auto work = std::make_unique<LoadingWork>(resource, m_workIdCounter.fetch_add(1));
+	auto work = std::make_shared<LoadingWork>(resource, m_workIdCounter.fetch_add(1));
 
 	// add to tracking set
 	{
@@ -204,23 +65,71 @@ void AsyncResourceLoader::requestAsyncLoad(Resource *resource)
 		m_loadingResources.insert(resource);
 	}
 
-	// add to work queue
+	m_activeWorkCount.fetch_add(1);
+
+	if (resource->isBackgroundWork())
 	{
-		std::lock_guard<std::mutex> lock(m_workQueueMutex);
-		m_pendingWork.push(std::move(work));
+		auto backgroundThread = std::make_unique<BackgroundThread>();
+		backgroundThread->thread = std::make_unique<McThread>([this, work, finished = &backgroundThread->finished](const std::stop_token &) -> void {
+			VPROF_THREAD_NAME("AsyncResourceLoader");
+			runLoadingWork(work);
+			finished->store(true);
+		});
+
+		if (backgroundThread->thread->isReady())
+		{
+			m_backgroundThreads.push_back(std::move(backgroundThread));
+			return;
+		}
+
+		debugLog("AsyncResourceLoader Warning: Couldn't create thread for {:s}, loading it as a job instead\n", resource->getName());
 	}
 
-	m_activeWorkCount.fetch_add(1);
-	ensureThreadAvailable();
-	m_workAvailable.notify_one();
+	m_jobs.push_back(jobSystem->schedule("AsyncResourceLoader::load", [this, work]() -> void { runLoadingWork(work); }, {}, JobSystem::PRIORITY::NORMAL));
+}
+
+void AsyncResourceLoader::runLoadingWork(const std::shared_ptr<LoadingWork> &work)
+{
+	if (m_shuttingDown.load())
+		return;
+
+	ALLOC_TAG(RESOURCES);
+
+	Resource *resource = work->resource;
+	work->state.store(WorkState::ASYNC_IN_PROGRESS);
+	m_asyncInProgressCount.fetch_add(1);
+
+	const bool debug = cv::debug_rm.getBool();
+	std::string debugName;
+	if (debug)
+	{
+		debugName = std::string{resource->getName().toUtf8()};
+		debugLog("AsyncResourceLoader: Loading {:s}\n", debugName);
+	}
+
+	{
+		VPROF_TRACE("Resource::loadAsync");
+		resource->loadAsync();
+	}
+
+	if (debug)
+		debugLog("AsyncResourceLoader: Finished async loading {:s}\n", debugName);
+
+	m_asyncInProgressCount.fetch_sub(1);
+	work->state.store(WorkState::ASYNC_COMPLETE);
+	markWorkAsyncComplete(work);
 }
 
 void AsyncResourceLoader::update(bool lowLatency)
 {
-	if (!lowLatency)
-		cleanupIdleThreads();
+	// without worker threads, the loading jobs (and all other background jobs) only ever run here
+	jobSystem->runQueuedJobs();
 
-	const size_t amountToProcess = lowLatency ? 1 : m_maxThreads;
+	std::erase_if(m_jobs, [](const JobSystem::JobHandle &job) { return job->isFinished(); });
+	std::erase_if(m_backgroundThreads, [](const std::unique_ptr<BackgroundThread> &backgroundThread) { return backgroundThread->finished.load(); });
+
+	// (roughly as many as can finish loading in parallel per frame)
+	const size_t amountToProcess = lowLatency ? 1 : std::max<size_t>(jobSystem->getNumWorkers(), 1);
 
 	// process completed async work
 	size_t numProcessed = 0;
@@ -236,7 +145,10 @@ void AsyncResourceLoader::update(bool lowLatency)
 		if (cv::debug_rm.getBool())
 			debugLog("AsyncResourceLoader: Sync init for {:s}\n", rs->getName());
 
-		rs->load();
+		{
+			ALLOC_TAG(RESOURCES);
+			rs->load();
+		}
 		work->state.store(WorkState::SYNC_COMPLETE);
 
 		// remove from tracking set
@@ -247,8 +159,6 @@ void AsyncResourceLoader::update(bool lowLatency)
 
 		m_activeWorkCount.fetch_sub(1);
 		numProcessed++;
-
-		// work will be automatically destroyed when unique_ptr goes out of scope
 	}
 
 	// process async destroy queue
@@ -341,78 +251,13 @@ bool AsyncResourceLoader::isLoadingResource(Resource *resource) const
 	return m_loadingResources.find(resource) != m_loadingResources.end();
 }
 
-void AsyncResourceLoader::ensureThreadAvailable()
-{
-	size_t activeThreads = m_activeThreadCount.load();
-	size_t activeWorkCount = m_activeWorkCount.load();
-
-	if (activeWorkCount > activeThreads && activeThreads < m_maxThreads)
-	{
-		std::lock_guard<std::mutex> lock(m_threadsMutex);
-
-		if (m_threads.size() < m_maxThreads)
-		{
-			auto loaderThread = std::make_unique<LoaderThread>(this, m_totalThreadsCreated.fetch_add(1));
-
-			loaderThread->thread = std::make_unique<McThread>(asyncResourceLoaderThread, loaderThread.get());
-			if (!loaderThread->thread->isReady())
-			{
-				if (cv::debug_rm.getBool())
-					debugLog("AsyncResourceLoader Warning: Couldn't create dynamic thread!\n");
-			}
-			else
-			{
-				if (cv::debug_rm.getBool())
-					debugLog("AsyncResourceLoader: Created dynamic thread #{} (total: {})\n", loaderThread->threadIndex, m_threads.size() + 1);
-
-				m_threads.push_back(std::move(loaderThread));
-			}
-		}
-	}
-}
-
-void AsyncResourceLoader::cleanupIdleThreads()
-{
-	if (m_threads.size() == 0)
-		return;
-
-	std::lock_guard<std::mutex> lock(m_threadsMutex);
-
-	if (m_threads.size() == 0)
-		return;
-
-	// always remove threads that have requested stop, regardless of minimum
-	// the minimum will be maintained by ensureThreadAvailable() when needed
-	std::erase_if(m_threads, [&](const std::unique_ptr<LoaderThread> &thread) {
-		if (thread->thread && thread->thread->isStopRequested())
-		{
-			if (cv::debug_rm.getBool())
-				Engine::logRaw("[cleanupIdleThreads] AsyncResourceLoader: Cleaning up thread #{}\n", thread->threadIndex);
-			return true;
-		}
-		return false;
-	});
-}
-
-std::unique_ptr<AsyncResourceLoader::LoadingWork> AsyncResourceLoader::getNextPendingWork()
-{
-	std::lock_guard<std::mutex> lock(m_workQueueMutex);
-
-	if (m_pendingWork.empty())
-		return nullptr;
-
-	auto work = std::move(m_pendingWork.front());
-	m_pendingWork.pop();
-	return work;
-}
-
-void AsyncResourceLoader::markWorkAsyncComplete(std::unique_ptr<LoadingWork> work)
+void AsyncResourceLoader::markWorkAsyncComplete(std::shared_ptr<LoadingWork> work)
 {
 	std::lock_guard<std::mutex> lock(m_workQueueMutex);
 	m_asyncCompleteWork.push(std::move(work));
 }
 
-std::unique_ptr<AsyncResourceLoader::LoadingWork> AsyncResourceLoader::getNextAsyncCompleteWork()
+std::shared_ptr<AsyncResourceLoader::LoadingWork> AsyncResourceLoader::getNextAsyncCompleteWork()
 {
 	std::lock_guard<std::mutex> lock(m_workQueueMutex);
 
@@ -10,19 +10,20 @@
 #define ASYNCRESOURCELOADER_H
 
 #include "Resource.h"
+#include "JobSystem.h"
+
 #include <atomic>
-#include <chrono>
-#include <condition_variable>
 #include <memory>
 #include <mutex>
 #include <queue>
 #include <unordered_set>
 #include <vector>
 
-class ConVar;
 class McThread;
 
-// everything is public because the class data should only be accessed by ResourceManager and the resource threads themselves
+// every loadAsync() runs as a job on the engine JobSystem (or on a thread of its own, for resources which are long running background work),
+// and the completed ones get their load() on the main thread in update()
+// everything is public because the class data should only be accessed by ResourceManager and the loading jobs themselves
 class AsyncResourceLoader final
 {
 public:
@@ -48,7 +49,7 @@ public:
 	[[nodiscard]] inline bool isLoading() const { return m_activeWorkCount.load() > 0; }
 	[[nodiscard]] bool isLoadingResource(Resource *resource) const;
 	[[nodiscard]] size_t getNumLoadingWork() const { return m_activeWorkCount.load(); }
-	[[nodiscard]] size_t getNumActiveThreads() const { return m_activeThreadCount.load(); }
+	[[nodiscard]] size_t getNumLoadingWorkAsyncInProgress() const { return m_asyncInProgressCount.load(); }
 	[[nodiscard]] inline size_t getNumLoadingWorkAsyncDestroy() const { return m_asyncDestroyQueue.size(); }
 
 	enum class WorkState : uint8_t
@@ -68,38 +69,25 @@ public:
 		LoadingWork(Resource *res, size_t id) : resource(res), workId(id) {}
 	};
 
-	class LoaderThread;
-	friend class LoaderThread;
-
-	// threading configuration
-	static constexpr int MIN_NUM_THREADS = 1;
-	static constexpr auto THREAD_IDLE_TIMEOUT = std::chrono::seconds{5};
+	// background work would occupy a job system worker for as long as it runs (or blocks on the disk/network), so it gets a thread of its own
+	struct BackgroundThread
+	{
+		std::unique_ptr<McThread> thread;
+		std::atomic<bool> finished{false};
+	};
 
-	// thread management
-	void ensureThreadAvailable();
-	void cleanupIdleThreads();
+	// runs on the job system (or a background thread)
+	void runLoadingWork(const std::shared_ptr<LoadingWork> &work);
 
 	// work queue management
-	std::unique_ptr<LoadingWork> getNextPendingWork();
-	void markWorkAsyncComplete(std::unique_ptr<LoadingWork> work);
-	std::unique_ptr<LoadingWork> getNextAsyncCompleteWork();
+	void markWorkAsyncComplete(std::shared_ptr<LoadingWork> work);
+	std::shared_ptr<LoadingWork> getNextAsyncCompleteWork();
 
-	size_t m_maxThreads;
-	std::chrono::seconds m_threadIdleTimeout{5};
+	// scheduled loading jobs which haven't finished yet (main thread only, so that shutdown() can wait for them)
+	std::vector<JobSystem::JobHandle> m_jobs;
+	std::vector<std::unique_ptr<BackgroundThread>> m_backgroundThreads; // (main thread only, joined once finished)
 
-	// thread pool
-	std::vector<std::unique_ptr<LoaderThread>> m_threads;
-	mutable std::mutex m_threadsMutex;
-
-	// thread lifecycle tracking
-	std::atomic<size_t> m_activeThreadCount{0};
-	std::atomic<size_t> m_totalThreadsCreated{0};
-
-	// separate queues for different work states (avoids O(n) scanning)
-	std::queue<std::unique_ptr<LoadingWork>> m_pendingWork;
-	std::queue<std::unique_ptr<LoadingWork>> m_asyncCompleteWork;
-
-	// single mutex for both work queues (they're accessed in sequence, not concurrently)
+	std::queue<std::shared_ptr<LoadingWork>> m_asyncCompleteWork;
 	mutable std::mutex m_workQueueMutex;
 
 	// fast lookup for checking if a resource is being loaded
@@ -108,12 +96,9 @@ public:
 
 	// atomic counters for efficient status queries
 	std::atomic<size_t> m_activeWorkCount{0};
+	std::atomic<size_t> m_asyncInProgressCount{0};
 	std::atomic<size_t> m_workIdCounter{0};
 
-	// work notification
-	std::condition_variable m_workAvailable;
-	std::mutex m_workAvailableMutex;
-
 	// async destroy queue
 	std::vector<Resource *> m_asyncDestroyQueue;
 	std::mutex m_asyncDestroyMutex;
@@ -71,6 +71,10 @@ public:
 	// type inspection
 	[[nodiscard]] virtual Type getResType() const = 0;
 
+	// long running background work (database loading, star calculation, search, ...) gets loaded on a thread of its own instead of a job system worker,
+	// so that it doesn't hold up regular loads
+	[[nodiscard]] virtual bool isBackgroundWork() const { return getResType() == APPDEFINED; }
+
 	template <typename T = Resource>
 	T *as()
 	{
@@ -9,6 +9,7 @@
 #include "AsyncResourceLoader.h"
 #include "Resource.h"
 
+#include "AllocTracker.h"
 #include "App.h"
 #include "ConVar.h"
 #include "Environment.h"
@@ -18,6 +19,14 @@
 namespace cv {
 ConVar rm_interrupt_on_destroy("rm_interrupt_on_destroy", true, FCVAR_CHEAT);
 ConVar debug_rm("debug_rm", false, FCVAR_NONE);
+ConVar rm_image_sharing("rm_image_sharing", true, FCVAR_NONE, "images loaded from byte-identical files share one decoded pixel buffer and texture (affects new loads only)");
+ConVar rm_image_sharing_stats("rm_image_sharing_stats", FCVAR_NONE, "print the hit rate of rm_image_sharing", []() -> void {
+	const Image::SHARING_STATS stats = Image::getSharingStats();
+	const uint64_t numLoads = stats.numHits + stats.numMisses;
+	debugLog("ResourceManager: Image sharing: {:d} hits / {:d} loads ({:.1f}%), {:.2f} MB not decoded again, {:d} distinct images in use, {:.2f} MB waiting for upload\n", stats.numHits,
+	         numLoads, numLoads > 0 ? 100.0 * static_cast<double>(stats.numHits) / static_cast<double>(numLoads) : 0.0, static_cast<double>(stats.numBytesSaved) / (1024.0 * 1024.0),
+	         stats.numEntries, static_cast<double>(stats.numPendingBytes) / (1024.0 * 1024.0));
+});
 }
 
 ResourceManager::ResourceManager()
@@ -42,7 +51,7 @@ ResourceManager::~ResourceManager()
 	// release all not-currently-being-loaded resources
 	destroyResources();
 
-	// shutdown async loader (handles thread cleanup)
+	// shutdown async loader (waits for loading jobs which are still running)
 	delete m_asyncLoader;
 }
 
@@ -136,6 +145,7 @@ void ResourceManager::loadResource(Resource *res, bool load)
 	if (!isNextLoadAsync)
 	{
 		// load normally
+		ALLOC_TAG(RESOURCES);
 		res->loadAsync();
 		res->load();
 	}
@@ -161,9 +171,9 @@ size_t ResourceManager::getNumLoadingWork() const
 	return m_asyncLoader->getNumLoadingWork();
 }
 
-size_t ResourceManager::getNumActiveThreads() const
+size_t ResourceManager::getNumLoadingWorkAsyncInProgress() const
 {
-	return m_asyncLoader->getNumActiveThreads();
+	return m_asyncLoader->getNumLoadingWorkAsyncInProgress();
 }
 
 size_t ResourceManager::getNumLoadingWorkAsyncDestroy() const
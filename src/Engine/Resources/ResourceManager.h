@@ -112,7 +112,7 @@ public:
 	[[nodiscard]] bool isLoading() const;
 	bool isLoadingResource(Resource *rs) const;
 	[[nodiscard]] size_t getNumLoadingWork() const;
-	[[nodiscard]] size_t getNumActiveThreads() const;
+	[[nodiscard]] size_t getNumLoadingWorkAsyncInProgress() const;
 	[[nodiscard]] size_t getNumLoadingWorkAsyncDestroy() const;
 
 private:
@@ -11,15 +11,58 @@
 
 #include "BassSound.h"
 
+#include <mutex>
 #include <utility>
 #include "BassSoundEngine.h"
 
 #include "BassManager.h"
 
+#include "AllocTracker.h"
 #include "ConVar.h"
 #include "Engine.h"
 #include "File.h"
 #include "ResourceManager.h"
+#include "SoundSampleCache.h"
+
+namespace
+{
+// maximum number of simultaneous playbacks of a sample, per sound using it
+constexpr DWORD MAX_SAMPLE_PLAYBACKS = 5;
+
+// owned by the SoundSampleCache and every BassSound using it
+struct SHARED_SAMPLE
+{
+	HSAMPLE sample;
+
+	explicit SHARED_SAMPLE(HSAMPLE sample) : sample(sample) {}
+	~SHARED_SAMPLE() { BASS_SampleFree(sample); }
+
+	SHARED_SAMPLE(const SHARED_SAMPLE &) = delete;
+	SHARED_SAMPLE &operator=(const SHARED_SAMPLE &) = delete;
+
+	// the channel limit grows with the number of users, so that (with BASS_SAMPLE_OVER_POS) sounds sharing a sample don't steal each other's channels
+	void addUser() { setNumUsers(+1); }
+	void removeUser() { setNumUsers(-1); }
+
+private:
+	void setNumUsers(int delta)
+	{
+		std::scoped_lock lock(mutex);
+
+		numUsers = std::max(numUsers + delta, 0);
+
+		BASS_SAMPLE info{};
+		if (!BASS_SampleGetInfo(sample, &info))
+			return;
+
+		info.max = static_cast<DWORD>(std::max(numUsers, 1)) * MAX_SAMPLE_PLAYBACKS;
+		BASS_SampleSetInfo(sample, &info);
+	}
+
+	std::mutex mutex;
+	int numUsers{0};
+};
+} // namespace
 
 BassSound::BassSound(UString filepath, bool stream, bool threeD, bool loop, bool prescan) : Sound(std::move(filepath), stream, threeD, loop, prescan)
 {
@@ -62,6 +105,7 @@ void BassSound::init()
 
 void BassSound::initAsync()
 {
+	ALLOC_TAG(AUDIO);
 	Sound::initAsync();
 	if (m_bIgnored)
 		return;
@@ -69,6 +113,9 @@ void BassSound::initAsync()
 	// create the sound
 	constexpr DWORD unicodeFlag = Env::cfg(OS::WINDOWS) ? BASS_UNICODE : 0;
 
+	// if the file has already been read into memory, create the stream/sample from there instead of hitting the disk again
+	m_prefetchedFile = soundEngine->getPrefetcher()->get(m_sFilePath);
+
 	if (m_bStream)
 	{
 		DWORD extraStreamCreateFileFlags = 0;
@@ -80,8 +127,12 @@ void BassSound::initAsync()
 			extraFXTempoCreateFlags |= BASS_STREAM_DECODE;
 		}
 
-		m_HSTREAM = BASS_StreamCreateFile(BASS_FILE_NAME, m_sFilePath.plat_str(), 0, 0,
-		                                  (m_bPrescan ? BASS_STREAM_PRESCAN : 0) | BASS_STREAM_DECODE | extraStreamCreateFileFlags | unicodeFlag);
+		if (m_prefetchedFile != nullptr) // (BASS_FILE_MEM doesn't copy, m_prefetchedFile keeps it alive until destroy())
+			m_HSTREAM = BASS_StreamCreateFile(BASS_FILE_MEM, m_prefetchedFile->data(), 0, m_prefetchedFile->size(),
+			                                  (m_bPrescan ? BASS_STREAM_PRESCAN : 0) | BASS_STREAM_DECODE | extraStreamCreateFileFlags);
+		else
+			m_HSTREAM = BASS_StreamCreateFile(BASS_FILE_NAME, m_sFilePath.plat_str(), 0, 0,
+			                                  (m_bPrescan ? BASS_STREAM_PRESCAN : 0) | BASS_STREAM_DECODE | extraStreamCreateFileFlags | unicodeFlag);
 
 		m_HSTREAM = BASS_FX_TempoCreate(m_HSTREAM, BASS_FX_TEMPO_ALGO_SHANNON | BASS_FX_FREESOURCE | extraFXTempoCreateFlags);
 
@@ -112,12 +163,48 @@ void BassSound::initAsync()
 		}
 		else
 		{
-			m_HSTREAM =
-			    BASS_SampleLoad(FALSE, m_sFilePath.plat_str(), 0, 0, 5,
-			                    (m_bIsLooped ? BASS_SAMPLE_LOOP : 0) | (m_bIs3d ? BASS_SAMPLE_3D | BASS_SAMPLE_MONO : 0) | BASS_SAMPLE_OVER_POS | unicodeFlag);
+			const DWORD sampleFlags = (m_bIsLooped ? BASS_SAMPLE_LOOP : 0) | (m_bIs3d ? BASS_SAMPLE_3D | BASS_SAMPLE_MONO : 0) | BASS_SAMPLE_OVER_POS;
+
+			// the file contents are the key for the sample cache, so read it ourselves
+			std::vector<char> fileBuffer;
+			if (m_prefetchedFile == nullptr)
+			{
+				McFile file(m_sFilePath);
+				if (file.canRead() && file.getFileSize() > 0)
+					fileBuffer = file.takeFileBuffer();
+			}
+			const char *fileData = (m_prefetchedFile != nullptr ? m_prefetchedFile->data() : fileBuffer.data());
+			const size_t fileSize = (m_prefetchedFile != nullptr ? m_prefetchedFile->size() : fileBuffer.size());
+
+			if (fileSize > 0)
+			{
+				const SoundSampleCache::KEY key = SoundSampleCache::makeKey(fileData, fileSize, sampleFlags);
+
+				m_sharedSample = soundEngine->getSampleCache()->get(key);
+				if (m_sharedSample == nullptr)
+				{
+					const HSAMPLE sample = BASS_SampleLoad(TRUE, fileData, 0, static_cast<DWORD>(fileSize), MAX_SAMPLE_PLAYBACKS, sampleFlags);
+					if (sample != 0)
+					{
+						BASS_SAMPLE info{};
+						BASS_SampleGetInfo(sample, &info);
+						m_sharedSample = soundEngine->getSampleCache()->insert(key, std::make_shared<SHARED_SAMPLE>(sample), info.length);
+					}
+				}
+
+				if (m_sharedSample != nullptr)
+				{
+					auto *sharedSample = static_cast<SHARED_SAMPLE *>(m_sharedSample.get());
+					sharedSample->addUser();
+					m_HSTREAM = sharedSample->sample;
+				}
+			}
+			else
+				m_HSTREAM = BASS_SampleLoad(FALSE, m_sFilePath.plat_str(), 0, 0, MAX_SAMPLE_PLAYBACKS, sampleFlags | unicodeFlag);
 		}
 
 		m_HSTREAMBACKUP = m_HSTREAM; // needed for proper cleanup for FX HSAMPLES
+		m_prefetchedFile.reset(); // (samples are decoded into their own memory)
 
 		if (m_HSTREAM == 0)
 		{
@@ -152,7 +239,7 @@ void BassSound::destroy()
 	{
 		if (m_HCHANNEL)
 			BASS_ChannelStop(m_HCHANNEL);
-		if (m_HSTREAMBACKUP)
+		if (m_HSTREAMBACKUP && m_sharedSample == nullptr)
 			BASS_SampleFree(m_HSTREAMBACKUP);
 
 		if constexpr (Env::cfg(AUD::WASAPI))
@@ -176,6 +263,13 @@ void BassSound::destroy()
 	m_HSTREAMBACKUP = 0;
 	m_HCHANNEL = 0;
 	m_bIgnored = false;
+
+	m_prefetchedFile.reset();
+	if (m_sharedSample != nullptr)
+	{
+		static_cast<SHARED_SAMPLE *>(m_sharedSample.get())->removeUser();
+		soundEngine->getSampleCache()->release(m_sharedSample);
+	}
 }
 
 SOUNDHANDLE BassSound::getHandle()
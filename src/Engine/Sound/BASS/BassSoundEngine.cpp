@@ -14,6 +14,7 @@
 #include "ConVar.h"
 #include "Engine.h"
 #include "Environment.h"
+#include "ResourceManager.h"
 
 #include <utility>
 
@@ -124,6 +125,7 @@ BassSoundEngine::BassSoundEngine()
 
 BassSoundEngine::~BassSoundEngine()
 {
+	m_sampleCache.clear();
 	if (m_bReady)
 	{
 		BASS_Free();
@@ -435,8 +437,24 @@ bool BassSoundEngine::initializeOutputDevice(int id, bool force)
 	debugLog("SoundEngine: initializeOutputDevice( {}, fallback = {} ) ...\n", id, (int)cv::win_snd_fallback_dsound.getBool());
 
 	const bool canReinitInsteadOfFreeInit = (m_iCurrentOutputDevice == id) && m_iCurrentOutputDevice != -1 && id != -1;
+
+	// samples don't survive BASS_Free(), so the sounds using them have to let go of them first (and get reloaded afterwards),
+	// otherwise they would later free stale handles which may belong to new samples by then
+	std::vector<Resource *> samplesToReload;
 	if (!canReinitInsteadOfFreeInit)
+	{
+		for (Sound *sound : resourceManager->getSounds())
+		{
+			if (!sound->isStream() && sound->isReady())
+			{
+				sound->release();
+				samplesToReload.push_back(sound);
+			}
+		}
+
+		m_sampleCache.clear(); // (frees all samples)
 		BASS_Free();
+	}
 
 	m_iCurrentOutputDevice = id;
 
@@ -456,6 +474,9 @@ bool BassSoundEngine::initializeOutputDevice(int id, bool force)
 
 	m_bReady = true;
 
+	if (!samplesToReload.empty())
+		resourceManager->reloadResources(samplesToReload);
+
 	// update current device name
 	for (const auto &device : m_outputDevices)
 	{
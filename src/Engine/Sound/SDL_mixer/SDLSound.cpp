@@ -10,6 +10,7 @@
 
 #if defined(MCENGINE_FEATURE_SDL_MIXER)
 
+#include "AllocTracker.h"
 #include "ConVar.h"
 #include "Engine.h"
 #include "File.h"
@@ -41,6 +42,7 @@ void SDLSound::init()
 
 void SDLSound::initAsync()
 {
+	ALLOC_TAG(AUDIO);
 	Sound::initAsync();
 	if (m_bIgnored)
 		return;
@@ -19,10 +19,12 @@
 #include "SoLoudFX.h"
 #include "SoLoudSoundEngine.h"
 
+#include "AllocTracker.h"
 #include "ConVar.h"
 #include "Engine.h"
 #include "File.h"
 #include "ResourceManager.h"
+#include "SoundSampleCache.h"
 
 namespace cv
 {
@@ -48,6 +50,7 @@ SoLoudSound::~SoLoudSound()
 
 void SoLoudSound::initAsync()
 {
+	ALLOC_TAG(AUDIO);
 	Sound::initAsync();
 	if (m_bIgnored)
 		return;
@@ -57,18 +60,28 @@ void SoLoudSound::initAsync()
 	{
 		if (m_bStream)
 			delete static_cast<SoLoud::SLFXStream *>(m_audioSource);
-		else
+		else if (m_sharedSample == nullptr)
 			delete static_cast<SoLoud::Wav *>(m_audioSource);
 
 		m_audioSource = nullptr;
 	}
+	soundEngine->getSampleCache()->release(m_sharedSample);
 
-	// load file into memory first to handle unicode paths properly (windows shenanigans)
+	// load file into memory first to handle unicode paths properly (windows shenanigans), samples also need it for the sample cache key
 	std::vector<char> fileBuffer;
 	const char *fileData{nullptr};
 	size_t fileSize{0};
 
-	if constexpr (Env::cfg(OS::WINDOWS))
+	// or use the copy which has already been read into memory ahead of time, if there is one (kept alive by m_prefetchedFile until destroy())
+	m_prefetchedFile = soundEngine->getPrefetcher()->get(m_sFilePath);
+	const bool loadFromMemory = (m_prefetchedFile != nullptr || Env::cfg(OS::WINDOWS) || !m_bStream);
+
+	if (m_prefetchedFile != nullptr)
+	{
+		fileData = m_prefetchedFile->data();
+		fileSize = m_prefetchedFile->size();
+	}
+	else if (loadFromMemory)
 	{
 		McFile file(m_sFilePath);
 
@@ -102,9 +115,9 @@ void SoLoudSound::initAsync()
 		// use SLFXStream for streaming audio (music, etc.) includes rate/pitch processing like BASS_FX_TempoCreate
 		auto *stream = new SoLoud::SLFXStream(cv::snd_soloud_prefer_ffmpeg.getInt() > 0);
 
-		// use loadToMem for streaming to handle unicode paths on windows
-		if constexpr (Env::cfg(OS::WINDOWS))
-			result = stream->loadMem(reinterpret_cast<const unsigned char *>(fileData), fileSize, true, false);
+		// use loadToMem for streaming to handle unicode paths on windows (prefetched files don't need to be copied)
+		if (loadFromMemory)
+			result = stream->loadMem(reinterpret_cast<const unsigned char *>(fileData), fileSize, m_prefetchedFile == nullptr, false);
 		else
 			result = stream->load(m_sFilePath.toUtf8());
 
@@ -128,33 +141,43 @@ void SoLoudSound::initAsync()
 	}
 	else
 	{
-		// use Wav for non-streaming audio (hit sounds, effects, etc.)
-		auto *wav = new SoLoud::Wav(cv::snd_soloud_prefer_ffmpeg.getInt() > 1);
+		// use Wav for non-streaming audio (hit sounds, effects, etc.), shared with all other sounds loading the same file
+		const bool preferFFmpeg = cv::snd_soloud_prefer_ffmpeg.getInt() > 1;
+		const SoundSampleCache::KEY key =
+		    SoundSampleCache::makeKey(fileData, fileSize, (m_bIs3d ? 2 : 0) | (preferFFmpeg ? 4 : 0)); // (3d attenuation is set on the source)
 
-		if constexpr (Env::cfg(OS::WINDOWS))
+		m_sharedSample = soundEngine->getSampleCache()->get(key);
+		if (m_sharedSample == nullptr)
+		{
+			auto wav = std::make_shared<SoLoud::Wav>(preferFFmpeg);
 			result = wav->loadMem(reinterpret_cast<const unsigned char *>(fileData), fileSize, true, false);
-		else
-			result = wav->load(m_sFilePath.toUtf8());
 
-		if (result == SoLoud::SO_NO_ERROR)
-		{
-			m_audioSource = wav;
-			m_fFrequency = wav->mBaseSamplerate;
+			if (result != SoLoud::SO_NO_ERROR)
+			{
+				debugLog("Sound Error: SoLoud::Wav::load() error {} on file {:s}\n", result, m_sFilePath.toUtf8());
+				m_prefetchedFile.reset();
+				return;
+			}
 
-			m_audioSource->setInaudibleBehavior(true, true); // keep ticking the sound if it goes to 0 volume, but do kill it if necessary
-		}
-		else
-		{
-			delete wav;
-			debugLog("Sound Error: SoLoud::Wav::load() error {} on file {:s}\n", result, m_sFilePath.toUtf8());
-			return;
+			wav->setInaudibleBehavior(true, true); // keep ticking the sound if it goes to 0 volume, but do kill it if necessary
+
+			const size_t numDecodedBytes = static_cast<size_t>(wav->mSampleCount) * wav->mChannels * sizeof(float);
+			m_sharedSample = soundEngine->getSampleCache()->insert(key, std::move(wav), numDecodedBytes);
 		}
+
+		m_prefetchedFile.reset(); // (fully decoded by now)
+
+		m_audioSource = static_cast<SoLoud::Wav *>(m_sharedSample.get());
+		m_fFrequency = m_audioSource->mBaseSamplerate;
 	}
 
 	// only play one music track at a time, allow non-music sounds to have multiple instances playing at a time by default
-	m_audioSource->setSingleInstance(m_bStream);
-
-	m_audioSource->setLooping(m_bIsLooped);
+	// samples may be shared with other sounds, so their looping/overlayability is applied per voice instead (see SoLoudSoundEngine::playSound())
+	if (m_bStream)
+	{
+		m_audioSource->setSingleInstance(true);
+		m_audioSource->setLooping(m_bIsLooped);
+	}
 
 	// configure 3D audio (need to test if this works)
 	if (m_bIs3d)
@@ -190,11 +213,13 @@ void SoLoudSound::destroy()
 	{
 		if (m_bStream)
 			delete static_cast<SoLoud::SLFXStream *>(m_audioSource);
-		else
+		else if (m_sharedSample == nullptr)
 			delete static_cast<SoLoud::Wav *>(m_audioSource);
 
 		m_audioSource = nullptr;
 	}
+	soundEngine->getSampleCache()->release(m_sharedSample);
+	m_prefetchedFile.reset();
 
 	m_fFrequency = 44100.0f;
 	m_fPitch = 1.0f;
@@ -377,8 +402,9 @@ void SoLoudSound::setLoop(bool loop)
 
 	m_bIsLooped = loop;
 
-	// apply to the source
-	m_audioSource->setLooping(loop);
+	// apply to the source (only if it's our own, see initAsync())
+	if (m_bStream)
+		m_audioSource->setLooping(loop);
 
 	// apply to the active voice
 	if (m_handle != 0)
@@ -388,7 +414,9 @@ void SoLoudSound::setLoop(bool loop)
 void SoLoudSound::setOverlayable(bool overlayable)
 {
 	m_bIsOverlayable = overlayable;
-	if (m_audioSource)
+
+	// (non-overlayable samples are stopped by SoLoudSoundEngine::playSound() instead, the source may be shared)
+	if (m_audioSource && m_bStream)
 		m_audioSource->setSingleInstance(!overlayable);
 }
 
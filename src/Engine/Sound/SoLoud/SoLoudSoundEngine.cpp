@@ -68,6 +68,7 @@ SoLoudSoundEngine::SoLoudSoundEngine()
 
 SoLoudSoundEngine::~SoLoudSoundEngine()
 {
+	m_sampleCache.clear(); // (cached sources still reference the soloud instance)
 	if (m_bReady && soloud)
 		soloud->deinit();
 	soloud.reset();
@@ -194,6 +195,9 @@ bool SoLoudSoundEngine::playSound(SoLoudSound *soloudSound, float pan, float pit
 		// store the handle and mark playback time
 		soloudSound->m_handle = handle;
 
+		if (!soloudSound->m_bStream && soloudSound->isLooped())
+			soloud->setLooping(handle, true); // (samples don't carry the flag on their source)
+
 		if (restorePos != 0.0)
 			soloud->seek(handle, restorePos); // restore the position to where we were pre-pause
 
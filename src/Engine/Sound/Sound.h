@@ -114,6 +114,12 @@ protected:
 
 	PlaybackInterpolator m_interpolator;
 
+	// whole file read ahead of time by the SoundPrefetcher (if it was), must outlive whatever stream reads from it
+	std::shared_ptr<const std::vector<char>> m_prefetchedFile;
+
+	// decoded sample from the SoundSampleCache (non-stream sounds only), possibly shared with other sounds, never freed directly
+	std::shared_ptr<void> m_sharedSample;
+
 private:
 	static bool isValidAudioFile(const std::string& filePath, const std::string &fileExt);
 };
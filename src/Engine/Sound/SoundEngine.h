@@ -11,6 +11,8 @@
 
 #include "cbase.h"
 #include "MultiCastDelegate.h"
+#include "SoundPrefetcher.h"
+#include "SoundSampleCache.h"
 
 #define SOUND_ENGINE_TYPE(ClassName, TypeID, ParentClass) \
 	static constexpr TypeId TYPE_ID = TypeID; \
@@ -67,6 +69,9 @@ public:
 	[[nodiscard]] inline bool shouldDetectBPM() const { return m_bBPMDetectEnabled; }
 	inline void setBPMDetection(bool enabled) { m_bBPMDetectEnabled = enabled; }
 
+	[[nodiscard]] inline SoundPrefetcher *getPrefetcher() { return &m_prefetcher; }
+	[[nodiscard]] inline SoundSampleCache *getSampleCache() { return &m_sampleCache; }
+
 	[[nodiscard]] inline const UString &getOutputDevice() const { return m_sCurrentOutputDevice; }
 	[[nodiscard]] inline float getVolume() const { return m_fVolume; }
 
@@ -104,6 +109,9 @@ protected:
 	float m_fVolume{1.0f};
 
 	bool m_bBPMDetectEnabled{false};
+
+	SoundPrefetcher m_prefetcher;
+	SoundSampleCache m_sampleCache; // backends must clear() it before their samples become invalid
 };
 
 // convenience conversion macro to get the sound handle, extra args are any extra conditions to check for besides general state validity
@@ -0,0 +1,180 @@
+//================ Copyright (c) 2025, WH, All rights reserved. =================//
+//
+// Purpose:		reads audio files into memory ahead of time
+//
+// $NoKeywords: $sndprefetch
+//===============================================================================//
+
+#include "SoundPrefetcher.h"
+
+#include "AllocTracker.h"
+#include "ConVar.h"
+#include "Engine.h"
+#include "File.h"
+#include "Profiler.h"
+#include "SoundEngine.h"
+#include "Thread.h"
+
+namespace cv
+{
+ConVar snd_prefetch("snd_prefetch", true, FCVAR_NONE, "read audio files which are likely to be played soon (e.g. neighbouring song browser entries) into memory in the background");
+ConVar snd_prefetch_cache_size_mb("snd_prefetch_cache_size_mb", 64, FCVAR_NONE, "maximum amount of memory used by snd_prefetch, in megabytes");
+ConVar snd_prefetch_stats("snd_prefetch_stats", FCVAR_NONE, "print the hit rate of snd_prefetch", []() -> void {
+	const SoundPrefetcher::STATS stats = soundEngine->getPrefetcher()->getStats();
+	const uint64_t numRequestedLoads = stats.numHits + stats.numMisses;
+	debugLog("SoundPrefetcher: {:d} hits / {:d} loads of requested files ({:.1f}%), {:d} other loads, {:d} files cached ({:.2f} MB)\n", stats.numHits,
+	         numRequestedLoads, numRequestedLoads > 0 ? 100.0 * static_cast<double>(stats.numHits) / static_cast<double>(numRequestedLoads) : 0.0,
+	         stats.numUnrequested, stats.numCachedFiles, static_cast<double>(stats.numCachedBytes) / (1024.0 * 1024.0));
+});
+} // namespace cv
+
+namespace
+{
+size_t getMaxCacheBytes()
+{
+	return static_cast<size_t>(std::max(cv::snd_prefetch_cache_size_mb.getInt(), 0)) * 1024 * 1024;
+}
+} // namespace
+
+SoundPrefetcher::SoundPrefetcher()
+{
+	m_thread = NULL; // only started on the first prefetch()
+
+	m_iCachedBytes = 0;
+	m_iUseCounter = 0;
+
+	m_iNumHits = 0;
+	m_iNumMisses = 0;
+	m_iNumUnrequested = 0;
+}
+
+SoundPrefetcher::~SoundPrefetcher()
+{
+	// (McThread requests stop and joins, which also wakes up the condition variable wait)
+	SAFE_DELETE(m_thread);
+}
+
+void SoundPrefetcher::prefetch(const std::vector<UString> &filePaths)
+{
+	if (!cv::snd_prefetch.getBool())
+		return;
+
+	{
+		std::scoped_lock lock(m_mutex);
+
+		m_requests.clear();
+		m_wantedFilePaths = filePaths;
+
+		// the first path gets the most recent use, so it's evicted last
+		const uint64_t base = m_iUseCounter + filePaths.size();
+		m_iUseCounter = base;
+
+		for (size_t i = 0; i < filePaths.size(); i++)
+		{
+			const uint64_t lastUse = base - i;
+
+			auto it = std::ranges::find_if(m_cache, [&](const ENTRY &entry) { return entry.filePath == filePaths[i]; });
+			if (it != m_cache.end())
+				it->lastUse = lastUse;
+			else
+				m_requests.push_back(REQUEST{.filePath = filePaths[i], .lastUse = lastUse});
+		}
+	}
+
+	if (m_thread == NULL)
+		m_thread = new McThread([this](const std::stop_token &stopToken) { threadFunc(stopToken); });
+	else
+		m_requestCond.notify_one();
+}
+
+SoundPrefetcher::FILEDATA SoundPrefetcher::get(const UString &filePath)
+{
+	if (!cv::snd_prefetch.getBool())
+		return nullptr;
+
+	std::scoped_lock lock(m_mutex);
+
+	auto it = std::ranges::find_if(m_cache, [&](const ENTRY &entry) { return entry.filePath == filePath; });
+	if (it == m_cache.end())
+	{
+		// only count misses which prefetching could have avoided
+		if (std::ranges::find(m_wantedFilePaths, filePath) != m_wantedFilePaths.end())
+			m_iNumMisses++;
+		else
+			m_iNumUnrequested++;
+
+		return nullptr;
+	}
+
+	m_iNumHits++;
+	it->lastUse = ++m_iUseCounter;
+
+	if (cv::debug_snd.getBool())
+		debugLog("SoundPrefetcher: Using prefetched {:s}\n", filePath);
+
+	return it->data;
+}
+
+SoundPrefetcher::STATS SoundPrefetcher::getStats()
+{
+	std::scoped_lock lock(m_mutex);
+	return STATS{.numHits = m_iNumHits, .numMisses = m_iNumMisses, .numUnrequested = m_iNumUnrequested, .numCachedFiles = m_cache.size(), .numCachedBytes = m_iCachedBytes};
+}
+
+void SoundPrefetcher::threadFunc(const std::stop_token &stopToken)
+{
+	VPROF_THREAD_NAME("SoundPrefetcher");
+	ALLOC_TAG(AUDIO);
+
+	while (!stopToken.stop_requested())
+	{
+		REQUEST request;
+		{
+			std::unique_lock lock(m_mutex);
+			if (!m_requestCond.wait(lock, stopToken, [this] { return !m_requests.empty(); }))
+				break; // stop requested
+
+			request = std::move(m_requests.front());
+			m_requests.pop_front();
+
+			if (std::ranges::any_of(m_cache, [&](const ENTRY &entry) { return entry.filePath == request.filePath; }))
+				continue;
+		}
+
+		// read the whole file (outside of the lock, this is the slow part)
+		std::vector<char> fileBuffer;
+		{
+			VPROF_TRACE("SoundPrefetcher::readFile");
+			McFile file(request.filePath);
+			if (!file.canRead() || file.getFileSize() < 1 || file.getFileSize() > getMaxCacheBytes())
+				continue;
+
+			fileBuffer = file.takeFileBuffer();
+			if (fileBuffer.empty())
+				continue;
+		}
+
+		if (cv::debug_snd.getBool())
+			debugLog("SoundPrefetcher: Prefetched {:s} ({:d} bytes)\n", request.filePath, fileBuffer.size());
+
+		std::scoped_lock lock(m_mutex);
+
+		m_iCachedBytes += fileBuffer.size();
+		m_cache.push_back(ENTRY{.filePath = std::move(request.filePath),
+		                        .data = std::make_shared<const std::vector<char>>(std::move(fileBuffer)),
+		                        .lastUse = request.lastUse});
+
+		evict(getMaxCacheBytes());
+	}
+}
+
+void SoundPrefetcher::evict(size_t maxBytes)
+{
+	while (m_iCachedBytes > maxBytes && !m_cache.empty())
+	{
+		auto leastRecentlyUsed = std::ranges::min_element(m_cache, {}, &ENTRY::lastUse);
+
+		m_iCachedBytes -= leastRecentlyUsed->data->size();
+		m_cache.erase(leastRecentlyUsed);
+	}
+}
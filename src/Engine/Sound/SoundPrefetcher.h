@@ -0,0 +1,88 @@
+//================ Copyright (c) 2025, WH, All rights reserved. =================//
+//
+// Purpose:		reads audio files into memory ahead of time
+//
+// $NoKeywords: $sndprefetch
+//===============================================================================//
+
+#pragma once
+#ifndef SOUNDPREFETCHER_H
+#define SOUNDPREFETCHER_H
+
+#include "cbase.h"
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+
+class McThread;
+
+// Reads whole audio files into a small byte-bounded cache on a background thread.
+// The sound backends check the cache in initAsync() and create their stream/sample from memory on a hit,
+// so e.g. song browser selection changes don't have to wait for the disk.
+class SoundPrefetcher final
+{
+public:
+	using FILEDATA = std::shared_ptr<const std::vector<char>>;
+
+	struct STATS
+	{
+		uint64_t numHits;
+		uint64_t numMisses; // requested files which weren't read yet (or already evicted again)
+		uint64_t numUnrequested; // loads of files which were never requested, these can't hit
+		size_t numCachedFiles;
+		size_t numCachedBytes;
+	};
+
+public:
+	SoundPrefetcher();
+	~SoundPrefetcher();
+
+	SoundPrefetcher &operator=(const SoundPrefetcher &) = delete;
+	SoundPrefetcher &operator=(SoundPrefetcher &&) = delete;
+	SoundPrefetcher(const SoundPrefetcher &) = delete;
+	SoundPrefetcher(SoundPrefetcher &&) = delete;
+
+	// replaces all pending requests, most wanted first (already cached files are kept, the least wanted ones get evicted first)
+	void prefetch(const std::vector<UString> &filePaths);
+
+	// complete file contents if cached, nullptr otherwise
+	// thread safe, the data stays valid for as long as it's referenced (even if it gets evicted in the meantime)
+	[[nodiscard]] FILEDATA get(const UString &filePath);
+
+	[[nodiscard]] STATS getStats();
+
+private:
+	struct ENTRY
+	{
+		UString filePath;
+		FILEDATA data;
+		uint64_t lastUse;
+	};
+
+	struct REQUEST
+	{
+		UString filePath;
+		uint64_t lastUse; // what the entry will start out with, so that more wanted files survive eviction longer
+	};
+
+	void threadFunc(const std::stop_token &stopToken);
+	void evict(size_t maxBytes); // (m_mutex must be held)
+
+	McThread *m_thread;
+
+	std::mutex m_mutex;
+	std::condition_variable_any m_requestCond;
+	std::deque<REQUEST> m_requests;
+	std::vector<UString> m_wantedFilePaths; // of the last prefetch() call
+
+	std::vector<ENTRY> m_cache;
+	size_t m_iCachedBytes;
+	uint64_t m_iUseCounter;
+
+	uint64_t m_iNumHits;
+	uint64_t m_iNumMisses;
+	uint64_t m_iNumUnrequested;
+};
+
+#endif
@@ -0,0 +1,164 @@
+//================ Copyright (c) 2025, WH, All rights reserved. =================//
+//
+// Purpose:		shares decoded (non-stream) samples between sounds with identical files
+//
+// $NoKeywords: $sndsamplecache
+//===============================================================================//
+
+#include "SoundSampleCache.h"
+
+#include "ConVar.h"
+#include "Engine.h"
+#include "MD5.h"
+#include "SoundEngine.h"
+
+#include <cstring>
+#include <limits>
+
+namespace cv
+{
+ConVar snd_sample_cache("snd_sample_cache", true, FCVAR_NONE, "share decoded samples (hitsounds etc.) between sounds with identical files, and keep unused ones around for skin switches/reloads");
+ConVar snd_sample_cache_size_mb("snd_sample_cache_size_mb", 32, FCVAR_NONE, "maximum amount of memory used by decoded samples which aren't used by any sound anymore, in megabytes");
+ConVar snd_sample_cache_stats("snd_sample_cache_stats", FCVAR_NONE, "print the hit rate of snd_sample_cache", []() -> void {
+	const SoundSampleCache::STATS stats = soundEngine->getSampleCache()->getStats();
+	const uint64_t numRepeatedLoads = stats.numHits + stats.numMisses;
+	debugLog("SoundSampleCache: {:d} hits / {:d} repeated loads ({:.1f}%), {:d} first loads, {:d} samples cached ({:d} unused, {:.2f} MB)\n", stats.numHits,
+	         numRepeatedLoads, numRepeatedLoads > 0 ? 100.0 * static_cast<double>(stats.numHits) / static_cast<double>(numRepeatedLoads) : 0.0,
+	         stats.numFirstLoads, stats.numEntries, stats.numUnusedEntries, static_cast<double>(stats.numCachedBytes) / (1024.0 * 1024.0));
+});
+} // namespace cv
+
+SoundSampleCache::SoundSampleCache()
+{
+	m_iCachedBytes = 0;
+	m_iUseCounter = 0;
+
+	m_iNumHits = 0;
+	m_iNumMisses = 0;
+	m_iNumFirstLoads = 0;
+}
+
+SoundSampleCache::KEY SoundSampleCache::makeKey(const char *fileData, size_t fileSize, uint32_t flags)
+{
+	MD5 md5;
+	for (size_t offset = 0; offset < fileSize; offset += std::numeric_limits<MD5::size_type>::max())
+	{
+		md5.update(fileData + offset, static_cast<MD5::size_type>(std::min<size_t>(fileSize - offset, std::numeric_limits<MD5::size_type>::max())));
+	}
+	md5.finalize();
+
+	KEY key{.fileSize = fileSize, .md5 = {}, .flags = flags};
+	std::memcpy(key.md5.data(), md5.getDigest(), key.md5.size());
+	return key;
+}
+
+SoundSampleCache::SAMPLE SoundSampleCache::get(const KEY &key)
+{
+	if (!cv::snd_sample_cache.getBool())
+		return nullptr;
+
+	std::scoped_lock lock(m_mutex);
+
+	const auto it = m_cache.find(key);
+	if (it == m_cache.end())
+	{
+		// only count misses which the cache could have avoided
+		if (m_everCachedKeys.contains(key))
+			m_iNumMisses++;
+		else
+			m_iNumFirstLoads++;
+
+		return nullptr;
+	}
+
+	m_iNumHits++;
+	it->second.lastUse = ++m_iUseCounter;
+
+	return it->second.sample;
+}
+
+SoundSampleCache::SAMPLE SoundSampleCache::insert(const KEY &key, SAMPLE sample, size_t numDecodedBytes)
+{
+	if (!cv::snd_sample_cache.getBool() || sample == nullptr)
+		return sample;
+
+	std::scoped_lock lock(m_mutex);
+
+	// (the one we got is freed by the caller dropping it)
+	const auto it = m_cache.find(key);
+	if (it != m_cache.end())
+	{
+		it->second.lastUse = ++m_iUseCounter;
+		return it->second.sample;
+	}
+
+	m_cache.emplace(key, ENTRY{.sample = sample, .numDecodedBytes = numDecodedBytes, .lastUse = ++m_iUseCounter});
+	m_everCachedKeys.insert(key);
+	m_iCachedBytes += numDecodedBytes;
+
+	evict();
+
+	return sample;
+}
+
+void SoundSampleCache::release(SAMPLE &sample)
+{
+	if (sample == nullptr)
+		return;
+
+	std::scoped_lock lock(m_mutex);
+
+	sample.reset();
+	evict();
+}
+
+void SoundSampleCache::clear()
+{
+	std::scoped_lock lock(m_mutex);
+
+	m_cache.clear();
+	m_iCachedBytes = 0;
+}
+
+SoundSampleCache::STATS SoundSampleCache::getStats()
+{
+	std::scoped_lock lock(m_mutex);
+
+	STATS stats{.numHits = m_iNumHits, .numMisses = m_iNumMisses, .numFirstLoads = m_iNumFirstLoads, .numEntries = m_cache.size(), .numUnusedEntries = 0, .numCachedBytes = m_iCachedBytes};
+	for (const auto &[key, entry] : m_cache)
+	{
+		if (entry.sample.use_count() < 2)
+			stats.numUnusedEntries++;
+	}
+	return stats;
+}
+
+void SoundSampleCache::evict()
+{
+	const size_t maxBytes = static_cast<size_t>(std::max(cv::snd_sample_cache_size_mb.getInt(), 0)) * 1024 * 1024;
+
+	// samples still in use can't be freed anyway, so only the unused ones count towards the budget
+	// (use_count() can only drop concurrently, since new references are only handed out under m_mutex)
+	size_t unusedBytes = 0;
+	for (const auto &[key, entry] : m_cache)
+	{
+		if (entry.sample.use_count() < 2)
+			unusedBytes += entry.numDecodedBytes;
+	}
+
+	while (unusedBytes > maxBytes)
+	{
+		auto leastRecentlyUsed = m_cache.end();
+		for (auto it = m_cache.begin(); it != m_cache.end(); ++it)
+		{
+			if (it->second.sample.use_count() < 2 && (leastRecentlyUsed == m_cache.end() || it->second.lastUse < leastRecentlyUsed->second.lastUse))
+				leastRecentlyUsed = it;
+		}
+		if (leastRecentlyUsed == m_cache.end())
+			break;
+
+		unusedBytes -= std::min(unusedBytes, leastRecentlyUsed->second.numDecodedBytes);
+		m_iCachedBytes -= leastRecentlyUsed->second.numDecodedBytes;
+		m_cache.erase(leastRecentlyUsed);
+	}
+}
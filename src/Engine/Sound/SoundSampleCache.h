@@ -0,0 +1,107 @@
+//================ Copyright (c) 2025, WH, All rights reserved. =================//
+//
+// Purpose:		shares decoded (non-stream) samples between sounds with identical files
+//
+// $NoKeywords: $sndsamplecache
+//===============================================================================//
+
+#pragma once
+#ifndef SOUNDSAMPLECACHE_H
+#define SOUNDSAMPLECACHE_H
+
+#include "cbase.h"
+
+#include <array>
+#include <cstring>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+
+// Decoded samples (BASS HSAMPLEs, SoLoud::Wavs) keyed by file contents + backend specific load flags.
+// Every sound loading the same bytes gets the same decoded sample, and samples which aren't used by any sound anymore
+// are kept around (within snd_sample_cache_size_mb) so that skin switches/reloads don't have to decode them again.
+// The backend owns what's inside a SAMPLE, the cache only keeps references to it.
+class SoundSampleCache final
+{
+public:
+	using SAMPLE = std::shared_ptr<void>;
+
+	struct KEY
+	{
+		size_t fileSize;
+		std::array<unsigned char, 16> md5;
+		uint32_t flags; // backend specific, anything which changes the decoded sample
+
+		bool operator==(const KEY &) const = default;
+	};
+
+	struct STATS
+	{
+		uint64_t numHits;
+		uint64_t numMisses; // samples which had been cached before, but were evicted/cleared in the meantime
+		uint64_t numFirstLoads; // these can't hit
+		size_t numEntries;
+		size_t numUnusedEntries;
+		size_t numCachedBytes;
+	};
+
+public:
+	SoundSampleCache();
+	~SoundSampleCache() = default;
+
+	SoundSampleCache &operator=(const SoundSampleCache &) = delete;
+	SoundSampleCache &operator=(SoundSampleCache &&) = delete;
+	SoundSampleCache(const SoundSampleCache &) = delete;
+	SoundSampleCache(SoundSampleCache &&) = delete;
+
+	[[nodiscard]] static KEY makeKey(const char *fileData, size_t fileSize, uint32_t flags);
+
+	// everything below is thread safe
+
+	// decoded sample if cached, nullptr otherwise
+	[[nodiscard]] SAMPLE get(const KEY &key);
+
+	// returns the sample to use, which is the already cached one if someone else was faster at decoding the same file
+	SAMPLE insert(const KEY &key, SAMPLE sample, size_t numDecodedBytes);
+
+	// drops a sound's reference to its sample, evicting unused samples if that puts them over the budget
+	void release(SAMPLE &sample);
+
+	// drops all unused samples, and forgets about the used ones (they are freed by their last user)
+	// must be called by the backend before its samples become invalid (shutdown, device changes)
+	void clear();
+
+	[[nodiscard]] STATS getStats();
+
+private:
+	struct KEY_HASH
+	{
+		size_t operator()(const KEY &key) const noexcept
+		{
+			uint64_t md5Prefix;
+			std::memcpy(&md5Prefix, key.md5.data(), sizeof(md5Prefix));
+			return std::hash<uint64_t>{}(md5Prefix) ^ (key.fileSize << 1) ^ (static_cast<size_t>(key.flags) << 7);
+		}
+	};
+
+	struct ENTRY
+	{
+		SAMPLE sample;
+		size_t numDecodedBytes;
+		uint64_t lastUse;
+	};
+
+	void evict(); // only unused entries, least recently used first, down to snd_sample_cache_size_mb (m_mutex must be held)
+
+	std::mutex m_mutex;
+	std::unordered_map<KEY, ENTRY, KEY_HASH> m_cache;
+	std::unordered_set<KEY, KEY_HASH> m_everCachedKeys;
+	size_t m_iCachedBytes;
+	uint64_t m_iUseCounter;
+
+	uint64_t m_iNumHits;
+	uint64_t m_iNumMisses;
+	uint64_t m_iNumFirstLoads;
+};
+
+#endif
@@ -19,12 +19,14 @@ TextureAtlas::TextureAtlas(int width, int height) : Resource()
 
 	m_iPadding = 1;
 
+	// (kept in system memory, putAt() can also be used after loading)
 	resourceManager->requestNextLoadUnmanaged();
-	m_atlasImage = resourceManager->createImage(m_iWidth, m_iHeight);
+	m_atlasImage = resourceManager->createImage(m_iWidth, m_iHeight, false, true);
 
-	m_iCurX = m_iPadding;
-	m_iCurY = m_iPadding;
-	m_iMaxHeight = 0;
+	// start with a single segment covering the entire width
+	m_skylines = {
+	    {0, m_iPadding, m_iWidth}
+    };
 }
 
 void TextureAtlas::init()
@@ -44,6 +46,49 @@ void TextureAtlas::destroy()
 	SAFE_DELETE(m_atlasImage);
 }
 
+bool TextureAtlas::grow(int width, int height)
+{
+	if (m_atlasImage == nullptr || width < m_iWidth || height < m_iHeight)
+		return false;
+
+	resourceManager->requestNextLoadUnmanaged();
+	Image *newAtlasImage = resourceManager->createImage(width, height, false, true);
+
+	for (int y = 0; y < m_iHeight; y++)
+	{
+		for (int x = 0; x < m_iWidth; x++)
+		{
+			newAtlasImage->setPixel(x, y, m_atlasImage->getPixel(x, y));
+		}
+	}
+
+	if (m_bReady)
+		resourceManager->loadResource(newAtlasImage);
+
+	SAFE_DELETE(m_atlasImage);
+	m_atlasImage = newAtlasImage;
+
+	// the new area to the right is empty, the new area on top is just more room for the existing segments
+	if (width > m_iWidth)
+	{
+		if (m_skylines.back().y == m_iPadding)
+			m_skylines.back().width += width - m_iWidth;
+		else
+			m_skylines.push_back({m_iWidth, m_iPadding, width - m_iWidth});
+	}
+
+	m_iWidth = width;
+	m_iHeight = height;
+
+	return true;
+}
+
+void TextureAtlas::upload()
+{
+	if (m_bReady && m_atlasImage != nullptr)
+		m_atlasImage->load();
+}
+
 void TextureAtlas::putAt(int x, int y, int width, int height, bool flipHorizontal, bool flipVertical, Color *pixels)
 {
 	if (width < 1 || height < 1 || pixels == nullptr || m_atlasImage == nullptr)
@@ -132,10 +177,8 @@ bool TextureAtlas::packRects(std::vector<PackRect> &rects)
 	// sort rectangles by height (tallest first) for better packing efficiency
 	std::ranges::sort(rects, [](const PackRect &a, const PackRect &b) { return a.height > b.height; });
 
-	// initialize skyline - start with single segment covering entire width
-	std::vector<Skyline> skylines = {
-	    {0, m_iPadding, m_iWidth}
-    };
+	// only committed if everything fits
+	std::vector<Skyline> skylines = m_skylines;
 
 	for (auto &rect : rects)
 	{
@@ -229,6 +272,7 @@ bool TextureAtlas::packRects(std::vector<PackRect> &rects)
 		}
 	}
 
+	m_skylines = std::move(skylines);
 	return true;
 }
 
@@ -29,8 +29,15 @@ public:
 	void putAt(int x, int y, int width, int height, bool flipHorizontal, bool flipVertical, Color *pixels);
 
 	// advanced skyline packing for efficient atlas utilization
+	// the skyline persists, so later calls pack around everything placed before (nothing is placed if any rect doesn't fit)
 	bool packRects(std::vector<PackRect> &rects);
 
+	// enlarge the atlas, keeping all existing pixels and packed positions (only pixel coordinates stay valid, not normalized ones)
+	bool grow(int width, int height);
+
+	// re-upload the atlas image after putAt() calls on an already loaded atlas (do it once after a batch of them)
+	void upload();
+
 	// calculate optimal atlas size for given rectangles
 	static size_t calculateOptimalSize(
 	    const std::vector<PackRect> &rects, float targetOccupancy = 0.75f, int padding = 1, size_t minSize = 256, size_t maxSize = 4096);
@@ -65,10 +72,7 @@ private:
 
 	Image *m_atlasImage;
 
-	// legacy packing state
-	int m_iCurX;
-	int m_iCurY;
-	int m_iMaxHeight;
+	std::vector<Skyline> m_skylines;
 };
 
 #endif
@@ -110,6 +110,12 @@ inline void sleepNS(uint64_t ns) noexcept
 	!!ns ? sleepPrecise(ns) : detail::yield_internal();
 }
 
+// plain OS sleep (no spinning at the end like the ones above), so it oversleeps by up to the scheduler granularity
+inline void sleepNSCoarse(uint64_t ns) noexcept
+{
+	!!ns ? SDL_DelayNS(ns) : detail::yield_internal();
+}
+
 inline void sleepMS(uint64_t ms) noexcept
 {
 	!!ms ? sleepPrecise(ms * NS_PER_MS) : detail::yield_internal();
@@ -0,0 +1,258 @@
+//================ Copyright (c) 2025, WH, All rights reserved. =================//
+//
+// Purpose:		multi-threaded event recorder, exports chrome/perfetto traces
+//
+// $NoKeywords: $vproftrace
+//===============================================================================//
+
+#include "TraceProfiler.h"
+
+#include "ConVar.h"
+#include "Engine.h"
+#include "File.h"
+#include "Profiler.h"
+
+#include <ctime>
+#include <mutex>
+
+namespace
+{
+struct EVENT
+{
+	const char *name;
+	const char *group; // NULL for counters
+	uint64_t startNS;
+	union
+	{
+		uint64_t durationNS;
+		double value;
+	};
+};
+
+struct THREAD_BUFFER
+{
+	uint32_t tid;
+	std::string name;					// guarded by s_buffersMutex
+	std::unique_ptr<EVENT[]> events;	// MAX_EVENTS_PER_THREAD, allocated by the owning thread on its first event
+	std::atomic<uint64_t> numWritten;	// total, events[numWritten % MAX_EVENTS_PER_THREAD] is the next slot
+	std::atomic<bool> exited;
+};
+
+// buffers outlive their threads until the next capture begins, so that e.g. loader threads which timed out during a capture still show up
+std::mutex s_buffersMutex;
+std::vector<std::unique_ptr<THREAD_BUFFER>> s_buffers;
+uint32_t s_iNextThreadID = 1;
+
+struct THREAD_BUFFER_REF
+{
+	THREAD_BUFFER *buffer = NULL;
+
+	~THREAD_BUFFER_REF()
+	{
+		if (buffer != NULL)
+			buffer->exited.store(true);
+	}
+};
+
+thread_local THREAD_BUFFER_REF t_threadBuffer;
+
+THREAD_BUFFER *getThreadBuffer()
+{
+	// only the first call on every thread takes the lock
+	if (t_threadBuffer.buffer == NULL)
+	{
+		auto buffer = std::make_unique<THREAD_BUFFER>();
+		buffer->numWritten.store(0);
+		buffer->exited.store(false);
+
+		std::scoped_lock lock(s_buffersMutex);
+
+		// short-lived threads which never recorded anything would otherwise pile up until the next capture
+		std::erase_if(s_buffers, [](const std::unique_ptr<THREAD_BUFFER> &exitedBuffer) {
+			return exitedBuffer->exited.load() && exitedBuffer->numWritten.load(std::memory_order_acquire) == 0;
+		});
+
+		buffer->tid = s_iNextThreadID++;
+		t_threadBuffer.buffer = buffer.get();
+		s_buffers.push_back(std::move(buffer));
+	}
+
+	return t_threadBuffer.buffer;
+}
+
+void record(const EVENT &event)
+{
+	THREAD_BUFFER *buffer = getThreadBuffer();
+	if (!buffer->events)
+		buffer->events = std::make_unique<EVENT[]>(TraceProfiler::MAX_EVENTS_PER_THREAD);
+
+	// single writer, the release store publishes the event (and the events array on the first call) to the exporting thread
+	const uint64_t numWritten = buffer->numWritten.load(std::memory_order_relaxed);
+	buffer->events[numWritten % TraceProfiler::MAX_EVENTS_PER_THREAD] = event;
+	buffer->numWritten.store(numWritten + 1, std::memory_order_release);
+}
+
+void appendEscaped(std::string &out, const char *string)
+{
+	for (const char *c = string; *c != '\0'; c++)
+	{
+		if (*c == '"' || *c == '\\')
+			out += '\\';
+		if (static_cast<unsigned char>(*c) >= 0x20)
+			out += *c;
+	}
+}
+} // namespace
+
+std::atomic<bool> TraceProfiler::s_bCapturing = false;
+uint64_t TraceProfiler::s_iCaptureStartNS = 0;
+uint64_t TraceProfiler::s_iCaptureEndNS = 0;
+
+void TraceProfiler::setThreadName(const char *name)
+{
+	THREAD_BUFFER *buffer = getThreadBuffer();
+
+	std::scoped_lock lock(s_buffersMutex);
+	buffer->name = name;
+}
+
+void TraceProfiler::beginCapture(double seconds)
+{
+	if (isCapturing())
+	{
+		debugLog("TraceProfiler: Already capturing\n");
+		return;
+	}
+
+	// forget threads which have exited since the last capture (nothing else can touch their buffers anymore)
+	{
+		std::scoped_lock lock(s_buffersMutex);
+		std::erase_if(s_buffers, [](const std::unique_ptr<THREAD_BUFFER> &buffer) { return buffer->exited.load(); });
+	}
+
+	s_iCaptureStartNS = Timing::getTicksNS();
+	s_iCaptureEndNS = s_iCaptureStartNS + static_cast<uint64_t>(std::max(seconds, 0.0) * (double)Timing::NS_PER_SECOND);
+	s_bCapturing.store(true);
+
+	debugLog("TraceProfiler: Capturing for {:.1f} seconds ...\n", seconds);
+}
+
+void TraceProfiler::update()
+{
+	if (isCapturing() && Timing::getTicksNS() >= s_iCaptureEndNS)
+		endCapture();
+}
+
+void TraceProfiler::recordScope(const char *name, const char *group, uint64_t startNS, uint64_t endNS)
+{
+	EVENT event{.name = name, .group = (group != NULL ? group : VPROF_BUDGETGROUP_ROOT), .startNS = startNS};
+	event.durationNS = endNS - startNS;
+	record(event);
+}
+
+void TraceProfiler::recordCounter(const char *name, double value)
+{
+	if (!isCapturing())
+		return;
+
+	EVENT event{.name = name, .group = NULL, .startNS = Timing::getTicksNS()};
+	event.value = value;
+	record(event);
+}
+
+void TraceProfiler::endCapture()
+{
+	s_bCapturing.store(false);
+	s_iCaptureEndNS = Timing::getTicksNS();
+
+	const auto toMicroseconds = [](uint64_t ns) -> double { return static_cast<double>(ns) / (double)Timing::NS_PER_US; };
+
+	std::string json = "{\"traceEvents\":[\n";
+	size_t numEvents = 0;
+	bool lostEvents = false;
+	{
+		std::scoped_lock lock(s_buffersMutex);
+
+		for (const std::unique_ptr<THREAD_BUFFER> &buffer : s_buffers)
+		{
+			json += fmt::format("{{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":{},\"args\":{{\"name\":\"", buffer->tid);
+			appendEscaped(json, buffer->name.empty() ? fmt::format("Thread {}", buffer->tid).c_str() : buffer->name.c_str());
+			json += "\"}},\n";
+
+			const uint64_t numWritten = buffer->numWritten.load(std::memory_order_acquire);
+			if (numWritten == 0)
+				continue;
+
+			// a thread which checked isCapturing() just before it was turned off may still be overwriting the oldest slot, skip that one
+			const uint64_t first = (numWritten > MAX_EVENTS_PER_THREAD ? numWritten - MAX_EVENTS_PER_THREAD + 1 : 0);
+			for (uint64_t i=first; i<numWritten; i++)
+			{
+				const EVENT &event = buffer->events[i % MAX_EVENTS_PER_THREAD];
+				if (event.startNS < s_iCaptureStartNS || event.startNS > s_iCaptureEndNS)
+					continue; // from a previous capture
+
+				if (i == first && first > 0)
+					lostEvents = true; // the ring buffer wrapped around during the capture
+
+				const double ts = toMicroseconds(event.startNS - s_iCaptureStartNS);
+				json += "{\"name\":\"";
+				appendEscaped(json, event.name);
+				if (event.group != NULL)
+				{
+					json += "\",\"cat\":\"";
+					appendEscaped(json, event.group);
+					json += fmt::format("\",\"ph\":\"X\",\"pid\":1,\"tid\":{},\"ts\":{:.3f},\"dur\":{:.3f}}},\n", buffer->tid, ts, toMicroseconds(event.durationNS));
+				}
+				else
+					json += fmt::format("\",\"ph\":\"C\",\"pid\":1,\"tid\":{},\"ts\":{:.3f},\"args\":{{\"value\":{}}}}},\n", buffer->tid, ts, event.value);
+
+				numEvents++;
+			}
+		}
+	}
+
+	// (the trailing comma of the last event isn't valid json, end with a dummy metadata event instead)
+	json += "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"args\":{\"name\":\"" PACKAGE_NAME "\"}}\n]}\n";
+
+	if (!env->directoryExists("traces") && !env->createDirectory("traces"))
+	{
+		debugLog("TraceProfiler Error: Couldn't create traces folder!\n");
+		return;
+	}
+
+	char dateString[64];
+	const std::time_t now = std::time(nullptr);
+	std::strftime(dateString, sizeof(dateString), "%Y-%m-%d_%H-%M-%S", std::localtime(&now));
+
+	const UString filePath = UString::format("traces/trace_%s.json", dateString);
+	McFile file(filePath, McFile::TYPE::WRITE);
+	if (!file.canWrite())
+	{
+		debugLog("TraceProfiler Error: Couldn't write {:s}\n", filePath);
+		return;
+	}
+	file.write(json.data(), json.size());
+
+	debugLog("TraceProfiler: Wrote {} events to {:s}{:s}\n", numEvents, filePath, lostEvents ? " (the oldest events were lost, increase MAX_EVENTS_PER_THREAD)" : "");
+}
+
+
+
+//*****************************//
+//	TraceProfiler ConCommands  //
+//*****************************//
+
+void _profile_capture(const UString &args)
+{
+	const float seconds = (args.length() > 0 ? args.toFloat() : 5.0f);
+	if (seconds <= 0.0f)
+	{
+		debugLog("Usage: profile_capture <seconds>\n");
+		return;
+	}
+
+	TraceProfiler::beginCapture(seconds);
+}
+namespace cv {
+ConVar profile_capture("profile_capture", FCVAR_NONE, "record all profiled scopes on all threads for the given number of seconds (default 5), and write them to traces/ (open with ui.perfetto.dev or chrome://tracing)", CFUNC(_profile_capture));
+}
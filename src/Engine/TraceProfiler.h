@@ -0,0 +1,71 @@
+//================ Copyright (c) 2025, WH, All rights reserved. =================//
+//
+// Purpose:		multi-threaded event recorder, exports chrome/perfetto traces
+//
+// $NoKeywords: $vproftrace
+//===============================================================================//
+
+#pragma once
+#ifndef TRACEPROFILER_H
+#define TRACEPROFILER_H
+
+#include "cbase.h"
+#include "Timing.h"
+
+#include <atomic>
+
+// Unlike the hierarchical VPROF profile (main thread only, aggregated per frame), this records every scope on every thread
+// as a timestamped event for a limited time, and writes the result as a Chrome trace JSON (ui.perfetto.dev, chrome://tracing).
+// Each thread records into its own ring buffer without taking any locks, the buffers are only merged when the capture is written.
+// If a thread records more than MAX_EVENTS_PER_THREAD events during a capture, its oldest events are lost.
+class TraceProfiler
+{
+public:
+	static constexpr size_t MAX_EVENTS_PER_THREAD = 1 << 16;
+
+	// shown instead of the numeric thread id in the trace, can be called at any time (also before/without a capture)
+	static void setThreadName(const char *name);
+
+	// starts a capture which is written to disk (by update()) once the given time has passed
+	static void beginCapture(double seconds);
+
+	// must be called once per frame on the main thread
+	static void update();
+
+	[[nodiscard]] static inline bool isCapturing() {return s_bCapturing.load(std::memory_order_relaxed);}
+
+	// NOTE: name strings are stored as pointers, they must outlive the capture (i.e. string literals)
+	static void recordScope(const char *name, const char *group, uint64_t startNS, uint64_t endNS);
+	static void recordCounter(const char *name, double value);
+
+private:
+	static void endCapture();
+
+	static std::atomic<bool> s_bCapturing;
+	static uint64_t s_iCaptureStartNS;
+	static uint64_t s_iCaptureEndNS;
+};
+
+class TraceProfilerScope
+{
+public:
+	inline TraceProfilerScope(const char *name, const char *group)
+	{
+		m_name = name;
+		m_group = group;
+		m_iStartNS = (TraceProfiler::isCapturing() ? Timing::getTicksNS() : 0);
+	}
+
+	inline ~TraceProfilerScope()
+	{
+		if (m_iStartNS != 0 && TraceProfiler::isCapturing())
+			TraceProfiler::recordScope(m_name, m_group, m_iStartNS, Timing::getTicksNS());
+	}
+
+private:
+	const char *m_name;
+	const char *m_group;
+	uint64_t m_iStartNS;
+};
+
+#endif
@@ -0,0 +1,105 @@
+//================ Copyright (c) 2025, WH, All rights reserved. =================//
+//
+// Purpose:		static bounding box tree for culling large element lists
+//
+// $NoKeywords: $buibvh
+//===============================================================================//
+
+#include "CBaseUIBoundsTree.h"
+
+#include <algorithm>
+#include <numeric>
+
+void CBaseUIBoundsTree::rebuild(const std::vector<McRect> &bounds)
+{
+	m_nodes.clear();
+	m_indices.resize(bounds.size());
+	std::iota(m_indices.begin(), m_indices.end(), 0);
+
+	if (bounds.size() > 0)
+	{
+		m_nodes.reserve((bounds.size() / MAX_LEAF_SIZE + 1) * 2);
+		build(bounds, 0, static_cast<uint32_t>(bounds.size()));
+	}
+
+	// leaf contents in tree order, for the exact tests
+	m_bounds.resize(bounds.size());
+	for (size_t i=0; i<m_indices.size(); i++)
+	{
+		m_bounds[i] = bounds[m_indices[i]];
+	}
+}
+
+void CBaseUIBoundsTree::clear()
+{
+	m_nodes.clear();
+	m_indices.clear();
+	m_bounds.clear();
+}
+
+uint32_t CBaseUIBoundsTree::build(const std::vector<McRect> &bounds, uint32_t begin, uint32_t end)
+{
+	McRect nodeBounds = bounds[m_indices[begin]];
+	for (uint32_t i=begin+1; i<end; i++)
+	{
+		nodeBounds = nodeBounds.Union(bounds[m_indices[i]]);
+	}
+
+	const uint32_t nodeIndex = static_cast<uint32_t>(m_nodes.size());
+	m_nodes.push_back(NODE{.bounds = nodeBounds, .first = begin, .count = end - begin});
+
+	if (end - begin <= MAX_LEAF_SIZE)
+		return nodeIndex;
+
+	// median split along the longer axis
+	const bool splitX = (nodeBounds.getWidth() > nodeBounds.getHeight());
+	const uint32_t mid = begin + (end - begin) / 2;
+	std::nth_element(m_indices.begin() + begin, m_indices.begin() + mid, m_indices.begin() + end, [&](uint32_t a, uint32_t b) {
+		return splitX ? bounds[a].getCenter().x < bounds[b].getCenter().x : bounds[a].getCenter().y < bounds[b].getCenter().y;
+	});
+
+	// the left child directly follows its parent
+	build(bounds, begin, mid);
+	const uint32_t right = build(bounds, mid, end);
+
+	m_nodes[nodeIndex].first = right;
+	m_nodes[nodeIndex].count = 0;
+
+	return nodeIndex;
+}
+
+void CBaseUIBoundsTree::query(const McRect &rect, std::vector<uint32_t> &out) const
+{
+	if (m_nodes.size() < 1) return;
+
+	const size_t firstResult = out.size();
+
+	// median splits keep the depth at log2(n / MAX_LEAF_SIZE), so this can never overflow
+	uint32_t stack[64];
+	int stackSize = 0;
+	stack[stackSize++] = 0;
+
+	while (stackSize > 0)
+	{
+		const uint32_t nodeIndex = stack[--stackSize];
+		const NODE &node = m_nodes[nodeIndex];
+		if (!rect.intersects(node.bounds))
+			continue;
+
+		if (node.count > 0)
+		{
+			for (uint32_t i=node.first; i<node.first+node.count; i++)
+			{
+				if (rect.intersects(m_bounds[i]))
+					out.push_back(m_indices[i]);
+			}
+		}
+		else
+		{
+			stack[stackSize++] = node.first;
+			stack[stackSize++] = nodeIndex + 1;
+		}
+	}
+
+	std::sort(out.begin() + firstResult, out.end());
+}
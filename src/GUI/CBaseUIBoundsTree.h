@@ -0,0 +1,44 @@
+//================ Copyright (c) 2025, WH, All rights reserved. =================//
+//
+// Purpose:		static bounding box tree for culling large element lists
+//
+// $NoKeywords: $buibvh
+//===============================================================================//
+
+#pragma once
+#ifndef CBASEUIBOUNDSTREE_H
+#define CBASEUIBOUNDSTREE_H
+
+#include "cbase.h"
+
+// Built once over a list of rectangles (indices are positions in that list), queried many times.
+// There is no incremental update, rebuild() it whenever any rectangle changes.
+class CBaseUIBoundsTree
+{
+public:
+	void rebuild(const std::vector<McRect> &bounds);
+	void clear();
+
+	// appends the indices of all rectangles intersecting rect to out, in ascending order
+	void query(const McRect &rect, std::vector<uint32_t> &out) const;
+
+	[[nodiscard]] inline size_t getNumBounds() const {return m_indices.size();}
+
+private:
+	static constexpr uint32_t MAX_LEAF_SIZE = 8;
+
+	struct NODE
+	{
+		McRect bounds;
+		uint32_t first;		// leaf: first index into m_indices, inner: index of the right child (the left one is the next node)
+		uint32_t count;		// leaf: number of indices, inner: 0
+	};
+
+	uint32_t build(const std::vector<McRect> &bounds, uint32_t begin, uint32_t end);
+
+	std::vector<NODE> m_nodes;
+	std::vector<uint32_t> m_indices;
+	std::vector<McRect> m_bounds;
+};
+
+#endif
@@ -12,6 +12,15 @@
 
 CBaseUIContainer::CBaseUIContainer(float Xpos, float Ypos, float Xsize, float Ysize, UString name) : CBaseUIElement(Xpos, Ypos, Xsize, Ysize, std::move(name))
 {
+	m_iActiveElementsBegin = 0;
+	m_iActiveElementsEnd = SIZE_MAX;
+	m_bActiveElementList = false;
+
+	m_iElementsRevision = 0;
+	m_iLayoutRevision = 0;
+
+	m_bParentOfElements = false;
+	m_bUpdatingPos = false;
 }
 
 CBaseUIContainer::~CBaseUIContainer()
@@ -26,11 +35,17 @@ void CBaseUIContainer::clear()
 		SAFE_DELETE(m_vElements[i]);
 	}
 	m_vElements = std::vector<CBaseUIElement*>();
+	onElementsChanged();
 }
 
 void CBaseUIContainer::empty()
 {
+	for (CBaseUIElement *element : m_vElements)
+	{
+		onElementRemoved(element);
+	}
 	m_vElements = std::vector<CBaseUIElement*>();
+	onElementsChanged();
 }
 
 CBaseUIContainer *CBaseUIContainer::addBaseUIElement(CBaseUIElement *element, float xPos, float yPos)
@@ -40,6 +55,7 @@ CBaseUIContainer *CBaseUIContainer::addBaseUIElement(CBaseUIElement *element, fl
 	element->setRelPos(xPos, yPos);
 	element->setPos(m_vPos + element->getRelPos());
 	m_vElements.push_back(element);
+	onElementAdded(element);
 
 	return this;
 }
@@ -51,6 +67,7 @@ CBaseUIContainer *CBaseUIContainer::addBaseUIElement(CBaseUIElement *element)
 	element->setRelPos(element->getPos().x, element->getPos().y);
 	element->setPos(m_vPos + element->getRelPos());
 	m_vElements.push_back(element);
+	onElementAdded(element);
 
 	return this;
 }
@@ -62,6 +79,7 @@ CBaseUIContainer *CBaseUIContainer::addBaseUIElementBack(CBaseUIElement *element
 	element->setRelPos(xPos, yPos);
 	element->setPos(m_vPos + element->getRelPos());
 	m_vElements.insert(m_vElements.begin(), element);
+	onElementAdded(element);
 
 	return this;
 }
@@ -74,6 +92,7 @@ CBaseUIContainer *CBaseUIContainer::addBaseUIElementBack(CBaseUIElement *element
 	element->setRelPos(element->getPos().x, element->getPos().y);
 	element->setPos(m_vPos + element->getRelPos());
 	m_vElements.insert(m_vElements.begin(), element);
+	onElementAdded(element);
 
 	return this;
 }
@@ -89,6 +108,7 @@ CBaseUIContainer *CBaseUIContainer::insertBaseUIElement(CBaseUIElement *element,
 		if (m_vElements[i] == index)
 		{
 			m_vElements.insert(m_vElements.begin() + std::clamp<int>(i, 0, m_vElements.size()), element);
+			onElementAdded(element);
 			return this;
 		}
 	}
@@ -109,6 +129,7 @@ CBaseUIContainer *CBaseUIContainer::insertBaseUIElementBack(CBaseUIElement *elem
 		if (m_vElements[i] == index)
 		{
 			m_vElements.insert(m_vElements.begin() + std::clamp<int>(i+1, 0, m_vElements.size()), element);
+			onElementAdded(element);
 			return this;
 		}
 	}
@@ -124,7 +145,9 @@ CBaseUIContainer *CBaseUIContainer::removeBaseUIElement(CBaseUIElement *element)
 	{
 		if (m_vElements[i] == element)
 		{
+			onElementRemoved(element);
 			m_vElements.erase(m_vElements.begin()+i);
+			onElementsChanged();
 			return this;
 		}
 	}
@@ -142,6 +165,7 @@ CBaseUIContainer *CBaseUIContainer::deleteBaseUIElement(CBaseUIElement *element)
 		{
 			SAFE_DELETE(element);
 			m_vElements.erase(m_vElements.begin()+i);
+			onElementsChanged();
 			return this;
 		}
 	}
@@ -151,6 +175,66 @@ CBaseUIContainer *CBaseUIContainer::deleteBaseUIElement(CBaseUIElement *element)
 	return this;
 }
 
+CBaseUIContainer *CBaseUIContainer::setParentOfElements(bool parentOfElements)
+{
+	if (parentOfElements == m_bParentOfElements)
+		return this;
+
+	m_bParentOfElements = parentOfElements;
+	for (CBaseUIElement *element : m_vElements)
+	{
+		if (m_bParentOfElements && element->getParent() == nullptr)
+			element->setParent(this);
+		else if (!m_bParentOfElements && element->getParent() == this)
+			element->setParent(nullptr);
+	}
+	m_iLayoutRevision++;
+
+	return this;
+}
+
+void CBaseUIContainer::onElementAdded(CBaseUIElement *element)
+{
+	// (elements which already belong to something else keep reporting there)
+	if (m_bParentOfElements && element->getParent() == nullptr)
+		element->setParent(this);
+
+	onElementsChanged();
+}
+
+void CBaseUIContainer::onElementRemoved(CBaseUIElement *element)
+{
+	if (element->getParent() == this)
+		element->setParent(nullptr);
+}
+
+void CBaseUIContainer::onElementsChanged()
+{
+	m_iElementsRevision++;
+
+	// indices are meaningless now
+	if (m_bActiveElementList)
+	{
+		m_bActiveElementList = false;
+		m_vActiveElements.clear();
+	}
+}
+
+void CBaseUIContainer::onChildBoundsChanged(CBaseUIElement *child)
+{
+	m_iLayoutRevision++;
+
+	// propagate the changed transform right away, instead of repositioning every element every frame
+	if (!child->isPositionedManually())
+		update_pos(child);
+}
+
+void CBaseUIContainer::onChildMoved(CBaseUIElement * /*child*/)
+{
+	if (!m_bUpdatingPos)
+		m_iLayoutRevision++;
+}
+
 CBaseUIElement *CBaseUIContainer::getBaseUIElement(const UString& name)
 {
 	MC_UNROLL
@@ -167,12 +251,10 @@ void CBaseUIContainer::draw()
 {
 	if (!m_bVisible) return;
 
-	MC_UNROLL
-	for (size_t i=0; i<m_vElements.size(); i++)
-	{
-		if (!m_vElements[i]->isDrawnManually())
-			m_vElements[i]->draw();
-	}
+	forEachActiveElement([](CBaseUIElement *element) {
+		if (!element->isDrawnManually())
+			element->draw();
+	});
 }
 
 void CBaseUIContainer::draw_debug()
@@ -189,27 +271,28 @@ void CBaseUIContainer::update()
 	CBaseUIElement::update();
 	if (!m_bVisible) return;
 
-	MC_UNROLL
-	for (size_t i=0; i<m_vElements.size(); i++)
-	{
-		m_vElements[i]->update();
-	}
+	forEachActiveElement([](CBaseUIElement *element) {element->update();});
 }
 
 void CBaseUIContainer::update_pos()
 {
-	MC_UNROLL
-	for (size_t i=0; i<m_vElements.size(); i++)
-	{
-		if (!m_vElements[i]->isPositionedManually())
-			m_vElements[i]->setPos(m_vPos + m_vElements[i]->getRelPos());
-	}
+	const bool wasUpdatingPos = m_bUpdatingPos;
+	m_bUpdatingPos = true;
+	forEachActiveElement([this](CBaseUIElement *element) {
+		if (!element->isPositionedManually())
+			element->setPos(m_vPos + element->getRelPos());
+	});
+	m_bUpdatingPos = wasUpdatingPos;
 }
 
 void CBaseUIContainer::update_pos(CBaseUIElement *element)
 {
-	if (element != NULL)
-		element->setPos(m_vPos + element->getRelPos());
+	if (element == NULL) return;
+
+	const bool wasUpdatingPos = m_bUpdatingPos;
+	m_bUpdatingPos = true;
+	element->setPos(m_vPos + element->getRelPos());
+	m_bUpdatingPos = wasUpdatingPos;
 }
 
 void CBaseUIContainer::onKeyUp(KeyboardEvent &e)
@@ -240,10 +323,7 @@ void CBaseUIContainer::onChar(KeyboardEvent &e)
 
 void CBaseUIContainer::onFocusStolen()
 {
-	for (size_t i=0; i<m_vElements.size(); i++)
-	{
-		m_vElements[i]->stealFocus();
-	}
+	forEachActiveElement([](CBaseUIElement *element) {element->stealFocus();});
 }
 
 void CBaseUIContainer::onEnabled()
@@ -272,13 +352,7 @@ bool CBaseUIContainer::isBusy()
 	if (!m_bVisible)
 		return false;
 
-	for (size_t i=0; i<m_vElements.size(); i++)
-	{
-		if (m_vElements[i]->isBusy())
-			return true;
-	}
-
-	return false;
+	return anyOfActiveElements([](CBaseUIElement *element) {return element->isBusy();});
 }
 
 bool CBaseUIContainer::isActive()
@@ -286,11 +360,5 @@ bool CBaseUIContainer::isActive()
 	if (!m_bVisible)
 		return false;
 
-	for (size_t i=0; i<m_vElements.size(); i++)
-	{
-		if (m_vElements[i]->isActive())
-			return true;
-	}
-
-	return false;
+	return anyOfActiveElements([](CBaseUIElement *element) {return element->isActive();});
 }
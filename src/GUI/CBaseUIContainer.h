@@ -35,6 +35,9 @@ public:
 	CBaseUIContainer *addBaseUIElementBack(CBaseUIElement *element, float xPos, float yPos);
 	CBaseUIContainer *addBaseUIElementBack(CBaseUIElement *element);
 
+	// become the parent of all (parentless) elements, to get notified about their position/size changes (off by default, since an element only has one parent)
+	CBaseUIContainer *setParentOfElements(bool parentOfElements);
+
 	CBaseUIContainer *insertBaseUIElement(CBaseUIElement *element, CBaseUIElement *index);
 	CBaseUIContainer *insertBaseUIElementBack(CBaseUIElement *element, CBaseUIElement *index);
 
@@ -45,6 +48,26 @@ public:
 
 	[[nodiscard]] inline const std::vector<CBaseUIElement*> &getElements() const {return m_vElements;}
 
+	// restricts the per-frame work (update/draw/update_pos/isBusy/isActive/focus) to the elements in [begin, end)
+	// the owner is responsible for keeping everything outside of the range invisible and inactive (see CBaseUIScrollView::setVirtualized())
+	void setActiveElementRange(size_t begin, size_t end) {m_iActiveElementsBegin = begin; m_iActiveElementsEnd = end; m_vActiveElements.clear(); m_bActiveElementList = false;}
+	void resetActiveElementRange() {setActiveElementRange(0, SIZE_MAX);}
+	[[nodiscard]] inline size_t getActiveElementsBegin() const {return std::min(m_iActiveElementsBegin, m_vElements.size());}
+	[[nodiscard]] inline size_t getActiveElementsEnd() const {return std::min(m_iActiveElementsEnd, m_vElements.size());}
+
+	// same as above, but for an arbitrary (ascending) list of element indices, e.g. the result of culling against a clip rect
+	// any add/insert/remove resets this back to all elements, until the owner sets a new list
+	void setActiveElements(std::vector<uint32_t> indices) {m_vActiveElements = std::move(indices); m_bActiveElementList = true;}
+	[[nodiscard]] inline bool hasActiveElementList() const {return m_bActiveElementList;}
+	[[nodiscard]] inline const std::vector<uint32_t> &getActiveElements() const {return m_vActiveElements;}
+
+	// incremented on every add/insert/remove, to detect changes without comparing the element lists
+	[[nodiscard]] inline uint64_t getElementsRevision() const {return m_iElementsRevision;}
+
+	// incremented whenever the position or size of any element changes (see CBaseUIElement::invalidateBounds()/invalidatePos()), requires setParentOfElements(true)
+	// moves caused by the container itself (update_pos()) don't count, those are implied by the container position
+	[[nodiscard]] inline uint64_t getLayoutRevision() const {return m_iLayoutRevision;}
+
 	void onMoved() override {update_pos();}
 	void onResized() override {update_pos();}
 
@@ -63,7 +86,55 @@ public:
 	// inspection
 	CBASE_UI_TYPE(CBaseUIContainer, CONTAINER, CBaseUIElement)
 protected:
+	void onChildBoundsChanged(CBaseUIElement *child) override;
+	void onChildMoved(CBaseUIElement *child) override;
+
+	// stops at (and returns true for) the first element the predicate returns true for
+	template <typename PREDICATE>
+	bool anyOfActiveElements(PREDICATE &&predicate)
+	{
+		if (m_bActiveElementList)
+		{
+			for (const uint32_t i : m_vActiveElements)
+			{
+				if (i < m_vElements.size() && predicate(m_vElements[i]))
+					return true;
+			}
+			return false;
+		}
+
+		const size_t end = getActiveElementsEnd();
+		for (size_t i=getActiveElementsBegin(); i<end; i++)
+		{
+			if (predicate(m_vElements[i]))
+				return true;
+		}
+		return false;
+	}
+
+	template <typename FUNC>
+	void forEachActiveElement(FUNC &&func)
+	{
+		anyOfActiveElements([&](CBaseUIElement *element) {func(element); return false;});
+	}
+
 	std::vector<CBaseUIElement*> m_vElements;
+
+	size_t m_iActiveElementsBegin;
+	size_t m_iActiveElementsEnd;
+	bool m_bActiveElementList;
+	std::vector<uint32_t> m_vActiveElements;
+
+	uint64_t m_iElementsRevision;
+	uint64_t m_iLayoutRevision;
+
+	bool m_bParentOfElements;
+	bool m_bUpdatingPos;
+
+private:
+	void onElementAdded(CBaseUIElement *element);
+	void onElementRemoved(CBaseUIElement *element);
+	void onElementsChanged();
 };
 
 #endif
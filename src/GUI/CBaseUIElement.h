@@ -12,50 +12,50 @@
 #include "cbase.h"
 #include "KeyboardListener.h"
 
-#define ELEMENT_BODY_BASE(T, v, o) v T *setPos(float xPos, float yPos) o {if (m_vPos.x != xPos || m_vPos.y != yPos) {m_vPos.x = xPos - m_vSize.x * m_vAnchor.x; m_vPos.y = yPos - m_vSize.y * m_vAnchor.y; onMoved();} return this;} \
-	v T *setPosX(float xPos) o {if (m_vPos.x != xPos) {m_vPos.x = xPos - m_vSize.x * m_vAnchor.x; onMoved();} return this;} \
-	v T *setPosY(float yPos) o {if (m_vPos.y != yPos) {m_vPos.y = yPos - m_vSize.y * m_vAnchor.y; onMoved();} return this;} \
-	v T *setPos(Vector2 position) o {if (m_vPos != position) {m_vPos = position - m_vSize * m_vAnchor; onMoved();} return this;} \
+#define ELEMENT_BODY_BASE(T, v, o) v T *setPos(float xPos, float yPos) o {if (m_vPos.x != xPos || m_vPos.y != yPos) {m_vPos.x = xPos - m_vSize.x * m_vAnchor.x; m_vPos.y = yPos - m_vSize.y * m_vAnchor.y; onMoved(); invalidatePos();} return this;} \
+	v T *setPosX(float xPos) o {if (m_vPos.x != xPos) {m_vPos.x = xPos - m_vSize.x * m_vAnchor.x; onMoved(); invalidatePos();} return this;} \
+	v T *setPosY(float yPos) o {if (m_vPos.y != yPos) {m_vPos.y = yPos - m_vSize.y * m_vAnchor.y; onMoved(); invalidatePos();} return this;} \
+	v T *setPos(Vector2 position) o {if (m_vPos != position) {m_vPos = position - m_vSize * m_vAnchor; onMoved(); invalidatePos();} return this;} \
 	\
-	v T *setPosAbsolute(float xPos, float yPos) o {if (m_vPos.x != xPos || m_vPos.y != yPos) {m_vPos.x = xPos; m_vPos.y = yPos; onMoved();} return this;} \
-	v T *setPosAbsoluteX(float xPos) o {if (m_vPos.x != xPos) {m_vPos.x = xPos; onMoved();} return this;} \
-	v T *setPosAbsoluteY(float yPos) o {if (m_vPos.y != yPos) {m_vPos.y = yPos; onMoved();} return this;} \
-	v T *setPosAbsolute(Vector2 position) o {if (m_vPos != position) {m_vPos = position; onMoved();} return this;} \
+	v T *setPosAbsolute(float xPos, float yPos) o {if (m_vPos.x != xPos || m_vPos.y != yPos) {m_vPos.x = xPos; m_vPos.y = yPos; onMoved(); invalidatePos();} return this;} \
+	v T *setPosAbsoluteX(float xPos) o {if (m_vPos.x != xPos) {m_vPos.x = xPos; onMoved(); invalidatePos();} return this;} \
+	v T *setPosAbsoluteY(float yPos) o {if (m_vPos.y != yPos) {m_vPos.y = yPos; onMoved(); invalidatePos();} return this;} \
+	v T *setPosAbsolute(Vector2 position) o {if (m_vPos != position) {m_vPos = position; onMoved(); invalidatePos();} return this;} \
 	\
-	v T *setRelPos(float xPos, float yPos) o {if (m_vmPos.x != xPos || m_vmPos.y != yPos) {m_vmPos.x = xPos - m_vSize.x * m_vAnchor.x; m_vmPos.y = yPos - m_vSize.y * m_vAnchor.y; updateLayout();} return this;} \
-	v T *setRelPosX(float xPos) o {if (m_vmPos.x != xPos) {m_vmPos.x = xPos - m_vSize.x * m_vAnchor.x; updateLayout();} return this;} \
-	v T *setRelPosY(float yPos) o {if (m_vmPos.y != yPos) {m_vmPos.y = yPos - m_vSize.x * m_vAnchor.y; updateLayout();} return this;} \
-	v T *setRelPos(Vector2 position) o {if (m_vmPos != position) {m_vmPos = position - m_vSize * m_vAnchor; updateLayout();} return this;} \
+	v T *setRelPos(float xPos, float yPos) o {if (m_vmPos.x != xPos || m_vmPos.y != yPos) {m_vmPos.x = xPos - m_vSize.x * m_vAnchor.x; m_vmPos.y = yPos - m_vSize.y * m_vAnchor.y; updateLayout(); invalidateBounds();} return this;} \
+	v T *setRelPosX(float xPos) o {if (m_vmPos.x != xPos) {m_vmPos.x = xPos - m_vSize.x * m_vAnchor.x; updateLayout(); invalidateBounds();} return this;} \
+	v T *setRelPosY(float yPos) o {if (m_vmPos.y != yPos) {m_vmPos.y = yPos - m_vSize.x * m_vAnchor.y; updateLayout(); invalidateBounds();} return this;} \
+	v T *setRelPos(Vector2 position) o {if (m_vmPos != position) {m_vmPos = position - m_vSize * m_vAnchor; updateLayout(); invalidateBounds();} return this;} \
 	\
-	v T *setRelPosAbsolute(float xPos, float yPos) o {if (m_vmPos.x != xPos || m_vmPos.y != yPos) {m_vmPos.x = xPos; m_vmPos.y = yPos; updateLayout();} return this;} \
-	v T *setRelPosAbsoluteX(float xPos) o {if (m_vmPos.x != xPos) {m_vmPos.x = xPos; updateLayout();} return this;} \
-	v T *setRelPosAbsoluteY(float yPos) o {if (m_vmPos.y != yPos) {m_vmPos.y = yPos; updateLayout();} return this;} \
-	v T *setRelPosAbsolute(Vector2 position) o {if (m_vmPos != position) {m_vmPos = position; updateLayout();} return this;} \
+	v T *setRelPosAbsolute(float xPos, float yPos) o {if (m_vmPos.x != xPos || m_vmPos.y != yPos) {m_vmPos.x = xPos; m_vmPos.y = yPos; updateLayout(); invalidateBounds();} return this;} \
+	v T *setRelPosAbsoluteX(float xPos) o {if (m_vmPos.x != xPos) {m_vmPos.x = xPos; updateLayout(); invalidateBounds();} return this;} \
+	v T *setRelPosAbsoluteY(float yPos) o {if (m_vmPos.y != yPos) {m_vmPos.y = yPos; updateLayout(); invalidateBounds();} return this;} \
+	v T *setRelPosAbsolute(Vector2 position) o {if (m_vmPos != position) {m_vmPos = position; updateLayout(); invalidateBounds();} return this;} \
 	\
-	v T *setSize(float xSize, float ySize) o {if (m_vSize.x != xSize || m_vSize.y != ySize) {m_vPos.x += (m_vSize.x - xSize) * m_vAnchor.x; m_vPos.y += (m_vSize.y - ySize) * m_vAnchor.y; m_vSize.x = xSize; m_vSize.y = ySize; onResized(); onMoved();} return this;} \
-	v T *setSizeX(float xSize) o {if (m_vSize.x != xSize) {m_vPos.x += (m_vSize.x - xSize) * m_vAnchor.x; m_vSize.x = xSize; onResized(); onMoved();} return this;} \
-	v T *setSizeY(float ySize) o {if (m_vSize.y != ySize) {m_vPos.y += (m_vSize.y - ySize) * m_vAnchor.y; m_vSize.y = ySize; onResized(); onMoved();} return this;} \
-	v T *setSize(Vector2 size) o {if (m_vSize != size) {m_vPos += (m_vSize - size) * m_vAnchor; m_vSize = size; onResized(); onMoved();} return this;} \
+	v T *setSize(float xSize, float ySize) o {if (m_vSize.x != xSize || m_vSize.y != ySize) {m_vPos.x += (m_vSize.x - xSize) * m_vAnchor.x; m_vPos.y += (m_vSize.y - ySize) * m_vAnchor.y; m_vSize.x = xSize; m_vSize.y = ySize; onResized(); onMoved(); invalidateBounds();} return this;} \
+	v T *setSizeX(float xSize) o {if (m_vSize.x != xSize) {m_vPos.x += (m_vSize.x - xSize) * m_vAnchor.x; m_vSize.x = xSize; onResized(); onMoved(); invalidateBounds();} return this;} \
+	v T *setSizeY(float ySize) o {if (m_vSize.y != ySize) {m_vPos.y += (m_vSize.y - ySize) * m_vAnchor.y; m_vSize.y = ySize; onResized(); onMoved(); invalidateBounds();} return this;} \
+	v T *setSize(Vector2 size) o {if (m_vSize != size) {m_vPos += (m_vSize - size) * m_vAnchor; m_vSize = size; onResized(); onMoved(); invalidateBounds();} return this;} \
 	\
-	v T *setSizeAbsolute(float xSize, float ySize) o {if (m_vSize.x != xSize || m_vSize.y != ySize) {m_vSize.x = xSize; m_vSize.y = ySize; onResized();} return this;} \
-	v T *setSizeAbsoluteX(float xSize) o {if (m_vSize.x != xSize) {m_vSize.x = xSize; onResized();} return this;} \
-	v T *setSizeAbsoluteY(float ySize) o {if (m_vSize.y != ySize) {m_vSize.y = ySize; onResized();} return this;} \
-	v T *setSizeAbsolute(Vector2 size) o {if (m_vSize != size) {m_vSize = size; onResized();} return this;} \
+	v T *setSizeAbsolute(float xSize, float ySize) o {if (m_vSize.x != xSize || m_vSize.y != ySize) {m_vSize.x = xSize; m_vSize.y = ySize; onResized(); invalidateBounds();} return this;} \
+	v T *setSizeAbsoluteX(float xSize) o {if (m_vSize.x != xSize) {m_vSize.x = xSize; onResized(); invalidateBounds();} return this;} \
+	v T *setSizeAbsoluteY(float ySize) o {if (m_vSize.y != ySize) {m_vSize.y = ySize; onResized(); invalidateBounds();} return this;} \
+	v T *setSizeAbsolute(Vector2 size) o {if (m_vSize != size) {m_vSize = size; onResized(); invalidateBounds();} return this;} \
 	\
-	v T *setRelSize(float xSize, float ySize) o {if(m_vmSize.x != xSize || m_vmSize.y != ySize) {m_vmPos.x += (m_vmSize.x - xSize) * m_vAnchor.x; m_vmPos.y += (m_vmSize.y - ySize) * m_vAnchor.y; m_vmSize.x = xSize; m_vmSize.y = ySize; updateLayout();} return this;} \
-	v T *setRelSizeX(float xSize) o {if (m_vmSize.x != xSize) {m_vmPos.x += (m_vmSize.x - xSize) * m_vAnchor.x; m_vmSize.x = xSize; updateLayout();} return this;} \
-	v T *setRelSizeY(float ySize) o {if (m_vmSize.y != ySize) {m_vmPos.y += (m_vmSize.y - ySize) * m_vAnchor.y; m_vmSize.y = ySize; updateLayout();} return this;} \
-	v T *setRelSize(Vector2 size) o {if (m_vmSize != size) {m_vmPos += (m_vmSize - size) * m_vAnchor; m_vmSize = size; updateLayout();} return this;} \
+	v T *setRelSize(float xSize, float ySize) o {if(m_vmSize.x != xSize || m_vmSize.y != ySize) {m_vmPos.x += (m_vmSize.x - xSize) * m_vAnchor.x; m_vmPos.y += (m_vmSize.y - ySize) * m_vAnchor.y; m_vmSize.x = xSize; m_vmSize.y = ySize; updateLayout(); invalidateBounds();} return this;} \
+	v T *setRelSizeX(float xSize) o {if (m_vmSize.x != xSize) {m_vmPos.x += (m_vmSize.x - xSize) * m_vAnchor.x; m_vmSize.x = xSize; updateLayout(); invalidateBounds();} return this;} \
+	v T *setRelSizeY(float ySize) o {if (m_vmSize.y != ySize) {m_vmPos.y += (m_vmSize.y - ySize) * m_vAnchor.y; m_vmSize.y = ySize; updateLayout(); invalidateBounds();} return this;} \
+	v T *setRelSize(Vector2 size) o {if (m_vmSize != size) {m_vmPos += (m_vmSize - size) * m_vAnchor; m_vmSize = size; updateLayout(); invalidateBounds();} return this;} \
 	\
-	v T *setRelSizeAbsolute(float xSize, float ySize) o {if (m_vmSize.x != xSize || m_vmSize.y != ySize) {m_vmSize.x = xSize; m_vmSize.y = ySize; updateLayout();} return this;} \
-	v T *setRelSizeAbsoluteX(float xSize) o {if (m_vmSize.x != xSize) {m_vmSize.x = xSize; updateLayout();} return this;} \
-	v T *setRelSizeAbsoluteY(float ySize) o {if (m_vmSize.y != ySize) {m_vmSize.y = ySize; updateLayout();} return this;} \
-	v T *setRelSizeAbsolute(Vector2 size) o {if (m_vmSize != size) {m_vmSize = size; updateLayout();} return this;} \
+	v T *setRelSizeAbsolute(float xSize, float ySize) o {if (m_vmSize.x != xSize || m_vmSize.y != ySize) {m_vmSize.x = xSize; m_vmSize.y = ySize; updateLayout(); invalidateBounds();} return this;} \
+	v T *setRelSizeAbsoluteX(float xSize) o {if (m_vmSize.x != xSize) {m_vmSize.x = xSize; updateLayout(); invalidateBounds();} return this;} \
+	v T *setRelSizeAbsoluteY(float ySize) o {if (m_vmSize.y != ySize) {m_vmSize.y = ySize; updateLayout(); invalidateBounds();} return this;} \
+	v T *setRelSizeAbsolute(Vector2 size) o {if (m_vmSize != size) {m_vmSize = size; updateLayout(); invalidateBounds();} return this;} \
 	\
-	v T *setAnchor(float xAnchor, float yAnchor) o {if (m_vAnchor.x != xAnchor || m_vAnchor.y != yAnchor){m_vmPos.x -= m_vmSize.x * (xAnchor - m_vAnchor.x); m_vmPos.y -= m_vmSize.y * (yAnchor - m_vAnchor.y); m_vPos.x -= m_vSize.x * (xAnchor - m_vAnchor.x); m_vPos.y -= m_vSize.y * (yAnchor - m_vAnchor.y); m_vAnchor.x = xAnchor; m_vAnchor.y = yAnchor; if (m_parent != nullptr) updateLayout(); onMoved();} return this;} \
-	v T *setAnchorX(float xAnchor) o {if (m_vAnchor.x != xAnchor){m_vmPos.x -= m_vmSize.x * (xAnchor - m_vAnchor.x); m_vPos.x -= m_vSize.x * (xAnchor - m_vAnchor.x); m_vAnchor.x = xAnchor; if (m_parent != nullptr) updateLayout(); onMoved();} return this;} \
-	v T *setAnchorY(float yAnchor) o {if (m_vAnchor.y != yAnchor){m_vmPos.y -= m_vmSize.y * (yAnchor - m_vAnchor.y); m_vPos.y -= m_vSize.y * (yAnchor - m_vAnchor.y); m_vAnchor.y = yAnchor; if (m_parent != nullptr) updateLayout(); onMoved();} return this;} \
-	v T *setAnchor(Vector2 anchor) o {if (m_vAnchor != anchor){m_vmPos -= m_vmSize * (anchor - m_vAnchor); m_vPos -= m_vSize * (anchor - m_vAnchor); m_vAnchor = anchor; if (m_parent != nullptr) updateLayout(); onMoved();} return this;} \
+	v T *setAnchor(float xAnchor, float yAnchor) o {if (m_vAnchor.x != xAnchor || m_vAnchor.y != yAnchor){m_vmPos.x -= m_vmSize.x * (xAnchor - m_vAnchor.x); m_vmPos.y -= m_vmSize.y * (yAnchor - m_vAnchor.y); m_vPos.x -= m_vSize.x * (xAnchor - m_vAnchor.x); m_vPos.y -= m_vSize.y * (yAnchor - m_vAnchor.y); m_vAnchor.x = xAnchor; m_vAnchor.y = yAnchor; if (m_parent != nullptr) updateLayout(); onMoved(); invalidateBounds();} return this;} \
+	v T *setAnchorX(float xAnchor) o {if (m_vAnchor.x != xAnchor){m_vmPos.x -= m_vmSize.x * (xAnchor - m_vAnchor.x); m_vPos.x -= m_vSize.x * (xAnchor - m_vAnchor.x); m_vAnchor.x = xAnchor; if (m_parent != nullptr) updateLayout(); onMoved(); invalidateBounds();} return this;} \
+	v T *setAnchorY(float yAnchor) o {if (m_vAnchor.y != yAnchor){m_vmPos.y -= m_vmSize.y * (yAnchor - m_vAnchor.y); m_vPos.y -= m_vSize.y * (yAnchor - m_vAnchor.y); m_vAnchor.y = yAnchor; if (m_parent != nullptr) updateLayout(); onMoved(); invalidateBounds();} return this;} \
+	v T *setAnchor(Vector2 anchor) o {if (m_vAnchor != anchor){m_vmPos -= m_vmSize * (anchor - m_vAnchor); m_vPos -= m_vSize * (anchor - m_vAnchor); m_vAnchor = anchor; if (m_parent != nullptr) updateLayout(); onMoved(); invalidateBounds();} return this;} \
 	\
 	v T *setAnchorAbsolute(float xAnchor, float yAnchor) o {if (m_vAnchor.x != xAnchor || m_vAnchor.y != yAnchor){m_vAnchor.x = xAnchor, m_vAnchor.y = yAnchor;} return this;} \
 	v T *setAnchorAbsoluteX(float xAnchor) o {if (m_vAnchor.x != xAnchor) {m_vAnchor.x = xAnchor;} return this;} \
@@ -150,6 +150,8 @@ public:
 	// actions
 	void stealFocus() {m_bMouseInsideCheck = true; m_bActive = false; onFocusStolen();}
 	virtual void updateLayout() {if(m_parent != nullptr) m_parent->updateLayout();}
+	void invalidateBounds() {if (m_parent != nullptr) m_parent->onChildBoundsChanged(this);} // relative position or size changed
+	void invalidatePos() {if (m_parent != nullptr) m_parent->onChildMoved(this);} // absolute position changed
 
 	// type inspection
 	[[nodiscard]] virtual TypeId getTypeId() const = 0;
@@ -164,6 +166,8 @@ protected:
 	// events
 	virtual void onResized() {;}
 	virtual void onMoved() {;}
+	virtual void onChildBoundsChanged(CBaseUIElement * /*child*/) {;}
+	virtual void onChildMoved(CBaseUIElement * /*child*/) {;}
 
 	virtual void onFocusStolen() {;}
 	virtual void onEnabled() {;}
@@ -24,6 +24,7 @@ ConVar ui_scrollview_kinetic_energy_multiplier("ui_scrollview_kinetic_energy_mul
 ConVar ui_scrollview_kinetic_approach_time("ui_scrollview_kinetic_approach_time", 0.075f, FCVAR_NONE, "approach target afterscroll delta over this duration");
 ConVar ui_scrollview_mousewheel_multiplier("ui_scrollview_mousewheel_multiplier", 3.5f, FCVAR_NONE);
 ConVar ui_scrollview_mousewheel_overscrollbounce("ui_scrollview_mousewheel_overscrollbounce", true, FCVAR_NONE);
+ConVar ui_scrollview_culling("ui_scrollview_culling", true, FCVAR_NONE, "scrollviews which enable culling only update/draw the elements intersecting the view (via a bounding box tree)");
 }
 
 CBaseUIScrollView::CBaseUIScrollView(float xPos, float yPos, float xSize, float ySize, const UString& name) : CBaseUIElement(xPos, yPos, xSize, ySize, name)
@@ -33,6 +34,17 @@ CBaseUIScrollView::CBaseUIScrollView(float xPos, float yPos, float xSize, float
 	m_bDrawScrollbars = true;
 	m_bClipping = true;
 
+	m_bVirtualized = false;
+	m_bCulling = false;
+	m_iVirtualizedElementsRevision = 0;
+	m_iVirtualizedBegin = 0;
+	m_iVirtualizedEnd = 0;
+
+	m_bClippingDirty = true;
+	m_clippingState = CLIPPING_STATE{};
+	m_iBoundsTreeElementsRevision = 0;
+	m_iBoundsTreeLayoutRevision = 0;
+
 	m_backgroundColor = 0xff000000;
 	m_frameColor = 0xffffffff;
 	m_frameBrightColor = 0;
@@ -60,6 +72,7 @@ CBaseUIScrollView::CBaseUIScrollView(float xPos, float yPos, float xSize, float
 	m_iScrollResistance = cv::ui_scrollview_resistance.getInt(); // TODO: dpi handling
 
 	m_container = new CBaseUIContainer(xPos, yPos, xSize, ySize, name);
+	m_container->setParentOfElements(true); // for the layout revision, see updateClipping()
 }
 
 CBaseUIScrollView::~CBaseUIScrollView()
@@ -530,7 +543,43 @@ void CBaseUIScrollView::scrollToElement(CBaseUIElement *element, int  /*xOffset*
 
 void CBaseUIScrollView::updateClipping()
 {
+	// skip everything if neither we, the scroll position, nor any element moved/resized/changed since the last pass (the common case for idle menus)
+	const CLIPPING_STATE clippingState{
+		.elementsRevision = m_container->getElementsRevision(),
+		.layoutRevision = m_container->getLayoutRevision(),
+		.containerPos = m_container->getPos(),
+		.pos = m_vPos,
+		.size = m_vSize,
+	};
+	const bool forceRebuild = m_bClippingDirty;
+	if (!forceRebuild && clippingState == m_clippingState)
+		return;
+
+	m_bClippingDirty = false;
+	m_clippingState = clippingState;
+
+	if (m_bVirtualized)
+	{
+		updateClippingVirtualized();
+		return;
+	}
+
 	const std::vector<CBaseUIElement*> &elements = m_container->getElements();
+
+	if (m_bCulling && cv::ui_scrollview_culling.getBool())
+	{
+		updateClippingCulled(forceRebuild);
+		return;
+	}
+
+	// back from culling, positions of everything which was culled are stale
+	if (m_container->hasActiveElementList())
+	{
+		m_container->resetActiveElementRange();
+		m_container->update_pos();
+	}
+	m_boundsTree.clear();
+
 	const McRect me = McRect(m_vPos.x, m_vPos.y, m_vSize.x, m_vSize.y);
 
 	for (size_t i=0; i<elements.size(); i++)
@@ -548,6 +597,125 @@ void CBaseUIScrollView::updateClipping()
 	}
 }
 
+void CBaseUIScrollView::updateClippingCulled(bool forceRebuild)
+{
+	const std::vector<CBaseUIElement*> &elements = m_container->getElements();
+
+	// the tree holds container relative bounds, so scrolling alone never invalidates it
+	if (forceRebuild || m_boundsTree.getNumBounds() != elements.size() || m_container->getElementsRevision() != m_iBoundsTreeElementsRevision || m_container->getLayoutRevision() != m_iBoundsTreeLayoutRevision)
+	{
+		m_iBoundsTreeElementsRevision = m_container->getElementsRevision();
+		m_iBoundsTreeLayoutRevision = m_container->getLayoutRevision();
+
+		std::vector<McRect> bounds;
+		bounds.reserve(elements.size());
+		for (const CBaseUIElement *e : elements)
+		{
+			bounds.emplace_back(e->getRelPos(), e->getSize());
+		}
+		m_boundsTree.rebuild(bounds);
+	}
+
+	std::vector<uint32_t> culledElements;
+	m_boundsTree.query(McRect(m_vPos - m_container->getPos(), m_vSize), culledElements);
+
+	// everything outside of the view must be invisible, since it isn't updated anymore
+	if (m_container->hasActiveElementList())
+	{
+		for (const uint32_t i : m_container->getActiveElements())
+		{
+			if (i < elements.size() && elements[i]->isVisible() && !std::ranges::binary_search(culledElements, i))
+				elements[i]->setVisible(false);
+		}
+	}
+	else
+	{
+		// first pass after the element list changed
+		size_t culledIndex = 0;
+		for (size_t i=0; i<elements.size(); i++)
+		{
+			if (culledIndex < culledElements.size() && culledElements[culledIndex] == i)
+				culledIndex++;
+			else if (elements[i]->isVisible())
+				elements[i]->setVisible(false);
+		}
+	}
+
+	for (const uint32_t i : culledElements)
+	{
+		CBaseUIElement *e = elements[i];
+
+		// (not repositioned while culled)
+		m_container->update_pos(e);
+
+		if (!e->isVisible())
+			e->setVisible(true);
+	}
+
+	m_container->setActiveElements(std::move(culledElements));
+}
+
+void CBaseUIScrollView::updateClippingVirtualized()
+{
+	const std::vector<CBaseUIElement*> &elements = m_container->getElements();
+	const McRect me = McRect(m_vPos.x, m_vPos.y, m_vSize.x, m_vSize.y);
+
+	// find the range of elements around the visible area (binary search over the relative y positions)
+	// the margin of one view height covers animated offsets (which can temporarily break the ordering a bit), and elements scrolling in within the next frame
+	const float viewTop = -std::round(m_vScrollPos.y);
+	const float margin = m_vSize.y;
+
+	const auto beginIt = std::partition_point(elements.begin(), elements.end(), [=](const CBaseUIElement *e) {return e->getRelPos().y + e->getSize().y < viewTop - margin;});
+	const auto endIt = std::partition_point(beginIt, elements.end(), [=](const CBaseUIElement *e) {return e->getRelPos().y <= viewTop + m_vSize.y + margin;});
+	const size_t begin = beginIt - elements.begin();
+	const size_t end = endIt - elements.begin();
+
+	// everything outside of the range must be invisible, since it isn't updated anymore
+	const bool elementsChanged = (m_container->getElementsRevision() != m_iVirtualizedElementsRevision);
+	const size_t previousBegin = m_iVirtualizedBegin;
+	const size_t previousEnd = std::min(m_iVirtualizedEnd, elements.size());
+	if (elementsChanged)
+	{
+		// the element list changed, so the previous range is meaningless (only happens on layout changes, not every frame)
+		m_iVirtualizedElementsRevision = m_container->getElementsRevision();
+		for (size_t i=0; i<elements.size(); i++)
+		{
+			if ((i < begin || i >= end) && elements[i]->isVisible())
+				elements[i]->setVisible(false);
+		}
+	}
+	else
+	{
+		for (size_t i=previousBegin; i<previousEnd; i++)
+		{
+			if ((i < begin || i >= end) && elements[i]->isVisible())
+				elements[i]->setVisible(false);
+		}
+	}
+
+	m_iVirtualizedBegin = begin;
+	m_iVirtualizedEnd = end;
+	m_container->setActiveElementRange(begin, end);
+
+	for (size_t i=begin; i<end; i++)
+	{
+		CBaseUIElement *e = elements[i];
+
+		// elements which were outside of the range until now still have their old positions
+		if (elementsChanged || i < previousBegin || i >= previousEnd)
+			m_container->update_pos(e);
+
+		const McRect elementBounds = McRect(e->getPos().x, e->getPos().y, e->getSize().x, e->getSize().y);
+		if (me.intersects(elementBounds))
+		{
+			if (!e->isVisible())
+				e->setVisible(true);
+		}
+		else if (e->isVisible())
+			e->setVisible(false);
+	}
+}
+
 void CBaseUIScrollView::updateScrollbars()
 {
 	// update vertical scrollbar
@@ -582,6 +750,38 @@ void CBaseUIScrollView::updateScrollbars()
 	}
 }
 
+CBaseUIScrollView *CBaseUIScrollView::setCulling(bool culling)
+{
+	if (culling == m_bCulling)
+		return this;
+
+	m_bCulling = culling;
+	m_bClippingDirty = true;
+
+	return this;
+}
+
+CBaseUIScrollView *CBaseUIScrollView::setVirtualized(bool virtualized)
+{
+	if (virtualized == m_bVirtualized)
+		return this;
+
+	m_bVirtualized = virtualized;
+	m_bClippingDirty = true;
+
+	// force a full clipping pass on the next update
+	m_iVirtualizedElementsRevision = m_container->getElementsRevision() - 1;
+	m_iVirtualizedBegin = m_iVirtualizedEnd = 0;
+
+	if (!m_bVirtualized)
+	{
+		m_container->resetActiveElementRange();
+		m_container->update_pos();
+	}
+
+	return this;
+}
+
 CBaseUIScrollView *CBaseUIScrollView::setScrollSizeToContent(int border)
 {
 	m_vScrollSize.zero();
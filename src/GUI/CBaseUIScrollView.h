@@ -12,6 +12,7 @@
 #define CBASEUISCROLLVIEW_H
 
 #include "CBaseUIElement.h"
+#include "CBaseUIBoundsTree.h"
 
 class CBaseUIContainer;
 
@@ -62,6 +63,8 @@ public:
 	CBaseUIScrollView *setScrollResistance(int scrollResistanceInPixels) {m_iScrollResistance = scrollResistanceInPixels; return this;}
 
 	CBaseUIScrollView *setBlockScrolling(bool block) {m_bBlockScrolling = block; return this;} // means: disable scrolling, not scrolling in 'blocks'
+	CBaseUIScrollView *setVirtualized(bool virtualized); // see m_bVirtualized
+	CBaseUIScrollView *setCulling(bool culling); // see m_bCulling
 
 	void setScrollMouseWheelMultiplier(float scrollMouseWheelMultiplier) {m_fScrollMouseWheelMultiplier = scrollMouseWheelMultiplier;}
 	void setScrollbarSizeMultiplier(float scrollbarSizeMultiplier) {m_fScrollbarSizeMultiplier = scrollbarSizeMultiplier;}
@@ -91,9 +94,23 @@ public:
 	CBASE_UI_TYPE(CBaseUIScrollView, SCROLLVIEW, CBaseUIElement)
 protected:
 	void onMoved() override;
+	void onChildBoundsChanged(CBaseUIElement * /*child*/) override {m_bClippingDirty = true;} // elements which report to us directly (e.g. context menus)
 
 private:
+	struct CLIPPING_STATE
+	{
+		uint64_t elementsRevision;
+		uint64_t layoutRevision;
+		Vector2 containerPos;
+		Vector2 pos;
+		Vector2 size;
+
+		bool operator==(const CLIPPING_STATE &) const = default;
+	};
+
 	void updateClipping();
+	void updateClippingVirtualized();
+	void updateClippingCulled(bool forceRebuild);
 	void updateScrollbars();
 
 	void scrollToYInt(int scrollPosY, bool animated = true, bool slow = true);
@@ -108,6 +125,23 @@ private:
 	bool m_bDrawScrollbars;
 	bool m_bClipping;
 
+	// the container elements are sorted top to bottom (vertical lists), so only the range around the visible ones has to be updated/drawn/positioned every frame
+	// instead of all of them (e.g. the song browser with tens of thousands of buttons)
+	bool m_bVirtualized;
+	uint64_t m_iVirtualizedElementsRevision;
+	size_t m_iVirtualizedBegin;
+	size_t m_iVirtualizedEnd;
+
+	// large unsorted containers (e.g. the options menu) can instead be culled against a tree of their elements' bounds, only the intersecting ones are updated/drawn
+	bool m_bCulling;
+
+	// clipping only runs if something changed since the last pass
+	bool m_bClippingDirty;
+	CLIPPING_STATE m_clippingState;
+	CBaseUIBoundsTree m_boundsTree;
+	uint64_t m_iBoundsTreeElementsRevision;
+	uint64_t m_iBoundsTreeLayoutRevision;
+
 	Color m_backgroundColor;
 	Color m_frameColor;
 	Color m_frameBrightColor;
@@ -7,6 +7,7 @@
 
 #include "VisualProfiler.h"
 
+#include "AllocTracker.h"
 #include "Engine.h"
 #include "ConVar.h"
 #include "Profiler.h"
@@ -15,6 +16,7 @@
 #include "Environment.h"
 #include "ResourceManager.h"
 #include "AnimationHandler.h"
+#include "JobSystem.h"
 #include "SoundEngine.h"
 
 #include <cstring>
@@ -117,6 +119,10 @@ void VisualProfiler::draw()
 					addTextLine(UString::format("Renderer: %s", rendTypeStr), textFont, m_textLines);
 					addTextLine(UString::format("VRAM: %i MB avail. / %i MB tot.", vramAvailableMB, vramTotalMB), textFont, m_textLines);
 
+					const Graphics::DRAW_STATS &drawStats = g->getDrawStats();
+					addTextLine(UString::fmt("Draw Calls: {}", drawStats.numDrawCalls), textFont, m_textLines);
+					addTextLine(UString::fmt("Batched Images: {} in {} batches", drawStats.numBatchedImages, drawStats.numBatchFlushes), textFont, m_textLines);
+
 				}
 				break;
 
@@ -142,7 +148,8 @@ void VisualProfiler::draw()
 					addTextLine(UString::fmt("SoundEngine: {:s}", sndEngTypeStr), textFont, m_textLines);
 					addTextLine(UString::fmt("Sound Device: {:s}", soundEngine->getOutputDevice()), textFont, m_textLines);
 					addTextLine(UString::fmt("Sound Volume: {:.4f}", soundEngine->getVolume()), textFont, m_textLines);
-					addTextLine(UString::fmt("RM Threads: {}", resourceManager->getNumActiveThreads()), textFont, m_textLines);
+					addTextLine(UString::fmt("Job Workers: {}", jobSystem->getNumWorkers()), textFont, m_textLines);
+					addTextLine(UString::fmt("RM LoadingWorkAsync: {}", resourceManager->getNumLoadingWorkAsyncInProgress()), textFont, m_textLines);
 					addTextLine(UString::fmt("RM LoadingWork: {}", resourceManager->getNumLoadingWork()), textFont, m_textLines);
 					addTextLine(UString::fmt("RM LoadingWorkAD: {}", resourceManager->getNumLoadingWorkAsyncDestroy()), textFont, m_textLines);
 					addTextLine(UString::fmt("RM Named Resources: {}", resourceManager->getResources().size()), textFont, m_textLines);
@@ -173,6 +180,29 @@ void VisualProfiler::draw()
 						addTextLine("(Empty)", textFont, m_textLines);
 				}
 				break;
+
+			case INFO_BLADE_DISPLAY_MODE::INFO_BLADE_DISPLAY_MODE_MEMORY_INFO:
+				{
+					textFont = m_fontConsole;
+					textScale = std::round(env->getDPIScale() + 0.255f);
+
+					if constexpr (AllocTracker::isEnabled())
+					{
+						const AllocTracker::STATS stats = AllocTracker::getStats();
+						const AllocTracker::TAG_STATS total = AllocTracker::getTotal(stats);
+
+						addTextLine(UString::fmt("Heap: {} KB in {} allocations", total.liveBytes / 1024, total.liveAllocations), textFont, m_textLines);
+						addTextLine(UString::fmt("Last Frame: {} allocations, {} KB", stats.numAllocationsLastFrame, stats.numBytesLastFrame / 1024), textFont, m_textLines);
+						for (size_t i=0; i<stats.tags.size(); i++)
+						{
+							addTextLine(UString::fmt("{:s}: {} KB in {} allocations", AllocTracker::getTagName(static_cast<AllocTracker::TAG>(i)),
+							                         stats.tags[i].liveBytes / 1024, stats.tags[i].liveAllocations), textFont, m_textLines);
+						}
+					}
+					else
+						addTextLine("(Allocation tracking not compiled in)", textFont, m_textLines);
+				}
+				break;
 			}
 		}
 
@@ -48,8 +48,9 @@ private:
 		INFO_BLADE_DISPLAY_MODE_GPU_INFO = 1,
 		INFO_BLADE_DISPLAY_MODE_ENGINE_INFO = 2,
 		INFO_BLADE_DISPLAY_MODE_APP_INFO = 3,
+		INFO_BLADE_DISPLAY_MODE_MEMORY_INFO = 4,
 
-		INFO_BLADE_DISPLAY_MODE_COUNT = 4
+		INFO_BLADE_DISPLAY_MODE_COUNT = 5
 	};
 
 	struct TEXT_LINE
@@ -68,6 +68,11 @@
  */
 #define MCENGINE_FEATURE_PROFILING
 
+/*
+ * Heap allocation tracking (alloc_stats) (defined in config.h)
+ */
+//#define MCENGINE_FEATURE_ALLOCTRACKING
+
 /*
  * If, for some reason, you want SDL main callbacks on desktop (it's forced on WASM)
  */
@@ -80,6 +80,7 @@ public:
 	SDL_AppResult initialize();
 	SDL_AppResult iterate();
 	SDL_AppResult handleEvent(SDL_Event *event);
+	void pollEvents(); // pump and handle everything in the queue (without main callbacks, SDL does that for us otherwise)
 	void shutdown(SDL_AppResult result);
 
 private:
@@ -173,6 +174,11 @@ MAIN_FUNC /* int argc, char *argv[] */
 	SDL_SetAppMetadataProperty(SDL_PROP_APP_METADATA_TYPE_STRING, "game");
 
 	SDL_SetHint(SDL_HINT_VIDEO_DOUBLE_BUFFER, "1");
+
+	// the null renderer is meant for machines without a display/gpu, so default to a driver which doesn't need one (the SDL_VIDEO_DRIVER env var still takes precedence)
+	if (std::ranges::any_of(argv + 1, argv + argc, [](const char *arg) { return std::string_view(arg) == "-nullgfx"; }))
+		SDL_SetHintWithPriority(SDL_HINT_VIDEO_DRIVER, "offscreen", SDL_HINT_DEFAULT);
+
 	if (!SDL_Init(SDL_INIT_VIDEO)) // other subsystems can be init later
 	{
 		fprintf(stderr, "Couldn't SDL_Init(): %s\n", SDL_GetError());
@@ -185,32 +191,13 @@ MAIN_FUNC /* int argc, char *argv[] */
 	if (!fmain || fmain->initialize() == SDL_APP_FAILURE)
 		SDL_AppQuit(fmain, SDL_APP_FAILURE);
 
-	constexpr int SIZE_EVENTS = 64;
-	std::array<SDL_Event, SIZE_EVENTS> events{};
-
 	while (fmain->isRunning())
 	{
 		VPROF_MAIN();
 		{
 			// event collection
 			VPROF_BUDGET("SDL", VPROF_BUDGETGROUP_WNDPROC);
-			int eventCount = 0;
-			{
-				VPROF_BUDGET("SDL_PumpEvents", VPROF_BUDGETGROUP_WNDPROC);
-				SDL_PumpEvents();
-			}
-			do
-			{
-				{
-					VPROF_BUDGET("SDL_PeepEvents", VPROF_BUDGETGROUP_WNDPROC);
-					eventCount = SDL_PeepEvents(&events[0], SIZE_EVENTS, SDL_GETEVENT, SDL_EVENT_FIRST, SDL_EVENT_LAST);
-				}
-				{
-					VPROF_BUDGET("handleEvent", VPROF_BUDGETGROUP_WNDPROC);
-					for (int i = 0; i < eventCount; ++i)
-						fmain->handleEvent(&events[i]);
-				}
-			} while (eventCount == SIZE_EVENTS);
+			fmain->pollEvents();
 		}
 		{
 			// engine update + draw + fps limiter
@@ -244,6 +231,7 @@ ConVar fps_max_background("fps_max_background", 30.0f, FCVAR_NONE, "framerate li
 ConVar fps_unlimited("fps_unlimited", false, FCVAR_NONE);
 
 ConVar fps_yield("fps_yield", true, FCVAR_NONE, "always release rest of timeslice at the end of each frame (call scheduler via sleep(0))");
+ConVar input_poll_rate("input_poll_rate", 1000, FCVAR_NONE, "keep handling input events this many times per second while the fps limiter waits for the next frame, so that input timing doesn't depend on fps_max (0 = only once per frame)");
 } // namespace cv
 
 SDLMain::SDLMain(int argc, char *argv[])
@@ -453,11 +441,11 @@ nocbinline SDL_AppResult SDLMain::handleEvent(SDL_Event *event)
 
 	// keyboard events
 	case SDL_EVENT_KEY_DOWN:
-		keyboard->onKeyDown(event->key.scancode);
+		keyboard->onKeyDown(event->key.scancode, event->key.timestamp);
 		break;
 
 	case SDL_EVENT_KEY_UP:
-		keyboard->onKeyUp(event->key.scancode);
+		keyboard->onKeyUp(event->key.scancode, event->key.timestamp);
 		break;
 
 	case SDL_EVENT_TEXT_INPUT:
@@ -467,11 +455,11 @@ nocbinline SDL_AppResult SDLMain::handleEvent(SDL_Event *event)
 
 	// mouse events
 	case SDL_EVENT_MOUSE_BUTTON_DOWN:
-		mouse->onButtonChange(static_cast<MouseButton::Index>(event->button.button), true); // C++ needs me to cast an unsigned char to an unsigned char
+		mouse->onButtonChange(static_cast<MouseButton::Index>(event->button.button), true, event->button.timestamp); // C++ needs me to cast an unsigned char to an unsigned char
 		break;
 
 	case SDL_EVENT_MOUSE_BUTTON_UP:
-		mouse->onButtonChange(static_cast<MouseButton::Index>(event->button.button), false);
+		mouse->onButtonChange(static_cast<MouseButton::Index>(event->button.button), false, event->button.timestamp);
 		break;
 
 	case SDL_EVENT_MOUSE_WHEEL:
@@ -488,7 +476,7 @@ nocbinline SDL_AppResult SDLMain::handleEvent(SDL_Event *event)
 		m_vLastRelMousePos.y = event->motion.yrel;
 		m_vLastAbsMousePos.x = event->motion.x;
 		m_vLastAbsMousePos.y = event->motion.y;
-		mouse->onMotion(event->motion.x, event->motion.y, event->motion.xrel, event->motion.yrel, event->motion.which != 0);
+		mouse->onMotion(event->motion.x, event->motion.y, event->motion.xrel, event->motion.yrel, event->motion.which != 0, event->motion.timestamp);
 		break;
 
 	default:
@@ -504,6 +492,30 @@ nocbinline SDL_AppResult SDLMain::handleEvent(SDL_Event *event)
 #pragma GCC diagnostic pop
 #endif
 
+void SDLMain::pollEvents()
+{
+	constexpr int SIZE_EVENTS = 64;
+	std::array<SDL_Event, SIZE_EVENTS> events{};
+
+	int eventCount = 0;
+	{
+		VPROF_BUDGET("SDL_PumpEvents", VPROF_BUDGETGROUP_WNDPROC);
+		SDL_PumpEvents();
+	}
+	do
+	{
+		{
+			VPROF_BUDGET("SDL_PeepEvents", VPROF_BUDGETGROUP_WNDPROC);
+			eventCount = SDL_PeepEvents(&events[0], SIZE_EVENTS, SDL_GETEVENT, SDL_EVENT_FIRST, SDL_EVENT_LAST);
+		}
+		{
+			VPROF_BUDGET("handleEvent", VPROF_BUDGETGROUP_WNDPROC);
+			for (int i = 0; i < eventCount; ++i)
+				handleEvent(&events[i]);
+		}
+	} while (eventCount == SIZE_EVENTS);
+}
+
 nocbinline SDL_AppResult SDLMain::iterate()
 {
 	if (!m_bRunning)
@@ -529,7 +541,7 @@ nocbinline SDL_AppResult SDLMain::iterate()
 
 		// if minimized or unfocused, use BG fps, otherwise use fps_max (if 0 it's unlimited)
 		const int targetFPS = m_bMinimized || !m_bHasFocus ? m_iFpsMaxBG : m_iFpsMax;
-		FPSLimiter::limitFrames(targetFPS);
+		FPSLimiter::limitFrames(targetFPS, [this] { pollEvents(); });
 	}
 
 	return SDL_APP_CONTINUE;
@@ -538,7 +550,7 @@ nocbinline SDL_AppResult SDLMain::iterate()
 bool SDLMain::createWindow()
 {
 	// pre window-creation settings
-	if constexpr (Env::cfg((REND::GL | REND::GLES32 | REND::GL3), !REND::DX11))
+	if (Env::cfg((REND::GL | REND::GLES32 | REND::GL3), !REND::DX11) && !m_bNullRenderer)
 	{
 		SDL_GL_SetAttribute(SDL_GL_DOUBLEBUFFER, 1);
 		SDL_GL_SetAttribute(SDL_GL_CONTEXT_PROFILE_MASK,
@@ -553,8 +565,9 @@ bool SDLMain::createWindow()
 	}
 
 	// set vulkan for linux dxvk-native, opengl otherwise (or none for windows dx11)
-	constexpr auto windowFlags = SDL_WINDOW_HIDDEN | SDL_WINDOW_INPUT_FOCUS | SDL_WINDOW_MOUSE_FOCUS |
-	                             (Env::cfg((REND::GL | REND::GLES32 | REND::GL3)) ? SDL_WINDOW_OPENGL : (Env::cfg(OS::LINUX, REND::DX11) ? SDL_WINDOW_VULKAN : 0UL));
+	// (no graphics api at all for the null renderer)
+	const auto windowFlags = SDL_WINDOW_HIDDEN | SDL_WINDOW_INPUT_FOCUS | SDL_WINDOW_MOUSE_FOCUS |
+	                         (m_bNullRenderer ? 0UL : Env::cfg((REND::GL | REND::GLES32 | REND::GL3)) ? SDL_WINDOW_OPENGL : (Env::cfg(OS::LINUX, REND::DX11) ? SDL_WINDOW_VULKAN : 0UL));
 
 	// get default monitor resolution and create the window with that as the starting size
 	long windowCreateWidth = WINDOW_WIDTH;
@@ -613,7 +626,7 @@ bool SDLMain::createWindow()
 
 void SDLMain::setupOpenGL()
 {
-	if constexpr (Env::cfg((REND::GL | REND::GLES32 | REND::GL3), !REND::DX11))
+	if (Env::cfg((REND::GL | REND::GLES32 | REND::GL3), !REND::DX11) && !m_bNullRenderer)
 	{
 		m_context = SDL_GL_CreateContext(m_window);
 		SDL_GL_MakeCurrent(m_window, m_context);
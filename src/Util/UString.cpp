@@ -771,3 +771,10 @@ bool UString::ncasecomp::operator()(const UString &lhs, const UString &rhs) cons
 	// if all compared characters are equal, shorter string is less
 	return lhsLen < rhsLen;
 }
+
+std::wstring UString::ncasecomp::collationKey(const UString &str)
+{
+	std::wstring key(str.unicodeView());
+	std::ranges::transform(key, key.begin(), normalizeCase);
+	return key;
+}
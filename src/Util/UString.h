@@ -262,6 +262,9 @@ public:
 	public:
 		bool operator()(const UString &lhs, const UString &rhs) const noexcept;
 
+		// case normalized copy, comparing these with std::wstring::operator< gives the same order as operator()
+		[[nodiscard]] static std::wstring collationKey(const UString &str);
+
 	private:
 		// consistent case normalization that avoids locale-dependent behavior (to use with std::sort to satisfy strict-weak-ordering)
 		static constexpr wchar_t normalizeCase(wchar_t ch) noexcept